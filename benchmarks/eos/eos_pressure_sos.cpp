@@ -0,0 +1,182 @@
+#include <benchmark/benchmark.h>
+#include "eos_multi_material.hpp"
+#include <Kokkos_Core.hpp>
+
+#include <cstdint>
+#include <cstdlib>
+#include <string>
+#include <vector>
+
+/**
+ * @file eos_pressure_sos.cpp
+ * @brief Memory bandwidth of the EOS kernels.
+ *
+ * Every benchmark sweeps 10^3 to 10^8 particles on the default Kokkos
+ * execution space (one binary per Kokkos build, the backend is reported in
+ * the context) and reports the achieved bandwidth in `GB/s`, counting one
+ * read of `rho`, `eint` (and `eos_id`) and one write of `p` and `sos` per
+ * particle. `Copy` measures the attainable bandwidth of a plain view copy
+ * of the same size. When the environment variable
+ * `SPHIROS_PEAK_BANDWIDTH` holds the device peak in GB/s, the fraction of
+ * the peak is reported as `peak`.
+ *
+ *     ./eos_pressure_sos_benchmark --benchmark_filter=LinearGas
+ */
+
+namespace {
+
+/**
+ * @brief Device peak bandwidth in GB/s (0 if unknown).
+ */
+double PeakBandwidth() {
+    const char* peak = std::getenv("SPHIROS_PEAK_BANDWIDTH");
+    return peak != nullptr ? std::atof(peak) : 0.0;
+}
+
+/**
+ * @brief Times the iterations of a benchmark and reports its bandwidth.
+ *
+ * @param state Benchmark state.
+ * @param bytes Bytes moved by one call of `kernel`.
+ * @param kernel Callable launching the kernel.
+ */
+template <class Kernel>
+void RunBandwidth(benchmark::State& state, const double bytes,
+                  Kernel&& kernel) {
+    Kokkos::fence();
+    double seconds = 0.0;
+    for (auto _ : state) {
+        Kokkos::Timer timer;
+        kernel();
+        Kokkos::fence();
+        const double elapsed = timer.seconds();
+        state.SetIterationTime(elapsed);
+        seconds += elapsed;
+    }
+    const double gb_s =
+        bytes * static_cast<double>(state.iterations()) / seconds / 1e9;
+    const double peak = PeakBandwidth();
+    state.SetBytesProcessed(static_cast<std::int64_t>(bytes) *
+                            state.iterations());
+    state.counters["GB/s"] = gb_s;
+    if (peak > 0.0) state.counters["peak"] = gb_s / peak;
+}
+
+/**
+ * @brief Times a single-material EOS kernel.
+ *
+ * @tparam EOS EOS type providing `PressureSoSImpl`.
+ * @param state Benchmark state (`range(0)` particles).
+ * @param eos EOS object.
+ */
+template <class EOS>
+void RunPressureSoS(benchmark::State& state, const EOS& eos) {
+    using Scalar = typename EOS::scalar_type;
+    const auto N = static_cast<std::size_t>(state.range(0));
+    Kokkos::View<Scalar*> rho("rho", N);
+    Kokkos::View<Scalar*> eint("eint", N);
+    Kokkos::View<Scalar*> p("p", N);
+    Kokkos::View<Scalar*> sos("sos", N);
+    Kokkos::deep_copy(rho, Scalar(1));
+    Kokkos::deep_copy(eint, Scalar(2));
+
+    RunBandwidth(state, 4.0 * sizeof(Scalar) * N,
+                 [&]() { eos.PressureSoSImpl(rho, eint, p, sos); });
+}
+
+/**
+ * @brief `EOSLinearGas::PressureSoSImpl`.
+ */
+template <typename Scalar>
+void LinearGas(benchmark::State& state) {
+    RunPressureSoS(state, EOSLinearGas<Scalar>(0, 1.4, 1e-6));
+}
+
+/**
+ * @brief `EOSStiffenedGas::PressureSoSImpl`.
+ */
+template <typename Scalar>
+void StiffenedGas(benchmark::State& state) {
+    RunPressureSoS(state, EOSStiffenedGas<Scalar>(0, 4.4, 1e-6, 6e8));
+}
+
+/**
+ * @brief `EOSMultiMaterial::PressureSoS` with two materials.
+ *
+ * `range(1)` selects the material layout: 0 for contiguous materials (as
+ * after `MaterialSort`), 1 for alternating materials (divergent branches).
+ */
+void MultiMaterial(benchmark::State& state) {
+    const auto N = static_cast<std::size_t>(state.range(0));
+    const bool interleaved = state.range(1) != 0;
+    std::vector<EOSVariant> eos_vector;
+    eos_vector.emplace_back(EOSLinearGas(0, 1.4, 1e-6));
+    eos_vector.emplace_back(EOSStiffenedGas(1, 4.4, 1e-6, 6e8));
+    const EOSMultiMaterial eos(eos_vector, false);
+
+    Kokkos::View<int*> eos_id("eos_id", N);
+    Kokkos::View<double*> rho("rho", N);
+    Kokkos::View<double*> eint("eint", N);
+    Kokkos::View<EOSScalar*> p("p", N);
+    Kokkos::View<EOSScalar*> sos("sos", N);
+    Kokkos::parallel_for(
+        "MultiMaterial::Init", N, KOKKOS_LAMBDA(const int i) {
+            const bool first_half = 2 * static_cast<std::size_t>(i) < N;
+            eos_id(i)             = interleaved ? i % 2 : (first_half ? 0 : 1);
+        });
+    Kokkos::deep_copy(rho, 1.0);
+    Kokkos::deep_copy(eint, 2.0);
+
+    const double bytes =
+        (sizeof(int) + 2.0 * sizeof(double) + 2.0 * sizeof(EOSScalar)) * N;
+    RunBandwidth(state, bytes,
+                 [&]() { eos.PressureSoS(eos_id, rho, eint, p, sos); });
+}
+
+/**
+ * @brief Plain copy of a view, the attainable bandwidth reference.
+ */
+template <typename Scalar>
+void Copy(benchmark::State& state) {
+    const auto N = static_cast<std::size_t>(state.range(0));
+    Kokkos::View<Scalar*> src("src", N);
+    Kokkos::View<Scalar*> dst("dst", N);
+
+    RunBandwidth(state, 2.0 * sizeof(Scalar) * N, [&]() {
+        Kokkos::parallel_for(
+            "Copy", N, KOKKOS_LAMBDA(const int i) { dst(i) = src(i); });
+    });
+}
+
+}  // namespace
+
+BENCHMARK(Copy<double>)->RangeMultiplier(10)->Range(1000, 100000000)
+    ->UseManualTime();
+BENCHMARK(LinearGas<double>)->RangeMultiplier(10)->Range(1000, 100000000)
+    ->UseManualTime();
+BENCHMARK(LinearGas<float>)->RangeMultiplier(10)->Range(1000, 100000000)
+    ->UseManualTime();
+BENCHMARK(StiffenedGas<double>)->RangeMultiplier(10)->Range(1000, 100000000)
+    ->UseManualTime();
+BENCHMARK(StiffenedGas<float>)->RangeMultiplier(10)->Range(1000, 100000000)
+    ->UseManualTime();
+BENCHMARK(MultiMaterial)
+    ->ArgNames({"N", "interleaved"})
+    ->ArgsProduct({benchmark::CreateRange(1000, 100000000, 10), {0, 1}})
+    ->UseManualTime();
+
+int main(int argc, char** argv) {
+    Kokkos::initialize(argc, argv);
+    {
+        benchmark::Initialize(&argc, argv);
+        benchmark::AddCustomContext("kokkos_execution_space",
+                                    Kokkos::DefaultExecutionSpace::name());
+        benchmark::AddCustomContext(
+            "kokkos_concurrency",
+            std::to_string(Kokkos::DefaultExecutionSpace().concurrency()));
+        benchmark::RunSpecifiedBenchmarks();
+        benchmark::Shutdown();
+    }
+    Kokkos::finalize();
+    return 0;
+}
@@ -0,0 +1,492 @@
+#include <mpi.h>
+#include <yaml-cpp/yaml.h>
+#include <Kokkos_Core.hpp>
+#include <CLI/CLI.hpp>
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstdint>
+#include <fstream>
+#include <iostream>
+#include <optional>
+#include <stdexcept>
+#include <string>
+#include <utility>
+
+#include "collective_read.hpp"
+#include "device_arena.hpp"
+#include "halo_exchange.hpp"
+#include "leap_frog.hpp"
+#include "load_balancer.hpp"
+#include "material_table.hpp"
+#include "neighbor_search.hpp"
+#include "particle_data.hpp"
+#include "simulation_config.hpp"
+#include "sph_solver.hpp"
+#include "timing_report.hpp"
+
+/**
+ * @file scaling_benchmark.cpp
+ * @brief Weak and strong scaling driver of a full SPH step.
+ *
+ * The driver reads a regular input deck (EOS, parts, solver, time
+ * integration, load balance and profiling sections) extended with a
+ * `scaling` section, generates a uniform particle lattice split over a
+ * Cartesian grid of ranks (no mesh file), and runs a fixed number of
+ * leap-frog steps: halo exchange, neighbor search, density, EOS, forces and
+ * load balancing, as in a production run. The lattice holds the sphere
+ * example as a dense ball of the `inner` part in the `outer` part.
+ *
+ * In `weak` mode `lattice` is the number of particles of each rank along
+ * each axis, so the problem grows with the ranks; in `strong` mode it is the
+ * global lattice, split as evenly as possible. The timed steps are reported
+ * as JSON: the case, the particle count, the wall time per step, the device
+ * allocations of the step workspace (`DeviceArena`, reset once per step:
+ * zero in a steady state) and, for every profiling region, the calls and
+ * the minimum, maximum and average time over the ranks.
+ *
+ *     mpirun -np 8 ./scaling_benchmark -i weak.yaml -o weak_8.json
+ */
+
+namespace {
+
+/**
+ * @brief Particle container of the driver.
+ */
+using Particles = ParticleData<Kokkos::LayoutRight, EOSScalar>;
+
+/**
+ * @struct LatticeState
+ * @brief Initial state of the particles of one part.
+ */
+struct LatticeState {
+    int part_id = 0;    ///< Part of the particles.
+    double rho  = 1.0;  ///< Density.
+    double eint = 1.0;  ///< Specific internal energy.
+};
+
+/**
+ * @struct ScalingCase
+ * @brief Content of the `scaling` section of the driver input.
+ */
+struct ScalingCase {
+    /**
+     * @brief `weak` (lattice per rank) or `strong` (global lattice).
+     */
+    std::string mode = "weak";
+    /**
+     * @brief Particles along each axis (per rank or global).
+     */
+    std::array<long, 3> lattice = {32, 32, 32};
+    /**
+     * @brief Ranks along each axis (0 for `MPI_Dims_create`).
+     */
+    std::array<int, 3> ranks = {0, 0, 0};
+    /**
+     * @brief Lattice spacing.
+     */
+    double spacing = 1e-2;
+    /**
+     * @brief Smoothing length in units of the spacing.
+     */
+    double eta = 1.3;
+    /**
+     * @brief Verlet skin in units of the spacing.
+     */
+    double skin = 0.2;
+    /**
+     * @brief Maximum number of steps between two neighbor list (and ghost)
+     * rebuilds.
+     */
+    int rebuild_every = 10;
+    /**
+     * @brief Untimed steps before the timed ones.
+     */
+    int warmup_steps = 2;
+    /**
+     * @brief Timed steps.
+     */
+    int steps = 20;
+    /**
+     * @brief Radius of the ball in units of the smallest box extent.
+     */
+    double sphere_radius = 0.25;
+    /**
+     * @brief State inside the ball.
+     */
+    LatticeState inner = {1, 1.0, 10.0};
+    /**
+     * @brief State outside the ball.
+     */
+    LatticeState outer = {0, 1.0, 1.0};
+    /**
+     * @brief Repartition the lattice with the SFC decomposition before the
+     * steps (instead of keeping the Cartesian blocks).
+     */
+    bool decompose = false;
+
+    /**
+     * @brief Parses and validates the `scaling` section.
+     *
+     * @param node Section node (missing values keep their defaults).
+     * @return Validated case.
+     * @throws std::invalid_argument If a value is invalid.
+     */
+    static ScalingCase FromNode(const YAML::Node& node) {
+        ScalingCase c;
+        if (node["mode"]) c.mode = node["mode"].as<std::string>();
+        if (node["lattice"]) {
+            c.lattice = node["lattice"].as<std::array<long, 3>>();
+        }
+        if (node["ranks"]) c.ranks = node["ranks"].as<std::array<int, 3>>();
+        if (node["spacing"]) c.spacing = node["spacing"].as<double>();
+        if (node["eta"]) c.eta = node["eta"].as<double>();
+        if (node["skin"]) c.skin = node["skin"].as<double>();
+        if (node["rebuild_every"]) {
+            c.rebuild_every = node["rebuild_every"].as<int>();
+        }
+        if (node["warmup_steps"]) {
+            c.warmup_steps = node["warmup_steps"].as<int>();
+        }
+        if (node["steps"]) c.steps = node["steps"].as<int>();
+        if (node["sphere_radius"]) {
+            c.sphere_radius = node["sphere_radius"].as<double>();
+        }
+        for (auto [key, state] : {std::pair{"inner", &c.inner},
+                                  std::pair{"outer", &c.outer}}) {
+            const YAML::Node part = node[key];
+            if (!part) continue;
+            if (part["part_id"]) state->part_id = part["part_id"].as<int>();
+            if (part["rho"]) state->rho = part["rho"].as<double>();
+            if (part["eint"]) state->eint = part["eint"].as<double>();
+        }
+        if (node["decompose"]) c.decompose = node["decompose"].as<bool>();
+
+        if (c.mode != "weak" && c.mode != "strong") {
+            throw std::invalid_argument(
+                "ScalingCase: mode must be 'weak' or 'strong'");
+        }
+        for (int d = 0; d < 3; ++d) {
+            if (c.lattice[d] < 1 || c.ranks[d] < 0) {
+                throw std::invalid_argument(
+                    "ScalingCase: lattice must be positive and ranks "
+                    "non-negative");
+            }
+        }
+        if (!(c.spacing > 0.0) || !(c.eta > 0.0) || !(c.skin >= 0.0) ||
+            c.rebuild_every < 1 || c.warmup_steps < 0 || c.steps < 1) {
+            throw std::invalid_argument(
+                "ScalingCase: spacing and eta must be positive, skin and "
+                "warmup_steps non-negative, rebuild_every and steps at "
+                "least 1");
+        }
+        if (!(c.inner.rho > 0.0) || !(c.outer.rho > 0.0)) {
+            throw std::invalid_argument(
+                "ScalingCase: part densities must be positive");
+        }
+        return c;
+    }
+};
+
+/**
+ * @brief Generates the lattice block of the calling rank.
+ *
+ * The global lattice is split into `dims` blocks along the axes; the rank
+ * of Cartesian coordinates `coords` owns the lattice nodes
+ * `[coords * n / dims, (coords + 1) * n / dims)` of each axis.
+ *
+ * @param c Scaling case.
+ * @param global Global lattice.
+ * @param dims Ranks along each axis.
+ * @param coords Cartesian coordinates of the calling rank.
+ * @param tables Material tables assigning the EOS ids.
+ * @return Particles of the block, at rest.
+ */
+Particles GenerateBlock(const ScalingCase& c,
+                        const std::array<long, 3>& global,
+                        const std::array<int, 3>& dims,
+                        const std::array<int, 3>& coords,
+                        const MaterialTable& tables) {
+    long lo[3], n[3];
+    for (int d = 0; d < 3; ++d) {
+        lo[d]         = coords[d] * global[d] / dims[d];
+        const long hi = (coords[d] + 1) * global[d] / dims[d];
+        n[d]          = hi - lo[d];
+    }
+    Particles particles(static_cast<std::size_t>(n[0] * n[1] * n[2]));
+
+    const double dx        = c.spacing;
+    const double center[3] = {0.5 * global[0] * dx, 0.5 * global[1] * dx,
+                              0.5 * global[2] * dx};
+    const double radius =
+        c.sphere_radius * dx *
+        static_cast<double>(std::min({global[0], global[1], global[2]}));
+    const double volume      = dx * dx * dx;
+    const double h           = c.eta * dx;
+    const LatticeState inner = c.inner;
+    const LatticeState outer = c.outer;
+    const long lo0 = lo[0], lo1 = lo[1], lo2 = lo[2];
+    const long n1 = n[1], n2 = n[2];
+    const auto x       = particles.X();
+    const auto v       = particles.V();
+    const auto mass    = particles.Mass();
+    const auto h_view  = particles.H();
+    const auto rho     = particles.Rho();
+    const auto eint    = particles.Eint();
+    const auto part_id = particles.PartId();
+    Kokkos::parallel_for(
+        "ScalingBenchmark::Generate", particles.Size(),
+        KOKKOS_LAMBDA(const int i) {
+            const long k[3] = {lo0 + i / (n1 * n2), lo1 + (i / n2) % n1,
+                               lo2 + i % n2};
+            double r2 = 0.0;
+            for (int d = 0; d < 3; ++d) {
+                x(i, d)         = (k[d] + 0.5) * dx;
+                v(i, d)         = 0.0;
+                const double dr = x(i, d) - center[d];
+                r2 += dr * dr;
+            }
+            const LatticeState& state = r2 < radius * radius ? inner : outer;
+            part_id(i) = state.part_id;
+            rho(i)     = state.rho;
+            eint(i)    = state.eint;
+            mass(i)    = state.rho * volume;
+            h_view(i)  = h;
+        });
+    tables.AssignEOSIds(particles);
+    return particles;
+}
+
+/**
+ * @brief Writes the timings of the timed steps as JSON (rank 0).
+ *
+ * @param filename Output path.
+ * @param c Scaling case.
+ * @param dims Ranks along each axis.
+ * @param n_global Global number of particles.
+ * @param seconds Wall time of the timed steps (slowest rank).
+ * @param arena_allocations Device arena allocations of the timed steps
+ * (most over the ranks).
+ * @param report Region timings of the timed steps.
+ * @throws std::runtime_error If the file cannot be written.
+ */
+void WriteResults(const std::string& filename, const ScalingCase& c,
+                  const std::array<int, 3>& dims,
+                  const unsigned long long n_global, const double seconds,
+                  const unsigned long long arena_allocations,
+                  const TimingReport& report) {
+    std::ofstream file(filename);
+    if (!file) {
+        throw std::runtime_error("ScalingBenchmark: cannot open " + filename);
+    }
+    const int n_ranks = dims[0] * dims[1] * dims[2];
+    file.precision(17);
+    file << "{\n  \"mode\": \"" << c.mode << "\",\n  \"ranks\": " << n_ranks
+         << ",\n  \"decomposition\": [" << dims[0] << ", " << dims[1] << ", "
+         << dims[2] << "],\n  \"lattice\": [" << c.lattice[0] << ", "
+         << c.lattice[1] << ", " << c.lattice[2]
+         << "],\n  \"particles\": " << n_global
+         << ",\n  \"particles_per_rank\": "
+         << static_cast<double>(n_global) / n_ranks
+         << ",\n  \"steps\": " << c.steps << ",\n  \"seconds\": " << seconds
+         << ",\n  \"seconds_per_step\": " << seconds / c.steps
+         << ",\n  \"particle_steps_per_second\": "
+         << static_cast<double>(n_global) * c.steps / seconds
+         << ",\n  \"arena_allocations\": " << arena_allocations
+         << ",\n  \"regions\": [";
+    const auto& rows = report.Rows();
+    for (std::size_t k = 0; k < rows.size(); ++k) {
+        const TimingReport::Row& row = rows[k];
+        file << (k == 0 ? "\n" : ",\n") << "    {\"name\": \"" << row.name
+             << "\", \"calls\": " << row.calls << ", \"min\": " << row.min
+             << ", \"max\": " << row.max << ", \"avg\": " << row.avg << "}";
+    }
+    file << "\n  ]\n}\n";
+}
+
+/**
+ * @brief Generates the case and runs the steps (collective).
+ *
+ * @param config Input deck.
+ * @param c Scaling case.
+ * @param output JSON output path.
+ */
+void Run(const SimulationConfig& config, const ScalingCase& c,
+         const std::string& output) {
+    int rank, size;
+    MPI_Comm_rank(MPI_COMM_WORLD, &rank);
+    MPI_Comm_size(MPI_COMM_WORLD, &size);
+    std::array<int, 3> dims = c.ranks;
+    if (MPI_Dims_create(size, 3, dims.data()) != MPI_SUCCESS ||
+        dims[0] * dims[1] * dims[2] != size) {
+        throw std::invalid_argument(
+            "ScalingBenchmark: ranks do not match the number of processes");
+    }
+    std::array<long, 3> global = c.lattice;
+    if (c.mode == "weak") {
+        for (int d = 0; d < 3; ++d) global[d] *= dims[d];
+    }
+    for (int d = 0; d < 3; ++d) {
+        if (global[d] < dims[d]) {
+            throw std::invalid_argument(
+                "ScalingBenchmark: fewer lattice nodes than ranks on an axis");
+        }
+    }
+    const std::array<int, 3> coords = {rank / (dims[1] * dims[2]),
+                                       (rank / dims[2]) % dims[1],
+                                       rank % dims[2]};
+
+    Profiler::Global().SetFence(config.Profiling().fence);
+    const MaterialTable tables(config);
+    Particles particles = GenerateBlock(c, global, dims, coords, tables);
+    const LoadBalanceConfig& lb = config.LoadBalance();
+    LoadBalancer balancer(lb.threshold, lb.cadence, MPI_COMM_WORLD);
+    if (c.decompose) balancer.Decompose(particles);
+
+    // Ghosts and neighbor lists reach the kernel support plus the skin, and
+    // are rebuilt together: every rebuild_every steps, when a particle moved
+    // by half the skin (NeighborSearch::NeedsRebuild) or after a migration
+    const double cutoff = CubicSplineKernel::support * c.eta * c.spacing;
+    const double skin   = c.skin * c.spacing;
+    HaloExchange halo(cutoff + skin);
+    NeighborSearch search(cutoff, skin, c.rebuild_every);
+    const SolverConfig& sc = config.Solver();
+    const PairLoop loop    = sc.pair_loop;
+    search.SetHalfList(loop == PairLoop::HalfScatter ||
+                       loop == PairLoop::HalfColoring);
+    SPHSolver<> solver(tables.EOS(),
+                       sc.eos_tolerance > 0.0 ? EOSCoupling::Lazy
+                                              : EOSCoupling::Separate,
+                       {}, sc.Tuning(), sc.eos_tolerance);
+    solver.SetLoop(loop);
+
+    int step     = 0;
+    int age      = 0;
+    bool rebuild = true;
+    auto forces  = [&](Particles& p) {
+        if (!rebuild) {
+            // The ghosts of the last build, moved with their owners; the
+            // halo build is collective, so any rank rebuilding makes all
+            // ranks rebuild
+            halo.Exchange(p);
+            int stale = ++age >= c.rebuild_every || search.NeedsRebuild(p.X());
+            MPI_Allreduce(MPI_IN_PLACE, &stale, 1, MPI_INT, MPI_LOR,
+                          MPI_COMM_WORLD);
+            rebuild = stale != 0;
+            if (rebuild) halo.RemoveGhosts(p);
+        }
+        if (rebuild) {
+            halo.Build(p);
+            halo.Exchange(p);
+            search.Build(p.X());
+            rebuild = false;
+            age     = 0;
+        }
+        solver.Density(p, search);
+        // The ghosts need the density of their owners
+        halo.Exchange(p);
+        solver.Forces(p, search);
+        halo.RemoveGhosts(p);
+    };
+
+    forces(particles);
+    LeapFrog integrator(config.TimeIntegration().cfl);
+    integrator.Start(particles);
+    // The workspace of a step is handed out by the device arena, sized by
+    // the first steps
+    DeviceArena& arena  = DeviceArena::Global();
+    std::size_t n_alloc = 0;
+    double seconds      = 0.0;
+    for (; step < c.warmup_steps + c.steps; ++step) {
+        if (step == c.warmup_steps) {
+            MPI_Barrier(MPI_COMM_WORLD);
+            Profiler::Global().Reset();
+            n_alloc = arena.NumAllocations();
+        }
+        arena.Reset();
+        Kokkos::Timer timer;
+        integrator.Step(particles, forces);
+        Kokkos::fence("ScalingBenchmark::Step");
+        const double elapsed = timer.seconds();
+        if (step >= c.warmup_steps) seconds += elapsed;
+        if (balancer.Update(step + 1, particles, elapsed)) rebuild = true;
+    }
+    double max_seconds = 0.0;
+    MPI_Reduce(&seconds, &max_seconds, 1, MPI_DOUBLE, MPI_MAX, 0,
+               MPI_COMM_WORLD);
+    const unsigned long long n_arena = arena.NumAllocations() - n_alloc;
+    unsigned long long max_arena     = 0;
+    MPI_Reduce(&n_arena, &max_arena, 1, MPI_UNSIGNED_LONG_LONG, MPI_MAX, 0,
+               MPI_COMM_WORLD);
+
+    const unsigned long long n_local = particles.Size();
+    unsigned long long n_global      = 0;
+    MPI_Reduce(&n_local, &n_global, 1, MPI_UNSIGNED_LONG_LONG, MPI_SUM, 0,
+               MPI_COMM_WORLD);
+    const TimingReport report;
+    if (rank == 0) {
+        std::cout << c.mode << " scaling: " << size << " ranks ("
+                  << dims[0] << "x" << dims[1] << "x" << dims[2] << "), "
+                  << n_global << " particles, " << c.steps << " steps, "
+                  << max_seconds / c.steps << " s/step" << std::endl;
+        std::cout << max_arena
+                  << " device arena allocations in the timed steps"
+                  << std::endl;
+        report.Print(std::cout);
+        WriteResults(output, c, dims, n_global, max_seconds, max_arena,
+                     report);
+    }
+}
+
+}  // namespace
+
+/**
+ * @brief Entry point of the scaling driver.
+ *
+ * @param argc Number of command-line arguments.
+ * @param argv Array of command-line arguments.
+ * @return Exit code.
+ */
+int main(int argc, char** argv) {
+    MPI_Init(&argc, &argv);
+    Kokkos::initialize(argc, argv);
+    int rank;
+    MPI_Comm_rank(MPI_COMM_WORLD, &rank);
+
+    CLI::App app{"SPHiros scaling benchmark"};
+    std::string input_file;
+    app.add_option("-i,--input", input_file, "Driver YAML file")->required();
+    std::string output_file = "scaling.json";
+    app.add_option("-o,--output", output_file, "JSON timings file");
+    int exit_code = 0;
+    try {
+        app.parse(argc, argv);
+    } catch (const CLI::ParseError& e) {
+        exit_code = app.exit(e);
+        Kokkos::finalize();
+        MPI_Finalize();
+        return exit_code;
+    }
+
+    try {
+        const std::string text = CollectiveRead::Broadcast(input_file);
+        const SimulationConfig config =
+            SimulationConfig::FromString(text, input_file);
+        std::optional<ScalingCase> c;
+        try {
+            c = ScalingCase::FromNode(YAML::Load(text)["scaling"]);
+        } catch (const YAML::Exception& e) {
+            throw std::invalid_argument("ScalingCase: " + input_file + ": " +
+                                        e.what());
+        }
+        Run(config, *c, output_file);
+    } catch (const std::exception& e) {
+        if (rank == 0) std::cerr << e.what() << std::endl;
+        exit_code = 1;
+    }
+
+    Kokkos::finalize();
+    MPI_Finalize();
+    return exit_code;
+}
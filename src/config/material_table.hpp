@@ -0,0 +1,156 @@
+#pragma once
+
+#include <algorithm>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+// Kokkos includes
+#include <Kokkos_Core.hpp>
+
+#include "eos_multi_material.hpp"
+#include "simulation_config.hpp"
+
+/**
+ * @file material_table.hpp
+ * @brief Defines the MaterialTable class for device-resident material
+ * lookups.
+ *
+ * This file provides the `MaterialTable` class, which compiles the parts and
+ * the EOS of a `SimulationConfig` into flat device tables.
+ */
+
+/**
+ * @class MaterialTable
+ * @brief Flat device tables part_id -> eos_id -> EOS parameters.
+ *
+ * `PartEOS()` maps a part id to its EOS id and `Table()` (the table of
+ * `EOSMultiMaterial`) maps an EOS id to its packed `EOSParams` block. Both
+ * are plain arrays built once at startup, so kernels resolve the material
+ * of a particle with two loads:
+ *
+ *     const EOSParams& params = table(part_eos(part_id(i)));
+ *
+ * and never touch the YAML nodes or the host-side `EOSVariant` objects.
+ */
+class MaterialTable {
+   public:
+    /**
+     * @brief Builds the tables of a configuration.
+     *
+     * @param config Validated configuration.
+     * @throws std::invalid_argument If a part uses an undefined EOS id.
+     */
+    explicit MaterialTable(const SimulationConfig& config)
+        : MaterialTable(config.EOS(), config.Parts()) {}
+
+    /**
+     * @brief Builds the tables of EOS objects and parts.
+     *
+     * @param eos_vector EOS objects.
+     * @param parts Parts (unique, non-negative part ids).
+     * @throws std::invalid_argument If a part uses an undefined EOS id.
+     */
+    MaterialTable(const std::vector<EOSVariant>& eos_vector,
+                  const std::vector<PartConfig>& parts)
+        : m_eos(eos_vector) {
+        int max_part = -1;
+        for (const auto& part : parts) {
+            max_part = std::max(max_part, part.part_id);
+        }
+        m_part_eos = Kokkos::View<int*>("part_eos", max_part + 1);
+        auto host_part_eos = Kokkos::create_mirror_view(m_part_eos);
+        Kokkos::deep_copy(host_part_eos, -1);
+        const auto host_table = Kokkos::create_mirror_view_and_copy(
+            Kokkos::HostSpace(), m_eos.Table());
+        for (const auto& part : parts) {
+            if (part.eos_id < 0 || part.eos_id >= m_eos.TableSize() ||
+                host_table(part.eos_id).type == EOSType::Undefined) {
+                throw std::invalid_argument(
+                    "MaterialTable: part_id " + std::to_string(part.part_id) +
+                    " uses undefined eos_id " + std::to_string(part.eos_id));
+            }
+            host_part_eos(part.part_id) = part.eos_id;
+        }
+        Kokkos::deep_copy(m_part_eos, host_part_eos);
+    }
+
+    /**
+     * @brief Sets the EOS id of every particle from its part id.
+     *
+     * @param part_id Per-particle part id Kokkos view.
+     * @param eos_id Per-particle EOS id Kokkos view (output).
+     * @throws std::runtime_error If a particle has an undefined part id.
+     */
+    template <class PartView, class EOSView>
+    void AssignEOSIds(const PartView& part_id, const EOSView& eos_id) const {
+        const auto part_eos = m_part_eos;
+        const int n_parts   = NumParts();
+        int n_undefined     = 0;
+        Kokkos::parallel_reduce(
+            "MaterialTable::AssignEOSIds", part_id.extent(0),
+            KOKKOS_LAMBDA(const int i, int& undefined) {
+                const int part = part_id(i);
+                const int eos  = part >= 0 && part < n_parts ? part_eos(part)
+                                                             : -1;
+                // Undefined parts keep a valid id and are reported
+                eos_id(i) = Kokkos::max(eos, 0);
+                undefined += eos < 0;
+            },
+            n_undefined);
+        if (n_undefined > 0) {
+            throw std::runtime_error(
+                "MaterialTable: " + std::to_string(n_undefined) +
+                " particles have an undefined part_id");
+        }
+    }
+
+    /**
+     * @brief Sets the EOS id of every particle of a container.
+     *
+     * @param particles Particle container providing `PartId` and `EOSId`.
+     * @throws std::runtime_error If a particle has an undefined part id.
+     */
+    template <class Particles>
+    void AssignEOSIds(const Particles& particles) const {
+        AssignEOSIds(particles.PartId(), particles.EOSId());
+    }
+
+    /**
+     * @brief Returns the part id to EOS id table.
+     *
+     * @return Device view indexed by part id (-1 for unused ids).
+     */
+    Kokkos::View<const int*> PartEOS() const { return m_part_eos; }
+
+    /**
+     * @brief Returns the EOS id to parameter block table.
+     *
+     * @return Device view indexed by EOS id.
+     */
+    Kokkos::View<const EOSParams*> Table() const { return m_eos.Table(); }
+
+    /**
+     * @brief Returns the multi-material EOS evaluating the table.
+     *
+     * @return Multi-material EOS.
+     */
+    const EOSMultiMaterial& EOS() const { return m_eos; }
+
+    /**
+     * @brief Returns the number of slots of the part table (largest id + 1).
+     *
+     * @return Size of the part table.
+     */
+    int NumParts() const { return static_cast<int>(m_part_eos.extent(0)); }
+
+   private:
+    /**
+     * @brief Multi-material EOS (EOS id to parameter block table).
+     */
+    EOSMultiMaterial m_eos;
+    /**
+     * @brief Part id to EOS id table.
+     */
+    Kokkos::View<int*> m_part_eos;
+};
@@ -0,0 +1,605 @@
+#pragma once
+
+#include <cstddef>
+#include <set>
+#include <stdexcept>
+#include <string>
+#include <variant>
+#include <vector>
+
+// yaml-cpp includes
+#include <yaml-cpp/yaml.h>
+
+#include "eos_multi_material.hpp"
+#include "sph_solver.hpp"
+
+/**
+ * @file simulation_config.hpp
+ * @brief Defines the SimulationConfig class for the YAML input file.
+ *
+ * This file provides the `SimulationConfig` class, which parses and
+ * validates every section of the input file once at startup. The solver
+ * then only sees plain values and EOS objects; the EOS and the parts are
+ * compiled into device tables by `MaterialTable`.
+ */
+
+/**
+ * @struct PartConfig
+ * @brief Entry of the `part` section.
+ */
+struct PartConfig {
+    /**
+     * @brief Part type (e.g. `SPHPart`).
+     */
+    std::string type;
+    /**
+     * @brief Part id (the `partId` field of the mesh).
+     */
+    int part_id = 0;
+    /**
+     * @brief EOS id of the part.
+     */
+    int eos_id = 0;
+};
+
+/**
+ * @struct SolverConfig
+ * @brief Content of the `solver` section.
+ */
+struct SolverConfig {
+    /**
+     * @brief Solver type.
+     */
+    std::string type = "SPHEuler";
+    /**
+     * @brief Density scheme.
+     */
+    std::string scheme;
+    /**
+     * @brief Pair loop of the forces (`CellTeams`, `FullList`,
+     * `HalfScatter` or `HalfColoring`).
+     */
+    PairLoop pair_loop = PairLoop::CellTeams;
+    /**
+     * @brief Threads per team of the pair kernels (0 for automatic).
+     */
+    int team_size = 0;
+    /**
+     * @brief Vector length of the pair kernels (0 for automatic).
+     */
+    int vector_length = 0;
+    /**
+     * @brief Relative change of `rho` or `eint` re-evaluating the EOS of a
+     * particle (`EOSCoupling::Lazy`; 0 evaluates every particle).
+     */
+    double eos_tolerance = 0.0;
+
+    /**
+     * @brief Returns the launch parameters of the pair kernels.
+     *
+     * @return `team_size` and `vector_length` (automatic tile).
+     */
+    TeamTuning Tuning() const { return {team_size, vector_length, 0}; }
+};
+
+/**
+ * @struct TimeIntegrationConfig
+ * @brief Content of the `time_integration` section.
+ */
+struct TimeIntegrationConfig {
+    /**
+     * @brief Courant number.
+     */
+    double cfl = 0.5;
+    /**
+     * @brief End time of the simulation.
+     */
+    double end_time = 0.0;
+};
+
+/**
+ * @struct LoadBalanceConfig
+ * @brief Content of the `load_balance` section.
+ */
+struct LoadBalanceConfig {
+    /**
+     * @brief Largest tolerated max/mean cost ratio.
+     */
+    double threshold = 1.2;
+    /**
+     * @brief Number of steps between two balance checks.
+     */
+    int cadence = 10;
+};
+
+/**
+ * @struct ProfilingConfig
+ * @brief Content of the `profiling` section.
+ */
+struct ProfilingConfig {
+    /**
+     * @brief Whether profiling regions fence the device.
+     */
+    bool fence = false;
+    /**
+     * @brief Path of the JSON timing report (empty for none).
+     */
+    std::string json;
+};
+
+/**
+ * @struct DiagnosticsConfig
+ * @brief Content of the `diagnostics` section.
+ */
+struct DiagnosticsConfig {
+    /**
+     * @struct Group
+     * @brief Entry of the `groups` list.
+     */
+    struct Group {
+        /**
+         * @brief Column prefix of the group.
+         */
+        std::string name;
+        /**
+         * @brief Part ids of the group (empty for every part).
+         */
+        std::vector<int> parts;
+    };
+
+    /**
+     * @brief Path of the time series (empty for none).
+     */
+    std::string file;
+    /**
+     * @brief Number of steps between two samples.
+     */
+    int cadence = 1;
+    /**
+     * @brief Sampled quantities (empty for all of them).
+     */
+    std::vector<std::string> quantities;
+    /**
+     * @brief Reduced groups (empty for every part at once).
+     */
+    std::vector<Group> groups;
+    /**
+     * @brief Pressure threshold of the shock position.
+     */
+    double shock_pressure = 0.0;
+    /**
+     * @brief Coordinate of the shock position (0, 1 or 2).
+     */
+    int shock_axis = 0;
+};
+
+/**
+ * @class SimulationConfig
+ * @brief Parsed and validated input file.
+ *
+ * The `eos` section is a list of groups; each group holds parallel arrays
+ * with one entry per EOS:
+ *
+ *     eos:
+ *       - type: ["EOSIdealGas", "EOSIdealGas"]
+ *         eos_id: [0, 1]
+ *         gamma: [1.4, 1.4]
+ *         pcutoff: [1e-6, 1e-6]
+ *       - type: ["EOSStiffenedGas"]
+ *         eos_id: [2]
+ *         gamma: [4.4]
+ *         pcutoff: [1e-6]
+ *         pinf: [6e8]
+ *
+ * `EOSIdealGas` and `EOSLinearGas` both map to `EOSLinearGas`. The `solver`
+ * and `time_integration` sections are lists of single-key maps; the
+ * `pair_loop`, `team_size` and `vector_length` keys of `solver` select and
+ * tune the pair kernels (`PairLoop`, `TeamTuning`), and a positive
+ * `eos_tolerance` selects the incremental EOS (`EOSLazy`). The
+ * `diagnostics` section configures the in-situ reductions (`Diagnostics`):
+ *
+ *     diagnostics:
+ *       file: "diagnostics.dat"
+ *       cadence: 10
+ *       quantities: ["mass", "total_energy", "shock_position"]
+ *       groups: [{name: "water", parts: [2]}]
+ *       shock_pressure: 0.5
+ *
+ * Every section is optional; missing values keep their defaults.
+ */
+class SimulationConfig {
+   public:
+    /**
+     * @brief Parses an input file.
+     *
+     * @param filename Path of the YAML file.
+     * @return Validated configuration.
+     * @throws std::invalid_argument If the file cannot be parsed or is
+     * invalid.
+     */
+    static SimulationConfig FromFile(const std::string& filename) {
+        try {
+            return SimulationConfig(YAML::LoadFile(filename));
+        } catch (const YAML::Exception& e) {
+            throw std::invalid_argument("SimulationConfig: " + filename +
+                                        ": " + e.what());
+        }
+    }
+
+    /**
+     * @brief Parses the contents of an input file.
+     *
+     * Lets one rank read the file and broadcast it (`CollectiveRead`)
+     * instead of every rank opening it.
+     *
+     * @param text YAML document.
+     * @param filename Path of the file (only used in messages).
+     * @return Validated configuration.
+     * @throws std::invalid_argument If the document cannot be parsed or is
+     * invalid.
+     */
+    static SimulationConfig FromString(const std::string& text,
+                                       const std::string& filename) {
+        try {
+            return SimulationConfig(YAML::Load(text));
+        } catch (const YAML::Exception& e) {
+            throw std::invalid_argument("SimulationConfig: " + filename +
+                                        ": " + e.what());
+        }
+    }
+
+    /**
+     * @brief Parses and validates a YAML document.
+     *
+     * @param root Root node of the input file.
+     * @throws std::invalid_argument If a section is invalid.
+     */
+    explicit SimulationConfig(const YAML::Node& root) {
+        try {
+            Parse(root);
+        } catch (const YAML::Exception& e) {
+            throw std::invalid_argument(std::string("SimulationConfig: ") +
+                                        e.what());
+        }
+        Validate();
+    }
+
+    /**
+     * @brief Returns the mesh prefix (`mesh` section).
+     *
+     * @return Mesh prefix, relative to the input file (empty if none).
+     */
+    const std::string& Mesh() const { return m_mesh; }
+
+    /**
+     * @brief Returns the EOS objects (`eos` section).
+     *
+     * @return EOS objects in input order.
+     */
+    const std::vector<EOSVariant>& EOS() const { return m_eos; }
+
+    /**
+     * @brief Returns the parts (`part` section).
+     *
+     * @return Parts in input order.
+     */
+    const std::vector<PartConfig>& Parts() const { return m_parts; }
+
+    /**
+     * @brief Returns the solver settings (`solver` section).
+     *
+     * @return Solver settings.
+     */
+    const SolverConfig& Solver() const { return m_solver; }
+
+    /**
+     * @brief Returns the time integration settings (`time_integration`
+     * section).
+     *
+     * @return Time integration settings.
+     */
+    const TimeIntegrationConfig& TimeIntegration() const {
+        return m_time_integration;
+    }
+
+    /**
+     * @brief Returns the load balancing settings (`load_balance` section).
+     *
+     * @return Load balancing settings.
+     */
+    const LoadBalanceConfig& LoadBalance() const { return m_load_balance; }
+
+    /**
+     * @brief Returns the ghost exchange radius (`halo_radius`).
+     *
+     * @return Interaction radius (0 without ghost exchange).
+     */
+    double HaloRadius() const { return m_halo_radius; }
+
+    /**
+     * @brief Returns the profiling settings (`profiling` section).
+     *
+     * @return Profiling settings.
+     */
+    const ProfilingConfig& Profiling() const { return m_profiling; }
+
+    /**
+     * @brief Returns the in-situ diagnostics settings (`diagnostics`
+     * section).
+     *
+     * @return Diagnostics settings.
+     */
+    const DiagnosticsConfig& Diagnostics() const { return m_diagnostics; }
+
+   private:
+    /**
+     * @brief Reads every section.
+     *
+     * @param root Root node of the input file.
+     * @throws std::invalid_argument On unknown EOS types or pair loops, or
+     * mismatched EOS arrays.
+     */
+    void Parse(const YAML::Node& root) {
+        if (root["mesh"]) m_mesh = root["mesh"].as<std::string>();
+        for (const auto& group : root["eos"]) ParseEOSGroup(group);
+        for (const auto& entry : root["part"]) {
+            PartConfig part;
+            if (entry["type"]) part.type = entry["type"].as<std::string>();
+            part.part_id = entry["part_id"].as<int>();
+            part.eos_id  = entry["eos_id"].as<int>();
+            m_parts.push_back(part);
+        }
+        for (const auto& entry : root["solver"]) {
+            if (entry["type"]) m_solver.type = entry["type"].as<std::string>();
+            if (entry["scheme"]) {
+                m_solver.scheme = entry["scheme"].as<std::string>();
+            }
+            if (entry["pair_loop"]) {
+                m_solver.pair_loop =
+                    ParsePairLoop(entry["pair_loop"].as<std::string>());
+            }
+            if (entry["team_size"]) {
+                m_solver.team_size = entry["team_size"].as<int>();
+            }
+            if (entry["vector_length"]) {
+                m_solver.vector_length = entry["vector_length"].as<int>();
+            }
+            if (entry["eos_tolerance"]) {
+                m_solver.eos_tolerance = entry["eos_tolerance"].as<double>();
+            }
+        }
+        for (const auto& entry : root["time_integration"]) {
+            if (entry["cfl"]) {
+                m_time_integration.cfl = entry["cfl"].as<double>();
+            }
+            if (entry["end_time"]) {
+                m_time_integration.end_time = entry["end_time"].as<double>();
+            }
+        }
+        if (const YAML::Node lb = root["load_balance"]) {
+            if (lb["threshold"]) {
+                m_load_balance.threshold = lb["threshold"].as<double>();
+            }
+            if (lb["cadence"]) m_load_balance.cadence = lb["cadence"].as<int>();
+        }
+        if (root["halo_radius"]) {
+            m_halo_radius = root["halo_radius"].as<double>();
+        }
+        if (const YAML::Node profiling = root["profiling"]) {
+            if (profiling["fence"]) {
+                m_profiling.fence = profiling["fence"].as<bool>();
+            }
+            if (profiling["json"]) {
+                m_profiling.json = profiling["json"].as<std::string>();
+            }
+        }
+        if (const YAML::Node diag = root["diagnostics"]) {
+            DiagnosticsConfig& d = m_diagnostics;
+            if (diag["file"]) d.file = diag["file"].as<std::string>();
+            if (diag["cadence"]) d.cadence = diag["cadence"].as<int>();
+            if (diag["quantities"]) {
+                d.quantities =
+                    diag["quantities"].as<std::vector<std::string>>();
+            }
+            for (const auto& entry : diag["groups"]) {
+                DiagnosticsConfig::Group group;
+                group.name = entry["name"].as<std::string>();
+                if (entry["parts"]) {
+                    group.parts = entry["parts"].as<std::vector<int>>();
+                }
+                d.groups.push_back(group);
+            }
+            if (diag["shock_pressure"]) {
+                d.shock_pressure = diag["shock_pressure"].as<double>();
+            }
+            if (diag["shock_axis"]) {
+                d.shock_axis = diag["shock_axis"].as<int>();
+            }
+        }
+    }
+
+    /**
+     * @brief Reads one group of the `eos` section.
+     *
+     * @param group Group node (parallel arrays).
+     * @throws std::invalid_argument On unknown EOS types or mismatched array
+     * sizes.
+     */
+    void ParseEOSGroup(const YAML::Node& group) {
+        const auto types = group["type"].as<std::vector<std::string>>();
+        const auto ids   = group["eos_id"].as<std::vector<int>>();
+        const auto gamma = Array(group, "gamma", types.size(), 0.0);
+        const auto pcut  = Array(group, "pcutoff", types.size(), 0.0);
+        const auto pinf  = Array(group, "pinf", types.size(), 0.0);
+        if (ids.size() != types.size()) {
+            throw std::invalid_argument(
+                "SimulationConfig: eos 'eos_id' must have one entry per "
+                "type");
+        }
+        for (std::size_t k = 0; k < types.size(); ++k) {
+            if (types[k] == "EOSIdealGas" || types[k] == "EOSLinearGas") {
+                m_eos.emplace_back(EOSLinearGas(ids[k], gamma[k], pcut[k]));
+            } else if (types[k] == "EOSStiffenedGas") {
+                m_eos.emplace_back(
+                    EOSStiffenedGas(ids[k], gamma[k], pcut[k], pinf[k]));
+            } else {
+                throw std::invalid_argument(
+                    "SimulationConfig: unknown EOS type '" + types[k] + "'");
+            }
+        }
+    }
+
+    /**
+     * @brief Maps the `pair_loop` key of the `solver` section to the solver
+     * enum.
+     *
+     * @param name Pair loop name.
+     * @return Pair loop.
+     * @throws std::invalid_argument On an unknown name.
+     */
+    static PairLoop ParsePairLoop(const std::string& name) {
+        if (name == "CellTeams") return PairLoop::CellTeams;
+        if (name == "FullList") return PairLoop::FullList;
+        if (name == "HalfScatter") return PairLoop::HalfScatter;
+        if (name == "HalfColoring") return PairLoop::HalfColoring;
+        throw std::invalid_argument("SimulationConfig: unknown pair_loop '" +
+                                    name + "'");
+    }
+
+    /**
+     * @brief Reads an optional array of an EOS group.
+     *
+     * @param group Group node.
+     * @param key Array name.
+     * @param n Expected number of entries.
+     * @param fallback Value of the entries when the array is absent.
+     * @return Array values.
+     * @throws std::invalid_argument If the array has the wrong size.
+     */
+    static std::vector<double> Array(const YAML::Node& group,
+                                     const std::string& key,
+                                     const std::size_t n,
+                                     const double fallback) {
+        if (!group[key]) return std::vector<double>(n, fallback);
+        auto values = group[key].as<std::vector<double>>();
+        if (values.size() != n) {
+            throw std::invalid_argument("SimulationConfig: eos '" + key +
+                                        "' must have one entry per type");
+        }
+        return values;
+    }
+
+    /**
+     * @brief Checks the consistency of the parsed values.
+     *
+     * @throws std::invalid_argument On invalid EOS or part ids, non-physical
+     * EOS parameters or invalid solver settings.
+     */
+    void Validate() const {
+        std::set<int> eos_ids;
+        for (const auto& eos : m_eos) {
+            const EOSParams params =
+                std::visit([](const auto& obj) { return obj.Params(); }, eos);
+            const int id =
+                std::visit([](const auto& obj) { return obj.Id(); }, eos);
+            if (id < 0 || !eos_ids.insert(id).second) {
+                throw std::invalid_argument(
+                    "SimulationConfig: invalid or duplicated eos_id " +
+                    std::to_string(id));
+            }
+            if (params.gamma <= 1.0 || params.pcutoff < 0.0 ||
+                params.pinf < 0.0) {
+                throw std::invalid_argument(
+                    "SimulationConfig: eos_id " + std::to_string(id) +
+                    " needs gamma > 1, pcutoff >= 0 and pinf >= 0");
+            }
+        }
+        std::set<int> part_ids;
+        for (const auto& part : m_parts) {
+            if (part.part_id < 0 || !part_ids.insert(part.part_id).second) {
+                throw std::invalid_argument(
+                    "SimulationConfig: invalid or duplicated part_id " +
+                    std::to_string(part.part_id));
+            }
+            if (eos_ids.count(part.eos_id) == 0) {
+                throw std::invalid_argument(
+                    "SimulationConfig: part_id " +
+                    std::to_string(part.part_id) + " uses undefined eos_id " +
+                    std::to_string(part.eos_id));
+            }
+        }
+        if (m_solver.type != "SPHEuler") {
+            throw std::invalid_argument("SimulationConfig: unknown solver '" +
+                                        m_solver.type + "'");
+        }
+        const int vector = m_solver.vector_length;
+        if (m_solver.team_size < 0 || vector < 0 ||
+            (vector & (vector - 1)) != 0) {
+            throw std::invalid_argument(
+                "SimulationConfig: solver needs team_size >= 0 and a "
+                "power-of-two vector_length (0 for automatic)");
+        }
+        if (!(m_solver.eos_tolerance >= 0.0)) {
+            throw std::invalid_argument(
+                "SimulationConfig: eos_tolerance must not be negative");
+        }
+        if (m_time_integration.cfl <= 0.0 ||
+            m_time_integration.end_time < 0.0) {
+            throw std::invalid_argument(
+                "SimulationConfig: time_integration needs cfl > 0 and "
+                "end_time >= 0");
+        }
+        if (m_load_balance.threshold < 1.0 || m_load_balance.cadence < 1) {
+            throw std::invalid_argument(
+                "SimulationConfig: load_balance needs threshold >= 1 and "
+                "cadence >= 1");
+        }
+        if (m_halo_radius < 0.0) {
+            throw std::invalid_argument(
+                "SimulationConfig: halo_radius must not be negative");
+        }
+        if (m_diagnostics.cadence < 1 || m_diagnostics.shock_axis < 0 ||
+            m_diagnostics.shock_axis > 2) {
+            throw std::invalid_argument(
+                "SimulationConfig: diagnostics needs cadence >= 1 and "
+                "shock_axis in [0, 2]");
+        }
+    }
+
+    /**
+     * @brief Mesh prefix.
+     */
+    std::string m_mesh;
+    /**
+     * @brief EOS objects.
+     */
+    std::vector<EOSVariant> m_eos;
+    /**
+     * @brief Parts.
+     */
+    std::vector<PartConfig> m_parts;
+    /**
+     * @brief Solver settings.
+     */
+    SolverConfig m_solver;
+    /**
+     * @brief Time integration settings.
+     */
+    TimeIntegrationConfig m_time_integration;
+    /**
+     * @brief Load balancing settings.
+     */
+    LoadBalanceConfig m_load_balance;
+    /**
+     * @brief Ghost exchange radius (0 without ghost exchange).
+     */
+    double m_halo_radius = 0.0;
+    /**
+     * @brief Profiling settings.
+     */
+    ProfilingConfig m_profiling;
+    /**
+     * @brief In-situ diagnostics settings.
+     */
+    DiagnosticsConfig m_diagnostics;
+};
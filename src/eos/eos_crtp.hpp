@@ -4,8 +4,13 @@
 #include <Kokkos_Core.hpp>
 
 #include <iostream>
+#include <string>
 #include <vector>
 
+#include "eos_params.hpp"
+#include "profiler.hpp"
+#include "simd_ops.hpp"
+
 /**
  * @file eos_crtp.hpp
  * @brief Defines the CRTP (Curiously Recurring Template Pattern) base class for
@@ -26,10 +31,28 @@
  * which computes pressure and speed of sound based on density, internal energy
  * and EOS-specific parameters.
  *
+ * On host execution spaces `PressureSoSKernel` evaluates the point function
+ * of the derived class on `Kokkos::Experimental::simd` packs of particles,
+ * unless the derived class sets `vectorized` to false.
+ *
+ * @tparam Derived EOS implementation.
+ * @tparam Scalar Floating-point type of the views and of the arithmetic of
+ * `PressureSoSImpl` (`double` or `float`).
  */
-template <typename Derived>
+template <typename Derived, typename Scalar = double>
 class EOSCRTP {
    public:
+    /**
+     * @brief Floating-point type of the EOS.
+     */
+    using scalar_type = Scalar;
+
+    /**
+     * @brief Whether `PressureSoSKernel` may use SIMD packs (hidden by
+     * derived classes whose point function does not support them).
+     */
+    static constexpr bool vectorized = true;
+
     /**
      * @brief Returns a reference to the derived class.
      *
@@ -58,7 +81,81 @@ class EOSCRTP {
     void PressureSoS() const {
         // Call the derived class's implementation
         static_cast<const Derived*>(this)->PressureSoSImpl(
-            Kokkos::View<double*>(), Kokkos::View<double*>(),
-            Kokkos::View<double*>(), Kokkos::View<double*>());
+            Kokkos::View<Scalar*>(), Kokkos::View<Scalar*>(),
+            Kokkos::View<Scalar*>(), Kokkos::View<Scalar*>());
+    }
+    /**
+     * @brief Calls the derived class's point-wise implementation of
+     * PressureSoS.
+     *
+     * This function can be called from device code. It evaluates the EOS for
+     * a single particle using the parameters packed in `params`, which allows
+     * multi-material kernels to dispatch on `EOSParams::type` without virtual
+     * functions.
+     *
+     * @tparam T Floating-point type of the particle values.
+     * @param params Packed EOS parameters.
+     * @param rho Density.
+     * @param eint Internal energy.
+     * @param p Pressure (output).
+     * @param sos Speed of sound (output).
+     */
+    template <typename T>
+    KOKKOS_INLINE_FUNCTION static void PressureSoSPoint(const EOSParams& params,
+                                                        const T rho,
+                                                        const T eint, T& p,
+                                                        T& sos) {
+        Derived::PressureSoSPointImpl(params, rho, eint, p, sos);
+    }
+
+   protected:
+    /**
+     * @brief Runs the derived point function over contiguous views.
+     *
+     * Building block of the `PressureSoSImpl` of the derived classes. On
+     * host execution spaces the particles go by SIMD packs
+     * (`SIMDOps::ForEach`), the last partial pack particle by particle;
+     * otherwise there is one particle per thread.
+     *
+     * @param label Kernel label.
+     * @param params Packed EOS parameters.
+     * @param rho Density Kokkos (sub)view.
+     * @param eint Internal energy Kokkos (sub)view.
+     * @param p Pressure Kokkos (sub)view (output).
+     * @param sos Speed of sound Kokkos (sub)view (output).
+     * @param exec Execution space instance; the call does not fence it.
+     */
+    static void PressureSoSKernel(const std::string& label,
+                                  const EOSParams& params,
+                                  Kokkos::View<Scalar*> rho,
+                                  Kokkos::View<Scalar*> eint,
+                                  Kokkos::View<Scalar*> p,
+                                  Kokkos::View<Scalar*> sos,
+                                  const Kokkos::DefaultExecutionSpace& exec) {
+        const auto N = rho.extent(0);
+        if constexpr (SIMDOps::enabled && Derived::vectorized) {
+            using Pack = SIMDOps::Pack<Scalar>;
+            SIMDOps::ForEach<Scalar>(
+                label, exec, N,
+                [=](const std::size_t i) {
+                    Pack p_i, sos_i;
+                    Derived::PressureSoSPointImpl(
+                        params, SIMDOps::Load(&rho(i)),
+                        SIMDOps::Load(&eint(i)), p_i, sos_i);
+                    SIMDOps::Store(p_i, &p(i));
+                    SIMDOps::Store(sos_i, &sos(i));
+                },
+                [=](const std::size_t i) {
+                    Derived::PressureSoSPointImpl(params, rho(i), eint(i),
+                                                  p(i), sos(i));
+                });
+        } else {
+            Kokkos::parallel_for(
+                label, Kokkos::RangePolicy<>(exec, 0, N),
+                KOKKOS_LAMBDA(const int i) {
+                    Derived::PressureSoSPointImpl(params, rho(i), eint(i),
+                                                  p(i), sos(i));
+                });
+        }
     }
 };
\ No newline at end of file
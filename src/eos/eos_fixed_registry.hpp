@@ -0,0 +1,111 @@
+#pragma once
+
+#include <initializer_list>
+
+#include "eos_params.hpp"
+#include "eos_stiffened_gas_fixed.hpp"
+
+/**
+ * @file eos_fixed_registry.hpp
+ * @brief Defines the registry of pre-instantiated compile-time EOS
+ * specializations.
+ *
+ * This file provides the `EOSFixedRegistry` class template, which maps
+ * runtime EOS parameters (e.g. read from the YAML input) onto compile-time
+ * specializations, and `EOSFixedMaterials`, the list of common materials
+ * shipped with SPHiros.
+ */
+
+/**
+ * @class EOSFixedRegistry
+ * @brief Registry of compile-time EOS specializations.
+ *
+ * `Specialize` is called once per material at startup: when the parameters
+ * of a runtime EOS match a registered specialization exactly, the packed
+ * block is retagged `EOSType::Fixed` with the index of that specialization,
+ * otherwise it is returned unchanged (fallback to the runtime parameters).
+ * `PressureSoSPoint` then dispatches on the index inside the kernel.
+ *
+ * @tparam Specs `EOSStiffenedGasFixed` specializations.
+ */
+template <class... Specs>
+class EOSFixedRegistry {
+   public:
+    /**
+     * @brief Number of registered specializations.
+     */
+    static constexpr int size = sizeof...(Specs);
+
+    /**
+     * @brief Returns the index of the specialization matching a parameter
+     * block.
+     *
+     * Linear gases match the specializations without infinite pressure.
+     *
+     * @param params Packed EOS parameters of a runtime EOS.
+     * @return Index in the registry, or -1 if none matches.
+     */
+    static int Find(const EOSParams& params) {
+        if (params.type != EOSType::LinearGas &&
+            params.type != EOSType::StiffenedGas) {
+            return -1;
+        }
+        const double pinf =
+            params.type == EOSType::LinearGas ? 0.0 : params.pinf;
+        int index = 0;
+        for (const bool match : std::initializer_list<bool>{
+                 (Specs::gamma == params.gamma && Specs::pinf == pinf)...}) {
+            if (match) return index;
+            ++index;
+        }
+        return -1;
+    }
+
+    /**
+     * @brief Retags a parameter block with its compile-time specialization.
+     *
+     * @param params Packed EOS parameters of a runtime EOS.
+     * @return Parameters tagged `EOSType::Fixed`, or `params` unchanged if no
+     * specialization matches.
+     */
+    static EOSParams Specialize(EOSParams params) {
+        const int index = Find(params);
+        if (index >= 0) {
+            params.type  = EOSType::Fixed;
+            params.fixed = index;
+        }
+        return params;
+    }
+
+    /**
+     * @brief Computes pressure and speed of sound with the specialization
+     * selected by `params.fixed`.
+     *
+     * @tparam T Floating-point type of the particle values.
+     * @param params Packed EOS parameters.
+     * @param rho Density.
+     * @param eint Internal energy.
+     * @param p Pressure (output).
+     * @param sos Speed of sound (output).
+     */
+    template <typename T>
+    KOKKOS_INLINE_FUNCTION static void PressureSoSPoint(const EOSParams& params,
+                                                        const T rho,
+                                                        const T eint, T& p,
+                                                        T& sos) {
+        int k = 0;
+        ((k++ == params.fixed
+              ? Specs::PressureSoSPoint(params, rho, eint, p, sos)
+              : void()),
+         ...);
+    }
+};
+
+/**
+ * @brief Common materials evaluated with compile-time parameters: diatomic
+ * ideal gas (air), monatomic ideal gas and water (stiffened gas).
+ */
+using EOSFixedMaterials =
+    EOSFixedRegistry<EOSStiffenedGasFixed<1.4>,
+                     EOSStiffenedGasFixed<5.0 / 3.0>,
+                     EOSStiffenedGasFixed<4.4, 6e8>>;
@@ -0,0 +1,210 @@
+#pragma once
+
+#include <cstddef>
+#include <limits>
+#include <stdexcept>
+
+#include "eos_multi_material.hpp"
+
+/**
+ * @file eos_lazy.hpp
+ * @brief Defines the EOSLazy class for incremental EOS re-evaluation.
+ *
+ * This file provides the `EOSLazy` class, which wraps an `EOSMultiMaterial`
+ * and only recomputes pressure and speed of sound for the particles whose
+ * density or internal energy changed since their last evaluation.
+ */
+
+/**
+ * @class EOSLazy
+ * @brief Multi-material EOS re-evaluated on state change.
+ *
+ * Every call compares `rho` and `eint` with the state of the last
+ * evaluation of each particle. The particles off by more than the relative
+ * tolerance on either value are compacted with a `parallel_scan`, and only
+ * they are evaluated, so the EOS work scales with the active particles
+ * (e.g. none in a quiescent far field). The other particles keep their
+ * pressure and speed of sound, at most `tolerance` away in state from the
+ * one they were computed for.
+ *
+ * The reference states are particle fields (`ParticleData::RhoEOS` and
+ * `EintEOS`), not a cache indexed by row: they move with the pressure and
+ * speed of sound through every reordering, migration and halo exchange, so
+ * no caller has to keep them in sync. A zero or NaN reference density
+ * marks a particle never evaluated (`ParticleData::Resize` sets it on the
+ * appended rows, so a row reused after `Compact` does not inherit the
+ * reference of a removed particle). A change of material must be followed
+ * by `Invalidate`.
+ */
+class EOSLazy {
+   public:
+    /**
+     * @brief Constructor for EOSLazy.
+     *
+     * @param eos Multi-material EOS.
+     * @param tolerance Relative change of `rho` or `eint` triggering a
+     * re-evaluation (0 re-evaluates every changed particle).
+     * @throws std::invalid_argument If `tolerance` is negative.
+     */
+    explicit EOSLazy(const EOSMultiMaterial& eos,
+                     const double tolerance = 1e-6)
+        : m_eos(eos) {
+        SetTolerance(tolerance);
+    }
+
+    /**
+     * @brief Computes pressure and speed of sound of the changed particles.
+     *
+     * @param eos_id Per-particle EOS id Kokkos view.
+     * @param rho Density Kokkos view.
+     * @param eint Internal energy Kokkos view.
+     * @param rho_eos Density of the last evaluation Kokkos view (updated).
+     * @param eint_eos Internal energy of the last evaluation Kokkos view
+     * (updated).
+     * @param p Pressure Kokkos view (output).
+     * @param sos Speed of sound Kokkos view (output).
+     * @param first First row considered (the rows before are ignored).
+     * @param exec Execution space instance running the kernels; the active
+     * count fences it.
+     * @return Number of evaluated particles.
+     */
+    template <class IdView, class StateView, class RefView,
+              class DerivedView>
+    std::size_t PressureSoS(const IdView& eos_id, const StateView& rho,
+                            const StateView& eint, const RefView& rho_eos,
+                            const RefView& eint_eos, const DerivedView& p,
+                            const DerivedView& sos,
+                            const std::size_t first = 0,
+                            const Kokkos::DefaultExecutionSpace& exec = {}) {
+        using T      = typename DerivedView::non_const_value_type;
+        const auto N = rho.extent(0);
+        ProfilingRegion region("EOS");
+        if (m_active.extent(0) < N) {
+            m_active = Kokkos::View<int*>(
+                Kokkos::view_alloc(Kokkos::WithoutInitializing,
+                                   "eos_lazy_active"),
+                N);
+        }
+
+        const auto active    = m_active;
+        const double tol     = m_tolerance;
+        std::size_t n_active = 0;
+        Kokkos::parallel_scan(
+            "EOSLazy::Select", Kokkos::RangePolicy<>(exec, first, N),
+            KOKKOS_LAMBDA(const int i, std::size_t& offset, const bool final) {
+                // Zero and NaN references (never evaluated) fail the tests
+                const bool same =
+                    rho_eos(i) > 0.0 &&
+                    Kokkos::abs(rho(i) - rho_eos(i)) <= tol * rho_eos(i) &&
+                    Kokkos::abs(eint(i) - eint_eos(i)) <=
+                        tol * Kokkos::abs(eint_eos(i));
+                if (same) return;
+                if (final) active(offset) = i;
+                ++offset;
+            },
+            n_active);
+
+        const auto table = m_eos.Table();
+        Kokkos::parallel_for(
+            "EOSLazy::PressureSoS", Kokkos::RangePolicy<>(exec, 0, n_active),
+            KOKKOS_LAMBDA(const int k) {
+                const int i = active(k);
+                T p_i       = p(i);
+                T sos_i     = sos(i);
+                EOSMultiMaterial::PressureSoSPoint(
+                    table, eos_id(i), static_cast<T>(rho(i)),
+                    static_cast<T>(eint(i)), p_i, sos_i);
+                p(i)        = p_i;
+                sos(i)      = sos_i;
+                rho_eos(i)  = rho(i);
+                eint_eos(i) = eint(i);
+            });
+        m_n_evaluated = n_active;
+        return n_active;
+    }
+
+    /**
+     * @brief Computes pressure and speed of sound of the changed particles
+     * of a particle container.
+     *
+     * @param particles Particle storage (e.g. `ParticleData`) providing
+     * `EOSId()`, `Rho()`, `Eint()`, `RhoEOS()`, `EintEOS()`, `P()` and
+     * `SoS()`.
+     * @param first First row considered.
+     * @return Number of evaluated particles.
+     */
+    template <class Particles>
+    std::size_t PressureSoS(const Particles& particles,
+                            const std::size_t first = 0) {
+        return PressureSoS(particles.EOSId(), particles.Rho(),
+                           particles.Eint(), particles.RhoEOS(),
+                           particles.EintEOS(), particles.P(),
+                           particles.SoS(), first);
+    }
+
+    /**
+     * @brief Forces the evaluation of every particle of a container at the
+     * next call.
+     *
+     * @param particles Particle storage providing `RhoEOS()`.
+     */
+    template <class Particles>
+    static void Invalidate(const Particles& particles) {
+        Kokkos::deep_copy(particles.RhoEOS(),
+                          std::numeric_limits<double>::quiet_NaN());
+    }
+
+    /**
+     * @brief Returns the relative tolerance.
+     *
+     * @return Relative change of `rho` or `eint` triggering a re-evaluation.
+     */
+    double Tolerance() const { return m_tolerance; }
+
+    /**
+     * @brief Sets the relative tolerance.
+     *
+     * @param tolerance Relative change of `rho` or `eint` triggering a
+     * re-evaluation.
+     * @throws std::invalid_argument If `tolerance` is negative.
+     */
+    void SetTolerance(const double tolerance) {
+        if (!(tolerance >= 0.0)) {
+            throw std::invalid_argument(
+                "EOSLazy: tolerance must be non-negative");
+        }
+        m_tolerance = tolerance;
+    }
+
+    /**
+     * @brief Returns the number of particles evaluated by the last call.
+     *
+     * @return Active particles of the last `PressureSoS`.
+     */
+    std::size_t NumEvaluated() const { return m_n_evaluated; }
+
+    /**
+     * @brief Returns the wrapped multi-material EOS.
+     *
+     * @return Multi-material EOS.
+     */
+    const EOSMultiMaterial& EOS() const { return m_eos; }
+
+   private:
+    /**
+     * @brief Multi-material EOS.
+     */
+    EOSMultiMaterial m_eos;
+    /**
+     * @brief Relative change triggering a re-evaluation.
+     */
+    double m_tolerance = 0.0;
+    /**
+     * @brief Compacted rows to evaluate (grown on demand).
+     */
+    Kokkos::View<int*> m_active;
+    /**
+     * @brief Number of particles evaluated by the last call.
+     */
+    std::size_t m_n_evaluated = 0;
+};
@@ -1,3 +1,5 @@
+#pragma once
+
 #include "eos_crtp.hpp"
 
 /**
@@ -16,8 +18,13 @@
  * The `EOSLinearGas` class computes pressure and speed of sound for a linear
  * gas model. It inherits from the `EOSCRTP` base class and provides the
  * implementation for the `PressureSoSImpl` method.
+ *
+ * @tparam Scalar Floating-point type of the views and parameters (deduced
+ * from the constructor arguments, e.g. `EOSLinearGas(0, 1.4f, 1e-6f)` is a
+ * single-precision EOS).
  */
-class EOSLinearGas : public EOSCRTP<EOSLinearGas> {
+template <typename Scalar = double>
+class EOSLinearGas : public EOSCRTP<EOSLinearGas<Scalar>, Scalar> {
    public:
     /**
      * @brief Constructor for EOSLinearGas.
@@ -30,7 +37,7 @@ class EOSLinearGas : public EOSCRTP<EOSLinearGas> {
      * @param pcutoff Minimum cutoff pressure to avoid negative or unphysical
      * values (e.g. cavitation).
      */
-    EOSLinearGas(int id, double gamma, double pcutoff)
+    EOSLinearGas(int id, Scalar gamma, Scalar pcutoff)
         : m_id(id), m_gamma(gamma), m_pcutoff(pcutoff) {}
 
     /**
@@ -44,17 +51,62 @@ class EOSLinearGas : public EOSCRTP<EOSLinearGas> {
      * @param eint Internal energy Kokkos (sub)view.
      * @param p Pressure Kokkos (sub)view (output).
      * @param sos Speed of sound Kokkos (sub)view (output).
+     * @param exec Execution space instance running the kernel (e.g. one per
+     * material group); the call does not fence it.
+     */
+    void PressureSoSImpl(
+        Kokkos::View<Scalar *> rho, Kokkos::View<Scalar *> eint,
+        Kokkos::View<Scalar *> p, Kokkos::View<Scalar *> sos,
+        const Kokkos::DefaultExecutionSpace &exec = {}) const {
+        ProfilingRegion region("EOS");
+        this->PressureSoSKernel(
+            "EOSLinearGas::PressureSoS(id=" + std::to_string(m_id) + ")",
+            Params(), rho, eint, p, sos, exec);
+    }
+
+    /**
+     * @brief Computes pressure and speed of sound for a single particle.
+     *
+     * Device-callable kernel body shared by `PressureSoSImpl` and the
+     * multi-material dispatch (`EOSMultiMaterial`).
+     *
+     * The arithmetic is carried out in the precision of the particle values.
+     *
+     * @tparam T Floating-point type of the particle values, or a SIMD pack
+     * of them.
+     * @param params Packed EOS parameters (`gamma`, `pcutoff`).
+     * @param rho Density.
+     * @param eint Internal energy.
+     * @param p Pressure (output).
+     * @param sos Speed of sound (output).
+     */
+    template <typename T>
+    KOKKOS_INLINE_FUNCTION static void PressureSoSPointImpl(
+        const EOSParams &params, const T rho, const T eint, T &p, T &sos) {
+        const T gamma = static_cast<T>(params.gamma);
+        p             = SIMDOps::Max((gamma - T(1)) * rho * eint,
+                                     static_cast<T>(params.pcutoff));
+        sos           = gamma * p / rho;
+    }
+
+    /**
+     * @brief Returns the EOS id.
+     *
+     * @return EOS id.
+     */
+    int Id() const { return m_id; }
+
+    /**
+     * @brief Exports the EOS parameters as a packed `EOSParams` block.
+     *
+     * @return Packed EOS parameters.
      */
-    void PressureSoSImpl(Kokkos::View<double *> rho,
-                         Kokkos::View<double *> eint, Kokkos::View<double *> p,
-                         Kokkos::View<double *> sos) const {
-        const auto N = rho.extent(0);
-        Kokkos::parallel_for(
-            "Initialize", N, KOKKOS_CLASS_LAMBDA(const int i) {
-                p(i) =
-                    Kokkos::max((m_gamma - 1.0) * rho(i) * eint(i), m_pcutoff);
-                sos(i) = m_gamma * p(i) / rho(i);
-            });
+    EOSParams Params() const {
+        EOSParams params;
+        params.type    = EOSType::LinearGas;
+        params.gamma   = m_gamma;
+        params.pcutoff = m_pcutoff;
+        return params;
     }
 
    private:
@@ -74,7 +126,7 @@ class EOSLinearGas : public EOSCRTP<EOSLinearGas> {
      * the thermodynamic properties of the gas. For example, for air, γ is
      * typically 1.4.
      */
-    double m_gamma;
+    Scalar m_gamma;
     /**
      * @brief Minimum cutoff pressure.
      *
@@ -82,5 +134,5 @@ class EOSLinearGas : public EOSCRTP<EOSLinearGas> {
      * avoid negative or unphysical results, such as cavitation. It ensures
      * numerical stability in the computations.
      */
-    double m_pcutoff;
+    Scalar m_pcutoff;
 };
@@ -0,0 +1,261 @@
+#pragma once
+
+#include <cstddef>
+#include <stdexcept>
+#include <string>
+#include <variant>
+#include <vector>
+
+#include "eos_fixed_registry.hpp"
+#include "eos_linear_gas.hpp"
+#include "eos_stiffened_gas.hpp"
+
+/**
+ * @file eos_multi_material.hpp
+ * @brief Defines the EOSMultiMaterial class for fused multi-material EOS
+ * evaluation.
+ *
+ * This file provides the `EOSMultiMaterial` class, which gathers the
+ * parameters of heterogeneous EOS objects into a packed device table and
+ * evaluates pressure and speed of sound for all particles in a single kernel,
+ * whatever their material.
+ */
+
+/**
+ * @brief Host-side container type for heterogeneous EOS objects.
+ */
+using EOSVariant = std::variant<EOSLinearGas<>, EOSStiffenedGas<>>;
+
+/**
+ * @class EOSMultiMaterial
+ * @brief Device-side multi-material EOS engine.
+ *
+ * The `EOSMultiMaterial` class stores one `EOSParams` block per EOS id in a
+ * device view. `PressureSoS` launches a single `parallel_for` over all
+ * particles, looks up the parameter block of each particle through its
+ * `eos_id` and dispatches on `EOSParams::type` to the static
+ * `PressureSoSPoint` of the matching `EOSCRTP` implementation. This replaces
+ * one kernel launch (and one full sweep over `rho`/`eint`) per EOS object.
+ */
+class EOSMultiMaterial {
+   public:
+    /**
+     * @brief Constructor for EOSMultiMaterial.
+     *
+     * Packs the parameters of all EOS objects into a device table indexed by
+     * EOS id. Ids do not need to be contiguous; unused slots are tagged
+     * `EOSType::Undefined`. Materials whose parameters match a compile-time
+     * specialization of `EOSFixedMaterials` are evaluated with it.
+     *
+     * @param eos_vector EOS objects to register.
+     * @param specialize Use the compile-time specializations (otherwise
+     * always evaluate with the runtime parameters).
+     * @throws std::invalid_argument If an EOS id is negative or duplicated.
+     */
+    explicit EOSMultiMaterial(const std::vector<EOSVariant>& eos_vector,
+                              const bool specialize = true) {
+        int max_id = -1;
+        for (const auto& eos : eos_vector) {
+            const int id = std::visit([](const auto& obj) { return obj.Id(); },
+                                      eos);
+            if (id < 0) {
+                throw std::invalid_argument(
+                    "EOSMultiMaterial: negative EOS id " + std::to_string(id));
+            }
+            max_id = Kokkos::max(max_id, id);
+        }
+
+        m_table         = Kokkos::View<EOSParams*>("eos_table", max_id + 1);
+        auto host_table = Kokkos::create_mirror_view(m_table);
+        for (int id = 0; id <= max_id; ++id) {
+            host_table(id) = EOSParams();
+        }
+        for (const auto& eos : eos_vector) {
+            std::visit(
+                [&](const auto& obj) {
+                    if (host_table(obj.Id()).type != EOSType::Undefined) {
+                        throw std::invalid_argument(
+                            "EOSMultiMaterial: duplicated EOS id " +
+                            std::to_string(obj.Id()));
+                    }
+                    host_table(obj.Id()) =
+                        specialize ? EOSFixedMaterials::Specialize(obj.Params())
+                                   : obj.Params();
+                },
+                eos);
+        }
+        Kokkos::deep_copy(m_table, host_table);
+    }
+
+    /**
+     * @brief Computes pressure and speed of sound for all materials.
+     *
+     * Evaluates every particle with the EOS selected by its `eos_id` entry in
+     * one fused kernel. The outputs may be stored in a lower precision than
+     * the state (e.g. `float` views, see `EOSScalar`); the point-wise EOS
+     * then computes in that precision, except where double accumulation is
+     * needed (see `EOSStiffenedGas::PressureSoSPointImpl`).
+     *
+     * @param eos_id Per-particle EOS id Kokkos (sub)view.
+     * @param rho Density Kokkos (sub)view.
+     * @param eint Internal energy Kokkos (sub)view.
+     * @param p Pressure Kokkos (sub)view (output).
+     * @param sos Speed of sound Kokkos (sub)view (output).
+     * @param exec Execution space instance running the kernel; the call
+     * does not fence it.
+     */
+    template <class IdView, class StateView, class DerivedView>
+    void PressureSoS(const IdView& eos_id, const StateView& rho,
+                     const StateView& eint, const DerivedView& p,
+                     const DerivedView& sos,
+                     const Kokkos::DefaultExecutionSpace& exec = {}) const {
+        using T          = typename DerivedView::non_const_value_type;
+        const auto N     = rho.extent(0);
+        const auto table = m_table;
+        ProfilingRegion region("EOS");
+        Kokkos::parallel_for(
+            "EOSMultiMaterial::PressureSoS", Kokkos::RangePolicy<>(exec, 0, N),
+            KOKKOS_LAMBDA(const int i) {
+                T p_i   = p(i);
+                T sos_i = sos(i);
+                PressureSoSPoint(table, eos_id(i), static_cast<T>(rho(i)),
+                                 static_cast<T>(eint(i)), p_i, sos_i);
+                p(i)   = p_i;
+                sos(i) = sos_i;
+            });
+    }
+
+    /**
+     * @brief Computes pressure and speed of sound of material groups
+     * concurrently.
+     *
+     * Each group of rows (e.g. the `MaterialSort::Range` of a material) is
+     * evaluated on its own execution space instance, taken round-robin from
+     * `instances` (see `Kokkos::Experimental::partition_space`), so that
+     * small groups share the device instead of running one after another.
+     * The inputs must be complete on every instance. The instances are
+     * fenced before returning, which orders the outputs before any later
+     * work; other instances are not synchronized.
+     *
+     * @param eos_id Per-particle EOS id Kokkos view.
+     * @param rho Density Kokkos view.
+     * @param eint Internal energy Kokkos view.
+     * @param p Pressure Kokkos view (output).
+     * @param sos Speed of sound Kokkos view (output).
+     * @param groups Half-open row ranges [first, second) of the groups.
+     * @param instances Execution space instances.
+     * @throws std::invalid_argument If `instances` is empty.
+     */
+    template <class IdView, class StateView, class DerivedView>
+    void PressureSoS(
+        const IdView& eos_id, const StateView& rho, const StateView& eint,
+        const DerivedView& p, const DerivedView& sos,
+        const std::vector<Kokkos::pair<int, int>>& groups,
+        const std::vector<Kokkos::DefaultExecutionSpace>& instances) const {
+        if (instances.empty()) {
+            throw std::invalid_argument(
+                "EOSMultiMaterial: at least one execution space instance is "
+                "needed");
+        }
+        for (std::size_t g = 0; g < groups.size(); ++g) {
+            const auto rows = groups[g];
+            if (rows.first >= rows.second) continue;
+            PressureSoS(Kokkos::subview(eos_id, rows),
+                        Kokkos::subview(rho, rows), Kokkos::subview(eint, rows),
+                        Kokkos::subview(p, rows), Kokkos::subview(sos, rows),
+                        instances[g % instances.size()]);
+        }
+        for (const auto& instance : instances) {
+            instance.fence("EOSMultiMaterial::PressureSoS");
+        }
+    }
+
+    /**
+     * @brief Computes pressure and speed of sound of a particle container.
+     *
+     * @param particles Particle storage (e.g. `ParticleData`) providing
+     * `EOSId()`, `Rho()`, `Eint()`, `P()` and `SoS()`.
+     */
+    template <class Particles>
+    void PressureSoS(const Particles& particles) const {
+        PressureSoS(particles.EOSId(), particles.Rho(), particles.Eint(),
+                    particles.P(), particles.SoS());
+    }
+
+    /**
+     * @brief Computes pressure and speed of sound for a single particle.
+     *
+     * Device-callable dispatch on the EOS type tag. Particles pointing to an
+     * unregistered slot of the table are left untouched.
+     *
+     * @tparam T Floating-point type of the particle values.
+     * @param params Packed EOS parameters.
+     * @param rho Density.
+     * @param eint Internal energy.
+     * @param p Pressure (output).
+     * @param sos Speed of sound (output).
+     */
+    template <typename T>
+    KOKKOS_INLINE_FUNCTION static void PressureSoSPoint(const EOSParams& params,
+                                                        const T rho,
+                                                        const T eint, T& p,
+                                                        T& sos) {
+        switch (params.type) {
+            case EOSType::LinearGas:
+                EOSLinearGas<>::PressureSoSPoint(params, rho, eint, p, sos);
+                break;
+            case EOSType::StiffenedGas:
+                EOSStiffenedGas<>::PressureSoSPoint(params, rho, eint, p, sos);
+                break;
+            case EOSType::Fixed:
+                EOSFixedMaterials::PressureSoSPoint(params, rho, eint, p, sos);
+                break;
+            default: break;
+        }
+    }
+
+    /**
+     * @brief Computes pressure and speed of sound for a particle given its
+     * EOS id.
+     *
+     * Looks the id up in the table; ids outside the table (negative or not
+     * below `TableSize()`) are left untouched like unregistered ones.
+     *
+     * @tparam T Floating-point type of the particle values.
+     * @param table Packed device EOS table (`Table()`).
+     * @param eos_id EOS id of the particle.
+     * @param rho Density.
+     * @param eint Internal energy.
+     * @param p Pressure (output).
+     * @param sos Speed of sound (output).
+     */
+    template <typename T>
+    KOKKOS_INLINE_FUNCTION static void PressureSoSPoint(
+        const Kokkos::View<const EOSParams*>& table, const int eos_id,
+        const T rho, const T eint, T& p, T& sos) {
+        if (eos_id < 0 || eos_id >= static_cast<int>(table.extent(0))) {
+            return;
+        }
+        PressureSoSPoint(table(eos_id), rho, eint, p, sos);
+    }
+
+    /**
+     * @brief Returns the number of slots of the EOS table (largest id + 1).
+     *
+     * @return Size of the EOS table.
+     */
+    int TableSize() const { return static_cast<int>(m_table.extent(0)); }
+
+    /**
+     * @brief Returns the packed device EOS table indexed by EOS id.
+     *
+     * @return Device view of EOS parameter blocks.
+     */
+    Kokkos::View<const EOSParams*> Table() const { return m_table; }
+
+   private:
+    /**
+     * @brief Packed EOS parameter blocks indexed by EOS id (device memory).
+     */
+    Kokkos::View<EOSParams*> m_table;
+};
@@ -0,0 +1,68 @@
+#pragma once
+
+/**
+ * @file eos_params.hpp
+ * @brief Defines the packed parameter block shared by all equation of state
+ * (EOS) implementations.
+ *
+ * This file provides the `EOSType` tag and the `EOSParams` structure. Together
+ * they describe any EOS as plain data that can be stored in a device-resident
+ * Kokkos view and evaluated inside a kernel without host-side dispatch. It
+ * also defines `EOSScalar`, the storage type of the EOS outputs selected at
+ * build time.
+ */
+
+/**
+ * @brief Scalar type of the fields computed by the EOS (pressure, speed of
+ * sound).
+ *
+ * `float` when the project is configured with `SPHIROS_SINGLE_PRECISION`,
+ * `double` otherwise. Parameters are always stored in double precision.
+ */
+#ifdef SPHIROS_SINGLE_PRECISION
+using EOSScalar = float;
+#else
+using EOSScalar = double;
+#endif
+
+/**
+ * @enum EOSType
+ * @brief Tag identifying the EOS model stored in an `EOSParams` block.
+ */
+enum class EOSType : int {
+    Undefined    = -1,  ///< Unregistered EOS id.
+    LinearGas    = 0,   ///< `EOSLinearGas`.
+    StiffenedGas = 1,   ///< `EOSStiffenedGas`.
+    Fixed        = 2    ///< Compile-time specialization (`EOSFixedMaterials`).
+};
+
+/**
+ * @struct EOSParams
+ * @brief Packed, trivially copyable EOS parameter block.
+ *
+ * Each EOS implementation exports its parameters into this structure so that
+ * heterogeneous materials can be gathered in a single device table. Fields
+ * that are not used by a given model are left to zero.
+ */
+struct EOSParams {
+    /**
+     * @brief EOS model tag.
+     */
+    EOSType type = EOSType::Undefined;
+    /**
+     * @brief Specific heat ratio (γ).
+     */
+    double gamma = 0.0;
+    /**
+     * @brief Minimum cutoff pressure.
+     */
+    double pcutoff = 0.0;
+    /**
+     * @brief Infinite pressure (stiffened gas only).
+     */
+    double pinf = 0.0;
+    /**
+     * @brief Index of the compile-time specialization (`EOSType::Fixed` only).
+     */
+    int fixed = -1;
+};
@@ -1,3 +1,7 @@
+#pragma once
+
+#include <type_traits>
+
 #include "eos_crtp.hpp"
 
 /**
@@ -17,9 +21,20 @@
  * The `EOSStiffenedGas` class computes pressure and speed of sound for a
  * stiffened gas model. It inherits from the `EOSCRTP` base class and provides
  * the implementation for the `PressureSoSImpl` method.
+ *
+ * @tparam Scalar Floating-point type of the views and parameters (deduced
+ * from the constructor arguments, e.g. `EOSStiffenedGas(0, 1.4f, 1e-6f)` is a
+ * single-precision EOS).
  */
-class EOSStiffenedGas : public EOSCRTP<EOSStiffenedGas> {
+template <typename Scalar = double>
+class EOSStiffenedGas : public EOSCRTP<EOSStiffenedGas<Scalar>, Scalar> {
    public:
+    /**
+     * @brief SIMD packs are only used in double precision, the pressure
+     * being accumulated in double.
+     */
+    static constexpr bool vectorized = std::is_same_v<Scalar, double>;
+
     /**
      * @brief Constructor for EOSStiffenedGas.
      *
@@ -32,7 +47,7 @@ class EOSStiffenedGas : public EOSCRTP<EOSStiffenedGas> {
      * values (e.g. cavitation).
      * @param pinf Infinite pressure.
      */
-    EOSStiffenedGas(int id, double gamma, double pcutoff, double pinf = 0.0)
+    EOSStiffenedGas(int id, Scalar gamma, Scalar pcutoff, Scalar pinf = 0)
         : m_id(id), m_gamma(gamma), m_pcutoff(pcutoff), m_pinf(pinf) {}
 
     /**
@@ -46,18 +61,70 @@ class EOSStiffenedGas : public EOSCRTP<EOSStiffenedGas> {
      * @param eint Internal energy Kokkos (sub)view.
      * @param p Pressure Kokkos (sub)view (output).
      * @param sos Speed of sound Kokkos (sub)view (output).
+     * @param exec Execution space instance running the kernel (e.g. one per
+     * material group); the call does not fence it.
+     */
+    void PressureSoSImpl(
+        Kokkos::View<Scalar *> rho, Kokkos::View<Scalar *> eint,
+        Kokkos::View<Scalar *> p, Kokkos::View<Scalar *> sos,
+        const Kokkos::DefaultExecutionSpace &exec = {}) const {
+        ProfilingRegion region("EOS");
+        this->PressureSoSKernel(
+            "EOSStiffenedGas::PressureSoS(id=" + std::to_string(m_id) + ")",
+            Params(), rho, eint, p, sos, exec);
+    }
+
+    /**
+     * @brief Computes pressure and speed of sound for a single particle.
+     *
+     * Device-callable kernel body shared by `PressureSoSImpl` and the
+     * multi-material dispatch (`EOSMultiMaterial`).
+     *
+     * The pressure is the difference of two large terms for stiff materials
+     * (`pinf` is O(1e9) Pa for water), so it is always accumulated in double
+     * precision and only rounded to `T` on output.
+     *
+     * @tparam T Floating-point type of the particle values, or a SIMD pack
+     * of doubles.
+     * @param params Packed EOS parameters (`gamma`, `pcutoff`, `pinf`).
+     * @param rho Density.
+     * @param eint Internal energy.
+     * @param p Pressure (output).
+     * @param sos Speed of sound (output).
+     */
+    template <typename T>
+    KOKKOS_INLINE_FUNCTION static void PressureSoSPointImpl(
+        const EOSParams &params, const T rho, const T eint, T &p, T &sos) {
+        using Acc       = SIMDOps::Double<T>;
+        const Acc gamma = params.gamma;
+        const Acc pinf  = params.pinf;
+        const Acc p_gas = (gamma - Acc(1.0)) * rho * eint;
+        const Acc p_acc =
+            SIMDOps::Max(p_gas - gamma * pinf, Acc(params.pcutoff));
+
+        p   = static_cast<T>(p_acc);
+        sos = static_cast<T>(gamma * (p_acc + pinf) / rho);
+    }
+
+    /**
+     * @brief Returns the EOS id.
+     *
+     * @return EOS id.
+     */
+    int Id() const { return m_id; }
+
+    /**
+     * @brief Exports the EOS parameters as a packed `EOSParams` block.
+     *
+     * @return Packed EOS parameters.
      */
-    void PressureSoSImpl(Kokkos::View<double *> rho,
-                         Kokkos::View<double *> eint, Kokkos::View<double *> p,
-                         Kokkos::View<double *> sos) const {
-        const auto N = rho.extent(0);
-        Kokkos::parallel_for(
-            "Initialize", N, KOKKOS_CLASS_LAMBDA(const int i) {
-                p(i) = Kokkos::max(
-                    (m_gamma - 1.0) * rho(i) * eint(i) - m_gamma * m_pinf,
-                    m_pcutoff);
-                sos(i) = m_gamma * (p(i) + m_pinf) / rho(i);
-            });
+    EOSParams Params() const {
+        EOSParams params;
+        params.type    = EOSType::StiffenedGas;
+        params.gamma   = m_gamma;
+        params.pcutoff = m_pcutoff;
+        params.pinf    = m_pinf;
+        return params;
     }
 
    private:
@@ -77,7 +144,7 @@ class EOSStiffenedGas : public EOSCRTP<EOSStiffenedGas> {
      * the thermodynamic properties of the gas. For example, for air, γ is
      * typically 1.4.
      */
-    double m_gamma;
+    Scalar m_gamma;
     /**
      * @brief Minimum cutoff pressure.
      *
@@ -85,9 +152,9 @@ class EOSStiffenedGas : public EOSCRTP<EOSStiffenedGas> {
      * avoid negative or unphysical results, such as cavitation. It ensures
      * numerical stability in the computations.
      */
-    double m_pcutoff;
+    Scalar m_pcutoff;
     /**
      * @brief Infinite pressure.
      */
-    double m_pinf;  // Infinitesimal pressure
+    Scalar m_pinf;  // Infinitesimal pressure
 };
\ No newline at end of file
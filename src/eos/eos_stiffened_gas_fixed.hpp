@@ -0,0 +1,136 @@
+#pragma once
+
+#include "eos_crtp.hpp"
+
+/**
+ * @file eos_stiffened_gas_fixed.hpp
+ * @brief Defines the EOSStiffenedGasFixed class, a stiffened gas equation of
+ * state with compile-time parameters.
+ *
+ * This file provides the `EOSStiffenedGasFixed` class template. Its specific
+ * heat ratio and infinite pressure are template arguments, so the compiler
+ * folds them into the kernel (e.g. the `pinf` terms vanish for ideal gases).
+ */
+
+/**
+ * @class EOSStiffenedGasFixed
+ * @brief Implements the stiffened gas equation of state with compile-time
+ * `gamma` and `pinf`.
+ *
+ * Evaluates the same formulas as `EOSStiffenedGas` (and `EOSLinearGas` when
+ * `PInf` is zero). Only the cutoff pressure is read at run time. Common
+ * materials are pre-instantiated in `EOSFixedMaterials`, which
+ * `EOSMultiMaterial` uses in place of the runtime-parameter versions.
+ *
+ * @tparam Gamma Specific heat ratio.
+ * @tparam PInf Infinite pressure.
+ */
+template <double Gamma, double PInf = 0.0>
+class EOSStiffenedGasFixed
+    : public EOSCRTP<EOSStiffenedGasFixed<Gamma, PInf>> {
+   public:
+    /**
+     * @brief Specific heat ratio (γ).
+     */
+    static constexpr double gamma = Gamma;
+    /**
+     * @brief Infinite pressure.
+     */
+    static constexpr double pinf = PInf;
+
+    /**
+     * @brief Constructor for EOSStiffenedGasFixed.
+     *
+     * @param id EOS id.
+     * @param pcutoff Minimum cutoff pressure to avoid negative or unphysical
+     * values (e.g. cavitation).
+     */
+    EOSStiffenedGasFixed(int id, double pcutoff)
+        : m_id(id), m_pcutoff(pcutoff) {}
+
+    /**
+     * @brief Computes pressure and speed of sound.
+     *
+     * @param rho Density Kokkos (sub)view.
+     * @param eint Internal energy Kokkos (sub)view.
+     * @param p Pressure Kokkos (sub)view (output).
+     * @param sos Speed of sound Kokkos (sub)view (output).
+     * @param exec Execution space instance running the kernel; the call
+     * does not fence it.
+     */
+    void PressureSoSImpl(
+        Kokkos::View<double *> rho, Kokkos::View<double *> eint,
+        Kokkos::View<double *> p, Kokkos::View<double *> sos,
+        const Kokkos::DefaultExecutionSpace &exec = {}) const {
+        const std::string label = "EOSStiffenedGasFixed::PressureSoS(id=" +
+                                  std::to_string(m_id) + ")";
+        ProfilingRegion region("EOS");
+        this->PressureSoSKernel(label, Params(), rho, eint, p, sos, exec);
+    }
+
+    /**
+     * @brief Computes pressure and speed of sound for a single particle.
+     *
+     * Without infinite pressure the arithmetic is carried out in the
+     * precision of the particle values; otherwise it is accumulated in double
+     * precision, as in `EOSStiffenedGas`.
+     *
+     * @tparam T Floating-point type of the particle values, or a SIMD pack
+     * of doubles.
+     * @param params Packed EOS parameters (only `pcutoff` is read).
+     * @param rho Density.
+     * @param eint Internal energy.
+     * @param p Pressure (output).
+     * @param sos Speed of sound (output).
+     */
+    template <typename T>
+    KOKKOS_INLINE_FUNCTION static void PressureSoSPointImpl(
+        const EOSParams &params, const T rho, const T eint, T &p, T &sos) {
+        if constexpr (PInf == 0.0) {
+            const T g = static_cast<T>(Gamma);
+            p         = SIMDOps::Max((g - T(1)) * rho * eint,
+                                     static_cast<T>(params.pcutoff));
+            sos       = g * p / rho;
+        } else {
+            using Acc       = SIMDOps::Double<T>;
+            const Acc g     = Gamma;
+            const Acc p_acc = SIMDOps::Max(
+                (g - Acc(1.0)) * rho * eint - g * Acc(PInf),
+                Acc(params.pcutoff));
+
+            p   = static_cast<T>(p_acc);
+            sos = static_cast<T>(g * (p_acc + Acc(PInf)) / rho);
+        }
+    }
+
+    /**
+     * @brief Returns the EOS id.
+     *
+     * @return EOS id.
+     */
+    int Id() const { return m_id; }
+
+    /**
+     * @brief Exports the EOS parameters as a packed `EOSParams` block.
+     *
+     * @return Packed EOS parameters (stiffened gas).
+     */
+    EOSParams Params() const {
+        EOSParams params;
+        params.type    = EOSType::StiffenedGas;
+        params.gamma   = Gamma;
+        params.pcutoff = m_pcutoff;
+        params.pinf    = PInf;
+        return params;
+    }
+
+   private:
+    /**
+     * @brief Unique identifier for the EOS.
+     */
+    int m_id;
+    /**
+     * @brief Minimum cutoff pressure.
+     */
+    double m_pcutoff;
+};
@@ -0,0 +1,329 @@
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <fstream>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "eos_crtp.hpp"
+
+/**
+ * @file eos_tabulated.hpp
+ * @brief Defines the EOSTabulated class for table-based equations of state.
+ *
+ * This file provides the `EOSTabulated` class, which interpolates pressure
+ * and speed of sound in a precomputed (rho, eint) table held in device
+ * memory, e.g. SESAME-like real-material data or an expensive analytic EOS
+ * sampled once.
+ */
+
+/**
+ * @struct EOSTableAxis
+ * @brief Log-spaced axis of an EOS table.
+ *
+ * The nodes are `min * (max / min)^(k / (n - 1))` for `k` in [0, n).
+ */
+struct EOSTableAxis {
+    double min = 0.0;  ///< First node (positive).
+    double max = 0.0;  ///< Last node (larger than `min`).
+    int n      = 0;    ///< Number of nodes (at least 2).
+
+    /**
+     * @brief Returns a node of the axis.
+     *
+     * @param k Node index in [0, n).
+     * @return Node value.
+     */
+    double Value(const int k) const {
+        if (k == n - 1) return max;
+        return min * std::pow(max / min, static_cast<double>(k) / (n - 1));
+    }
+};
+
+/**
+ * @struct EOSTable
+ * @brief Device-copyable (rho, eint) -> (p, sos) lookup table.
+ *
+ * The node `(i, j)` of the density and energy axes is the row
+ * `i * n[1] + j` of `values`, whose columns are the pressure and the speed
+ * of sound (interleaved), so a lookup reads the four corners of a bin from
+ * two pairs of adjacent rows. The values are read through the
+ * `RandomAccess` trait (the read-only data cache on GPUs).
+ */
+struct EOSTable {
+    /**
+     * @brief Pressure and speed of sound of every node.
+     */
+    Kokkos::View<const double* [2], Kokkos::LayoutRight,
+                 Kokkos::MemoryTraits<Kokkos::RandomAccess>>
+        values;
+    /**
+     * @brief First node of the density and energy axes.
+     */
+    double lo[2] = {0.0, 0.0};
+    /**
+     * @brief Last node of the density and energy axes.
+     */
+    double hi[2] = {0.0, 0.0};
+    /**
+     * @brief Logarithm of the first nodes.
+     */
+    double log_lo[2] = {0.0, 0.0};
+    /**
+     * @brief Bins per unit logarithm of the axes.
+     */
+    double scale[2] = {0.0, 0.0};
+    /**
+     * @brief Number of nodes of the axes.
+     */
+    int n[2] = {0, 0};
+    /**
+     * @brief Minimum cutoff pressure.
+     */
+    double pcutoff = 0.0;
+
+    /**
+     * @brief Interpolates pressure and speed of sound.
+     *
+     * Bilinear interpolation in (log rho, log eint). States outside the
+     * table are clamped to its boundary.
+     *
+     * @param rho Density.
+     * @param eint Internal energy.
+     * @param p Pressure (output).
+     * @param sos Speed of sound (output).
+     */
+    KOKKOS_INLINE_FUNCTION void Lookup(const double rho, const double eint,
+                                       double& p, double& sos) const {
+        int k_rho, k_eint;
+        double t_rho, t_eint;
+        Locate(0, rho, k_rho, t_rho);
+        Locate(1, eint, k_eint, t_eint);
+        const int c = k_rho * n[1] + k_eint;
+        double f[2];
+        for (int v = 0; v < 2; ++v) {
+            const double lower = (1.0 - t_eint) * values(c, v) +
+                                 t_eint * values(c + 1, v);
+            const double upper = (1.0 - t_eint) * values(c + n[1], v) +
+                                 t_eint * values(c + n[1] + 1, v);
+            f[v]               = (1.0 - t_rho) * lower + t_rho * upper;
+        }
+        p   = Kokkos::max(f[0], pcutoff);
+        sos = f[1];
+    }
+
+    /**
+     * @brief Returns the bin of a value and its position in the bin.
+     *
+     * Building block of `Lookup`.
+     *
+     * @param axis Axis (0 for the density, 1 for the energy).
+     * @param value Value, clamped to the axis (NaN maps to the first node).
+     * @param k Bin index in [0, n - 2] (output).
+     * @param t Position in the bin in [0, 1] (output).
+     */
+    KOKKOS_INLINE_FUNCTION void Locate(const int axis, const double value,
+                                       int& k, double& t) const {
+        double v = value;
+        if (!(v > lo[axis])) v = lo[axis];
+        if (v > hi[axis]) v = hi[axis];
+        const double x = (Kokkos::log(v) - log_lo[axis]) * scale[axis];
+        k              = Kokkos::min(static_cast<int>(x), n[axis] - 2);
+        t              = Kokkos::min(x - k, 1.0);
+    }
+};
+
+/**
+ * @class EOSTabulated
+ * @brief Implements a tabulated equation of state.
+ *
+ * Pressure and speed of sound are interpolated in an `EOSTable` on
+ * log-spaced density and internal energy axes, so a lookup costs two
+ * logarithms and four pairs of loads whatever the model behind the data.
+ * The table lives in device memory; copies of the EOS share it.
+ *
+ * The evaluation needs the table, not only an `EOSParams` block, so this
+ * EOS is called through `PressureSoSImpl` and is not part of the
+ * `EOSMultiMaterial` dispatch.
+ *
+ * @tparam Scalar Floating-point type of the views; the table and the
+ * interpolation stay in double precision.
+ */
+template <typename Scalar = double>
+class EOSTabulated : public EOSCRTP<EOSTabulated<Scalar>, Scalar> {
+   public:
+    /**
+     * @brief Constructor for EOSTabulated.
+     *
+     * @param id EOS id.
+     * @param rho Density axis.
+     * @param eint Internal energy axis.
+     * @param p Pressure of every node, the energy index running fastest.
+     * @param sos Speed of sound of every node, same ordering.
+     * @param pcutoff Minimum cutoff pressure applied after interpolation.
+     * @throws std::invalid_argument On an invalid axis or a table size other
+     * than `rho.n * eint.n`.
+     */
+    EOSTabulated(int id, const EOSTableAxis& rho, const EOSTableAxis& eint,
+                 const std::vector<double>& p, const std::vector<double>& sos,
+                 double pcutoff)
+        : m_id(id) {
+        const EOSTableAxis axes[2] = {rho, eint};
+        for (int a = 0; a < 2; ++a) {
+            if (axes[a].n < 2 || !(axes[a].min > 0.0) ||
+                !(axes[a].max > axes[a].min)) {
+                throw std::invalid_argument(
+                    "EOSTabulated: axes need 0 < min < max and n >= 2");
+            }
+            m_table.lo[a]     = axes[a].min;
+            m_table.hi[a]     = axes[a].max;
+            m_table.log_lo[a] = std::log(axes[a].min);
+            m_table.n[a]      = axes[a].n;
+            m_table.scale[a] =
+                (axes[a].n - 1) / std::log(axes[a].max / axes[a].min);
+        }
+        const std::size_t size = static_cast<std::size_t>(rho.n) * eint.n;
+        if (p.size() != size || sos.size() != size) {
+            throw std::invalid_argument(
+                "EOSTabulated: tables must hold rho.n * eint.n values");
+        }
+        m_table.pcutoff = pcutoff;
+
+        Kokkos::View<double* [2], Kokkos::LayoutRight> values(
+            Kokkos::view_alloc(Kokkos::WithoutInitializing, "eos_table"),
+            size);
+        auto host = Kokkos::create_mirror_view(values);
+        for (std::size_t k = 0; k < size; ++k) {
+            host(k, 0) = p[k];
+            host(k, 1) = sos[k];
+        }
+        Kokkos::deep_copy(values, host);
+        m_table.values = values;
+    }
+
+    /**
+     * @brief Samples another EOS on the nodes of a table.
+     *
+     * @tparam EOS `EOSCRTP` implementation providing `Params` and
+     * `PressureSoSPoint` (e.g. `EOSStiffenedGas<>`).
+     * @param id EOS id.
+     * @param eos Sampled EOS.
+     * @param rho Density axis.
+     * @param eint Internal energy axis.
+     * @return Tabulated EOS with the cutoff pressure of `eos`.
+     */
+    template <class EOS>
+    static EOSTabulated Tabulate(int id, const EOS& eos,
+                                 const EOSTableAxis& rho,
+                                 const EOSTableAxis& eint) {
+        const EOSParams params = eos.Params();
+        const std::size_t size =
+            static_cast<std::size_t>(std::max(rho.n, 0)) *
+            std::max(eint.n, 0);
+        std::vector<double> p(size), sos(size);
+        for (int i = 0; i < rho.n; ++i) {
+            for (int j = 0; j < eint.n; ++j) {
+                const std::size_t k = static_cast<std::size_t>(i) * eint.n + j;
+                EOS::PressureSoSPoint(params, rho.Value(i), eint.Value(j),
+                                      p[k], sos[k]);
+            }
+        }
+        return EOSTabulated(id, rho, eint, p, sos, params.pcutoff);
+    }
+
+    /**
+     * @brief Reads a table from a text file.
+     *
+     * The file holds `n_rho rho_min rho_max`, then `n_eint eint_min
+     * eint_max`, then one `p sos` pair per node, the energy index running
+     * fastest. Text after `#` on a line is a comment.
+     *
+     * @param id EOS id.
+     * @param filename Table path.
+     * @param pcutoff Minimum cutoff pressure.
+     * @return Tabulated EOS.
+     * @throws std::runtime_error If the file cannot be read or is truncated.
+     * @throws std::invalid_argument On invalid axes.
+     */
+    static EOSTabulated FromFile(int id, const std::string& filename,
+                                 double pcutoff) {
+        std::ifstream file(filename);
+        if (!file) {
+            throw std::runtime_error("EOSTabulated: cannot open " + filename);
+        }
+        std::stringstream stream;
+        for (std::string line; std::getline(file, line);) {
+            stream << line.substr(0, line.find('#')) << '\n';
+        }
+        EOSTableAxis rho, eint;
+        stream >> rho.n >> rho.min >> rho.max >> eint.n >> eint.min >>
+            eint.max;
+        if (!stream || rho.n < 2 || eint.n < 2) {
+            throw std::runtime_error("EOSTabulated: invalid header in " +
+                                     filename);
+        }
+        const std::size_t size = static_cast<std::size_t>(rho.n) * eint.n;
+        std::vector<double> p(size), sos(size);
+        for (std::size_t k = 0; k < size; ++k) stream >> p[k] >> sos[k];
+        if (!stream) {
+            throw std::runtime_error("EOSTabulated: truncated table in " +
+                                     filename);
+        }
+        return EOSTabulated(id, rho, eint, p, sos, pcutoff);
+    }
+
+    /**
+     * @brief Computes pressure and speed of sound.
+     *
+     * @param rho Density Kokkos (sub)view.
+     * @param eint Internal energy Kokkos (sub)view.
+     * @param p Pressure Kokkos (sub)view (output).
+     * @param sos Speed of sound Kokkos (sub)view (output).
+     * @param exec Execution space instance running the kernel; the call
+     * does not fence it.
+     */
+    void PressureSoSImpl(
+        Kokkos::View<Scalar *> rho, Kokkos::View<Scalar *> eint,
+        Kokkos::View<Scalar *> p, Kokkos::View<Scalar *> sos,
+        const Kokkos::DefaultExecutionSpace &exec = {}) const {
+        const EOSTable table = m_table;
+        ProfilingRegion region("EOS");
+        Kokkos::parallel_for(
+            "EOSTabulated::PressureSoS(id=" + std::to_string(m_id) + ")",
+            Kokkos::RangePolicy<>(exec, 0, rho.extent(0)),
+            KOKKOS_LAMBDA(const int i) {
+                double p_i, sos_i;
+                table.Lookup(rho(i), eint(i), p_i, sos_i);
+                p(i)   = static_cast<Scalar>(p_i);
+                sos(i) = static_cast<Scalar>(sos_i);
+            });
+    }
+
+    /**
+     * @brief Returns the EOS id.
+     *
+     * @return EOS id.
+     */
+    int Id() const { return m_id; }
+
+    /**
+     * @brief Returns the device lookup table.
+     *
+     * @return Device-copyable table.
+     */
+    const EOSTable &Table() const { return m_table; }
+
+   private:
+    /**
+     * @brief Unique identifier for the EOS.
+     */
+    int m_id;
+    /**
+     * @brief Device lookup table.
+     */
+    EOSTable m_table;
+};
@@ -0,0 +1,235 @@
+#pragma once
+
+#include <cstddef>
+#include <string>
+
+// Kokkos includes
+#include <Kokkos_Core.hpp>
+#include <Kokkos_SIMD.hpp>
+
+/**
+ * @file simd_ops.hpp
+ * @brief Defines the SIMDOps helpers for explicitly vectorized kernels.
+ *
+ * This file provides the `SIMDOps` structure, the small set of operations
+ * the EOS and SPH kernels need to run the same templated arithmetic on
+ * scalars and on `Kokkos::Experimental::simd` packs.
+ */
+
+/**
+ * @struct SIMDOps
+ * @brief Scalar and SIMD overloads of the kernel building blocks.
+ *
+ * A kernel body written for a value type `T` with `Max`, `Select` and the
+ * arithmetic operators compiles both for `T = double` (device and tail
+ * iterations) and for `T = Pack<double>` (one register of lanes). The packed
+ * path is only used when `enabled`, i.e. when the default execution space
+ * runs on the host: GPU backends keep one particle per thread.
+ */
+struct SIMDOps {
+    /**
+     * @brief Native SIMD pack of the host.
+     *
+     * @tparam T Lane type.
+     */
+    template <class T>
+    using Pack = Kokkos::Experimental::simd<T>;
+
+    /**
+     * @brief True if the default execution space runs the packed kernels.
+     */
+    static constexpr bool enabled =
+        Kokkos::SpaceAccessibility<Kokkos::DefaultExecutionSpace,
+                                   Kokkos::HostSpace>::accessible;
+
+    /**
+     * @struct DoubleLanes
+     * @brief Double-precision type with the lanes of `T`.
+     *
+     * `double` for scalars and `T` itself for double packs, so the
+     * accumulations required in double precision (e.g.
+     * `EOSStiffenedGas::PressureSoSPointImpl`) compile for both.
+     *
+     * @tparam T Scalar or pack type.
+     */
+    template <class T>
+    struct DoubleLanes {
+        using type = double;  ///< Scalar accumulator.
+    };
+
+    /**
+     * @brief Double-precision type with the lanes of `T`.
+     *
+     * @tparam T Scalar or pack type.
+     */
+    template <class T>
+    using Double = typename DoubleLanes<T>::type;
+
+    /**
+     * @brief Returns the number of lanes of a pack.
+     *
+     * @tparam T Lane type.
+     * @return Pack width.
+     */
+    template <class T>
+    static constexpr std::size_t Width() {
+        return Pack<T>::size();
+    }
+
+    /**
+     * @brief Loads a pack from contiguous values.
+     *
+     * @param ptr First value (no alignment requirement).
+     * @return Pack of `ptr[0], ..., ptr[Width() - 1]`.
+     */
+    template <class T>
+    static Pack<T> Load(const T* ptr) {
+        Pack<T> pack;
+        pack.copy_from(ptr, Flags());
+        return pack;
+    }
+
+    /**
+     * @brief Stores a pack to contiguous values.
+     *
+     * @param pack Values to store.
+     * @param ptr First destination (no alignment requirement).
+     */
+    template <class T>
+    static void Store(const Pack<T>& pack, T* ptr) {
+        pack.copy_to(ptr, Flags());
+    }
+
+    /**
+     * @brief Returns the larger of two scalars.
+     *
+     * @param a First value.
+     * @param b Second value.
+     * @return max(a, b).
+     */
+    template <class T>
+    KOKKOS_INLINE_FUNCTION static T Max(const T a, const T b) {
+        return Kokkos::max(a, b);
+    }
+
+    /**
+     * @brief Returns the lane-wise larger of two packs.
+     *
+     * @param a First pack.
+     * @param b Second pack.
+     * @return max(a, b) in every lane.
+     */
+    template <class T, class Abi>
+    static Kokkos::Experimental::simd<T, Abi> Max(
+        const Kokkos::Experimental::simd<T, Abi>& a,
+        const Kokkos::Experimental::simd<T, Abi>& b) {
+        return Kokkos::Experimental::condition(a < b, b, a);
+    }
+
+    /**
+     * @brief Selects one of two scalars.
+     *
+     * @param mask Condition.
+     * @param a Value if the condition holds.
+     * @param b Value otherwise.
+     * @return mask ? a : b.
+     */
+    template <class T>
+    KOKKOS_INLINE_FUNCTION static T Select(const bool mask, const T a,
+                                           const T b) {
+        return mask ? a : b;
+    }
+
+    /**
+     * @brief Selects lane-wise between two packs.
+     *
+     * Both packs are computed; masked-out lanes may hold non-finite values.
+     *
+     * @param mask Condition of every lane.
+     * @param a Lanes taken where the condition holds.
+     * @param b Lanes taken otherwise.
+     * @return mask ? a : b in every lane.
+     */
+    template <class T, class Abi>
+    static Kokkos::Experimental::simd<T, Abi> Select(
+        const typename Kokkos::Experimental::simd<T, Abi>::mask_type& mask,
+        const Kokkos::Experimental::simd<T, Abi>& a,
+        const Kokkos::Experimental::simd<T, Abi>& b) {
+        return Kokkos::Experimental::condition(mask, a, b);
+    }
+
+    /**
+     * @brief Returns the sum of the lanes of a pack.
+     *
+     * @param pack Values to sum.
+     * @return pack[0] + ... + pack[Width() - 1].
+     */
+    template <class T>
+    static T Sum(const Pack<T>& pack) {
+        T lanes[Pack<T>::size()];
+        Store(pack, lanes);
+        T sum = T(0);
+        for (std::size_t l = 0; l < Pack<T>::size(); ++l) sum += lanes[l];
+        return sum;
+    }
+
+    /**
+     * @brief Runs a kernel over `[0, n)` by packs of `Width<T>()` elements.
+     *
+     * `pack(i)` handles the elements `i, ..., i + Width<T>() - 1`; the last
+     * partial pack is handled element by element by `tail(i)`. The bodies
+     * are host lambdas, so the call only compiles when `enabled`; guard it
+     * with `if constexpr (SIMDOps::enabled)`.
+     *
+     * @tparam T Lane type.
+     * @param label Kernel label.
+     * @param exec Execution space instance; the call does not fence it.
+     * @param n Number of elements.
+     * @param pack Callable on the first element of a full pack.
+     * @param tail Callable on a single element.
+     */
+    template <class T, class PackBody, class TailBody>
+    static void ForEach(const std::string& label,
+                        const Kokkos::DefaultExecutionSpace& exec,
+                        const std::size_t n, const PackBody& pack,
+                        const TailBody& tail) {
+        static_assert(sizeof(T) > 0 && enabled,
+                      "SIMDOps::ForEach: the default execution space must "
+                      "access HostSpace");
+        constexpr std::size_t width = Pack<T>::size();
+        Kokkos::parallel_for(
+            label, Kokkos::RangePolicy<>(exec, 0, (n + width - 1) / width),
+            [=](const std::size_t k) {
+                const std::size_t i = k * width;
+                if (i + width <= n) {
+                    pack(i);
+                } else {
+                    for (std::size_t t = i; t < n; ++t) tail(t);
+                }
+            });
+    }
+
+   private:
+    /**
+     * @brief Returns the load and store flags (unaligned access).
+     *
+     * @return Default SIMD flags of the Kokkos version.
+     */
+    static constexpr auto Flags() {
+#if KOKKOS_VERSION >= 40300
+        return Kokkos::Experimental::simd_flag_default;
+#else
+        return Kokkos::Experimental::element_aligned_tag();
+#endif
+    }
+};
+
+/**
+ * @brief Double packs accumulate in their own lanes.
+ *
+ * @tparam Abi Pack ABI.
+ */
+template <class Abi>
+struct SIMDOps::DoubleLanes<Kokkos::Experimental::simd<double, Abi>> {
+    using type = Kokkos::Experimental::simd<double, Abi>;  ///< Pack itself.
+};
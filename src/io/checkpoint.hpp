@@ -0,0 +1,741 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+// mpi includes
+#include <mpi.h>
+// Kokkos includes
+#include <Kokkos_Core.hpp>
+
+#include "profiler.hpp"
+#include "vtk_common.hpp"
+
+/**
+ * @file checkpoint.hpp
+ * @brief Defines the CheckpointWriter and CheckpointReader classes for
+ * collective MPI-IO checkpoint/restart.
+ *
+ * This file provides a single-shared-file checkpoint format. The file holds
+ * a header, a table of entries and, for each entry, a data region starting
+ * on a stripe boundary:
+ *
+ * - *fields* are per-particle arrays, stored in global particle order (the
+ *   concatenation of the ranks' particles), written and read with collective
+ *   MPI-IO so that any number of ranks can restart from the file;
+ * - *records* are small global arrays (time, EOS parameter tables, ...),
+ *   written by rank 0 and broadcast on read.
+ *
+ * Data is stored in the byte order of the writing machine.
+ */
+
+/**
+ * @struct CheckpointEntry
+ * @brief Entry of the checkpoint table (packed, stored as is in the file).
+ */
+struct CheckpointEntry {
+    /**
+     * @brief Entry name (null terminated).
+     */
+    char name[64] = {};
+    /**
+     * @brief Element type (VTK data type name, or "Raw" for other types).
+     */
+    char type[16] = {};
+    /**
+     * @brief Size of an element in bytes.
+     */
+    std::uint64_t element_size = 0;
+    /**
+     * @brief Number of elements per row (components).
+     */
+    std::uint64_t n_components = 1;
+    /**
+     * @brief Number of rows (global particles for fields).
+     */
+    std::uint64_t n_rows = 0;
+    /**
+     * @brief File offset of the data region.
+     */
+    std::uint64_t offset = 0;
+    /**
+     * @brief 0 for per-particle fields, 1 for records.
+     */
+    std::uint64_t is_record = 0;
+};
+
+/**
+ * @struct CheckpointHeader
+ * @brief Header of a checkpoint file (stored as is at offset 0).
+ */
+struct CheckpointHeader {
+    /**
+     * @brief File signature.
+     */
+    char magic[8] = {'S', 'P', 'H', 'C', 'K', 'P', 'T', '1'};
+    /**
+     * @brief Number of ranks that wrote the file.
+     */
+    std::uint64_t n_ranks = 0;
+    /**
+     * @brief Global number of particles.
+     */
+    std::uint64_t n_particles = 0;
+    /**
+     * @brief Alignment of the data regions.
+     */
+    std::uint64_t stripe_size = 0;
+    /**
+     * @brief Number of entries of the table following the header.
+     */
+    std::uint64_t n_entries = 0;
+};
+
+/**
+ * @class CheckpointIO
+ * @brief MPI-IO helpers shared by the checkpoint writer and reader.
+ */
+class CheckpointIO {
+   public:
+    /**
+     * @brief Largest transfer of a single MPI-IO call (int count limit).
+     */
+    static constexpr std::size_t max_transfer = std::size_t(1) << 30;
+
+    /**
+     * @brief Returns the VTK type name of `T`, or "Raw" for non-arithmetic
+     * types.
+     *
+     * @return Type name.
+     */
+    template <typename T>
+    static std::string TypeName() {
+        if constexpr (std::is_arithmetic_v<T>) {
+            return VTKType::Name<T>();
+        } else {
+            return "Raw";
+        }
+    }
+
+    /**
+     * @brief Rounds an offset up to a multiple of the stripe size.
+     *
+     * @param offset File offset.
+     * @param stripe_size Alignment.
+     * @return Aligned offset.
+     */
+    static std::uint64_t Align(const std::uint64_t offset,
+                               const std::uint64_t stripe_size) {
+        return (offset + stripe_size - 1) / stripe_size * stripe_size;
+    }
+
+    /**
+     * @brief Returns the MPI-IO hints matching a stripe size.
+     *
+     * Collective buffering aggregates the ranks' data into stripe-sized
+     * chunks so that each stripe is written by a single aggregator.
+     *
+     * @param stripe_size Stripe size in bytes.
+     * @return MPI info object (to be freed by the caller).
+     */
+    static MPI_Info Hints(const std::size_t stripe_size) {
+        MPI_Info info;
+        MPI_Info_create(&info);
+        const std::string stripe = std::to_string(stripe_size);
+        MPI_Info_set(info, "striping_unit", stripe.c_str());
+        MPI_Info_set(info, "cb_buffer_size",
+                     std::to_string(4 * stripe_size).c_str());
+        MPI_Info_set(info, "romio_cb_write", "enable");
+        MPI_Info_set(info, "romio_cb_read", "enable");
+        return info;
+    }
+
+    /**
+     * @brief Collective write or read of a contiguous byte range, split into
+     * transfers of at most `max_transfer` bytes.
+     *
+     * All the ranks of the file communicator must call this function, with
+     * possibly zero bytes.
+     *
+     * @param file MPI file handle.
+     * @param comm Communicator of the file.
+     * @param offset File offset of the local range.
+     * @param data Local buffer.
+     * @param n_bytes Local number of bytes.
+     * @param write True to write, false to read.
+     * @throws std::runtime_error If an MPI-IO call fails.
+     */
+    static void TransferAll(MPI_File file, MPI_Comm comm,
+                            const std::uint64_t offset, void* data,
+                            const std::size_t n_bytes, const bool write) {
+        unsigned long n_calls = (n_bytes + max_transfer - 1) / max_transfer;
+        MPI_Allreduce(MPI_IN_PLACE, &n_calls, 1, MPI_UNSIGNED_LONG, MPI_MAX,
+                      comm);
+        auto* bytes = static_cast<char*>(data);
+        for (unsigned long k = 0; k < n_calls; ++k) {
+            const std::size_t begin = std::min(k * max_transfer, n_bytes);
+            const int count =
+                static_cast<int>(std::min(max_transfer, n_bytes - begin));
+            const int error =
+                write ? MPI_File_write_at_all(file, offset + begin,
+                                              bytes + begin, count, MPI_BYTE,
+                                              MPI_STATUS_IGNORE)
+                      : MPI_File_read_at_all(file, offset + begin,
+                                             bytes + begin, count, MPI_BYTE,
+                                             MPI_STATUS_IGNORE);
+            if (error != MPI_SUCCESS) {
+                throw std::runtime_error(
+                    "CheckpointIO: MPI-IO transfer failed");
+            }
+        }
+    }
+
+    /**
+     * @brief Copies the rows of a Kokkos view into a row-major host buffer.
+     *
+     * @param field Kokkos view (rank 1 or rank 2).
+     * @return Packed values.
+     */
+    template <class ViewType>
+    static std::vector<typename ViewType::non_const_value_type> Pack(
+        const ViewType& field) {
+        using T   = typename ViewType::non_const_value_type;
+        auto host = Kokkos::create_mirror_view_and_copy(Kokkos::HostSpace(),
+                                                        field);
+        const std::size_t n  = field.extent(0);
+        const std::size_t nc = ViewType::rank == 1 ? 1 : field.extent(1);
+        std::vector<T> packed(n * nc);
+        for (std::size_t i = 0; i < n; ++i) {
+            if constexpr (ViewType::rank == 1) {
+                packed[i] = host(i);
+            } else {
+                for (std::size_t c = 0; c < nc; ++c) {
+                    packed[i * nc + c] = host(i, c);
+                }
+            }
+        }
+        return packed;
+    }
+
+    /**
+     * @brief Copies a row-major host buffer into a Kokkos view.
+     *
+     * @param packed Packed values.
+     * @param field Kokkos view (rank 1 or rank 2).
+     */
+    template <class ViewType>
+    static void Unpack(
+        const std::vector<typename ViewType::non_const_value_type>& packed,
+        const ViewType& field) {
+        auto host            = Kokkos::create_mirror_view(field);
+        const std::size_t n  = field.extent(0);
+        const std::size_t nc = ViewType::rank == 1 ? 1 : field.extent(1);
+        for (std::size_t i = 0; i < n; ++i) {
+            if constexpr (ViewType::rank == 1) {
+                host(i) = packed[i];
+            } else {
+                for (std::size_t c = 0; c < nc; ++c) {
+                    host(i, c) = packed[i * nc + c];
+                }
+            }
+        }
+        Kokkos::deep_copy(field, host);
+    }
+};
+
+/**
+ * @class CheckpointWriter
+ * @brief Collective writer of a shared checkpoint file.
+ *
+ * Fields and records are staged on the host with `AddField`/`AddRecord`
+ * (the device data may change afterwards); `Write` then lays out the file
+ * and writes every region with one collective call per region.
+ */
+class CheckpointWriter {
+   public:
+    /**
+     * @brief Constructor for CheckpointWriter.
+     *
+     * @param comm MPI communicator.
+     * @param stripe_size Stripe size of the file system (alignment of the
+     * data regions, in bytes).
+     * @throws std::invalid_argument If `stripe_size` is zero.
+     */
+    explicit CheckpointWriter(MPI_Comm comm           = MPI_COMM_WORLD,
+                              std::size_t stripe_size = std::size_t(1) << 20)
+        : m_comm(comm), m_stripe_size(stripe_size) {
+        if (stripe_size == 0) {
+            throw std::invalid_argument(
+                "CheckpointWriter: stripe_size must be positive");
+        }
+        MPI_Comm_rank(m_comm, &m_rank);
+        MPI_Comm_size(m_comm, &m_size);
+    }
+
+    /**
+     * @brief Stages a per-particle field.
+     *
+     * All the fields must have the same number of local particles.
+     *
+     * @param name Field name (at most 63 characters).
+     * @param field Kokkos view (rank 1, or rank 2 N x components).
+     * @throws std::invalid_argument On name or size mismatches.
+     */
+    template <class ViewType>
+    void AddField(const std::string& name, const ViewType& field) {
+        using T = typename ViewType::non_const_value_type;
+        if (m_n_fields > 0 && m_n_local != field.extent(0)) {
+            throw std::invalid_argument(
+                "CheckpointWriter: field " + name +
+                " has a different number of particles");
+        }
+        CheckpointEntry entry = MakeEntry<T>(name);
+        entry.n_components    = ViewType::rank == 1 ? 1 : field.extent(1);
+        const auto packed     = CheckpointIO::Pack(field);
+        AddEntry(entry, packed.data(), packed.size() * sizeof(T));
+        m_n_local = field.extent(0);
+        ++m_n_fields;
+    }
+
+    /**
+     * @brief Stages every field of a particle container.
+     *
+     * @param particles Particle container providing `ForEachField`.
+     */
+    template <class Particles>
+    void AddParticles(const Particles& particles) {
+        particles.ForEachField([&](const std::string& name,
+                                   const auto& field) {
+            AddField(name, field);
+        });
+    }
+
+    /**
+     * @brief Stages a global record (written by rank 0).
+     *
+     * @param name Record name (at most 63 characters).
+     * @param values Record values (trivially copyable type).
+     */
+    template <typename T>
+    void AddRecord(const std::string& name, const std::vector<T>& values) {
+        static_assert(std::is_trivially_copyable_v<T>,
+                      "CheckpointWriter: records must be trivially copyable");
+        CheckpointEntry entry = MakeEntry<T>(name);
+        entry.n_rows          = values.size();
+        entry.is_record       = 1;
+        AddEntry(entry, values.data(), values.size() * sizeof(T));
+    }
+
+    /**
+     * @brief Writes the checkpoint file (collective).
+     *
+     * @param filename Path of the shared file.
+     * @throws std::runtime_error If the file cannot be written.
+     */
+    void Write(const std::string& filename) {
+        ProfilingRegion region("IO");
+        // Global particle offset of this rank
+        unsigned long n_local = m_n_local;
+        unsigned long first   = 0;
+        unsigned long n_total = 0;
+        MPI_Exscan(&n_local, &first, 1, MPI_UNSIGNED_LONG, MPI_SUM, m_comm);
+        if (m_rank == 0) first = 0;
+        MPI_Allreduce(&n_local, &n_total, 1, MPI_UNSIGNED_LONG, MPI_SUM,
+                      m_comm);
+
+        // Layout: header and table, then one stripe-aligned region per entry
+        CheckpointHeader header;
+        header.n_ranks     = m_size;
+        header.n_particles = n_total;
+        header.stripe_size = m_stripe_size;
+        header.n_entries   = m_entries.size();
+        std::uint64_t end  = sizeof(CheckpointHeader) +
+                            m_entries.size() * sizeof(CheckpointEntry);
+        for (auto& entry : m_entries) {
+            if (!entry.is_record) entry.n_rows = n_total;
+            entry.offset = CheckpointIO::Align(end, m_stripe_size);
+            end          = entry.offset + entry.n_rows * RowSize(entry);
+        }
+
+        MPI_Info info = CheckpointIO::Hints(m_stripe_size);
+        MPI_File file;
+        const int error =
+            MPI_File_open(m_comm, filename.c_str(),
+                          MPI_MODE_CREATE | MPI_MODE_WRONLY, info, &file);
+        MPI_Info_free(&info);
+        if (error != MPI_SUCCESS) {
+            throw std::runtime_error("CheckpointWriter: cannot open " +
+                                     filename);
+        }
+        MPI_File_set_size(file, end);
+
+        std::vector<char> table(sizeof(CheckpointHeader) +
+                                m_entries.size() * sizeof(CheckpointEntry));
+        std::memcpy(table.data(), &header, sizeof(CheckpointHeader));
+        if (!m_entries.empty()) {
+            std::memcpy(table.data() + sizeof(CheckpointHeader),
+                        m_entries.data(),
+                        m_entries.size() * sizeof(CheckpointEntry));
+        }
+        CheckpointIO::TransferAll(file, m_comm, 0, table.data(),
+                                  m_rank == 0 ? table.size() : 0, true);
+
+        for (std::size_t k = 0; k < m_entries.size(); ++k) {
+            const auto& entry = m_entries[k];
+            const bool local  = !entry.is_record || m_rank == 0;
+            const std::uint64_t offset =
+                entry.offset + (entry.is_record ? 0 : first * RowSize(entry));
+            CheckpointIO::TransferAll(file, m_comm, offset, m_data[k].data(),
+                                      local ? m_data[k].size() : 0, true);
+        }
+        MPI_File_close(&file);
+    }
+
+    /**
+     * @brief Returns the staged entries (offsets are set by `Write`).
+     *
+     * @return Entry table.
+     */
+    const std::vector<CheckpointEntry>& Entries() const { return m_entries; }
+
+   private:
+    /**
+     * @brief Creates an entry with a name and an element type.
+     *
+     * @param name Entry name.
+     * @return Entry.
+     * @throws std::invalid_argument If the name is too long or already used.
+     */
+    template <typename T>
+    CheckpointEntry MakeEntry(const std::string& name) const {
+        CheckpointEntry entry;
+        if (name.empty() || name.size() >= sizeof(entry.name)) {
+            throw std::invalid_argument("CheckpointWriter: invalid name " +
+                                        name);
+        }
+        for (const auto& other : m_entries) {
+            if (name == other.name) {
+                throw std::invalid_argument(
+                    "CheckpointWriter: duplicate entry " + name);
+            }
+        }
+        const std::string type = CheckpointIO::TypeName<T>();
+        std::memcpy(entry.name, name.data(), name.size());
+        std::memcpy(entry.type, type.data(), type.size());
+        entry.element_size = sizeof(T);
+        return entry;
+    }
+
+    /**
+     * @brief Appends an entry and a copy of its local data.
+     *
+     * @param entry Entry.
+     * @param data Local data.
+     * @param n_bytes Size of the local data.
+     */
+    void AddEntry(const CheckpointEntry& entry, const void* data,
+                  const std::size_t n_bytes) {
+        const auto* bytes = static_cast<const char*>(data);
+        m_entries.push_back(entry);
+        m_data.emplace_back(bytes, bytes + n_bytes);
+    }
+
+    /**
+     * @brief Returns the size of a row of an entry in bytes.
+     *
+     * @param entry Entry.
+     * @return Row size.
+     */
+    static std::uint64_t RowSize(const CheckpointEntry& entry) {
+        return entry.element_size * entry.n_components;
+    }
+
+    /**
+     * @brief MPI communicator.
+     */
+    MPI_Comm m_comm;
+    /**
+     * @brief Alignment of the data regions.
+     */
+    std::size_t m_stripe_size;
+    /**
+     * @brief MPI rank.
+     */
+    int m_rank = 0;
+    /**
+     * @brief Number of MPI ranks.
+     */
+    int m_size = 1;
+    /**
+     * @brief Number of local particles.
+     */
+    std::size_t m_n_local = 0;
+    /**
+     * @brief Number of staged fields.
+     */
+    int m_n_fields = 0;
+    /**
+     * @brief Staged entries.
+     */
+    std::vector<CheckpointEntry> m_entries;
+    /**
+     * @brief Local data of each entry.
+     */
+    std::vector<std::vector<char>> m_data;
+};
+
+/**
+ * @class CheckpointReader
+ * @brief Collective reader of a shared checkpoint file.
+ *
+ * Rank 0 reads the header and the table and broadcasts them. The global
+ * particles are split into contiguous, nearly equal ranges, one per rank of
+ * the reading communicator, whatever the number of ranks that wrote the
+ * file; particles can then be redistributed spatially (see
+ * `SFCPartition`).
+ */
+class CheckpointReader {
+   public:
+    /**
+     * @brief Constructor for CheckpointReader (collective).
+     *
+     * @param filename Path of the shared file.
+     * @param comm MPI communicator.
+     * @throws std::runtime_error If the file cannot be opened or is not a
+     * checkpoint.
+     */
+    explicit CheckpointReader(const std::string& filename,
+                              MPI_Comm comm = MPI_COMM_WORLD)
+        : m_comm(comm) {
+        MPI_Comm_rank(m_comm, &m_rank);
+        MPI_Comm_size(m_comm, &m_size);
+
+        const int error =
+            MPI_File_open(m_comm, filename.c_str(), MPI_MODE_RDONLY,
+                          MPI_INFO_NULL, &m_file);
+        if (error != MPI_SUCCESS) {
+            throw std::runtime_error("CheckpointReader: cannot open " +
+                                     filename);
+        }
+
+        int valid = 0;
+        if (m_rank == 0) {
+            MPI_File_read_at(m_file, 0, &m_header, sizeof(CheckpointHeader),
+                             MPI_BYTE, MPI_STATUS_IGNORE);
+            valid = std::memcmp(m_header.magic, CheckpointHeader().magic,
+                                sizeof(m_header.magic)) == 0;
+        }
+        MPI_Bcast(&valid, 1, MPI_INT, 0, m_comm);
+        if (!valid) {
+            MPI_File_close(&m_file);
+            throw std::runtime_error("CheckpointReader: " + filename +
+                                     " is not a checkpoint file");
+        }
+        MPI_Bcast(&m_header, sizeof(CheckpointHeader), MPI_BYTE, 0, m_comm);
+
+        m_entries.resize(m_header.n_entries);
+        const int table_bytes =
+            static_cast<int>(m_entries.size() * sizeof(CheckpointEntry));
+        if (m_rank == 0) {
+            MPI_File_read_at(m_file, sizeof(CheckpointHeader),
+                             m_entries.data(), table_bytes, MPI_BYTE,
+                             MPI_STATUS_IGNORE);
+        }
+        MPI_Bcast(m_entries.data(), table_bytes, MPI_BYTE, 0, m_comm);
+
+        const std::uint64_t n = m_header.n_particles;
+        m_first               = n * m_rank / m_size;
+        m_n_local             = n * (m_rank + 1) / m_size - m_first;
+    }
+
+    CheckpointReader(const CheckpointReader&)            = delete;
+    CheckpointReader& operator=(const CheckpointReader&) = delete;
+
+    /**
+     * @brief Destructor for CheckpointReader (collective, closes the file).
+     */
+    ~CheckpointReader() { MPI_File_close(&m_file); }
+
+    /**
+     * @brief Returns the global number of particles.
+     *
+     * @return Number of particles.
+     */
+    std::size_t NumParticles() const { return m_header.n_particles; }
+
+    /**
+     * @brief Returns the number of ranks that wrote the file.
+     *
+     * @return Number of writing ranks.
+     */
+    int NumRanksWritten() const { return static_cast<int>(m_header.n_ranks); }
+
+    /**
+     * @brief Returns the range of global particles read by this rank.
+     *
+     * @return First global particle and number of local particles.
+     */
+    std::pair<std::size_t, std::size_t> LocalRange() const {
+        return {m_first, m_n_local};
+    }
+
+    /**
+     * @brief Returns the entry table.
+     *
+     * @return Entries.
+     */
+    const std::vector<CheckpointEntry>& Entries() const { return m_entries; }
+
+    /**
+     * @brief Checks whether an entry exists.
+     *
+     * @param name Entry name.
+     * @return True if the entry exists.
+     */
+    bool Has(const std::string& name) const {
+        return std::any_of(
+            m_entries.begin(), m_entries.end(),
+            [&](const CheckpointEntry& entry) { return name == entry.name; });
+    }
+
+    /**
+     * @brief Reads the local range of a per-particle field (collective).
+     *
+     * @param name Field name.
+     * @param field Kokkos view with `LocalRange().second` rows.
+     */
+    template <class ViewType>
+    void ReadField(const std::string& name, const ViewType& field) {
+        ReadRows(name, field, m_first);
+    }
+
+    /**
+     * @brief Resizes a particle container to the local range and reads all
+     * of its fields stored in the file (collective).
+     *
+     * @param particles Particle container providing `Resize` and
+     * `ForEachField`.
+     */
+    template <class Particles>
+    void ReadParticles(Particles& particles) {
+        ProfilingRegion region("IO");
+        particles.Resize(m_n_local);
+        particles.ForEachField([&](const std::string& name,
+                                   const auto& field) {
+            if (Has(name)) ReadField(name, field);
+        });
+    }
+
+    /**
+     * @brief Reads consecutive rows of a per-particle field (collective).
+     *
+     * @param name Field name.
+     * @param field Kokkos view; its number of rows sets the range size.
+     * @param first First global row to read.
+     * @throws std::invalid_argument If the field does not exist, has another
+     * type or shape, or the range is out of bounds.
+     */
+    template <class ViewType>
+    void ReadRows(const std::string& name, const ViewType& field,
+                  const std::size_t first) {
+        using T                      = typename ViewType::non_const_value_type;
+        const CheckpointEntry& entry = Find<T>(name, false);
+
+        const std::size_t nc = ViewType::rank == 1 ? 1 : field.extent(1);
+        if (entry.n_components != nc ||
+            first + field.extent(0) > entry.n_rows) {
+            throw std::invalid_argument("CheckpointReader: field " + name +
+                                        " does not fit the destination view");
+        }
+        std::vector<T> packed(field.extent(0) * nc);
+        CheckpointIO::TransferAll(m_file, m_comm,
+                                  entry.offset + first * nc * sizeof(T),
+                                  packed.data(), packed.size() * sizeof(T),
+                                  false);
+        CheckpointIO::Unpack(packed, field);
+    }
+
+    /**
+     * @brief Reads a global record (rank 0 reads, then broadcasts).
+     *
+     * @param name Record name.
+     * @return Record values.
+     */
+    template <typename T>
+    std::vector<T> ReadRecord(const std::string& name) {
+        const CheckpointEntry& entry = Find<T>(name, true);
+        std::vector<T> values(entry.n_rows);
+        const int n_bytes = static_cast<int>(values.size() * sizeof(T));
+        if (m_rank == 0) {
+            MPI_File_read_at(m_file, entry.offset, values.data(), n_bytes,
+                             MPI_BYTE, MPI_STATUS_IGNORE);
+        }
+        MPI_Bcast(values.data(), n_bytes, MPI_BYTE, 0, m_comm);
+        return values;
+    }
+
+   private:
+    /**
+     * @brief Finds an entry and checks its kind and element type.
+     *
+     * @param name Entry name.
+     * @param is_record Expected kind.
+     * @return Entry.
+     * @throws std::invalid_argument If no entry matches.
+     */
+    template <typename T>
+    const CheckpointEntry& Find(const std::string& name,
+                                const bool is_record) const {
+        for (const auto& entry : m_entries) {
+            if (name != entry.name) continue;
+            if (entry.is_record != static_cast<std::uint64_t>(is_record) ||
+                CheckpointIO::TypeName<T>() != entry.type ||
+                entry.element_size != sizeof(T)) {
+                throw std::invalid_argument("CheckpointReader: entry " + name +
+                                            " has another kind or type");
+            }
+            return entry;
+        }
+        throw std::invalid_argument("CheckpointReader: no entry " + name);
+    }
+
+    /**
+     * @brief MPI communicator.
+     */
+    MPI_Comm m_comm;
+    /**
+     * @brief MPI rank.
+     */
+    int m_rank = 0;
+    /**
+     * @brief Number of MPI ranks.
+     */
+    int m_size = 1;
+    /**
+     * @brief MPI file handle.
+     */
+    MPI_File m_file;
+    /**
+     * @brief File header.
+     */
+    CheckpointHeader m_header;
+    /**
+     * @brief Entry table.
+     */
+    std::vector<CheckpointEntry> m_entries;
+    /**
+     * @brief First global particle read by this rank.
+     */
+    std::size_t m_first = 0;
+    /**
+     * @brief Number of local particles.
+     */
+    std::size_t m_n_local = 0;
+};
@@ -0,0 +1,273 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <exception>
+#include <fstream>
+#include <iterator>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+// mpi includes
+#include <mpi.h>
+
+#include "profiler.hpp"
+
+/**
+ * @file collective_read.hpp
+ * @brief Defines the CollectiveRead helpers for startup file reads.
+ *
+ * This file provides the `CollectiveRead` structure, which reads the input
+ * files of a run with as few file system clients as possible: small files
+ * replicated on every rank (input deck, `.pvtu` index) are read once and
+ * broadcast, and per-rank files (mesh pieces) are read by one MPI-IO client
+ * per node and forwarded to the other ranks of the node.
+ */
+
+/**
+ * @struct CollectiveRead
+ * @brief Collective whole-file reads.
+ *
+ * At thousands of ranks the startup time is dominated by the metadata
+ * servers of the parallel file system (one open per rank and file), not by
+ * the bandwidth. Every function is collective over its communicator and
+ * throws on every rank when a file is missing, so that no rank is left
+ * waiting in a later collective call.
+ */
+struct CollectiveRead {
+    /**
+     * @brief Reads a file on one rank and broadcasts its contents.
+     *
+     * @param filename Path of the file (only used on `root`).
+     * @param comm MPI communicator.
+     * @param root Reading rank.
+     * @return File contents, on every rank.
+     * @throws std::runtime_error If the file cannot be read.
+     */
+    static std::string Broadcast(const std::string& filename,
+                                 MPI_Comm comm = MPI_COMM_WORLD,
+                                 const int root = 0) {
+        ProfilingRegion region("IO");
+        int rank;
+        MPI_Comm_rank(comm, &rank);
+        std::string buffer;
+        long long size = -1;
+        if (rank == root) {
+            std::ifstream file(filename, std::ios::binary);
+            if (file) {
+                buffer.assign(std::istreambuf_iterator<char>(file),
+                              std::istreambuf_iterator<char>());
+                size = static_cast<long long>(buffer.size());
+            }
+        }
+        MPI_Bcast(&size, 1, MPI_LONG_LONG, root, comm);
+        if (size < 0) {
+            throw std::runtime_error("CollectiveRead: cannot open " +
+                                     filename);
+        }
+        buffer.resize(static_cast<std::size_t>(size));
+        for (std::size_t begin = 0; begin < buffer.size();
+             begin += max_transfer) {
+            const int count = static_cast<int>(
+                std::min(max_transfer, buffer.size() - begin));
+            MPI_Bcast(buffer.data() + begin, count, MPI_CHAR, root, comm);
+        }
+        return buffer;
+    }
+
+    /**
+     * @brief Reads per-rank files through one MPI-IO client per node.
+     *
+     * The ranks sharing a node (`MPI_COMM_TYPE_SHARED`) send their file
+     * names to the lowest rank of the node, which reads all of them with
+     * MPI-IO and sends the contents back.
+     *
+     * @param filenames Paths of the files of the calling rank (possibly
+     * none).
+     * @param comm MPI communicator.
+     * @return Contents of the files, in the order of `filenames`.
+     * @throws std::runtime_error On every rank if a file of any rank cannot
+     * be read.
+     */
+    static std::vector<std::string> NodeAggregated(
+        const std::vector<std::string>& filenames,
+        MPI_Comm comm = MPI_COMM_WORLD) {
+        ProfilingRegion region("IO");
+        int rank;
+        MPI_Comm_rank(comm, &rank);
+        MPI_Comm node;
+        MPI_Comm_split_type(comm, MPI_COMM_TYPE_SHARED, rank, MPI_INFO_NULL,
+                            &node);
+        int node_rank, node_size;
+        MPI_Comm_rank(node, &node_rank);
+        MPI_Comm_size(node, &node_size);
+
+        // File names of every rank of the node, one per line
+        std::string names;
+        for (const std::string& filename : filenames) names += filename + '\n';
+        int length = static_cast<int>(names.size());
+        std::vector<int> lengths(node_size), displacements(node_size, 0);
+        MPI_Gather(&length, 1, MPI_INT, lengths.data(), 1, MPI_INT, 0, node);
+        for (int r = 1; r < node_size; ++r) {
+            displacements[r] = displacements[r - 1] + lengths[r - 1];
+        }
+        std::string all(
+            node_rank == 0 ? displacements.back() + lengths.back() : 0, '\0');
+        MPI_Gatherv(names.data(), length, MPI_CHAR, all.data(),
+                    lengths.data(), displacements.data(), MPI_CHAR, 0, node);
+
+        std::vector<std::string> contents(filenames.size());
+        std::vector<long long> sizes(filenames.size(), -1);
+        if (node_rank == 0) {
+            for (int r = 0; r < node_size; ++r) {
+                std::istringstream stream(
+                    all.substr(displacements[r], lengths[r]));
+                std::vector<std::string> files;
+                std::vector<long long> file_sizes;
+                for (std::string name; std::getline(stream, name);) {
+                    files.emplace_back();
+                    file_sizes.push_back(
+                        ReadMPIIO(name, files.back())
+                            ? static_cast<long long>(files.back().size())
+                            : -1);
+                }
+                if (r == 0) {
+                    contents = std::move(files);
+                    sizes    = std::move(file_sizes);
+                    continue;
+                }
+                MPI_Send(file_sizes.data(),
+                         static_cast<int>(file_sizes.size()), MPI_LONG_LONG,
+                         r, 0, node);
+                for (std::string& file : files) SendBytes(file, r, node);
+            }
+        } else {
+            MPI_Recv(sizes.data(), static_cast<int>(sizes.size()),
+                     MPI_LONG_LONG, 0, 0, node, MPI_STATUS_IGNORE);
+            for (std::size_t k = 0; k < filenames.size(); ++k) {
+                contents[k].resize(std::max(sizes[k], 0LL));
+                RecvBytes(contents[k], node);
+            }
+        }
+        MPI_Comm_free(&node);
+
+        std::string missing;
+        for (std::size_t k = 0; k < filenames.size(); ++k) {
+            if (sizes[k] < 0 && missing.empty()) missing = filenames[k];
+        }
+        Checked(
+            [&] {
+                if (!missing.empty()) {
+                    throw std::runtime_error("CollectiveRead: cannot open " +
+                                             missing);
+                }
+            },
+            comm);
+        return contents;
+    }
+
+    /**
+     * @brief Runs a phase that may fail on some ranks only (collective).
+     *
+     * An exception thrown by `phase` on one rank is rethrown on every rank
+     * once all of them finished the phase, so that they leave together
+     * instead of waiting for each other in the next collective call.
+     *
+     * @param phase Callable run on every rank.
+     * @param comm MPI communicator.
+     * @throws std::runtime_error On every rank if `phase` threw on any rank
+     * (with its message on the ranks where it threw).
+     */
+    template <class Phase>
+    static void Checked(Phase&& phase, MPI_Comm comm = MPI_COMM_WORLD) {
+        std::string error;
+        int failed = 0;
+        try {
+            phase();
+        } catch (const std::exception& e) {
+            error  = e.what();
+            failed = 1;
+        }
+        int any_failed = 0;
+        MPI_Allreduce(&failed, &any_failed, 1, MPI_INT, MPI_MAX, comm);
+        if (failed) throw std::runtime_error(error);
+        if (any_failed) {
+            throw std::runtime_error(
+                "CollectiveRead: phase failed on another rank");
+        }
+    }
+
+   private:
+    /**
+     * @brief Largest number of bytes of a single MPI call.
+     */
+    static constexpr std::size_t max_transfer = std::size_t(1) << 30;
+
+    /**
+     * @brief Reads a whole file with independent MPI-IO.
+     *
+     * Building block of `NodeAggregated`.
+     *
+     * @param filename Path of the file.
+     * @param buffer File contents (output, empty on failure).
+     * @return True if the file was read.
+     */
+    static bool ReadMPIIO(const std::string& filename, std::string& buffer) {
+        MPI_File file;
+        if (MPI_File_open(MPI_COMM_SELF, filename.c_str(), MPI_MODE_RDONLY,
+                          MPI_INFO_NULL, &file) != MPI_SUCCESS) {
+            return false;
+        }
+        MPI_Offset size = 0;
+        MPI_File_get_size(file, &size);
+        buffer.assign(static_cast<std::size_t>(size), '\0');
+        bool valid = true;
+        for (std::size_t begin = 0; valid && begin < buffer.size();
+             begin += max_transfer) {
+            const int count = static_cast<int>(
+                std::min(max_transfer, buffer.size() - begin));
+            valid = MPI_File_read_at(file, static_cast<MPI_Offset>(begin),
+                                     buffer.data() + begin, count, MPI_BYTE,
+                                     MPI_STATUS_IGNORE) == MPI_SUCCESS;
+        }
+        MPI_File_close(&file);
+        if (!valid) buffer.clear();
+        return valid;
+    }
+
+    /**
+     * @brief Sends a buffer in transfers of at most `max_transfer` bytes.
+     *
+     * @param buffer Bytes to send.
+     * @param dest Destination rank.
+     * @param comm MPI communicator.
+     */
+    static void SendBytes(std::string& buffer, const int dest,
+                          MPI_Comm comm) {
+        for (std::size_t begin = 0; begin < buffer.size();
+             begin += max_transfer) {
+            const int count = static_cast<int>(
+                std::min(max_transfer, buffer.size() - begin));
+            MPI_Send(buffer.data() + begin, count, MPI_CHAR, dest, 1, comm);
+        }
+    }
+
+    /**
+     * @brief Receives a buffer sent by `SendBytes` (sized by the caller).
+     *
+     * @param buffer Destination bytes.
+     * @param comm MPI communicator (the source is rank 0).
+     */
+    static void RecvBytes(std::string& buffer, MPI_Comm comm) {
+        for (std::size_t begin = 0; begin < buffer.size();
+             begin += max_transfer) {
+            const int count = static_cast<int>(
+                std::min(max_transfer, buffer.size() - begin));
+            MPI_Recv(buffer.data() + begin, count, MPI_CHAR, 0, 1, comm,
+                     MPI_STATUS_IGNORE);
+        }
+    }
+};
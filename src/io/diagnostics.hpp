@@ -0,0 +1,379 @@
+#pragma once
+
+#include <cstddef>
+#include <fstream>
+#include <limits>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+// mpi includes
+#include <mpi.h>
+// Kokkos includes
+#include <Kokkos_Core.hpp>
+
+#include "profiler.hpp"
+
+/**
+ * @file diagnostics.hpp
+ * @brief Defines the Diagnostics class for in-situ global reductions.
+ *
+ * This file provides the `Diagnostics` class, which reduces the particle
+ * fields to a few global integrals and extrema on the device every few
+ * steps and appends them to a compact time series, so that parameter
+ * sweeps do not need full-field VTU dumps.
+ */
+
+/**
+ * @struct DiagnosticsGroup
+ * @brief Set of parts reduced together.
+ */
+struct DiagnosticsGroup {
+    std::string name;           ///< Column prefix.
+    std::vector<int> part_ids;  ///< Reduced parts (empty for every part).
+};
+
+/**
+ * @class Diagnostics
+ * @brief Time series of global reductions of the particle fields.
+ *
+ * The available quantities are
+ *
+ * - `mass`, `momentum_x`, `momentum_y`, `momentum_z`, `kinetic_energy`,
+ *   `internal_energy` and `total_energy` (sums over the particles);
+ * - `max_pressure`, `min_density` and `max_density`;
+ * - `shock_position`, the largest coordinate along the shock axis of the
+ *   particles whose pressure exceeds the shock pressure (a front moving
+ *   towards increasing coordinates into a lower pressure state).
+ *
+ * Every group is reduced by a single fused `parallel_reduce` computing all
+ * the quantities at once, so a sample reads each field once per group,
+ * followed by one `MPI_Allreduce` of the sums and one of the extrema. Rank
+ * 0 appends one line per sample with the step, the time and one column
+ * `<group>.<quantity>` per group and quantity. Extrema of groups without
+ * particles are NaN.
+ */
+class Diagnostics {
+   public:
+    /**
+     * @brief Constructor for Diagnostics (collective).
+     *
+     * Rank 0 creates the output file and writes its header.
+     *
+     * @param filename Path of the time series.
+     * @param cadence Number of steps between two samples.
+     * @param quantities Sampled quantities (empty for all of them).
+     * @param groups Reduced groups (empty for one group `all` of every
+     * part).
+     * @param shock_pressure Pressure threshold of `shock_position`.
+     * @param shock_axis Coordinate of `shock_position` (0, 1 or 2).
+     * @param comm MPI communicator.
+     * @throws std::invalid_argument On an unknown quantity, a cadence below
+     * 1, a shock axis out of range or a negative part id.
+     * @throws std::runtime_error On every rank if rank 0 cannot write the
+     * file.
+     */
+    Diagnostics(const std::string& filename, const int cadence,
+                const std::vector<std::string>& quantities = {},
+                const std::vector<DiagnosticsGroup>& groups = {},
+                const double shock_pressure = 0.0, const int shock_axis = 0,
+                MPI_Comm comm = MPI_COMM_WORLD)
+        : m_cadence(cadence),
+          m_shock_pressure(shock_pressure),
+          m_shock_axis(shock_axis),
+          m_comm(comm) {
+        if (cadence < 1 || shock_axis < 0 || shock_axis > 2) {
+            throw std::invalid_argument(
+                "Diagnostics: needs cadence >= 1 and shock_axis in [0, 2]");
+        }
+        const std::vector<std::string> names = QuantityNames();
+        for (const std::string& quantity :
+             quantities.empty() ? names : quantities) {
+            std::size_t q = 0;
+            while (q < names.size() && names[q] != quantity) ++q;
+            if (q == names.size()) {
+                throw std::invalid_argument(
+                    "Diagnostics: unknown quantity '" + quantity + "'");
+            }
+            m_quantities.push_back(static_cast<int>(q));
+        }
+        m_groups = groups.empty() ? std::vector<DiagnosticsGroup>{{"all", {}}}
+                                  : groups;
+        for (const DiagnosticsGroup& group : m_groups) {
+            m_members.push_back(Members(group));
+            for (const int q : m_quantities) {
+                m_columns.push_back(group.name + "." + names[q]);
+            }
+        }
+        m_values.assign(m_columns.size(),
+                        std::numeric_limits<double>::quiet_NaN());
+
+        // Rank 0 opens the file, every rank learns whether it could
+        MPI_Comm_rank(m_comm, &m_rank);
+        int opened = 1;
+        if (m_rank == 0) {
+            m_file.open(filename);
+            opened = m_file ? 1 : 0;
+        }
+        MPI_Bcast(&opened, 1, MPI_INT, 0, m_comm);
+        if (!opened) {
+            throw std::runtime_error("Diagnostics: cannot open " + filename);
+        }
+        if (m_rank != 0) return;
+        m_file.precision(17);
+        m_file << "# step time";
+        for (const std::string& column : m_columns) m_file << ' ' << column;
+        m_file << '\n';
+        m_file.flush();
+    }
+
+    /**
+     * @brief Returns the names of the available quantities.
+     *
+     * @return Quantity names, in column order.
+     */
+    static std::vector<std::string> QuantityNames() {
+        return {"mass", "momentum_x", "momentum_y", "momentum_z",
+                "kinetic_energy", "internal_energy", "total_energy",
+                "max_pressure", "min_density", "max_density",
+                "shock_position"};
+    }
+
+    /**
+     * @brief Checks whether a step is sampled.
+     *
+     * @param step Step index.
+     * @return True every `cadence` steps (including step 0).
+     */
+    bool Due(const long step) const { return step % m_cadence == 0; }
+
+    /**
+     * @brief Samples the particles if the step is due (collective).
+     *
+     * @param step Step index.
+     * @param time Simulation time.
+     * @param particles Particle storage (e.g. `ParticleData`) providing
+     * `X`, `V`, `Mass`, `Rho`, `Eint`, `P` and `PartId`; ghosts must have
+     * been removed.
+     * @return True if a sample was taken.
+     */
+    template <class Particles>
+    bool Sample(const long step, const double time,
+                const Particles& particles) {
+        if (!Due(step)) return false;
+        Reduce(particles);
+        if (m_rank == 0) {
+            m_file << step << ' ' << time;
+            for (const double value : m_values) m_file << ' ' << value;
+            m_file << '\n';
+            m_file.flush();
+        }
+        return true;
+    }
+
+    /**
+     * @brief Computes every column without writing them (collective).
+     *
+     * @param particles Particle storage, as for `Sample`.
+     * @return Values of the columns, identical on every rank.
+     */
+    template <class Particles>
+    const std::vector<double>& Reduce(const Particles& particles) {
+        ProfilingRegion region("Diagnostics");
+        const std::size_t n_groups = m_groups.size();
+        std::vector<double> sums(n_groups * n_sums);
+        std::vector<double> extrema(n_groups * n_extrema);
+        for (std::size_t g = 0; g < n_groups; ++g) {
+            ReduceGroup(particles, m_members[g], &sums[g * n_sums],
+                        &extrema[g * n_extrema]);
+        }
+        MPI_Allreduce(MPI_IN_PLACE, sums.data(), static_cast<int>(sums.size()),
+                      MPI_DOUBLE, MPI_SUM, m_comm);
+        MPI_Allreduce(MPI_IN_PLACE, extrema.data(),
+                      static_cast<int>(extrema.size()), MPI_DOUBLE, MPI_MAX,
+                      m_comm);
+
+        std::size_t c = 0;
+        for (std::size_t g = 0; g < n_groups; ++g) {
+            const double* sum = &sums[g * n_sums];
+            const double* ext = &extrema[g * n_extrema];
+            for (const int q : m_quantities) {
+                if (q < n_sums) {
+                    m_values[c++] = sum[q];
+                } else if (q == n_sums) {
+                    // total energy
+                    m_values[c++] = sum[4] + sum[5];
+                } else {
+                    // Extrema are reduced as maxima (the minimum negated)
+                    const int e    = q - n_sums - 1;
+                    const double v = ext[e];
+                    m_values[c++] =
+                        v == std::numeric_limits<double>::lowest()
+                            ? std::numeric_limits<double>::quiet_NaN()
+                            : (e == 1 ? -v : v);
+                }
+            }
+        }
+        return m_values;
+    }
+
+    /**
+     * @brief Returns the column names.
+     *
+     * @return One `<group>.<quantity>` name per column.
+     */
+    const std::vector<std::string>& Columns() const { return m_columns; }
+
+    /**
+     * @brief Returns the values of the last sample.
+     *
+     * @return Values of the columns (NaN before the first sample).
+     */
+    const std::vector<double>& Values() const { return m_values; }
+
+    /**
+     * @brief Returns the number of steps between two samples.
+     *
+     * @return Sampling cadence.
+     */
+    int Cadence() const { return m_cadence; }
+
+   private:
+    /**
+     * @brief Number of summed quantities (mass to internal energy).
+     */
+    static constexpr int n_sums = 6;
+    /**
+     * @brief Number of extrema (max pressure to shock position).
+     */
+    static constexpr int n_extrema = 4;
+
+    /**
+     * @brief Reduces the local particles of one group.
+     *
+     * Building block of `Reduce`.
+     *
+     * @param particles Particle storage.
+     * @param members Membership flag of every part id (empty for all).
+     * @param sum Local sums (output, `n_sums` values).
+     * @param ext Local extrema (output, `n_extrema` values).
+     */
+    template <class Particles>
+    void ReduceGroup(const Particles& particles,
+                     const Kokkos::View<int*>& members, double* sum,
+                     double* ext) const {
+        const auto x         = particles.X();
+        const auto v         = particles.V();
+        const auto mass      = particles.Mass();
+        const auto rho       = particles.Rho();
+        const auto eint      = particles.Eint();
+        const auto p         = particles.P();
+        const auto part_id   = particles.PartId();
+        const bool all       = members.extent(0) == 0;
+        const int n_members  = static_cast<int>(members.extent(0));
+        const double p_shock = m_shock_pressure;
+        const int axis       = m_shock_axis;
+        Kokkos::parallel_reduce(
+            "Diagnostics::Reduce", particles.Size(),
+            KOKKOS_LAMBDA(const int i, double& m, double& mvx, double& mvy,
+                          double& mvz, double& ek, double& ei, double& pmax,
+                          double& neg_rho_min, double& rho_max,
+                          double& shock) {
+                if (!all) {
+                    const int id = part_id(i);
+                    if (id < 0 || id >= n_members || members(id) == 0) return;
+                }
+                const double m_i = mass(i);
+                const double v2  = v(i, 0) * v(i, 0) + v(i, 1) * v(i, 1) +
+                                  v(i, 2) * v(i, 2);
+                m += m_i;
+                mvx += m_i * v(i, 0);
+                mvy += m_i * v(i, 1);
+                mvz += m_i * v(i, 2);
+                ek += 0.5 * m_i * v2;
+                ei += m_i * eint(i);
+                const double p_i = p(i);
+                pmax             = Kokkos::max(pmax, p_i);
+                neg_rho_min      = Kokkos::max(neg_rho_min, -rho(i));
+                rho_max          = Kokkos::max(rho_max, rho(i));
+                if (p_i > p_shock) shock = Kokkos::max(shock, x(i, axis));
+            },
+            Kokkos::Sum<double>(sum[0]), Kokkos::Sum<double>(sum[1]),
+            Kokkos::Sum<double>(sum[2]), Kokkos::Sum<double>(sum[3]),
+            Kokkos::Sum<double>(sum[4]), Kokkos::Sum<double>(sum[5]),
+            Kokkos::Max<double>(ext[0]), Kokkos::Max<double>(ext[1]),
+            Kokkos::Max<double>(ext[2]), Kokkos::Max<double>(ext[3]));
+    }
+
+    /**
+     * @brief Uploads the part membership flags of a group.
+     *
+     * Building block of the constructor.
+     *
+     * @param group Group.
+     * @return One flag per part id up to the largest one of the group
+     * (empty for every part).
+     * @throws std::invalid_argument On a negative part id.
+     */
+    static Kokkos::View<int*> Members(const DiagnosticsGroup& group) {
+        if (group.part_ids.empty()) return {};
+        int n = 0;
+        for (const int id : group.part_ids) {
+            if (id < 0) {
+                throw std::invalid_argument(
+                    "Diagnostics: part ids must be non-negative");
+            }
+            n = id + 1 > n ? id + 1 : n;
+        }
+        Kokkos::View<int*> members("diagnostics_members", n);
+        auto host = Kokkos::create_mirror_view(members);
+        for (const int id : group.part_ids) host(id) = 1;
+        Kokkos::deep_copy(members, host);
+        return members;
+    }
+
+    /**
+     * @brief Number of steps between two samples.
+     */
+    int m_cadence;
+    /**
+     * @brief Pressure threshold of the shock position.
+     */
+    double m_shock_pressure;
+    /**
+     * @brief Coordinate of the shock position.
+     */
+    int m_shock_axis;
+    /**
+     * @brief Indices of the sampled quantities in `QuantityNames`.
+     */
+    std::vector<int> m_quantities;
+    /**
+     * @brief Reduced groups.
+     */
+    std::vector<DiagnosticsGroup> m_groups;
+    /**
+     * @brief Part membership flags of every group (empty for all parts).
+     */
+    std::vector<Kokkos::View<int*>> m_members;
+    /**
+     * @brief Column names.
+     */
+    std::vector<std::string> m_columns;
+    /**
+     * @brief Values of the last sample.
+     */
+    std::vector<double> m_values;
+    /**
+     * @brief MPI communicator.
+     */
+    MPI_Comm m_comm;
+    /**
+     * @brief MPI rank.
+     */
+    int m_rank = 0;
+    /**
+     * @brief Time series (rank 0 only).
+     */
+    std::ofstream m_file;
+};
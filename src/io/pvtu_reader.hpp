@@ -0,0 +1,220 @@
+#pragma once
+
+#include <algorithm>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+// mpi includes
+#include <mpi.h>
+
+#include "collective_read.hpp"
+#include "vtk_common.hpp"
+#include "vtu_reader.hpp"
+
+/**
+ * @file pvtu_reader.hpp
+ * @brief Defines the PVTUReader class for reading parallel VTK unstructured
+ * grid files.
+ *
+ * This file provides the `PVTUReader` class, which reads the index of a
+ * `.pvtu` file and distributes its pieces over the MPI ranks. The pieces
+ * themselves are read with `VTUReader`.
+ */
+
+/**
+ * @class PVTUReader
+ * @brief Reader of the index of a parallel VTU file.
+ *
+ * Piece sources are resolved relative to the directory of the `.pvtu` file.
+ * With `P` ranks and `M` pieces, rank `r` reads the contiguous block of
+ * pieces [`r * M / P`, `(r + 1) * M / P`), so that every piece is read by
+ * exactly one rank. The collective overloads read the index on rank 0 only
+ * and the pieces through one MPI-IO client per node (`CollectiveRead`).
+ */
+class PVTUReader {
+   public:
+    /**
+     * @brief Constructor for PVTUReader.
+     *
+     * @param filename Path of the `.pvtu` file.
+     * @throws std::runtime_error If the file cannot be read or is not a
+     * parallel unstructured grid.
+     */
+    explicit PVTUReader(const std::string& filename) {
+        std::ifstream file(filename);
+        if (!file) {
+            throw std::runtime_error("PVTUReader: cannot open " + filename);
+        }
+        Parse(filename, std::string(std::istreambuf_iterator<char>(file),
+                                    std::istreambuf_iterator<char>()));
+    }
+
+    /**
+     * @brief Constructor for PVTUReader reading the index on rank 0 only
+     * (collective).
+     *
+     * @param filename Path of the `.pvtu` file.
+     * @param comm MPI communicator.
+     * @throws std::runtime_error If the file cannot be read or is not a
+     * parallel unstructured grid.
+     */
+    PVTUReader(const std::string& filename, MPI_Comm comm) {
+        Parse(filename, CollectiveRead::Broadcast(filename, comm));
+    }
+
+    /**
+     * @brief Returns the number of pieces.
+     *
+     * @return Number of pieces.
+     */
+    std::size_t NumPieces() const { return m_pieces.size(); }
+
+    /**
+     * @brief Returns the paths of all the pieces.
+     *
+     * @return Piece paths, in file order.
+     */
+    const std::vector<std::string>& Pieces() const { return m_pieces; }
+
+    /**
+     * @brief Returns the names of the point data arrays.
+     *
+     * @return Array names.
+     */
+    const std::vector<std::string>& PointDataNames() const {
+        return m_point_data;
+    }
+
+    /**
+     * @brief Returns the number of ghost layers written in the pieces.
+     *
+     * @return Ghost level.
+     */
+    int GhostLevel() const { return m_ghost_level; }
+
+    /**
+     * @brief Returns the paths of the pieces assigned to a rank.
+     *
+     * @param rank MPI rank.
+     * @param size Number of MPI ranks.
+     * @return Piece paths (possibly empty if there are more ranks than
+     * pieces).
+     */
+    std::vector<std::string> PiecesOfRank(const int rank,
+                                          const int size) const {
+        const std::size_t n     = m_pieces.size();
+        const std::size_t first = n * rank / size;
+        const std::size_t last  = n * (rank + 1) / size;
+        return std::vector<std::string>(m_pieces.begin() + first,
+                                        m_pieces.begin() + last);
+    }
+
+    /**
+     * @brief Opens the pieces assigned to a rank.
+     *
+     * @param rank MPI rank.
+     * @param size Number of MPI ranks.
+     * @return Readers of the pieces.
+     */
+    std::vector<VTUReader> Open(const int rank, const int size) const {
+        ProfilingRegion region("IO");
+        std::vector<VTUReader> readers;
+        for (const auto& piece : PiecesOfRank(rank, size)) {
+            readers.emplace_back(piece);
+        }
+        return readers;
+    }
+
+    /**
+     * @brief Opens the pieces of the calling rank (collective).
+     *
+     * The pieces of the ranks of a node are read by a single MPI-IO client
+     * and forwarded, so that the file system sees one client per node.
+     *
+     * @param comm MPI communicator.
+     * @return Readers of the pieces of the calling rank.
+     * @throws std::runtime_error If a piece cannot be read.
+     */
+    std::vector<VTUReader> Open(MPI_Comm comm) const {
+        int rank, size;
+        MPI_Comm_rank(comm, &rank);
+        MPI_Comm_size(comm, &size);
+        const std::vector<std::string> pieces = PiecesOfRank(rank, size);
+        std::vector<std::string> contents =
+            CollectiveRead::NodeAggregated(pieces, comm);
+        ProfilingRegion region("IO");
+        std::vector<VTUReader> readers;
+        for (std::size_t k = 0; k < pieces.size(); ++k) {
+            readers.emplace_back(pieces[k], std::move(contents[k]));
+        }
+        return readers;
+    }
+
+   private:
+    /**
+     * @brief Indexes the contents of a `.pvtu` file.
+     *
+     * Building block of the constructors.
+     *
+     * @param filename Path of the file (piece sources are relative to it).
+     * @param buffer File contents.
+     * @throws std::runtime_error If the file is not a parallel unstructured
+     * grid.
+     */
+    void Parse(const std::string& filename, const std::string& buffer) {
+        const std::filesystem::path folder =
+            std::filesystem::path(filename).parent_path();
+
+        bool is_pvtu       = false;
+        bool in_point_data = false;
+        std::size_t pos    = buffer.find('<');
+        while (pos != std::string::npos) {
+            if (buffer.compare(pos, 2, "<?") == 0 ||
+                buffer.compare(pos, 2, "<!") == 0) {
+                pos = buffer.find('<', buffer.find('>', pos));
+                continue;
+            }
+            const VTKTag tag = VTKTag::Parse(buffer, pos);
+            pos              = buffer.find('<', tag.end);
+            if (tag.closing) continue;
+
+            if (tag.name == "VTKFile") {
+                is_pvtu = tag.Get("type") == "PUnstructuredGrid";
+            } else if (tag.name == "PUnstructuredGrid") {
+                m_ghost_level = std::stoi(tag.Get("GhostLevel", "0"));
+            } else if (tag.name == "PDataArray" && in_point_data) {
+                m_point_data.push_back(tag.Get("Name"));
+            } else if (tag.name == "Piece") {
+                m_pieces.push_back((folder / tag.Get("Source")).string());
+            }
+            if (tag.name == "PPointData") in_point_data = !tag.self_closing;
+            if (tag.name == "PPoints" || tag.name == "PCellData" ||
+                tag.name == "PCells") {
+                in_point_data = false;
+            }
+        }
+        if (!is_pvtu) {
+            throw std::runtime_error("PVTUReader: " + filename +
+                                     " is not a PUnstructuredGrid");
+        }
+    }
+
+    /**
+     * @brief Paths of the pieces.
+     */
+    std::vector<std::string> m_pieces;
+    /**
+     * @brief Names of the point data arrays.
+     */
+    std::vector<std::string> m_point_data;
+    /**
+     * @brief Number of ghost layers.
+     */
+    int m_ghost_level = 0;
+};
@@ -2,6 +2,8 @@
 
 #include <pybind11/embed.h>  // For embedding Python
 #include <iostream>
+#include <stdexcept>
+#include <string>
 
 namespace py = pybind11;
 
@@ -21,6 +23,7 @@ void use_meshio(const std::string& input_file, const std::string& output_file) {
         std::cout << "Mesh successfully read from " << input_file
                   << " and written to " << output_file << std::endl;
     } catch (const pybind11::error_already_set& e) {
-        std::cerr << "Python error: " << e.what() << std::endl;
+        // Reported by the caller, which propagates it to every rank
+        throw std::runtime_error(std::string("meshio: ") + e.what());
     }
 }
\ No newline at end of file
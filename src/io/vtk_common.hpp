@@ -0,0 +1,289 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <map>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <vector>
+
+/**
+ * @file vtk_common.hpp
+ * @brief Helpers shared by the native VTK XML (VTU/PVTU) reader and writer.
+ *
+ * This file provides base64 encoding/decoding, a minimal parser for the XML
+ * tags of VTK files and the mapping between VTK data type names and C++
+ * types.
+ */
+
+/**
+ * @class VTKBase64
+ * @brief Base64 encoding and decoding of VTK binary payloads.
+ */
+class VTKBase64 {
+   public:
+    /**
+     * @brief Encodes bytes to base64.
+     *
+     * @param data Bytes to encode.
+     * @param size Number of bytes.
+     * @return Base64 text (with padding).
+     */
+    static std::string Encode(const void* data, const std::size_t size) {
+        static constexpr char table[] =
+            "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+        const auto* bytes = static_cast<const std::uint8_t*>(data);
+        std::string out;
+        out.reserve(EncodedSize(size));
+        std::size_t i = 0;
+        for (; i + 2 < size; i += 3) {
+            const std::uint32_t v = (bytes[i] << 16) | (bytes[i + 1] << 8) |
+                                    bytes[i + 2];
+            out.push_back(table[(v >> 18) & 0x3f]);
+            out.push_back(table[(v >> 12) & 0x3f]);
+            out.push_back(table[(v >> 6) & 0x3f]);
+            out.push_back(table[v & 0x3f]);
+        }
+        if (i < size) {
+            std::uint32_t v = bytes[i] << 16;
+            if (i + 1 < size) v |= bytes[i + 1] << 8;
+            out.push_back(table[(v >> 18) & 0x3f]);
+            out.push_back(table[(v >> 12) & 0x3f]);
+            out.push_back(i + 1 < size ? table[(v >> 6) & 0x3f] : '=');
+            out.push_back('=');
+        }
+        return out;
+    }
+
+    /**
+     * @brief Decodes base64 text, ignoring whitespace.
+     *
+     * @param text Base64 text.
+     * @return Decoded bytes.
+     * @throws std::runtime_error On invalid characters.
+     */
+    static std::vector<std::uint8_t> Decode(std::string_view text) {
+        std::vector<std::uint8_t> out;
+        out.reserve(text.size() / 4 * 3);
+        std::uint32_t acc = 0;
+        int n_bits        = 0;
+        for (const char c : text) {
+            if (c == '=') break;
+            if (c == ' ' || c == '\n' || c == '\r' || c == '\t') continue;
+            const int v = Value(c);
+            if (v < 0) {
+                throw std::runtime_error("VTKBase64: invalid character '" +
+                                         std::string(1, c) + "'");
+            }
+            acc = (acc << 6) | static_cast<std::uint32_t>(v);
+            n_bits += 6;
+            if (n_bits >= 8) {
+                n_bits -= 8;
+                out.push_back(
+                    static_cast<std::uint8_t>((acc >> n_bits) & 0xff));
+            }
+        }
+        return out;
+    }
+
+    /**
+     * @brief Returns the length of the base64 encoding of `size` bytes.
+     *
+     * @param size Number of bytes.
+     * @return Number of base64 characters (with padding).
+     */
+    static constexpr std::size_t EncodedSize(const std::size_t size) {
+        return (size + 2) / 3 * 4;
+    }
+
+   private:
+    /**
+     * @brief Returns the 6-bit value of a base64 character (-1 if invalid).
+     *
+     * @param c Base64 character.
+     * @return 6-bit value.
+     */
+    static int Value(const char c) {
+        if (c >= 'A' && c <= 'Z') return c - 'A';
+        if (c >= 'a' && c <= 'z') return c - 'a' + 26;
+        if (c >= '0' && c <= '9') return c - '0' + 52;
+        if (c == '+') return 62;
+        if (c == '/') return 63;
+        return -1;
+    }
+};
+
+/**
+ * @struct VTKTag
+ * @brief XML tag of a VTK file (name and attributes).
+ */
+struct VTKTag {
+    /**
+     * @brief Tag name (without the leading '/' of closing tags).
+     */
+    std::string name;
+    /**
+     * @brief Tag attributes.
+     */
+    std::map<std::string, std::string> attributes;
+    /**
+     * @brief True for closing tags (`</Name>`).
+     */
+    bool closing = false;
+    /**
+     * @brief True for self-closing tags (`<Name ... />`).
+     */
+    bool self_closing = false;
+    /**
+     * @brief Position of the opening '<' in the buffer.
+     */
+    std::size_t begin = 0;
+    /**
+     * @brief Position just after the closing '>' in the buffer.
+     */
+    std::size_t end = 0;
+
+    /**
+     * @brief Returns an attribute value, or a default if absent.
+     *
+     * @param key Attribute name.
+     * @param fallback Default value.
+     * @return Attribute value.
+     */
+    std::string Get(const std::string& key,
+                    const std::string& fallback = "") const {
+        const auto it = attributes.find(key);
+        return it == attributes.end() ? fallback : it->second;
+    }
+
+    /**
+     * @brief Parses the tag starting at `pos` (which must point to '<').
+     *
+     * @param buffer XML text.
+     * @param pos Position of '<'.
+     * @return Parsed tag.
+     * @throws std::runtime_error If the tag is not terminated.
+     */
+    static VTKTag Parse(std::string_view buffer, const std::size_t pos) {
+        VTKTag tag;
+        tag.begin               = pos;
+        const std::size_t close = buffer.find('>', pos);
+        if (close == std::string_view::npos) {
+            throw std::runtime_error("VTKTag: unterminated XML tag");
+        }
+        tag.end = close + 1;
+
+        std::size_t i = pos + 1;
+        if (i < close && buffer[i] == '/') {
+            tag.closing = true;
+            ++i;
+        }
+        tag.self_closing = buffer[close - 1] == '/';
+        const std::size_t name_end = buffer.find_first_of(" \t\r\n/>", i);
+        tag.name = std::string(buffer.substr(i, name_end - i));
+
+        i = name_end;
+        while (i < close) {
+            const std::size_t eq = buffer.find('=', i);
+            if (eq == std::string_view::npos || eq > close) break;
+            const std::size_t key_begin =
+                buffer.find_first_not_of(" \t\r\n", i);
+            std::size_t key_end = eq;
+            while (key_end > key_begin &&
+                   (buffer[key_end - 1] == ' ' || buffer[key_end - 1] == '\t'))
+                --key_end;
+            const std::size_t quote = buffer.find_first_of("\"'", eq);
+            const std::size_t value_end =
+                buffer.find(buffer[quote], quote + 1);
+            tag.attributes[std::string(
+                buffer.substr(key_begin, key_end - key_begin))] =
+                std::string(buffer.substr(quote + 1, value_end - quote - 1));
+            i = value_end + 1;
+        }
+        return tag;
+    }
+};
+
+/**
+ * @class VTKType
+ * @brief Mapping between VTK data type names and C++ types.
+ */
+class VTKType {
+   public:
+    /**
+     * @brief Returns the size in bytes of a VTK data type.
+     *
+     * @param type VTK data type name (e.g. "Float64").
+     * @return Size in bytes.
+     * @throws std::runtime_error On unknown types.
+     */
+    static std::size_t Size(const std::string& type) {
+        if (type == "Int8" || type == "UInt8") return 1;
+        if (type == "Int16" || type == "UInt16") return 2;
+        if (type == "Int32" || type == "UInt32" || type == "Float32")
+            return 4;
+        if (type == "Int64" || type == "UInt64" || type == "Float64")
+            return 8;
+        throw std::runtime_error("VTKType: unsupported data type " + type);
+    }
+
+    /**
+     * @brief Calls `f` with a value-initialized element of the C++ type
+     * matching a VTK data type.
+     *
+     * This dispatches the data type once per array instead of once per
+     * element: `f` is typically a generic lambda taking `auto tag` and using
+     * `decltype(tag)`.
+     *
+     * @param type VTK data type name.
+     * @param f Callable invoked with the C++ type tag.
+     * @throws std::runtime_error On unknown types.
+     */
+    template <class F>
+    static void Visit(const std::string& type, F&& f) {
+        if (type == "Float64") return f(double{});
+        if (type == "Float32") return f(float{});
+        if (type == "Int64") return f(std::int64_t{});
+        if (type == "UInt64") return f(std::uint64_t{});
+        if (type == "Int32") return f(std::int32_t{});
+        if (type == "UInt32") return f(std::uint32_t{});
+        if (type == "Int16") return f(std::int16_t{});
+        if (type == "UInt16") return f(std::uint16_t{});
+        if (type == "Int8") return f(std::int8_t{});
+        if (type == "UInt8") return f(std::uint8_t{});
+        throw std::runtime_error("VTKType: unsupported data type " + type);
+    }
+
+    /**
+     * @brief Loads an (unaligned, native endian) element of type `S`.
+     *
+     * @param bytes Pointer to the element.
+     * @return Loaded value.
+     */
+    template <typename S>
+    static S Load(const std::uint8_t* bytes) {
+        S value;
+        std::memcpy(&value, bytes, sizeof(S));
+        return value;
+    }
+
+    /**
+     * @brief Returns the VTK data type name of a C++ type.
+     *
+     * @return VTK data type name.
+     */
+    template <typename T>
+    static std::string Name() {
+        using U = std::remove_cv_t<T>;
+        if constexpr (std::is_same_v<U, double>) return "Float64";
+        if constexpr (std::is_same_v<U, float>) return "Float32";
+        if constexpr (std::is_integral_v<U>) {
+            return std::string(std::is_signed_v<U> ? "Int" : "UInt") +
+                   std::to_string(8 * sizeof(U));
+        }
+        throw std::runtime_error("VTKType: unsupported C++ type");
+    }
+};
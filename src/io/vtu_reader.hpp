@@ -0,0 +1,638 @@
+#pragma once
+
+#include <algorithm>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+// Kokkos includes
+#include <Kokkos_Core.hpp>
+
+#include "host_pinned_space.hpp"
+#include "profiler.hpp"
+#include "vtk_common.hpp"
+
+/**
+ * @file vtu_reader.hpp
+ * @brief Defines the VTUReader class for reading VTK unstructured grid files.
+ *
+ * This file provides the `VTUReader` class, a native reader for the point
+ * data of VTK XML unstructured grid (`.vtu`) files. It supports the `ascii`,
+ * inline `binary` (base64) and `appended` (raw or base64) formats with UInt32
+ * or UInt64 headers. Compressed files are not supported.
+ */
+
+/**
+ * @struct VTUArray
+ * @brief Description of a `DataArray` of a VTU file.
+ */
+struct VTUArray {
+    /**
+     * @brief Array name.
+     */
+    std::string name;
+    /**
+     * @brief VTK data type name (e.g. "Float64").
+     */
+    std::string type;
+    /**
+     * @brief Storage format ("ascii", "binary" or "appended").
+     */
+    std::string format;
+    /**
+     * @brief Number of components per point.
+     */
+    int n_components = 1;
+    /**
+     * @brief Offset of the data in the appended section.
+     */
+    std::size_t offset = 0;
+    /**
+     * @brief First character of the inline data in the file buffer.
+     */
+    std::size_t begin = 0;
+    /**
+     * @brief Past-the-end character of the inline data in the file buffer.
+     */
+    std::size_t end = 0;
+};
+
+/**
+ * @class VTUReader
+ * @brief Native reader of the points and point data of a VTU piece.
+ *
+ * The whole file is read at construction and its XML structure is indexed;
+ * arrays are decoded on request. Decoding writes directly into host views,
+ * typically host-pinned staging buffers, which are then deep-copied to the
+ * device: `Read`, `Concatenate` and the `ReadPoints`/`ReadPointData`
+ * overloads do both steps. The static overloads concatenate several pieces
+ * (e.g. the pieces of a `.pvtu` file assigned to one MPI rank).
+ */
+class VTUReader {
+   public:
+    /**
+     * @brief Constructor for VTUReader.
+     *
+     * @param filename Path of the `.vtu` file.
+     * @throws std::runtime_error If the file cannot be read, is not an
+     * uncompressed unstructured grid or has no `Points` array.
+     */
+    explicit VTUReader(const std::string& filename) : m_filename(filename) {
+        std::ifstream file(filename, std::ios::binary);
+        if (!file) {
+            throw std::runtime_error("VTUReader: cannot open " + filename);
+        }
+        m_buffer.assign(std::istreambuf_iterator<char>(file),
+                        std::istreambuf_iterator<char>());
+        Parse();
+    }
+
+    /**
+     * @brief Constructor for VTUReader from the contents of a file.
+     *
+     * @param filename Path of the `.vtu` file (only used in messages).
+     * @param buffer File contents (e.g. read by `CollectiveRead`).
+     * @throws std::runtime_error If the contents are not an uncompressed
+     * unstructured grid or have no `Points` array.
+     */
+    VTUReader(const std::string& filename, std::string buffer)
+        : m_filename(filename), m_buffer(std::move(buffer)) {
+        Parse();
+    }
+
+    /**
+     * @brief Returns the path of the file.
+     *
+     * @return File path.
+     */
+    const std::string& FileName() const { return m_filename; }
+
+    /**
+     * @brief Returns the number of points of the piece.
+     *
+     * @return Number of points.
+     */
+    std::size_t NumPoints() const { return m_n_points; }
+
+    /**
+     * @brief Returns the names of the point data arrays.
+     *
+     * @return Array names, in file order.
+     */
+    std::vector<std::string> PointDataNames() const {
+        std::vector<std::string> names;
+        for (const auto& array : m_point_data) names.push_back(array.name);
+        return names;
+    }
+
+    /**
+     * @brief Checks whether a point data array exists.
+     *
+     * @param name Array name.
+     * @return True if the array exists.
+     */
+    bool HasPointData(const std::string& name) const {
+        for (const auto& array : m_point_data) {
+            if (array.name == name) return true;
+        }
+        return false;
+    }
+
+    /**
+     * @brief Returns the description of an array.
+     *
+     * @param name Point data array name, or "Points" for the coordinates.
+     * @return Array description.
+     * @throws std::invalid_argument If the array does not exist.
+     */
+    const VTUArray& Array(const std::string& name) const {
+        for (const auto& array : m_point_data) {
+            if (array.name == name) return array;
+        }
+        if (name == "Points") return m_points;
+        throw std::invalid_argument("VTUReader: no point data array " + name +
+                                    " in " + m_filename);
+    }
+
+    /**
+     * @brief Decodes an array into a host view.
+     *
+     * Values are converted to the value type of `dst`. Point `i` of the
+     * piece is written to row `offset + i` of `dst`.
+     *
+     * @param name Point data array name, or "Points" for the coordinates.
+     * @param dst Host-accessible Kokkos view (rank 1 for scalar arrays, rank 2
+     * with `n_components` columns otherwise).
+     * @param offset First row of `dst` to write to.
+     * @throws std::invalid_argument If `dst` does not fit the array.
+     */
+    template <class HostView>
+    void ReadInto(const std::string& name, const HostView& dst,
+                  const std::size_t offset = 0) const {
+        using T               = typename HostView::non_const_value_type;
+        const VTUArray& array = Array(name);
+        const std::size_t n   = m_n_points;
+        const int nc          = array.n_components;
+        const bool fits_rank  = HostView::rank == 1
+                                     ? nc == 1
+                                     : static_cast<int>(dst.extent(1)) == nc;
+        if (!fits_rank || dst.extent(0) < offset + n) {
+            throw std::invalid_argument("VTUReader: destination view of " +
+                                        name + " has the wrong shape");
+        }
+
+        const auto store = [&](const std::size_t i, const int c, const T v) {
+            if constexpr (HostView::rank == 1) {
+                dst(offset + i) = v;
+            } else {
+                dst(offset + i, c) = v;
+            }
+        };
+
+        if (array.format == "ascii") {
+            const char* text = m_buffer.data() + array.begin;
+            char* next       = nullptr;
+            for (std::size_t i = 0; i < n; ++i) {
+                for (int c = 0; c < nc; ++c) {
+                    store(i, c, static_cast<T>(std::strtod(text, &next)));
+                    if (next == text) {
+                        throw std::runtime_error(
+                            "VTUReader: truncated ascii array " + name);
+                    }
+                    text = next;
+                }
+            }
+            return;
+        }
+
+        std::vector<std::uint8_t> storage;
+        const std::uint8_t* data = Payload(array, storage);
+        const std::size_t size   = VTKType::Size(array.type);
+        VTKType::Visit(array.type, [&](auto tag) {
+            using S = decltype(tag);
+            Kokkos::parallel_for(
+                "VTUReader::ReadInto",
+                Kokkos::RangePolicy<Kokkos::DefaultHostExecutionSpace>(0, n),
+                [&](const std::size_t i) {
+                    for (int c = 0; c < nc; ++c) {
+                        const std::uint8_t* bytes = data + (i * nc + c) * size;
+                        store(i, c, static_cast<T>(VTKType::Load<S>(bytes)));
+                    }
+                });
+        });
+    }
+
+    /**
+     * @brief Reads an array into a device view.
+     *
+     * The array is decoded into a host-pinned staging view, which is then
+     * deep-copied to `dst`.
+     *
+     * @param name Point data array name, or "Points" for the coordinates.
+     * @param dst Kokkos view with `NumPoints()` rows.
+     */
+    template <class ViewType>
+    void Read(const std::string& name, const ViewType& dst) const {
+        ProfilingRegion region("IO");
+        auto staging = Staging(dst);
+        ReadInto(name, staging);
+        Upload(staging, dst);
+    }
+
+    /**
+     * @brief Reads the point coordinates.
+     *
+     * @return Device view of coordinates (N x 3).
+     */
+    Kokkos::View<double* [3]> ReadPoints() const {
+        Kokkos::View<double* [3]> x(
+            Kokkos::view_alloc(Kokkos::WithoutInitializing, "x"), m_n_points);
+        Read("Points", x);
+        return x;
+    }
+
+    /**
+     * @brief Reads a scalar point data array.
+     *
+     * @param name Array name.
+     * @return Device view of values (size N).
+     */
+    template <typename T = double>
+    Kokkos::View<T*> ReadPointData(const std::string& name) const {
+        Kokkos::View<T*> values(
+            Kokkos::view_alloc(Kokkos::WithoutInitializing, name), m_n_points);
+        Read(name, values);
+        return values;
+    }
+
+    /**
+     * @brief Reads and concatenates the point coordinates of several pieces.
+     *
+     * @param pieces Readers of the pieces, in concatenation order.
+     * @return Device view of coordinates (sum of the N x 3).
+     */
+    static Kokkos::View<double* [3]> ReadPoints(
+        const std::vector<VTUReader>& pieces) {
+        Kokkos::View<double* [3]> x(
+            Kokkos::view_alloc(Kokkos::WithoutInitializing, "x"),
+            TotalPoints(pieces));
+        Concatenate(pieces, "Points", x);
+        return x;
+    }
+
+    /**
+     * @brief Reads and concatenates a scalar point data array of several
+     * pieces.
+     *
+     * @param pieces Readers of the pieces, in concatenation order.
+     * @param name Array name.
+     * @return Device view of values (sum of the N).
+     */
+    template <typename T = double>
+    static Kokkos::View<T*> ReadPointData(const std::vector<VTUReader>& pieces,
+                                          const std::string& name) {
+        Kokkos::View<T*> values(
+            Kokkos::view_alloc(Kokkos::WithoutInitializing, name),
+            TotalPoints(pieces));
+        Concatenate(pieces, name, values);
+        return values;
+    }
+
+    /**
+     * @brief Decodes an array of several pieces into a device view.
+     *
+     * All pieces are decoded into a single host-pinned staging buffer so that
+     * only one host-device copy is made.
+     *
+     * @param pieces Readers of the pieces, in concatenation order.
+     * @param name Point data array name, or "Points" for the coordinates.
+     * @param dst Kokkos view with `TotalPoints(pieces)` rows.
+     */
+    template <class ViewType>
+    static void Concatenate(const std::vector<VTUReader>& pieces,
+                            const std::string& name, const ViewType& dst) {
+        ProfilingRegion region("IO");
+        auto staging       = Staging(dst);
+        std::size_t offset = 0;
+        for (const auto& piece : pieces) {
+            piece.ReadInto(name, staging, offset);
+            offset += piece.NumPoints();
+        }
+        Upload(staging, dst);
+    }
+
+    /**
+     * @brief Returns the total number of points of several pieces.
+     *
+     * @param pieces Readers of the pieces.
+     * @return Sum of the number of points.
+     */
+    static std::size_t TotalPoints(const std::vector<VTUReader>& pieces) {
+        std::size_t n = 0;
+        for (const auto& piece : pieces) n += piece.NumPoints();
+        return n;
+    }
+
+   private:
+    /**
+     * @brief Allocates the host-pinned staging view of a destination view.
+     *
+     * @param dst Destination Kokkos view.
+     * @return Row-major staging view of the same shape.
+     */
+    template <class ViewType>
+    static HostPinnedStaging<ViewType> Staging(const ViewType& dst) {
+        const auto alloc =
+            Kokkos::view_alloc(Kokkos::WithoutInitializing, "vtu_staging");
+        if constexpr (ViewType::rank == 1) {
+            return HostPinnedStaging<ViewType>(alloc, dst.extent(0));
+        } else {
+            return HostPinnedStaging<ViewType>(alloc, dst.extent(0),
+                                               dst.extent(1));
+        }
+    }
+
+    /**
+     * @brief Copies a staging view to its destination view.
+     *
+     * Destinations that are not row-major are repacked on the device.
+     *
+     * @param staging Host-pinned staging view.
+     * @param dst Destination Kokkos view.
+     */
+    template <class StagingType, class ViewType>
+    static void Upload(const StagingType& staging, const ViewType& dst) {
+        if constexpr (is_staging_compatible_v<ViewType>) {
+            Kokkos::deep_copy(dst, staging);
+        } else {
+            auto packed = Kokkos::create_mirror_view_and_copy(
+                typename ViewType::memory_space(), staging);
+            Kokkos::deep_copy(dst, packed);
+        }
+    }
+
+    /**
+     * @brief Indexes the XML structure of the file.
+     *
+     * @throws std::runtime_error On unsupported or malformed files.
+     */
+    void Parse() {
+        const std::string_view buffer(m_buffer);
+
+        // Binary appended data may contain '<': only scan the XML before it
+        std::size_t xml_end = buffer.find("<AppendedData");
+        if (xml_end != std::string_view::npos) {
+            const VTKTag appended = VTKTag::Parse(buffer, xml_end);
+            m_appended_base64 = appended.Get("encoding", "raw") == "base64";
+            m_appended        = buffer.find('_', appended.end);
+            if (m_appended == std::string_view::npos) {
+                throw std::runtime_error("VTUReader: no '_' marker in " +
+                                         m_filename);
+            }
+            ++m_appended;
+        } else {
+            xml_end = buffer.size();
+        }
+
+        std::string section;
+        bool in_piece   = false;
+        bool has_points = false;
+        std::size_t pos = buffer.find('<');
+        while (pos < xml_end) {
+            if (buffer.compare(pos, 2, "<?") == 0 ||
+                buffer.compare(pos, 2, "<!") == 0) {
+                pos = buffer.find('<', buffer.find('>', pos));
+                continue;
+            }
+            const VTKTag tag = VTKTag::Parse(buffer, pos);
+            pos              = buffer.find('<', tag.end);
+
+            if (tag.name == "VTKFile" && !tag.closing) {
+                ParseHeader(tag);
+            } else if (tag.name == "Piece") {
+                // Only the first piece of the file is read
+                if (tag.closing) break;
+                in_piece   = true;
+                m_n_points = std::stoull(tag.Get("NumberOfPoints", "0"));
+            } else if (tag.name == "PointData" || tag.name == "Points" ||
+                       tag.name == "CellData" || tag.name == "Cells") {
+                section = tag.closing || tag.self_closing ? "" : tag.name;
+            } else if (tag.name == "DataArray" && !tag.closing && in_piece) {
+                VTUArray array;
+                array.name         = tag.Get("Name");
+                array.type         = tag.Get("type");
+                array.format       = tag.Get("format", "ascii");
+                array.n_components = std::stoi(tag.Get("NumberOfComponents",
+                                                       "1"));
+                array.offset       = std::stoull(tag.Get("offset", "0"));
+                array.begin        = tag.end;
+                array.end          = tag.self_closing ? tag.end : pos;
+                if (section == "PointData") {
+                    m_point_data.push_back(array);
+                } else if (section == "Points") {
+                    m_points   = array;
+                    has_points = true;
+                }
+            }
+        }
+        if (!has_points) {
+            throw std::runtime_error("VTUReader: no Points array in " +
+                                     m_filename);
+        }
+    }
+
+    /**
+     * @brief Checks the `VTKFile` tag and reads the header and byte order.
+     *
+     * @param tag `VTKFile` tag.
+     * @throws std::runtime_error On unsupported files.
+     */
+    void ParseHeader(const VTKTag& tag) {
+        if (tag.Get("type") != "UnstructuredGrid") {
+            throw std::runtime_error("VTUReader: " + m_filename +
+                                     " is not an UnstructuredGrid");
+        }
+        if (!tag.Get("compressor").empty()) {
+            throw std::runtime_error("VTUReader: compressed file " +
+                                     m_filename + " is not supported");
+        }
+        const std::string header_type = tag.Get("header_type", "UInt32");
+        if (header_type != "UInt32" && header_type != "UInt64") {
+            throw std::runtime_error("VTUReader: unsupported header_type " +
+                                     header_type);
+        }
+        m_header_size  = VTKType::Size(header_type);
+        const bool big = tag.Get("byte_order") == "BigEndian";
+        m_swap         = big != (std::endian::native == std::endian::big);
+    }
+
+    /**
+     * @brief Returns the raw bytes of a binary or appended array.
+     *
+     * Raw appended data is returned in place; base64 and byte-swapped data
+     * are decoded into `storage`.
+     *
+     * @param array Array description.
+     * @param storage Decoding buffer.
+     * @return Pointer to the (native endian) array bytes.
+     * @throws std::runtime_error If the data is truncated.
+     */
+    const std::uint8_t* Payload(const VTUArray& array,
+                                std::vector<std::uint8_t>& storage) const {
+        const std::size_t expected =
+            m_n_points * array.n_components * VTKType::Size(array.type);
+        const std::uint8_t* data = nullptr;
+        std::size_t n_bytes      = 0;
+
+        if (array.format == "appended" && !m_appended_base64) {
+            const std::size_t begin = m_appended + array.offset;
+            if (begin + m_header_size > m_buffer.size()) {
+                throw std::runtime_error("VTUReader: truncated array " +
+                                         array.name);
+            }
+            const auto* bytes =
+                reinterpret_cast<const std::uint8_t*>(m_buffer.data());
+            n_bytes = Header(bytes + begin);
+            data    = bytes + begin + m_header_size;
+            if (begin + m_header_size + n_bytes > m_buffer.size()) {
+                throw std::runtime_error("VTUReader: truncated array " +
+                                         array.name);
+            }
+        } else {
+            std::string_view text =
+                array.format == "appended"
+                    ? std::string_view(m_buffer).substr(m_appended +
+                                                        array.offset)
+                    : std::string_view(m_buffer).substr(
+                          array.begin, array.end - array.begin);
+            text.remove_prefix(std::min(text.find_first_not_of(" \t\r\n"),
+                                        text.size()));
+            DecodeBase64(text, storage);
+            n_bytes = storage.size();
+            data    = storage.data();
+        }
+
+        if (n_bytes < expected) {
+            throw std::runtime_error("VTUReader: array " + array.name +
+                                     " has fewer bytes than expected");
+        }
+        if (m_swap) {
+            if (data != storage.data()) storage.assign(data, data + expected);
+            SwapBytes(storage.data(), expected, VTKType::Size(array.type));
+            data = storage.data();
+        }
+        return data;
+    }
+
+    /**
+     * @brief Decodes a base64 block (`header + data`) into `storage`.
+     *
+     * VTK writes the header and the data either as one base64 stream or as
+     * two separately padded streams; a padding character at the end of the
+     * encoded header identifies the latter.
+     *
+     * @param text Base64 text starting at the block.
+     * @param storage Output buffer (data bytes only).
+     */
+    void DecodeBase64(std::string_view text,
+                      std::vector<std::uint8_t>& storage) const {
+        const std::size_t header_chars =
+            VTKBase64::EncodedSize(m_header_size);
+        if (text.size() < header_chars) {
+            throw std::runtime_error("VTUReader: truncated base64 block");
+        }
+        const auto header = VTKBase64::Decode(text.substr(0, header_chars));
+        const std::size_t n_bytes = Header(header.data());
+
+        if (text[header_chars - 1] == '=') {
+            const std::size_t data_chars = VTKBase64::EncodedSize(n_bytes);
+            storage = VTKBase64::Decode(text.substr(header_chars, data_chars));
+        } else {
+            const std::size_t block_chars =
+                VTKBase64::EncodedSize(m_header_size + n_bytes);
+            storage = VTKBase64::Decode(text.substr(0, block_chars));
+            storage.erase(storage.begin(),
+                          storage.begin() +
+                              std::min(m_header_size, storage.size()));
+        }
+        storage.resize(std::min(storage.size(), n_bytes));
+    }
+
+    /**
+     * @brief Reads a block header (number of data bytes).
+     *
+     * @param bytes Pointer to the header.
+     * @return Number of data bytes of the block.
+     */
+    std::size_t Header(const std::uint8_t* bytes) const {
+        std::uint8_t header[8];
+        std::memcpy(header, bytes, m_header_size);
+        if (m_swap) SwapBytes(header, m_header_size, m_header_size);
+        return m_header_size == 8
+                   ? static_cast<std::size_t>(
+                         VTKType::Load<std::uint64_t>(header))
+                   : VTKType::Load<std::uint32_t>(header);
+    }
+
+    /**
+     * @brief Reverses the byte order of each element of a buffer.
+     *
+     * @param bytes Buffer.
+     * @param n_bytes Buffer size in bytes.
+     * @param size Element size in bytes.
+     */
+    static void SwapBytes(std::uint8_t* bytes, const std::size_t n_bytes,
+                          const std::size_t size) {
+        for (std::size_t i = 0; i + size <= n_bytes; i += size) {
+            for (std::size_t j = 0; j < size / 2; ++j) {
+                std::swap(bytes[i + j], bytes[i + size - 1 - j]);
+            }
+        }
+    }
+
+    /**
+     * @brief Path of the file.
+     */
+    std::string m_filename;
+    /**
+     * @brief File contents.
+     */
+    std::string m_buffer;
+    /**
+     * @brief Number of points of the piece.
+     */
+    std::size_t m_n_points = 0;
+    /**
+     * @brief Size in bytes of the block headers (4 or 8).
+     */
+    std::size_t m_header_size = 4;
+    /**
+     * @brief True if the file byte order differs from the native one.
+     */
+    bool m_swap = false;
+    /**
+     * @brief Position of the first byte after the '_' appended data marker.
+     */
+    std::size_t m_appended = 0;
+    /**
+     * @brief True if the appended data is base64 encoded.
+     */
+    bool m_appended_base64 = false;
+    /**
+     * @brief Coordinates array.
+     */
+    VTUArray m_points;
+    /**
+     * @brief Point data arrays.
+     */
+    std::vector<VTUArray> m_point_data;
+};
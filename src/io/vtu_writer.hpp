@@ -0,0 +1,519 @@
+#pragma once
+
+#include <algorithm>
+#include <any>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <functional>
+#include <future>
+#include <ostream>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+// mpi includes
+#include <mpi.h>
+// Kokkos includes
+#include <Kokkos_Core.hpp>
+
+#include "host_mirror_pool.hpp"
+#include "profiler.hpp"
+#include "vtk_common.hpp"
+
+/**
+ * @file vtu_writer.hpp
+ * @brief Defines the VTUWriter class for parallel particle output.
+ *
+ * This file provides the `VTUWriter` class, which writes particle fields to
+ * one raw appended-binary `.vtu` piece per MPI rank and a `.pvtu` index from
+ * rank 0. The device-to-host copy and the file write of a frame overlap with
+ * the following time steps.
+ */
+
+/**
+ * @struct VTUStagedArray
+ * @brief Host copy of a particle field waiting to be written.
+ */
+struct VTUStagedArray {
+    /**
+     * @brief Array name.
+     */
+    std::string name;
+    /**
+     * @brief VTK data type name.
+     */
+    std::string type;
+    /**
+     * @brief Number of components per point.
+     */
+    int n_components = 1;
+    /**
+     * @brief Size of the data in bytes.
+     */
+    std::size_t n_bytes = 0;
+    /**
+     * @brief Host-pinned buffer borrowed from `HostMirrorPool::Global()`
+     * (kept and reused across frames).
+     */
+    HostMirrorPool::Block block;
+    /**
+     * @brief Unmanaged staging view of `block`.
+     */
+    std::any view;
+    /**
+     * @brief Row-major device copy of non row-major fields.
+     */
+    std::any packed;
+    /**
+     * @brief Writes the staged data.
+     */
+    std::function<void(std::ostream&)> write;
+};
+
+/**
+ * @struct VTUFrame
+ * @brief Staging buffer of one output frame.
+ */
+struct VTUFrame {
+    /**
+     * @brief Time step index of the frame.
+     */
+    int step = 0;
+    /**
+     * @brief Number of local points.
+     */
+    std::size_t n_points = 0;
+    /**
+     * @brief Point coordinates.
+     */
+    VTUStagedArray points;
+    /**
+     * @brief Point data arrays.
+     */
+    std::vector<VTUStagedArray> point_data;
+    /**
+     * @brief Number of point data arrays staged for the current frame.
+     */
+    std::size_t n_staged = 0;
+    /**
+     * @brief Completion of the asynchronous write of the frame.
+     */
+    std::future<void> pending;
+};
+
+/**
+ * @class VTUWriter
+ * @brief Double-buffered asynchronous writer of particle fields.
+ *
+ * Fields are staged with `AddField` and the frame is written by `Write`:
+ *
+ *     writer.AddField("rho", rho);
+ *     writer.AddField("velocity", v);
+ *     writer.Write(step, x);
+ *
+ * Staging enqueues device-to-host copies into host-pinned buffers on the
+ * execution space instance of the writer; they do not block the host. On the
+ * default instance they are ordered with the solver kernels, which may
+ * overwrite the fields right away. On a dedicated instance the copies also
+ * overlap with the device work: the fields must be complete when they are
+ * staged, and `WaitStaging` must return before they are overwritten. A
+ * worker thread waits for the copies (fencing only the writer instance) and
+ * writes the files while the solver advances. Two frames are staged
+ * alternately, so the host only blocks if a frame is still being written two
+ * outputs later.
+ *
+ * Files are named `<prefix>_<step>_<rank>.vtu` and `<prefix>_<step>.pvtu`.
+ * Each particle is written as a `VTK_VERTEX` cell so that the pieces can be
+ * displayed directly.
+ */
+class VTUWriter {
+   public:
+    /**
+     * @brief Constructor for VTUWriter.
+     *
+     * @param prefix Path prefix of the output files.
+     * @param comm MPI communicator.
+     * @param exec Execution space instance of the staging copies.
+     */
+    explicit VTUWriter(const std::string& prefix,
+                       MPI_Comm comm = MPI_COMM_WORLD,
+                       const Kokkos::DefaultExecutionSpace& exec = {})
+        : m_prefix(prefix), m_exec(exec) {
+        MPI_Comm_rank(comm, &m_rank);
+        MPI_Comm_size(comm, &m_size);
+    }
+
+    VTUWriter(const VTUWriter&)            = delete;
+    VTUWriter& operator=(const VTUWriter&) = delete;
+
+    /**
+     * @brief Destructor for VTUWriter (waits for the pending writes).
+     */
+    ~VTUWriter() {
+        for (auto& frame : m_frames) {
+            if (frame.pending.valid()) frame.pending.wait();
+        }
+    }
+
+    /**
+     * @brief Stages a point data field of the next frame.
+     *
+     * @param name Field name.
+     * @param field Kokkos view (rank 1 for scalars, rank 2 N x components
+     * for vectors).
+     */
+    template <class ViewType>
+    void AddField(const std::string& name, const ViewType& field) {
+        VTUFrame& frame = Current();
+        if (frame.n_staged == frame.point_data.size()) {
+            frame.point_data.emplace_back();
+        }
+        Stage(frame.point_data[frame.n_staged], name, field, m_exec);
+        ++frame.n_staged;
+    }
+
+    /**
+     * @brief Stages the positions and writes the frame asynchronously.
+     *
+     * @param step Time step index (used in the file names).
+     * @param x Particle positions Kokkos view (N x 3).
+     */
+    template <class PositionView>
+    void Write(const int step, const PositionView& x) {
+        ProfilingRegion region("IO");
+        VTUFrame& frame = Current();
+        Stage(frame.points, "Points", x, m_exec);
+        frame.step     = step;
+        frame.n_points = x.extent(0);
+        frame.point_data.resize(frame.n_staged);
+        frame.n_staged = 0;
+
+        const std::string piece = PieceFile(step, m_rank);
+        const std::string index = m_rank == 0 ? PVTUFile(step) : "";
+        std::vector<std::string> pieces;
+        for (int r = 0; r < m_size && m_rank == 0; ++r) {
+            pieces.push_back(
+                std::filesystem::path(PieceFile(step, r)).filename().string());
+        }
+        const auto exec = m_exec;
+        frame.pending   = std::async(
+            std::launch::async, [&frame, piece, index, pieces, exec]() {
+                // Only blocks this thread: the solver keeps enqueuing work
+                exec.fence("VTUWriter::Write");
+                WritePiece(piece, frame);
+                if (!index.empty()) WritePVTU(index, frame, pieces);
+            });
+        m_current = 1 - m_current;
+    }
+
+    /**
+     * @brief Stages every field of a particle container and writes the frame
+     * asynchronously.
+     *
+     * @param step Time step index (used in the file names).
+     * @param particles Particle container providing `ForEachField` and `X`.
+     */
+    template <class Particles>
+    void WriteParticles(const int step, const Particles& particles) {
+        particles.ForEachField([&](const std::string& name,
+                                   const auto& field) {
+            if (name != "x") AddField(name, field);
+        });
+        Write(step, particles.X());
+    }
+
+    /**
+     * @brief Waits for the staging copies of the fields (fences the writer
+     * instance only).
+     *
+     * Needed before overwriting staged fields when the writer has a
+     * dedicated execution space instance.
+     */
+    void WaitStaging() const { m_exec.fence("VTUWriter::WaitStaging"); }
+
+    /**
+     * @brief Waits for all the pending writes.
+     *
+     * @throws std::runtime_error If a write failed.
+     */
+    void Wait() {
+        ProfilingRegion region("IO");
+        for (auto& frame : m_frames) {
+            if (frame.pending.valid()) frame.pending.get();
+        }
+    }
+
+    /**
+     * @brief Returns the path of the piece of a rank.
+     *
+     * @param step Time step index.
+     * @param rank MPI rank.
+     * @return Piece path.
+     */
+    std::string PieceFile(const int step, const int rank) const {
+        return m_prefix + "_" + std::to_string(step) + "_" +
+               std::to_string(rank) + ".vtu";
+    }
+
+    /**
+     * @brief Returns the path of the index file.
+     *
+     * @param step Time step index.
+     * @return Index path.
+     */
+    std::string PVTUFile(const int step) const {
+        return m_prefix + "_" + std::to_string(step) + ".pvtu";
+    }
+
+    /**
+     * @brief Writes a raw appended-binary VTU piece.
+     *
+     * @param filename Piece path.
+     * @param frame Staged frame (the staging copies must be complete).
+     * @throws std::runtime_error If the file cannot be written.
+     */
+    static void WritePiece(const std::string& filename,
+                           const VTUFrame& frame) {
+        std::ofstream file(filename, std::ios::binary);
+        if (!file) {
+            throw std::runtime_error("VTUWriter: cannot open " + filename);
+        }
+        const std::size_t n = frame.n_points;
+
+        std::size_t offset = 0;
+        const auto header  = [&](const std::string& name,
+                                const std::string& type, const int nc,
+                                const std::size_t n_bytes) {
+            file << "        <DataArray type=\"" << type << "\" Name=\""
+                 << name << "\" NumberOfComponents=\"" << nc
+                 << "\" format=\"appended\" offset=\"" << offset
+                 << "\"/>\n";
+            offset += sizeof(std::uint64_t) + n_bytes;
+        };
+
+        file << "<?xml version=\"1.0\"?>\n"
+             << "<VTKFile type=\"UnstructuredGrid\" version=\"1.0\" "
+                "byte_order=\"LittleEndian\" header_type=\"UInt64\">\n"
+             << "  <UnstructuredGrid>\n"
+             << "    <Piece NumberOfPoints=\"" << n << "\" NumberOfCells=\""
+             << n << "\">\n"
+             << "      <PointData>\n";
+        for (const auto& array : frame.point_data) {
+            header(array.name, array.type, array.n_components, array.n_bytes);
+        }
+        file << "      </PointData>\n"
+             << "      <Points>\n";
+        header("Points", frame.points.type, 3, frame.points.n_bytes);
+        file << "      </Points>\n"
+             << "      <Cells>\n";
+        header("connectivity", "Int64", 1, n * sizeof(std::int64_t));
+        header("offsets", "Int64", 1, n * sizeof(std::int64_t));
+        header("types", "UInt8", 1, n);
+        file << "      </Cells>\n"
+             << "    </Piece>\n"
+             << "  </UnstructuredGrid>\n"
+             << "  <AppendedData encoding=\"raw\">\n"
+             << "   _";
+
+        const auto block = [&](const std::size_t n_bytes) {
+            const std::uint64_t size = n_bytes;
+            file.write(reinterpret_cast<const char*>(&size), sizeof(size));
+        };
+        for (const auto& array : frame.point_data) {
+            block(array.n_bytes);
+            array.write(file);
+        }
+        block(frame.points.n_bytes);
+        frame.points.write(file);
+
+        // One vertex cell per particle, written in chunks
+        std::vector<std::int64_t> chunk(std::min<std::size_t>(n, 1 << 16));
+        for (int k = 0; k < 2; ++k) {
+            block(n * sizeof(std::int64_t));
+            for (std::size_t i = 0; i < n; i += chunk.size()) {
+                const std::size_t m = std::min(chunk.size(), n - i);
+                for (std::size_t j = 0; j < m; ++j) chunk[j] = i + j + k;
+                file.write(reinterpret_cast<const char*>(chunk.data()),
+                           m * sizeof(std::int64_t));
+            }
+        }
+        block(n);
+        const std::vector<char> types(n, 1);
+        file.write(types.data(), n);
+
+        file << "\n  </AppendedData>\n"
+             << "</VTKFile>\n";
+        if (!file) {
+            throw std::runtime_error("VTUWriter: write to " + filename +
+                                     " failed");
+        }
+    }
+
+    /**
+     * @brief Writes the `.pvtu` index of a frame.
+     *
+     * @param filename Index path.
+     * @param frame Staged frame (only the array descriptions are used).
+     * @param pieces Piece sources, relative to the index directory.
+     * @throws std::runtime_error If the file cannot be written.
+     */
+    static void WritePVTU(const std::string& filename, const VTUFrame& frame,
+                          const std::vector<std::string>& pieces) {
+        std::ofstream file(filename);
+        if (!file) {
+            throw std::runtime_error("VTUWriter: cannot open " + filename);
+        }
+        file << "<?xml version=\"1.0\"?>\n"
+             << "<VTKFile type=\"PUnstructuredGrid\" version=\"1.0\" "
+                "byte_order=\"LittleEndian\" header_type=\"UInt64\">\n"
+             << "  <PUnstructuredGrid GhostLevel=\"0\">\n"
+             << "    <PPointData>\n";
+        for (const auto& array : frame.point_data) {
+            file << "      <PDataArray type=\"" << array.type << "\" Name=\""
+                 << array.name << "\" NumberOfComponents=\""
+                 << array.n_components << "\"/>\n";
+        }
+        file << "    </PPointData>\n"
+             << "    <PPoints>\n"
+             << "      <PDataArray type=\"" << frame.points.type
+             << "\" Name=\"Points\" NumberOfComponents=\"3\"/>\n"
+             << "    </PPoints>\n";
+        for (const auto& piece : pieces) {
+            file << "    <Piece Source=\"" << piece << "\"/>\n";
+        }
+        file << "  </PUnstructuredGrid>\n"
+             << "</VTKFile>\n";
+        if (!file) {
+            throw std::runtime_error("VTUWriter: write to " + filename +
+                                     " failed");
+        }
+    }
+
+   private:
+    /**
+     * @brief Returns the frame being staged, waiting for its previous write.
+     *
+     * @return Current frame.
+     */
+    VTUFrame& Current() {
+        VTUFrame& frame = m_frames[m_current];
+        if (frame.pending.valid()) frame.pending.get();
+        return frame;
+    }
+
+    /**
+     * @brief Enqueues the copy of a field into its staging buffer.
+     *
+     * The staging view is reused if the field has the same type and size as
+     * in the previous frame. Staging views are row-major, which is the VTK
+     * (point-major) order.
+     *
+     * @param array Staged array.
+     * @param name Field name.
+     * @param field Kokkos view (rank 1 or 2).
+     * @param exec Execution space instance of the copies.
+     */
+    template <class ViewType>
+    static void Stage(VTUStagedArray& array, const std::string& name,
+                      const ViewType& field,
+                      const Kokkos::DefaultExecutionSpace& exec) {
+        static_assert(ViewType::rank == 1 || ViewType::rank == 2,
+                      "VTUWriter: fields must be rank 1 or rank 2 views");
+        using Staging = PooledView<HostPinnedStaging<ViewType>>;
+        using Packed  = Kokkos::View<typename ViewType::non_const_data_type,
+                                    Kokkos::LayoutRight,
+                                    typename ViewType::memory_space>;
+        using T       = typename Staging::non_const_value_type;
+
+        const std::size_t n = field.extent(0);
+        const int nc        = ViewType::rank == 1 ? 1 : field.extent(1);
+
+        auto* staging = std::any_cast<Staging>(&array.view);
+        if (staging == nullptr || staging->extent(0) != n) {
+            auto& pool    = HostMirrorPool::Global();
+            auto mirrored = [&]() {
+                if constexpr (Staging::rank_dynamic == 2) {
+                    return pool.Borrow<Staging>(n, nc);
+                } else {
+                    return pool.Borrow<Staging>(n);
+                }
+            }();
+            array.block = std::move(mirrored.block);
+            array.view  = mirrored.view;
+            staging     = std::any_cast<Staging>(&array.view);
+        }
+        if constexpr (is_staging_compatible_v<ViewType>) {
+            Kokkos::deep_copy(exec, *staging, field);
+        } else {
+            // Repack column-major or strided fields on the device first
+            auto* packed = std::any_cast<Packed>(&array.packed);
+            if (packed == nullptr || packed->extent(0) != n) {
+                array.packed = Allocate<Packed>(name, n, nc);
+                packed       = std::any_cast<Packed>(&array.packed);
+            }
+            Kokkos::deep_copy(exec, *packed, field);
+            Kokkos::deep_copy(exec, *staging, *packed);
+        }
+
+        array.name         = name;
+        array.type         = VTKType::Name<T>();
+        array.n_components = nc;
+        array.n_bytes      = n * nc * sizeof(T);
+
+        const Staging view = *staging;
+        array.write        = [view](std::ostream& out) {
+            out.write(reinterpret_cast<const char*>(view.data()),
+                      view.size() * sizeof(T));
+        };
+    }
+
+    /**
+     * @brief Allocates an uninitialized rank 1 or rank 2 view.
+     *
+     * @tparam ViewType Kokkos view type.
+     * @param name View label.
+     * @param n Number of rows.
+     * @param nc Number of components (ignored for rank 1 views).
+     * @return Kokkos view.
+     */
+    template <class ViewType>
+    static ViewType Allocate(const std::string& name, const std::size_t n,
+                             const int nc) {
+        const auto alloc =
+            Kokkos::view_alloc(Kokkos::WithoutInitializing, name);
+        if constexpr (ViewType::rank == 1) {
+            return ViewType(alloc, n);
+        } else {
+            return ViewType(alloc, n, nc);
+        }
+    }
+
+    /**
+     * @brief Path prefix of the output files.
+     */
+    std::string m_prefix;
+    /**
+     * @brief Execution space instance of the staging copies.
+     */
+    Kokkos::DefaultExecutionSpace m_exec;
+    /**
+     * @brief MPI rank.
+     */
+    int m_rank = 0;
+    /**
+     * @brief Number of MPI ranks.
+     */
+    int m_size = 1;
+    /**
+     * @brief Double-buffered frames.
+     */
+    std::array<VTUFrame, 2> m_frames;
+    /**
+     * @brief Index of the frame being staged.
+     */
+    int m_current = 0;
+};
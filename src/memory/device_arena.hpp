@@ -0,0 +1,367 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <ostream>
+#include <type_traits>
+#include <vector>
+
+// Kokkos includes
+#include <Kokkos_Core.hpp>
+
+/**
+ * @file device_arena.hpp
+ * @brief Defines the DeviceArena class for transient per-step device views.
+ *
+ * This file provides the `DeviceArena` class, a bump allocator over one
+ * device buffer that hands out the workspace of a step (neighbor lists,
+ * halo buffers, compaction scratch, reduction temporaries) as unmanaged
+ * views, so that the step loop does not call the device allocator.
+ */
+
+/**
+ * @brief Unmanaged device view handed out by a `DeviceArena`.
+ *
+ * @tparam DataType Kokkos data type (e.g. `int*` or `double* [3]`).
+ * @tparam Layout Kokkos layout (`LayoutLeft` or `LayoutRight`).
+ */
+template <class DataType, class Layout = Kokkos::LayoutRight>
+using ArenaView =
+    Kokkos::View<DataType, Layout, Kokkos::DefaultExecutionSpace::memory_space,
+                 Kokkos::MemoryTraits<Kokkos::Unmanaged>>;
+
+/**
+ * @class DeviceArena
+ * @brief Per-step bump allocator of device workspace.
+ *
+ * Every request is carved from the buffer at the next `alignment`-byte
+ * boundary, and `Reset` makes the whole buffer available again, typically
+ * once per step:
+ *
+ *     auto& arena = DeviceArena::Global();
+ *     for (int step = 0; step < n_steps; ++step) {
+ *         arena.Reset();
+ *         auto keys = arena.Allocate<ArenaView<std::uint64_t*>>(n);
+ *         ...
+ *     }
+ *
+ * A request that does not fit in the buffer gets a dedicated allocation,
+ * held until the next `Reset`, which then regrows the buffer to the
+ * high-water mark (the most bytes handed out between two resets). From the
+ * second step of a steady-state loop on, no device allocation happens.
+ *
+ * Routines that only need workspace for the duration of a call (e.g.
+ * `ParticlePermutation::Gather`) open a `Scope`, which hands the workspace
+ * back on exit; without a `Reset` loop around them, the outermost scope
+ * regrows the buffer instead, so the arena never accumulates overflows.
+ *
+ * The views must not be used after the next `Reset` (or the end of their
+ * scope). Kernels enqueued on
+ * the default execution space instance run in order, so the workspace of a
+ * step can be reused by the next one without a fence; with other instances,
+ * fence them before `Reset`. The buffer of `Global()` is released by
+ * `Kokkos::finalize`.
+ */
+class DeviceArena {
+   public:
+    /**
+     * @brief Alignment of every view in bytes (a GPU cache line pair).
+     */
+    static constexpr std::size_t alignment = 256;
+
+    /**
+     * @brief Device byte storage of the arena.
+     */
+    using Storage =
+        Kokkos::View<char*, Kokkos::DefaultExecutionSpace::memory_space>;
+
+    /**
+     * @brief Constructor for DeviceArena.
+     *
+     * @param capacity Initial buffer size in bytes (0 grows it at the first
+     * reset).
+     */
+    explicit DeviceArena(const std::size_t capacity = 0) {
+        if (capacity > 0) Grow(capacity);
+    }
+
+    DeviceArena(const DeviceArena&)            = delete;
+    DeviceArena& operator=(const DeviceArena&) = delete;
+
+    /**
+     * @class Scope
+     * @brief Hands back the workspace requested during its lifetime.
+     */
+    class Scope {
+       public:
+        /**
+         * @brief Constructor for Scope.
+         *
+         * @param arena Arena whose state is restored on destruction.
+         */
+        explicit Scope(DeviceArena& arena)
+            : m_arena(arena),
+              m_offset(arena.m_offset),
+              m_used(arena.m_used),
+              m_n_overflow(arena.m_overflow.size()) {}
+
+        Scope(const Scope&)            = delete;
+        Scope& operator=(const Scope&) = delete;
+
+        /**
+         * @brief Destructor for Scope.
+         */
+        ~Scope() { m_arena.Rewind(m_offset, m_used, m_n_overflow); }
+
+       private:
+        /**
+         * @brief Arena.
+         */
+        DeviceArena& m_arena;
+        /**
+         * @brief First free byte of the buffer on entry.
+         */
+        std::size_t m_offset;
+        /**
+         * @brief Bytes handed out on entry.
+         */
+        std::size_t m_used;
+        /**
+         * @brief Number of overflow allocations on entry.
+         */
+        std::size_t m_n_overflow;
+    };
+
+    /**
+     * @brief Returns the process-wide arena.
+     *
+     * @return Arena released by `Kokkos::finalize`.
+     */
+    static DeviceArena& Global() {
+        static DeviceArena arena;
+        static std::once_flag hook;
+        std::call_once(hook, [] {
+            Kokkos::push_finalize_hook([] { arena.Release(); });
+        });
+        return arena;
+    }
+
+    /**
+     * @brief Hands out aligned workspace.
+     *
+     * @param bytes Requested size in bytes.
+     * @return Device address of at least `bytes` bytes (uninitialized,
+     * valid until the next `Reset`).
+     */
+    char* AllocateBytes(const std::size_t bytes) {
+        const std::size_t size = AlignUp(bytes);
+        ++m_n_requests;
+        m_used += size;
+        m_high_water = std::max(m_high_water, m_used);
+        if (m_offset + size <= m_capacity) {
+            char* data = m_base + m_offset;
+            m_offset += size;
+            return data;
+        }
+        ++m_n_allocations;
+        m_overflow.emplace_back(
+            Kokkos::view_alloc(Kokkos::WithoutInitializing,
+                               "device_arena_overflow"),
+            size + alignment);
+        return Align(m_overflow.back().data());
+    }
+
+    /**
+     * @brief Hands out an unmanaged device view.
+     *
+     * @tparam ViewType Unmanaged view type in the default memory space
+     * (e.g. `ArenaView<int*>`).
+     * @param extents Runtime extents of the view.
+     * @return View (uninitialized, valid until the next `Reset`).
+     */
+    template <class ViewType, class... Extents>
+    ViewType Allocate(const Extents... extents) {
+        static_assert(ViewType::traits::memory_traits::is_unmanaged,
+                      "DeviceArena: the view type must be unmanaged");
+        static_assert(
+            std::is_same_v<typename ViewType::memory_space,
+                           Kokkos::DefaultExecutionSpace::memory_space>,
+            "DeviceArena: the view must be in the default memory space");
+        using T = typename ViewType::value_type;
+        const std::size_t n_bytes =
+            ViewType(static_cast<T*>(nullptr), extents...).span() * sizeof(T);
+        return ViewType(reinterpret_cast<T*>(AllocateBytes(n_bytes)),
+                        extents...);
+    }
+
+    /**
+     * @brief Makes the whole buffer available again.
+     *
+     * Frees the overflow allocations of the step and, if the buffer is
+     * below the high-water mark, regrows it.
+     */
+    void Reset() {
+        m_overflow.clear();
+        m_offset = 0;
+        m_used   = 0;
+        if (m_capacity < m_high_water) Grow(m_high_water);
+    }
+
+    /**
+     * @brief Frees the buffer (the statistics are kept).
+     */
+    void Release() {
+        m_overflow.clear();
+        m_storage  = Storage();
+        m_base     = nullptr;
+        m_capacity = 0;
+        m_offset   = 0;
+        m_used     = 0;
+    }
+
+    /**
+     * @brief Prints the high-water mark and the allocation counts.
+     *
+     * @param os Output stream.
+     */
+    void Print(std::ostream& os) const {
+        os << "DeviceArena: high-water mark " << m_high_water
+           << " bytes, capacity " << Capacity() << " bytes, "
+           << m_n_requests << " requests, " << m_n_allocations
+           << " device allocations\n";
+    }
+
+    /**
+     * @brief Returns the size of the buffer.
+     *
+     * @return Capacity in bytes.
+     */
+    std::size_t Capacity() const { return m_capacity; }
+
+    /**
+     * @brief Returns the bytes handed out since the last reset.
+     *
+     * @return Used bytes, overflow allocations included.
+     */
+    std::size_t Used() const { return m_used; }
+
+    /**
+     * @brief Returns the most bytes handed out between two resets.
+     *
+     * @return High-water mark in bytes.
+     */
+    std::size_t HighWaterMark() const { return m_high_water; }
+
+    /**
+     * @brief Returns the number of device allocations made so far.
+     *
+     * Constant in a steady-state loop.
+     *
+     * @return Number of allocations (buffer and overflows).
+     */
+    std::size_t NumAllocations() const { return m_n_allocations; }
+
+    /**
+     * @brief Returns the number of requests served so far.
+     *
+     * @return Number of requests.
+     */
+    std::size_t NumRequests() const { return m_n_requests; }
+
+    /**
+     * @brief Rounds a size up to the alignment.
+     *
+     * @param bytes Size in bytes.
+     * @return Multiple of `alignment`.
+     */
+    static constexpr std::size_t AlignUp(const std::size_t bytes) {
+        return (bytes + alignment - 1) / alignment * alignment;
+    }
+
+   private:
+    /**
+     * @brief Restores the state recorded by a `Scope`.
+     *
+     * Building block of `Scope`. Frees the overflow allocations made since,
+     * and regrows the buffer when nothing is handed out anymore.
+     *
+     * @param offset First free byte of the buffer.
+     * @param used Bytes handed out.
+     * @param n_overflow Number of overflow allocations.
+     */
+    void Rewind(const std::size_t offset, const std::size_t used,
+                const std::size_t n_overflow) {
+        m_overflow.resize(n_overflow);
+        m_offset = offset;
+        m_used   = used;
+        if (m_used == 0 && m_capacity < m_high_water) Grow(m_high_water);
+    }
+
+    /**
+     * @brief Reallocates the buffer.
+     *
+     * Building block of the constructor, `Reset` and `Rewind`.
+     *
+     * @param capacity New size in bytes.
+     */
+    void Grow(const std::size_t capacity) {
+        // Free the old buffer first so both never coexist
+        m_storage  = Storage();
+        m_capacity = AlignUp(capacity);
+        m_storage  = Storage(Kokkos::view_alloc(Kokkos::WithoutInitializing,
+                                                "device_arena"),
+                             m_capacity + alignment);
+        m_base     = Align(m_storage.data());
+        ++m_n_allocations;
+    }
+
+    /**
+     * @brief Rounds an address up to the alignment.
+     *
+     * @param data Address of an allocation of `alignment` extra bytes.
+     * @return First aligned address of the allocation.
+     */
+    static char* Align(char* data) {
+        const std::uintptr_t address = reinterpret_cast<std::uintptr_t>(data);
+        return data + (AlignUp(address) - address);
+    }
+
+    /**
+     * @brief Buffer.
+     */
+    Storage m_storage;
+    /**
+     * @brief First aligned byte of the buffer.
+     */
+    char* m_base = nullptr;
+    /**
+     * @brief Usable bytes of the buffer from `m_base`.
+     */
+    std::size_t m_capacity = 0;
+    /**
+     * @brief Dedicated allocations of the requests that did not fit.
+     */
+    std::vector<Storage> m_overflow;
+    /**
+     * @brief First free byte of the buffer.
+     */
+    std::size_t m_offset = 0;
+    /**
+     * @brief Bytes handed out since the last reset.
+     */
+    std::size_t m_used = 0;
+    /**
+     * @brief Most bytes handed out between two resets.
+     */
+    std::size_t m_high_water = 0;
+    /**
+     * @brief Number of device allocations.
+     */
+    std::size_t m_n_allocations = 0;
+    /**
+     * @brief Number of requests.
+     */
+    std::size_t m_n_requests = 0;
+};
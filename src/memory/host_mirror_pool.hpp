@@ -0,0 +1,313 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <mutex>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+// Kokkos includes
+#include <Kokkos_Core.hpp>
+
+#include "host_pinned_space.hpp"
+
+/**
+ * @file host_mirror_pool.hpp
+ * @brief Defines the HostMirrorPool class for reusable host-pinned buffers.
+ *
+ * This file provides the `HostMirrorPool` class, a cache of host-pinned
+ * buffers borrowed by the host-device staging paths (output, diagnostics,
+ * MPI staging) instead of allocating a mirror at every visit.
+ */
+
+/**
+ * @brief Unmanaged host-pinned view with the data type and layout of a view.
+ *
+ * @tparam ViewType Kokkos view type (`LayoutLeft` or `LayoutRight`).
+ */
+template <class ViewType>
+using PooledView =
+    Kokkos::View<typename ViewType::non_const_data_type,
+                 typename ViewType::array_layout, HostPinnedSpace,
+                 Kokkos::MemoryTraits<Kokkos::Unmanaged>>;
+
+/**
+ * @class HostMirrorPool
+ * @brief Size-classed pool of host-pinned buffers.
+ *
+ * Requests are rounded up to a power of two (at least `min_bytes`) and
+ * served from the free list of that size class; a pinned allocation only
+ * happens when the list is empty. Buffers go back to their list when the
+ * `Block` owning them is destroyed, so a loop that borrows the same sizes
+ * at every visit stops allocating after the first one.
+ *
+ *     auto host = HostMirrorPool::Global().Mirror(particles.P());
+ *     Kokkos::deep_copy(host.view, particles.P());
+ *
+ * The pool is thread-safe. The buffers of `Global()` are released by
+ * `Kokkos::finalize`; blocks must be returned before.
+ */
+class HostMirrorPool {
+   public:
+    /**
+     * @brief Smallest buffer size in bytes.
+     */
+    static constexpr std::size_t min_bytes = 256;
+
+    /**
+     * @brief Host-pinned byte storage of a buffer.
+     */
+    using Storage = Kokkos::View<char*, HostPinnedSpace>;
+
+    /**
+     * @class Block
+     * @brief Borrowed buffer, returned to its pool on destruction.
+     */
+    class Block {
+       public:
+        Block() = default;
+
+        Block(const Block&)            = delete;
+        Block& operator=(const Block&) = delete;
+
+        Block(Block&& other) noexcept
+            : m_pool(std::exchange(other.m_pool, nullptr)),
+              m_storage(std::exchange(other.m_storage, Storage())) {}
+
+        Block& operator=(Block&& other) noexcept {
+            if (this != &other) {
+                Return();
+                m_pool    = std::exchange(other.m_pool, nullptr);
+                m_storage = std::exchange(other.m_storage, Storage());
+            }
+            return *this;
+        }
+
+        /**
+         * @brief Destructor for Block (returns the buffer to its pool).
+         */
+        ~Block() { Return(); }
+
+        /**
+         * @brief Returns the address of the buffer.
+         *
+         * @return Buffer address (null for an empty block).
+         */
+        char* Data() const { return m_storage.data(); }
+
+        /**
+         * @brief Returns the size of the buffer.
+         *
+         * @return Size in bytes (the size class, at least the request).
+         */
+        std::size_t Bytes() const { return m_storage.extent(0); }
+
+       private:
+        friend class HostMirrorPool;
+
+        /**
+         * @brief Wraps a buffer of a pool.
+         *
+         * @param pool Owning pool.
+         * @param storage Buffer.
+         */
+        Block(HostMirrorPool* pool, Storage storage)
+            : m_pool(pool), m_storage(std::move(storage)) {}
+
+        /**
+         * @brief Gives the buffer back to its pool.
+         */
+        void Return() {
+            if (m_pool != nullptr) m_pool->Return(std::move(m_storage));
+            m_pool    = nullptr;
+            m_storage = Storage();
+        }
+
+        /**
+         * @brief Owning pool (null for an empty block).
+         */
+        HostMirrorPool* m_pool = nullptr;
+        /**
+         * @brief Buffer.
+         */
+        Storage m_storage;
+    };
+
+    /**
+     * @struct Mirrored
+     * @brief Unmanaged view over a borrowed block.
+     *
+     * @tparam HostView Unmanaged host-pinned view type.
+     */
+    template <class HostView>
+    struct Mirrored {
+        /**
+         * @brief Block holding the data (keeps it borrowed).
+         */
+        Block block;
+        /**
+         * @brief View of the block.
+         */
+        HostView view;
+    };
+
+    HostMirrorPool() = default;
+
+    HostMirrorPool(const HostMirrorPool&)            = delete;
+    HostMirrorPool& operator=(const HostMirrorPool&) = delete;
+
+    /**
+     * @brief Returns the process-wide pool.
+     *
+     * @return Pool released by `Kokkos::finalize`.
+     */
+    static HostMirrorPool& Global() {
+        static HostMirrorPool pool;
+        static std::once_flag hook;
+        std::call_once(hook, [] {
+            Kokkos::push_finalize_hook([] { pool.Release(); });
+        });
+        return pool;
+    }
+
+    /**
+     * @brief Borrows a buffer.
+     *
+     * @param bytes Requested size in bytes.
+     * @return Block of at least `bytes` bytes (uninitialized).
+     */
+    Block Acquire(const std::size_t bytes) {
+        const int size_class = SizeClass(bytes);
+        std::lock_guard<std::mutex> lock(m_mutex);
+        ++m_n_borrowed;
+        auto& free = m_free[size_class];
+        if (!free.empty()) {
+            Storage storage = std::move(free.back());
+            free.pop_back();
+            return Block(this, std::move(storage));
+        }
+        ++m_n_allocations;
+        return Block(this, Storage(Kokkos::view_alloc(
+                                       Kokkos::WithoutInitializing,
+                                       "host_mirror_pool"),
+                                   std::size_t(1) << size_class));
+    }
+
+    /**
+     * @brief Borrows an unmanaged host-pinned view.
+     *
+     * @tparam HostView Unmanaged view type in `HostPinnedSpace`.
+     * @param extents Runtime extents of the view.
+     * @return Block and view (uninitialized).
+     */
+    template <class HostView, class... Extents>
+    Mirrored<HostView> Borrow(const Extents... extents) {
+        static_assert(HostView::traits::memory_traits::is_unmanaged,
+                      "HostMirrorPool: the view type must be unmanaged");
+        using T = typename HostView::value_type;
+        const std::size_t n_bytes =
+            HostView(static_cast<T*>(nullptr), extents...).span() * sizeof(T);
+        Mirrored<HostView> mirrored{Acquire(n_bytes), HostView()};
+        mirrored.view =
+            HostView(reinterpret_cast<T*>(mirrored.block.Data()), extents...);
+        return mirrored;
+    }
+
+    /**
+     * @brief Borrows a host-pinned mirror of a view (same data type, layout
+     * and extents, uninitialized).
+     *
+     * @param view Contiguous `LayoutLeft` or `LayoutRight` Kokkos view.
+     * @return Block and mirror view.
+     */
+    template <class ViewType>
+    Mirrored<PooledView<ViewType>> Mirror(const ViewType& view) {
+        using Layout = typename ViewType::array_layout;
+        static_assert(std::is_same_v<Layout, Kokkos::LayoutLeft> ||
+                          std::is_same_v<Layout, Kokkos::LayoutRight>,
+                      "HostMirrorPool: strided views cannot be mirrored");
+        static_assert(ViewType::rank_dynamic <= 2,
+                      "HostMirrorPool: at most two runtime extents");
+        if constexpr (ViewType::rank_dynamic == 2) {
+            return Borrow<PooledView<ViewType>>(view.extent(0),
+                                                view.extent(1));
+        } else {
+            return Borrow<PooledView<ViewType>>(view.extent(0));
+        }
+    }
+
+    /**
+     * @brief Frees the cached buffers (borrowed blocks are not affected).
+     */
+    void Release() {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        for (auto& free : m_free) free.clear();
+    }
+
+    /**
+     * @brief Returns the number of pinned allocations made so far.
+     *
+     * Constant in a steady-state loop.
+     *
+     * @return Number of allocations.
+     */
+    std::size_t NumAllocations() const {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        return m_n_allocations;
+    }
+
+    /**
+     * @brief Returns the number of blocks currently borrowed.
+     *
+     * @return Number of blocks not yet returned.
+     */
+    std::size_t NumBorrowed() const {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        return m_n_borrowed;
+    }
+
+    /**
+     * @brief Returns the size class of a request.
+     *
+     * @param bytes Requested size in bytes.
+     * @return Base-2 logarithm of the buffer size.
+     */
+    static int SizeClass(const std::size_t bytes) {
+        int size_class = 0;
+        while ((std::size_t(1) << size_class) < std::max(bytes, min_bytes)) {
+            ++size_class;
+        }
+        return size_class;
+    }
+
+   private:
+    /**
+     * @brief Puts a returned buffer back in its free list.
+     *
+     * @param storage Buffer.
+     */
+    void Return(Storage storage) {
+        const int size_class = SizeClass(storage.extent(0));
+        std::lock_guard<std::mutex> lock(m_mutex);
+        --m_n_borrowed;
+        m_free[size_class].push_back(std::move(storage));
+    }
+
+    /**
+     * @brief Protects the free lists and the counters.
+     */
+    mutable std::mutex m_mutex;
+    /**
+     * @brief Free buffers of each size class.
+     */
+    std::vector<Storage> m_free[8 * sizeof(std::size_t)];
+    /**
+     * @brief Number of pinned allocations.
+     */
+    std::size_t m_n_allocations = 0;
+    /**
+     * @brief Number of borrowed blocks.
+     */
+    std::size_t m_n_borrowed = 0;
+};
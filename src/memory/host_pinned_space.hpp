@@ -0,0 +1,52 @@
+#pragma once
+
+#include <type_traits>
+
+// Kokkos includes
+#include <Kokkos_Core.hpp>
+
+/**
+ * @file host_pinned_space.hpp
+ * @brief Defines the host memory space used to stage device transfers.
+ *
+ * `HostPinnedSpace` is page-locked host memory on CUDA/HIP/SYCL backends,
+ * which allows fast (and asynchronous) host-device copies, and plain
+ * `Kokkos::HostSpace` on host-only builds. Staging buffers are always
+ * `LayoutRight` (row-major, i.e. point-major for particle fields), which is
+ * the order of file formats.
+ */
+
+#ifdef KOKKOS_HAS_SHARED_HOST_PINNED_SPACE
+/**
+ * @brief Page-locked host memory space used for host-device staging.
+ */
+using HostPinnedSpace = Kokkos::SharedHostPinnedSpace;
+#else
+/**
+ * @brief Host memory space used for host-device staging.
+ */
+using HostPinnedSpace = Kokkos::HostSpace;
+#endif
+
+/**
+ * @brief Host-pinned, row-major staging view type of a particle field.
+ *
+ * @tparam ViewType Kokkos view type of the field (rank 1 or 2).
+ */
+template <class ViewType>
+using HostPinnedStaging =
+    Kokkos::View<typename ViewType::non_const_data_type, Kokkos::LayoutRight,
+                 HostPinnedSpace>;
+
+/**
+ * @brief True if a field can be copied to/from its staging view directly.
+ *
+ * Other fields (e.g. column-major or strided subviews) are repacked through
+ * a row-major device copy first.
+ *
+ * @tparam ViewType Kokkos view type of the field.
+ */
+template <class ViewType>
+inline constexpr bool is_staging_compatible_v =
+    ViewType::rank == 1 ||
+    std::is_same_v<typename ViewType::array_layout, Kokkos::LayoutRight>;
@@ -0,0 +1,364 @@
+#pragma once
+
+#include <cstddef>
+#include <limits>
+#include <stdexcept>
+#include <vector>
+
+// mpi includes
+#include <mpi.h>
+// Kokkos includes
+#include <Kokkos_Core.hpp>
+
+#include "device_arena.hpp"
+#include "morton.hpp"
+#include "particle_transfer.hpp"
+#include "profiler.hpp"
+
+/**
+ * @file halo_exchange.hpp
+ * @brief Defines the HaloExchange class for ghost particle exchange.
+ *
+ * This file provides the `HaloExchange` class, which identifies the local
+ * particles within the interaction radius of the other ranks' domains and
+ * copies them there as ghost particles with non-blocking MPI, so that the
+ * communication overlaps with the computation on interior particles.
+ */
+
+/**
+ * @class HaloExchange
+ * @brief Ghost particle identification and non-blocking halo exchange.
+ *
+ * The domain of a rank is the bounding box of its local particles (compact
+ * with the SFC decomposition of `SFCPartition`). `Build` sends a local
+ * particle to every rank whose box is closer than `radius`; the relation is
+ * symmetric, so two ranks are peers when their boxes are closer than
+ * `radius`. Ghosts are appended after the `NumLocal()` local particles of the
+ * container, grouped by source rank.
+ *
+ * Local particles that are not sent anywhere are interior: all their
+ * neighbors within `radius` are local, so they can be processed between
+ * `Begin` and `End`, while the messages are in flight.
+ *
+ * The packing and unpacking of the ghosts run on the execution space
+ * instance given at construction. With a dedicated instance, the interior
+ * work can be enqueued on another instance before `Begin`: packing only
+ * reads the fields (and `Begin` does not reallocate once the capacity of
+ * the container holds the ghosts), so both overlap on the device. `End`
+ * returns once the ghosts are written.
+ *
+ *     interior_work(compute);  // Enqueued, not fenced
+ *     halo.Begin(particles);   // Runs on the halo instance
+ *     halo.End(particles);
+ *     boundary_work(compute);
+ */
+class HaloExchange {
+   public:
+    /**
+     * @brief Constructor for HaloExchange.
+     *
+     * @param radius Interaction radius (kernel support plus Verlet skin).
+     * @param comm MPI communicator.
+     * @param exec Execution space instance of the ghost packing and
+     * unpacking.
+     * @throws std::invalid_argument If `radius` is not positive.
+     */
+    explicit HaloExchange(double radius, MPI_Comm comm = MPI_COMM_WORLD,
+                          const Kokkos::DefaultExecutionSpace& exec = {})
+        : m_radius(radius), m_comm(comm), m_transfer(comm, 1, exec) {
+        if (radius <= 0.0) {
+            throw std::invalid_argument(
+                "HaloExchange: radius must be positive");
+        }
+        MPI_Comm_rank(m_comm, &m_rank);
+        MPI_Comm_size(m_comm, &m_size);
+    }
+
+    /**
+     * @brief Identifies the ghosts of the current positions (collective).
+     *
+     * All the particles of the container are considered local.
+     *
+     * @param particles Particle container providing `Size` and `X`.
+     */
+    template <class Particles>
+    void Build(const Particles& particles) {
+        ProfilingRegion region("Halo");
+        m_n_local    = particles.Size();
+        const auto x = particles.X();
+        const auto N = static_cast<int>(m_n_local);
+
+        // Domains of all the ranks (empty ranks have an inverted box)
+        const BoundingBox box = BoundingBox::Of(x);
+        std::vector<double> boxes(6 * m_size);
+        for (int d = 0; d < 3; ++d) {
+            boxes[6 * m_rank + d]     = N > 0 ? box.lo[d] : 1.0;
+            boxes[6 * m_rank + 3 + d] = N > 0 ? box.hi[d] : -1.0;
+        }
+        MPI_Allgather(MPI_IN_PLACE, 6, MPI_DOUBLE, boxes.data(), 6, MPI_DOUBLE,
+                      m_comm);
+
+        m_peers.clear();
+        for (int r = 0; r < m_size; ++r) {
+            if (r != m_rank && BoxDistance2(boxes, m_rank, r) <
+                                   m_radius * m_radius) {
+                m_peers.push_back(r);
+            }
+        }
+
+        // Particles within the radius of each peer domain, grouped by peer;
+        // the per-peer lists and flags are scratch of the device arena, the
+        // send indices are kept by the transfer until the next build
+        auto& arena = DeviceArena::Global();
+        const DeviceArena::Scope scope(arena);
+        const double r2     = m_radius * m_radius;
+        const auto boundary = arena.Allocate<ArenaView<int*>>(N);
+        Kokkos::deep_copy(boundary, 0);
+        std::vector<int> send_counts(m_peers.size());
+        std::vector<ArenaView<int*>> send_lists;
+        for (std::size_t k = 0; k < m_peers.size(); ++k) {
+            Kokkos::Array<double, 6> peer;
+            for (int c = 0; c < 6; ++c) peer[c] = boxes[6 * m_peers[k] + c];
+            int count = 0;
+            Kokkos::parallel_reduce(
+                "HaloExchange::Count", N,
+                KOKKOS_LAMBDA(const int i, int& n) {
+                    n += PointDistance2(x, i, peer) < r2;
+                },
+                count);
+            const auto list = arena.Allocate<ArenaView<int*>>(count);
+            Kokkos::parallel_scan(
+                "HaloExchange::Select", N,
+                KOKKOS_LAMBDA(const int i, int& offset, const bool final) {
+                    if (PointDistance2(x, i, peer) >= r2) return;
+                    if (final) {
+                        list(offset) = i;
+                        boundary(i)  = 1;
+                    }
+                    ++offset;
+                });
+            send_counts[k] = count;
+            send_lists.push_back(list);
+        }
+        std::size_t n_send = 0;
+        for (const int count : send_counts) n_send += count;
+        Kokkos::View<int*> send_index(
+            Kokkos::view_alloc(Kokkos::WithoutInitializing, "halo_send"),
+            n_send);
+        std::size_t offset = 0;
+        for (const auto& list : send_lists) {
+            const std::size_t n = list.extent(0);
+            const auto rows     = Kokkos::make_pair(offset, offset + n);
+            Kokkos::deep_copy(Kokkos::subview(send_index, rows), list);
+            offset += n;
+        }
+
+        // Interior and boundary local particles
+        int n_boundary = 0;
+        Kokkos::parallel_reduce(
+            "HaloExchange::CountBoundary", N,
+            KOKKOS_LAMBDA(const int i, int& n) { n += boundary(i); },
+            n_boundary);
+        Kokkos::View<int*> interior(
+            Kokkos::view_alloc(Kokkos::WithoutInitializing, "halo_interior"),
+            N - n_boundary);
+        Kokkos::View<int*> boundary_list(
+            Kokkos::view_alloc(Kokkos::WithoutInitializing, "halo_boundary"),
+            n_boundary);
+        Kokkos::parallel_scan(
+            "HaloExchange::Split", N,
+            KOKKOS_LAMBDA(const int i, int& n_b, const bool final) {
+                if (final) {
+                    if (boundary(i)) {
+                        boundary_list(n_b) = i;
+                    } else {
+                        interior(i - n_b) = i;
+                    }
+                }
+                n_b += boundary(i);
+            });
+        m_interior = interior;
+        m_boundary = boundary_list;
+
+        // Ghost counts from the (symmetric) peers
+        std::vector<int> recv_counts(m_peers.size());
+        std::vector<MPI_Request> requests(2 * m_peers.size());
+        for (std::size_t k = 0; k < m_peers.size(); ++k) {
+            MPI_Irecv(&recv_counts[k], 1, MPI_INT, m_peers[k], 0, m_comm,
+                      &requests[2 * k]);
+            MPI_Isend(&send_counts[k], 1, MPI_INT, m_peers[k], 0, m_comm,
+                      &requests[2 * k + 1]);
+        }
+        MPI_Waitall(static_cast<int>(requests.size()), requests.data(),
+                    MPI_STATUSES_IGNORE);
+        m_transfer.Setup(send_index, m_peers, send_counts, m_peers,
+                         recv_counts);
+    }
+
+    /**
+     * @brief Packs the boundary particles and posts the halo messages.
+     *
+     * Drops the previous ghosts and makes room for the new ones; views taken
+     * from the container before the call must be refreshed.
+     *
+     * @param particles Particle container providing `Resize` and
+     * `ForEachField`, with the local particles of the last `Build` first.
+     */
+    template <class Particles>
+    void Begin(Particles& particles) {
+        ProfilingRegion region("Halo");
+        particles.Resize(m_n_local);
+        m_transfer.Begin(particles);
+        particles.Resize(m_n_local + m_transfer.NumRecv());
+    }
+
+    /**
+     * @brief Waits for the halo messages and writes the ghosts.
+     *
+     * @param particles Particle container passed to `Begin`.
+     */
+    template <class Particles>
+    void End(Particles& particles) {
+        ProfilingRegion region("Halo");
+        m_transfer.End(particles, m_n_local);
+    }
+
+    /**
+     * @brief Exchanges the ghosts without overlap (`Begin` then `End`).
+     *
+     * @param particles Particle container.
+     */
+    template <class Particles>
+    void Exchange(Particles& particles) {
+        Begin(particles);
+        End(particles);
+    }
+
+    /**
+     * @brief Removes the ghosts from a container.
+     *
+     * @param particles Particle container.
+     */
+    template <class Particles>
+    void RemoveGhosts(Particles& particles) const {
+        particles.Resize(m_n_local);
+    }
+
+    /**
+     * @brief Returns the number of local particles.
+     *
+     * @return Number of local particles.
+     */
+    std::size_t NumLocal() const { return m_n_local; }
+
+    /**
+     * @brief Returns the number of ghost particles.
+     *
+     * @return Number of ghosts.
+     */
+    std::size_t NumGhosts() const { return m_transfer.NumRecv(); }
+
+    /**
+     * @brief Returns the peer ranks.
+     *
+     * @return Ranks exchanging ghosts with this rank.
+     */
+    const std::vector<int>& Peers() const { return m_peers; }
+
+    /**
+     * @brief Returns the local particles not needed by any other rank.
+     *
+     * @return Device view of local indices.
+     */
+    Kokkos::View<const int*> Interior() const { return m_interior; }
+
+    /**
+     * @brief Returns the local particles sent as ghosts.
+     *
+     * @return Device view of local indices.
+     */
+    Kokkos::View<const int*> Boundary() const { return m_boundary; }
+
+    /**
+     * @brief Returns the squared distance between a particle and a box.
+     *
+     * @param x Particle positions Kokkos view (N x 3).
+     * @param i Particle index.
+     * @param box Lower then upper corner.
+     * @return Squared distance (zero inside the box).
+     */
+    template <class PositionView>
+    KOKKOS_INLINE_FUNCTION static double PointDistance2(
+        const PositionView& x, const int i,
+        const Kokkos::Array<double, 6>& box) {
+        double d2 = 0.0;
+        for (int d = 0; d < 3; ++d) {
+            const double gap = Kokkos::max(
+                Kokkos::max(box[d] - x(i, d), x(i, d) - box[3 + d]), 0.0);
+            d2 += gap * gap;
+        }
+        return d2;
+    }
+
+   private:
+    /**
+     * @brief Returns the squared distance between two rank domains.
+     *
+     * @param boxes Gathered boxes (lower then upper corner, per rank).
+     * @param a First rank.
+     * @param b Second rank.
+     * @return Squared distance, or infinity if a box is empty.
+     */
+    static double BoxDistance2(const std::vector<double>& boxes, const int a,
+                               const int b) {
+        double d2 = 0.0;
+        for (int d = 0; d < 3; ++d) {
+            const double lo_a = boxes[6 * a + d], hi_a = boxes[6 * a + 3 + d];
+            const double lo_b = boxes[6 * b + d], hi_b = boxes[6 * b + 3 + d];
+            if (lo_a > hi_a || lo_b > hi_b) {
+                return std::numeric_limits<double>::infinity();
+            }
+            const double gap =
+                Kokkos::max(Kokkos::max(lo_b - hi_a, lo_a - hi_b), 0.0);
+            d2 += gap * gap;
+        }
+        return d2;
+    }
+
+    /**
+     * @brief Interaction radius.
+     */
+    double m_radius;
+    /**
+     * @brief MPI communicator.
+     */
+    MPI_Comm m_comm;
+    /**
+     * @brief MPI rank.
+     */
+    int m_rank = 0;
+    /**
+     * @brief Number of MPI ranks.
+     */
+    int m_size = 1;
+    /**
+     * @brief Number of local particles.
+     */
+    std::size_t m_n_local = 0;
+    /**
+     * @brief Peer ranks.
+     */
+    std::vector<int> m_peers;
+    /**
+     * @brief Interior local particles.
+     */
+    Kokkos::View<int*> m_interior;
+    /**
+     * @brief Boundary local particles.
+     */
+    Kokkos::View<int*> m_boundary;
+    /**
+     * @brief Point-to-point transfer of the boundary particles.
+     */
+    ParticleTransfer m_transfer;
+};
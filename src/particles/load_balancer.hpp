@@ -0,0 +1,235 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <stdexcept>
+
+// mpi includes
+#include <mpi.h>
+// Kokkos includes
+#include <Kokkos_Core.hpp>
+
+#include "morton.hpp"
+#include "particle_migration.hpp"
+#include "sfc_partition.hpp"
+
+/**
+ * @file load_balancer.hpp
+ * @brief Defines the LoadBalancer class for dynamic repartitioning.
+ *
+ * This file provides the `LoadBalancer` class, which monitors the per-rank
+ * cost of the time steps and cuts the Morton curve again, weighted by the
+ * measured cost, when the ranks drift out of balance.
+ */
+
+/**
+ * @class LoadBalancer
+ * @brief Threshold-triggered SFC repartitioning.
+ *
+ * Every `cadence` steps `Update` compares the largest per-rank cost (e.g.
+ * step wall time or neighbor pair count) with the mean. When the ratio
+ * exceeds `threshold`, the particles are migrated along a new SFC partition
+ * whose parts carry equal total weight. The cost of a rank is spread
+ * uniformly over its particles unless per-particle weights are given, so
+ * that ranks that ran slow give away particles.
+ */
+class LoadBalancer {
+   public:
+    /**
+     * @brief Constructor for LoadBalancer.
+     *
+     * @param threshold Largest tolerated max/mean cost ratio (>= 1).
+     * @param cadence Number of steps between two checks (>= 1).
+     * @param comm MPI communicator.
+     * @throws std::invalid_argument On an invalid threshold or cadence.
+     */
+    explicit LoadBalancer(double threshold = 1.2, int cadence = 10,
+                          MPI_Comm comm = MPI_COMM_WORLD)
+        : m_threshold(threshold),
+          m_cadence(cadence),
+          m_comm(comm),
+          m_partition(comm),
+          m_migration(comm) {
+        if (threshold < 1.0) {
+            throw std::invalid_argument(
+                "LoadBalancer: threshold must be at least 1");
+        }
+        if (cadence < 1) {
+            throw std::invalid_argument(
+                "LoadBalancer: cadence must be at least 1");
+        }
+    }
+
+    /**
+     * @brief Returns the max/mean ratio of the per-rank costs (collective).
+     *
+     * @param local_cost Cost of this rank.
+     * @return Imbalance (1 when balanced or when the total cost is zero).
+     */
+    double Imbalance(const double local_cost) const {
+        double max_cost = local_cost;
+        double sum_cost = local_cost;
+        int size        = 1;
+        MPI_Comm_size(m_comm, &size);
+        MPI_Allreduce(MPI_IN_PLACE, &max_cost, 1, MPI_DOUBLE, MPI_MAX, m_comm);
+        MPI_Allreduce(MPI_IN_PLACE, &sum_cost, 1, MPI_DOUBLE, MPI_SUM, m_comm);
+        return sum_cost > 0.0 ? max_cost * size / sum_cost : 1.0;
+    }
+
+    /**
+     * @brief Checks the balance and repartitions if needed (collective).
+     *
+     * Does nothing (and does not communicate) when `step` is not a multiple
+     * of the cadence.
+     *
+     * @param step Time step index.
+     * @param particles Particle container (see `ParticleMigration`).
+     * @param local_cost Cost of this rank since the last check.
+     * @return True if the particles were migrated.
+     */
+    template <class Particles>
+    bool Update(const int step, Particles& particles, const double local_cost) {
+        if (step % m_cadence != 0) return false;
+        m_imbalance = Imbalance(local_cost);
+        if (m_imbalance <= m_threshold) return false;
+        Kokkos::View<double*> weights(
+            Kokkos::view_alloc(Kokkos::WithoutInitializing, "lb_weights"),
+            particles.Size());
+        const double n = static_cast<double>(particles.Size());
+        Kokkos::deep_copy(weights, n > 0.0 ? local_cost / n : 0.0);
+        Decompose(particles, weights);
+        return true;
+    }
+
+    /**
+     * @brief Checks the balance with per-particle costs (collective).
+     *
+     * @param step Time step index.
+     * @param particles Particle container (see `ParticleMigration`).
+     * @param weights Cost of each particle Kokkos view (e.g. neighbor
+     * counts).
+     * @return True if the particles were migrated.
+     */
+    template <class Particles>
+    bool Update(const int step, Particles& particles,
+                Kokkos::View<const double*> weights) {
+        if (step % m_cadence != 0) return false;
+        double local_cost = 0.0;
+        Kokkos::parallel_reduce(
+            "LoadBalancer::Cost", weights.extent(0),
+            KOKKOS_LAMBDA(const int i, double& cost) { cost += weights(i); },
+            local_cost);
+        m_imbalance = Imbalance(local_cost);
+        if (m_imbalance <= m_threshold) return false;
+        Decompose(particles, weights);
+        return true;
+    }
+
+    /**
+     * @brief Migrates the particles along a new SFC partition (collective).
+     *
+     * @param particles Particle container (see `ParticleMigration`).
+     * @param weights Cost of each particle Kokkos view.
+     * @throws std::invalid_argument If `weights` has the wrong size.
+     */
+    template <class Particles>
+    void Decompose(Particles& particles, Kokkos::View<const double*> weights) {
+        if (weights.extent(0) != particles.Size()) {
+            throw std::invalid_argument(
+                "LoadBalancer: one weight is needed per particle");
+        }
+        const auto x          = particles.X();
+        const BoundingBox box = SFCPartition::GlobalBox(x, m_comm);
+        Kokkos::View<std::uint64_t*> keys(
+            Kokkos::view_alloc(Kokkos::WithoutInitializing, "lb_keys"),
+            x.extent(0));
+        MortonEncoder(box).Keys(x, keys);
+        m_partition.Build(keys, weights);
+        Kokkos::View<int*> owner(
+            Kokkos::view_alloc(Kokkos::WithoutInitializing, "lb_owner"),
+            x.extent(0));
+        m_partition.Owners(keys, owner);
+        m_migration.Migrate(particles, owner);
+        ++m_n_rebalances;
+    }
+
+    /**
+     * @brief Migrates the particles along a new SFC partition with unit
+     * weights (collective).
+     *
+     * @param particles Particle container (see `ParticleMigration`).
+     */
+    template <class Particles>
+    void Decompose(Particles& particles) {
+        Kokkos::View<double*> weights(
+            Kokkos::view_alloc(Kokkos::WithoutInitializing, "lb_weights"),
+            particles.Size());
+        Kokkos::deep_copy(weights, 1.0);
+        Decompose(particles, weights);
+    }
+
+    /**
+     * @brief Returns the imbalance measured by the last check.
+     *
+     * @return Max/mean cost ratio.
+     */
+    double LastImbalance() const { return m_imbalance; }
+
+    /**
+     * @brief Returns the number of decompositions performed.
+     *
+     * @return Number of calls to `Decompose`.
+     */
+    int NumRebalances() const { return m_n_rebalances; }
+
+    /**
+     * @brief Returns the imbalance threshold.
+     *
+     * @return Largest tolerated max/mean cost ratio.
+     */
+    double Threshold() const { return m_threshold; }
+
+    /**
+     * @brief Returns the check cadence.
+     *
+     * @return Number of steps between two checks.
+     */
+    int Cadence() const { return m_cadence; }
+
+    /**
+     * @brief Returns the current partition.
+     *
+     * @return SFC partition of the last decomposition.
+     */
+    const SFCPartition& Partition() const { return m_partition; }
+
+   private:
+    /**
+     * @brief Largest tolerated max/mean cost ratio.
+     */
+    double m_threshold;
+    /**
+     * @brief Number of steps between two checks.
+     */
+    int m_cadence;
+    /**
+     * @brief MPI communicator.
+     */
+    MPI_Comm m_comm;
+    /**
+     * @brief SFC partition.
+     */
+    SFCPartition m_partition;
+    /**
+     * @brief Particle migration.
+     */
+    ParticleMigration m_migration;
+    /**
+     * @brief Imbalance measured by the last check.
+     */
+    double m_imbalance = 1.0;
+    /**
+     * @brief Number of decompositions performed.
+     */
+    int m_n_rebalances = 0;
+};
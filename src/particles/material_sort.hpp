@@ -0,0 +1,150 @@
+#pragma once
+
+#include <cstdint>
+#include <stdexcept>
+#include <string>
+
+// Kokkos includes
+#include <Kokkos_Core.hpp>
+#include <Kokkos_Sort.hpp>
+
+#include "host_mirror_pool.hpp"
+#include "particle_permutation.hpp"
+
+/**
+ * @file material_sort.hpp
+ * @brief Defines the MaterialSort class for material-contiguous particle
+ * ordering.
+ *
+ * This file provides the `MaterialSort` class, which sorts particles by
+ * material (part or EOS id) and records the offsets of each material block so
+ * that every EOS can be evaluated on a contiguous Kokkos subview.
+ */
+
+/**
+ * @class MaterialSort
+ * @brief Stable sort of particles by material id with per-material offsets.
+ *
+ * After `Build`, the particle fields reordered with `Permutation().Apply()`
+ * store all particles of material `m` in the index range `Range(m)`. The sort
+ * is stable: particles of a same material keep their relative order.
+ */
+class MaterialSort {
+   public:
+    /**
+     * @brief Default constructor (no material).
+     */
+    MaterialSort() = default;
+
+    /**
+     * @brief Computes the material ordering.
+     *
+     * Can be called at load time and again on demand (e.g. after particles
+     * migrated); the resulting permutation is relative to the ordering of
+     * `material_id` at the time of the call.
+     *
+     * @param material_id Per-particle material id Kokkos view, with values in
+     * [0, n_materials).
+     * @param n_materials Number of materials.
+     * @throws std::invalid_argument If a material id is out of range.
+     */
+    void Build(Kokkos::View<const int*> material_id, const int n_materials) {
+        const auto N = static_cast<int>(material_id.extent(0));
+
+        // Sort composite (material, index) keys: stable and deterministic
+        Kokkos::View<std::uint64_t*> keys(
+            Kokkos::view_alloc(Kokkos::WithoutInitializing, "material_keys"),
+            N);
+        Kokkos::View<int*> counts("material_counts", n_materials);
+        int n_invalid = 0;
+        Kokkos::parallel_reduce(
+            "MaterialSort::Keys", N,
+            KOKKOS_LAMBDA(const int i, int& invalid) {
+                const int m = material_id(i);
+                if (m < 0 || m >= n_materials) {
+                    ++invalid;
+                    return;
+                }
+                keys(i) = (static_cast<std::uint64_t>(m) << 32) |
+                          static_cast<std::uint64_t>(i);
+                Kokkos::atomic_add(&counts(m), 1);
+            },
+            n_invalid);
+        if (n_invalid > 0) {
+            throw std::invalid_argument(
+                "MaterialSort: " + std::to_string(n_invalid) +
+                " particle(s) with a material id outside [0, " +
+                std::to_string(n_materials) + ")");
+        }
+        Kokkos::sort(keys);
+
+        Kokkos::View<int*> permute(
+            Kokkos::view_alloc(Kokkos::WithoutInitializing, "permutation"), N);
+        Kokkos::parallel_for(
+            "MaterialSort::Permutation", N, KOKKOS_LAMBDA(const int i) {
+                permute(i) = static_cast<int>(keys(i) & 0xffffffffULL);
+            });
+        m_permutation = ParticlePermutation(permute);
+
+        // Offsets of each material block (few materials: host scan)
+        const auto host_counts = HostMirrorPool::Global().Mirror(counts);
+        Kokkos::deep_copy(host_counts.view, counts);
+        if (m_offsets.extent(0) != static_cast<std::size_t>(n_materials + 1)) {
+            m_offsets = Kokkos::View<int*, Kokkos::HostSpace>(
+                "material_offsets", n_materials + 1);
+        }
+        m_offsets(0) = 0;
+        for (int m = 0; m < n_materials; ++m) {
+            m_offsets(m + 1) = m_offsets(m) + host_counts.view(m);
+        }
+    }
+
+    /**
+     * @brief Returns the index range of a material in the sorted ordering.
+     *
+     * Meant to be passed to `Kokkos::subview`.
+     *
+     * @param material Material id.
+     * @return Half-open index range [first, second).
+     */
+    Kokkos::pair<int, int> Range(const int material) const {
+        return Kokkos::make_pair(m_offsets(material), m_offsets(material + 1));
+    }
+
+    /**
+     * @brief Returns the number of materials.
+     *
+     * @return Number of materials.
+     */
+    int NumMaterials() const {
+        return m_offsets.extent(0) > 0
+                   ? static_cast<int>(m_offsets.extent(0)) - 1
+                   : 0;
+    }
+
+    /**
+     * @brief Returns the material offsets table (size `NumMaterials() + 1`).
+     *
+     * @return Host view of offsets.
+     */
+    Kokkos::View<const int*, Kokkos::HostSpace> Offsets() const {
+        return m_offsets;
+    }
+
+    /**
+     * @brief Returns the permutation to the material ordering.
+     *
+     * @return Particle permutation and its inverse.
+     */
+    const ParticlePermutation& Permutation() const { return m_permutation; }
+
+   private:
+    /**
+     * @brief Permutation from the input ordering to the material ordering.
+     */
+    ParticlePermutation m_permutation;
+    /**
+     * @brief First particle of each material, plus the total count (host).
+     */
+    Kokkos::View<int*, Kokkos::HostSpace> m_offsets;
+};
@@ -0,0 +1,180 @@
+#pragma once
+
+#include <cstdint>
+
+// Kokkos includes
+#include <Kokkos_Core.hpp>
+
+/**
+ * @file morton.hpp
+ * @brief Defines Morton (Z-order) space-filling-curve keys for particles.
+ *
+ * This file provides the `BoundingBox` structure and the `MortonEncoder`
+ * class, which maps particle positions to 63-bit Morton keys (21 bits per
+ * direction). Particles that are close along the curve are close in space,
+ * which makes the keys suitable both for cache-friendly particle ordering and
+ * for domain decomposition.
+ */
+
+/**
+ * @struct BoundingBox
+ * @brief Axis-aligned bounding box.
+ */
+struct BoundingBox {
+    /**
+     * @brief Lower corner.
+     */
+    Kokkos::Array<double, 3> lo = {0.0, 0.0, 0.0};
+    /**
+     * @brief Upper corner.
+     */
+    Kokkos::Array<double, 3> hi = {0.0, 0.0, 0.0};
+
+    /**
+     * @brief Computes the bounding box of a set of particles.
+     *
+     * @param x Particle positions Kokkos view (N x 3).
+     * @return Bounding box (degenerate box at the origin if `x` is empty).
+     */
+    template <class PositionView>
+    static BoundingBox Of(const PositionView& x) {
+        BoundingBox box;
+        if (x.extent(0) == 0) return box;
+        Kokkos::parallel_reduce(
+            "BoundingBox::Of", x.extent(0),
+            KOKKOS_LAMBDA(const int i, double& xmin, double& ymin, double& zmin,
+                          double& xmax, double& ymax, double& zmax) {
+                xmin = Kokkos::min(xmin, x(i, 0));
+                ymin = Kokkos::min(ymin, x(i, 1));
+                zmin = Kokkos::min(zmin, x(i, 2));
+                xmax = Kokkos::max(xmax, x(i, 0));
+                ymax = Kokkos::max(ymax, x(i, 1));
+                zmax = Kokkos::max(zmax, x(i, 2));
+            },
+            Kokkos::Min<double>(box.lo[0]), Kokkos::Min<double>(box.lo[1]),
+            Kokkos::Min<double>(box.lo[2]), Kokkos::Max<double>(box.hi[0]),
+            Kokkos::Max<double>(box.hi[1]), Kokkos::Max<double>(box.hi[2]));
+        return box;
+    }
+};
+
+/**
+ * @class MortonEncoder
+ * @brief Device-copyable Morton key encoder over a bounding box.
+ *
+ * Positions are quantized on a cubic 2^21 x 2^21 x 2^21 lattice covering the
+ * bounding box (the largest box edge is used in every direction so that the
+ * curve preserves distances isotropically), then the bits of the three
+ * integer coordinates are interleaved.
+ */
+class MortonEncoder {
+   public:
+    /**
+     * @brief Number of bits per direction.
+     */
+    static constexpr int bits = 21;
+
+    /**
+     * @brief Default constructor (unit box at the origin).
+     */
+    MortonEncoder() = default;
+
+    /**
+     * @brief Constructor for MortonEncoder.
+     *
+     * @param box Bounding box of all the particles to be encoded
+     * consistently (e.g. the global box across MPI ranks).
+     */
+    explicit MortonEncoder(const BoundingBox& box) : m_lo(box.lo) {
+        double extent = 0.0;
+        for (int d = 0; d < 3; ++d) {
+            extent = Kokkos::max(extent, box.hi[d] - box.lo[d]);
+        }
+        const double cells = static_cast<double>((1u << bits) - 1);
+        m_scale            = extent > 0.0 ? cells / extent : 0.0;
+    }
+
+    /**
+     * @brief Returns the Morton key of a position.
+     *
+     * @param x Position along x.
+     * @param y Position along y.
+     * @param z Position along z.
+     * @return 63-bit Morton key.
+     */
+    KOKKOS_INLINE_FUNCTION std::uint64_t operator()(const double x,
+                                                    const double y,
+                                                    const double z) const {
+        return Interleave(Quantize(x, 0), Quantize(y, 1), Quantize(z, 2));
+    }
+
+    /**
+     * @brief Quantizes a position component on the 2^21 lattice.
+     *
+     * @param x Position component.
+     * @param d Direction.
+     * @return Integer lattice coordinate, clamped to the box.
+     */
+    KOKKOS_INLINE_FUNCTION std::uint32_t Quantize(const double x,
+                                                  const int d) const {
+        const double max_coord = static_cast<double>((1u << bits) - 1);
+        const double q =
+            Kokkos::min(Kokkos::max((x - m_lo[d]) * m_scale, 0.0), max_coord);
+        return static_cast<std::uint32_t>(q);
+    }
+
+    /**
+     * @brief Interleaves the bits of three 21-bit integer coordinates.
+     *
+     * @param ix Integer coordinate along x.
+     * @param iy Integer coordinate along y.
+     * @param iz Integer coordinate along z.
+     * @return 63-bit Morton key.
+     */
+    KOKKOS_INLINE_FUNCTION static std::uint64_t Interleave(
+        const std::uint32_t ix, const std::uint32_t iy,
+        const std::uint32_t iz) {
+        return Spread(ix) | (Spread(iy) << 1) | (Spread(iz) << 2);
+    }
+
+    /**
+     * @brief Inserts two zero bits between each of the 21 low bits of `v`.
+     *
+     * @param v Integer coordinate.
+     * @return Spread bits.
+     */
+    KOKKOS_INLINE_FUNCTION static std::uint64_t Spread(const std::uint32_t v) {
+        std::uint64_t b = v & 0x1fffffULL;
+        b = (b | (b << 32)) & 0x1f00000000ffffULL;
+        b = (b | (b << 16)) & 0x1f0000ff0000ffULL;
+        b = (b | (b << 8)) & 0x100f00f00f00f00fULL;
+        b = (b | (b << 4)) & 0x10c30c30c30c30c3ULL;
+        b = (b | (b << 2)) & 0x1249249249249249ULL;
+        return b;
+    }
+
+    /**
+     * @brief Computes the Morton keys of a set of particles.
+     *
+     * @param x Particle positions Kokkos view (N x 3).
+     * @param keys Morton keys Kokkos view (output, size N).
+     */
+    template <class PositionView>
+    void Keys(const PositionView& x, Kokkos::View<std::uint64_t*> keys) const {
+        const MortonEncoder encoder = *this;
+        Kokkos::parallel_for(
+            "MortonEncoder::Keys", x.extent(0), KOKKOS_LAMBDA(const int i) {
+                keys(i) = encoder(x(i, 0), x(i, 1), x(i, 2));
+            });
+    }
+
+   private:
+    /**
+     * @brief Lower corner of the encoded box.
+     */
+    Kokkos::Array<double, 3> m_lo = {0.0, 0.0, 0.0};
+    /**
+     * @brief Lattice cells per unit length.
+     */
+    double m_scale = 0.0;
+};
@@ -0,0 +1,439 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <limits>
+#include <stdexcept>
+#include <string>
+
+// Kokkos includes
+#include <Kokkos_Core.hpp>
+
+#include "device_arena.hpp"
+#include "particle_permutation.hpp"
+
+/**
+ * @file particle_data.hpp
+ * @brief Defines the ParticleData class, the structure-of-arrays storage of
+ * all particle fields.
+ *
+ * This file provides the `ParticleData` class, which owns every per-particle
+ * field as a separate Kokkos view. Fields are allocated with a capacity
+ * larger than the number of particles so that adding or removing particles
+ * does not reallocate them every time.
+ */
+
+/**
+ * @class ParticleData
+ * @brief Structure-of-arrays storage of particle fields.
+ *
+ * The accessors return views of the first `Size()` entries, so kernels can
+ * use `extent(0)` as the number of particles. Code that must visit every
+ * field (permutations, output, checkpoints, ...) uses `ForEachField`, so a
+ * new field only has to be declared here.
+ *
+ * @tparam VectorLayout Kokkos layout of the vector fields (positions,
+ * velocities, accelerations): `LayoutRight` stores the three components of a
+ * particle together, `LayoutLeft` stores each component contiguously.
+ * @tparam DerivedScalar Scalar type of the fields recomputed from the state
+ * at every step (pressure, speed of sound); `float` halves their memory
+ * traffic.
+ */
+template <class VectorLayout = Kokkos::LayoutRight,
+          typename DerivedScalar = double>
+class ParticleData {
+   public:
+    /**
+     * @brief Vector field view type (capacity x 3).
+     */
+    using vector_view = Kokkos::View<double* [3], VectorLayout>;
+    /**
+     * @brief Scalar state field view type.
+     */
+    using scalar_view = Kokkos::View<double*>;
+    /**
+     * @brief Derived scalar field view type.
+     */
+    using derived_view = Kokkos::View<DerivedScalar*>;
+    /**
+     * @brief Integer field view type.
+     */
+    using index_view = Kokkos::View<int*>;
+
+    /**
+     * @brief Constructor for ParticleData.
+     *
+     * @param n Initial number of particles.
+     * @param growth_factor Capacity growth factor when the storage is full.
+     * @throws std::invalid_argument If `growth_factor` is not above 1.
+     */
+    explicit ParticleData(const std::size_t n       = 0,
+                          const double growth_factor = 1.5)
+        : m_growth_factor(growth_factor) {
+        if (growth_factor <= 1.0) {
+            throw std::invalid_argument(
+                "ParticleData: growth_factor must be greater than 1");
+        }
+        Reserve(n);
+        m_size = n;
+    }
+
+    /**
+     * @brief Returns the number of particles.
+     *
+     * @return Number of particles.
+     */
+    std::size_t Size() const { return m_size; }
+
+    /**
+     * @brief Returns the number of particles that fit without reallocation.
+     *
+     * @return Capacity.
+     */
+    std::size_t Capacity() const { return m_capacity; }
+
+    /**
+     * @brief Grows the capacity (never shrinks), preserving the contents.
+     *
+     * @param capacity Requested capacity.
+     */
+    void Reserve(const std::size_t capacity) {
+        if (capacity <= m_capacity) return;
+        m_capacity = capacity;
+        ForEachStorage([&](const std::string&, auto& field) {
+            Kokkos::resize(field, m_capacity);
+        });
+    }
+
+    /**
+     * @brief Changes the number of particles.
+     *
+     * When the capacity is exceeded it grows by `growth_factor`, so that a
+     * sequence of insertions reallocates a logarithmic number of times.
+     * Existing particles are preserved; new particles are zero-initialized
+     * on reallocation and otherwise keep stale values, except for
+     * `RhoEOS`, which is NaN so that `EOSLazy` evaluates them.
+     *
+     * @param n New number of particles.
+     */
+    void Resize(const std::size_t n) {
+        if (n > m_capacity) {
+            const auto grown =
+                static_cast<std::size_t>(m_capacity * m_growth_factor);
+            Reserve(std::max(n, grown));
+        }
+        if (n > m_size) {
+            Kokkos::deep_copy(
+                Kokkos::subview(m_rho_eos, Kokkos::make_pair(m_size, n)),
+                std::numeric_limits<double>::quiet_NaN());
+        }
+        m_size = n;
+    }
+
+    /**
+     * @brief Appends particles.
+     *
+     * @param n Number of particles to append.
+     * @return Index of the first appended particle.
+     */
+    std::size_t Add(const std::size_t n) {
+        const std::size_t first = m_size;
+        Resize(m_size + n);
+        return first;
+    }
+
+    /**
+     * @brief Removes the particles whose flag is zero, keeping the order of
+     * the others.
+     *
+     * @param keep Per-particle flag Kokkos view (size `Size()`).
+     * @throws std::invalid_argument If `keep` has the wrong size.
+     */
+    void Compact(Kokkos::View<const int*> keep) {
+        if (keep.extent(0) != m_size) {
+            throw std::invalid_argument(
+                "ParticleData: keep flags must have one entry per particle");
+        }
+        std::size_t n_keep = 0;
+        Kokkos::parallel_reduce(
+            "ParticleData::CountKept", m_size,
+            KOKKOS_LAMBDA(const int i, std::size_t& count) {
+                count += keep(i) != 0;
+            },
+            n_keep);
+        // The map lives in the device arena until the last gather
+        auto& arena = DeviceArena::Global();
+        const DeviceArena::Scope scope(arena);
+        const auto map = arena.Allocate<ArenaView<int*>>(n_keep);
+        Kokkos::parallel_scan(
+            "ParticleData::Compact", m_size,
+            KOKKOS_LAMBDA(const int i, int& offset, const bool final) {
+                if (keep(i) == 0) return;
+                if (final) map(offset) = i;
+                ++offset;
+            });
+        ForEachField([&](const std::string&, const auto& field) {
+            ParticlePermutation::Gather(field, map);
+        });
+        m_size = n_keep;
+    }
+
+    /**
+     * @brief Reorders all the fields.
+     *
+     * @param permutation Permutation to apply (size `Size()`).
+     */
+    void Apply(const ParticlePermutation& permutation) const {
+        ForEachField([&](const std::string&, const auto& field) {
+            permutation.Apply(field);
+        });
+    }
+
+    /**
+     * @brief Restores the ordering of all the fields before a permutation.
+     *
+     * @param permutation Permutation to revert (size `Size()`).
+     */
+    void Revert(const ParticlePermutation& permutation) const {
+        ForEachField([&](const std::string&, const auto& field) {
+            permutation.Revert(field);
+        });
+    }
+
+    /**
+     * @brief Calls `f(name, field)` for every field, where `field` is the
+     * view of the first `Size()` particles.
+     *
+     * @param f Callable taking a field name and a Kokkos view.
+     */
+    template <class F>
+    void ForEachField(F&& f) const {
+        f("x", X());
+        f("v", V());
+        f("a", A());
+        f("mass", Mass());
+        f("h", H());
+        f("rho", Rho());
+        f("eint", Eint());
+        f("deint_dt", DEintDt());
+        f("p", P());
+        f("sos", SoS());
+        f("rho_eos", RhoEOS());
+        f("eint_eos", EintEOS());
+        f("eos_id", EOSId());
+        f("part_id", PartId());
+    }
+
+    /**
+     * @brief Returns the positions.
+     *
+     * @return Kokkos view (N x 3).
+     */
+    auto X() const { return Head(m_x); }
+
+    /**
+     * @brief Returns the velocities.
+     *
+     * @return Kokkos view (N x 3).
+     */
+    auto V() const { return Head(m_v); }
+
+    /**
+     * @brief Returns the accelerations.
+     *
+     * @return Kokkos view (N x 3).
+     */
+    auto A() const { return Head(m_a); }
+
+    /**
+     * @brief Returns the masses.
+     *
+     * @return Kokkos view (N).
+     */
+    auto Mass() const { return Head(m_mass); }
+
+    /**
+     * @brief Returns the smoothing lengths.
+     *
+     * @return Kokkos view (N).
+     */
+    auto H() const { return Head(m_h); }
+
+    /**
+     * @brief Returns the densities.
+     *
+     * @return Kokkos view (N).
+     */
+    auto Rho() const { return Head(m_rho); }
+
+    /**
+     * @brief Returns the specific internal energies.
+     *
+     * @return Kokkos view (N).
+     */
+    auto Eint() const { return Head(m_eint); }
+
+    /**
+     * @brief Returns the rates of change of the specific internal energies.
+     *
+     * @return Kokkos view (N).
+     */
+    auto DEintDt() const { return Head(m_deint_dt); }
+
+    /**
+     * @brief Returns the pressures.
+     *
+     * @return Kokkos view (N).
+     */
+    auto P() const { return Head(m_p); }
+
+    /**
+     * @brief Returns the speeds of sound.
+     *
+     * The EOS store the squared speed of sound (e.g. `gamma p / rho`).
+     *
+     * @return Kokkos view (N).
+     */
+    auto SoS() const { return Head(m_sos); }
+
+    /**
+     * @brief Returns the densities of the last EOS evaluations.
+     *
+     * State the pressure and speed of sound were computed for (see
+     * `EOSLazy`); stored per particle so that it moves with the rows.
+     *
+     * @return Kokkos view (N).
+     */
+    auto RhoEOS() const { return Head(m_rho_eos); }
+
+    /**
+     * @brief Returns the internal energies of the last EOS evaluations.
+     *
+     * @return Kokkos view (N).
+     */
+    auto EintEOS() const { return Head(m_eint_eos); }
+
+    /**
+     * @brief Returns the EOS ids.
+     *
+     * @return Kokkos view (N).
+     */
+    auto EOSId() const { return Head(m_eos_id); }
+
+    /**
+     * @brief Returns the part ids.
+     *
+     * @return Kokkos view (N).
+     */
+    auto PartId() const { return Head(m_part_id); }
+
+   private:
+    /**
+     * @brief Calls `f(name, storage)` for the full-capacity view of every
+     * field.
+     *
+     * @param f Callable taking a field name and a Kokkos view reference.
+     */
+    template <class F>
+    void ForEachStorage(F&& f) {
+        f("x", m_x);
+        f("v", m_v);
+        f("a", m_a);
+        f("mass", m_mass);
+        f("h", m_h);
+        f("rho", m_rho);
+        f("eint", m_eint);
+        f("deint_dt", m_deint_dt);
+        f("p", m_p);
+        f("sos", m_sos);
+        f("rho_eos", m_rho_eos);
+        f("eint_eos", m_eint_eos);
+        f("eos_id", m_eos_id);
+        f("part_id", m_part_id);
+    }
+
+    /**
+     * @brief Returns the first `Size()` rows of a field.
+     *
+     * @param field Full-capacity view.
+     * @return Kokkos subview.
+     */
+    template <class ViewType>
+    auto Head(const ViewType& field) const {
+        const auto rows = Kokkos::make_pair(std::size_t(0), m_size);
+        if constexpr (ViewType::rank == 1) {
+            return Kokkos::subview(field, rows);
+        } else {
+            return Kokkos::subview(field, rows, Kokkos::ALL);
+        }
+    }
+
+    /**
+     * @brief Number of particles.
+     */
+    std::size_t m_size = 0;
+    /**
+     * @brief Number of allocated particles.
+     */
+    std::size_t m_capacity = 0;
+    /**
+     * @brief Capacity growth factor.
+     */
+    double m_growth_factor;
+    /**
+     * @brief Positions.
+     */
+    vector_view m_x{"x", 0};
+    /**
+     * @brief Velocities.
+     */
+    vector_view m_v{"v", 0};
+    /**
+     * @brief Accelerations.
+     */
+    vector_view m_a{"a", 0};
+    /**
+     * @brief Masses.
+     */
+    scalar_view m_mass{"mass", 0};
+    /**
+     * @brief Smoothing lengths.
+     */
+    scalar_view m_h{"h", 0};
+    /**
+     * @brief Densities.
+     */
+    scalar_view m_rho{"rho", 0};
+    /**
+     * @brief Specific internal energies.
+     */
+    scalar_view m_eint{"eint", 0};
+    /**
+     * @brief Rates of change of the specific internal energies.
+     */
+    scalar_view m_deint_dt{"deint_dt", 0};
+    /**
+     * @brief Pressures.
+     */
+    derived_view m_p{"p", 0};
+    /**
+     * @brief Speeds of sound.
+     */
+    derived_view m_sos{"sos", 0};
+    /**
+     * @brief Densities of the last EOS evaluations.
+     */
+    scalar_view m_rho_eos{"rho_eos", 0};
+    /**
+     * @brief Internal energies of the last EOS evaluations.
+     */
+    scalar_view m_eint_eos{"eint_eos", 0};
+    /**
+     * @brief EOS ids.
+     */
+    index_view m_eos_id{"eos_id", 0};
+    /**
+     * @brief Part ids.
+     */
+    index_view m_part_id{"part_id", 0};
+};
@@ -0,0 +1,159 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <stdexcept>
+#include <vector>
+
+// mpi includes
+#include <mpi.h>
+// Kokkos includes
+#include <Kokkos_Core.hpp>
+#include <Kokkos_Sort.hpp>
+
+#include "device_arena.hpp"
+#include "host_mirror_pool.hpp"
+#include "particle_transfer.hpp"
+#include "profiler.hpp"
+
+/**
+ * @file particle_migration.hpp
+ * @brief Defines the ParticleMigration class for moving particles to their
+ * owning rank.
+ *
+ * This file provides the `ParticleMigration` class, which sends every
+ * particle to the rank given by a domain decomposition (e.g.
+ * `SFCPartition::Owners`) and appends the particles received from the other
+ * ranks.
+ */
+
+/**
+ * @class ParticleMigration
+ * @brief Redistribution of the particles among the ranks.
+ *
+ * The particles kept by a rank stay first, in their original order, followed
+ * by the received particles grouped by source rank.
+ */
+class ParticleMigration {
+   public:
+    /**
+     * @brief Constructor for ParticleMigration.
+     *
+     * @param comm MPI communicator.
+     */
+    explicit ParticleMigration(MPI_Comm comm = MPI_COMM_WORLD)
+        : m_comm(comm), m_transfer(comm, 2) {
+        MPI_Comm_rank(m_comm, &m_rank);
+        MPI_Comm_size(m_comm, &m_size);
+    }
+
+    /**
+     * @brief Moves the particles to their owning rank (collective).
+     *
+     * @param particles Particle container providing `Size`, `Resize`,
+     * `Compact` and `ForEachField`.
+     * @param owner Owning rank of each particle Kokkos view.
+     * @return New number of local particles.
+     * @throws std::invalid_argument If `owner` has the wrong size.
+     */
+    template <class Particles>
+    std::size_t Migrate(Particles& particles, Kokkos::View<const int*> owner) {
+        ProfilingRegion region("Migration");
+        const std::size_t N = particles.Size();
+        if (owner.extent(0) != N) {
+            throw std::invalid_argument(
+                "ParticleMigration: one owner is needed per particle");
+        }
+        const int rank = m_rank;
+        const int size = m_size;
+
+        // Number of particles per destination
+        Kokkos::View<int*> counts("migration_counts", size);
+        Kokkos::parallel_for(
+            "ParticleMigration::Count", N, KOKKOS_LAMBDA(const int i) {
+                if (owner(i) != rank) {
+                    Kokkos::atomic_add(&counts(owner(i)), 1);
+                }
+            });
+        const auto host_counts = HostMirrorPool::Global().Mirror(counts);
+        Kokkos::deep_copy(host_counts.view, counts);
+        std::vector<int> send_all(host_counts.view.data(),
+                                  host_counts.view.data() + size);
+        std::vector<int> recv_all(size);
+        MPI_Alltoall(send_all.data(), 1, MPI_INT, recv_all.data(), 1, MPI_INT,
+                     m_comm);
+
+        std::vector<int> send_ranks, send_counts, recv_ranks, recv_counts;
+        int n_send = 0;
+        for (int r = 0; r < size; ++r) {
+            n_send += send_all[r];
+            if (send_all[r] > 0) {
+                send_ranks.push_back(r);
+                send_counts.push_back(send_all[r]);
+            }
+            if (recv_all[r] > 0) {
+                recv_ranks.push_back(r);
+                recv_counts.push_back(recv_all[r]);
+            }
+        }
+
+        // Send indices grouped by destination, in particle order: one pass
+        // packs the composite (owner, index) keys of the leaving particles,
+        // whose sort is stable and deterministic (as in `MaterialSort`); the
+        // keys and the keep flags are scratch of the device arena
+        auto& arena = DeviceArena::Global();
+        const DeviceArena::Scope scope(arena);
+        const auto keys = arena.Allocate<ArenaView<std::uint64_t*>>(n_send);
+        const auto keep = arena.Allocate<ArenaView<int*>>(N);
+        Kokkos::parallel_scan(
+            "ParticleMigration::Select", N,
+            KOKKOS_LAMBDA(const int i, int& offset, const bool final) {
+                const bool stays = owner(i) == rank;
+                if (final) {
+                    keep(i) = stays;
+                    if (!stays) {
+                        keys(offset) =
+                            (static_cast<std::uint64_t>(owner(i)) << 32) |
+                            static_cast<std::uint64_t>(i);
+                    }
+                }
+                offset += !stays;
+            });
+        Kokkos::sort(keys);
+        Kokkos::View<int*> send_index(
+            Kokkos::view_alloc(Kokkos::WithoutInitializing, "migration_send"),
+            n_send);
+        Kokkos::parallel_for(
+            "ParticleMigration::SendIndex", n_send, KOKKOS_LAMBDA(const int k) {
+                send_index(k) = static_cast<int>(keys(k) & 0xffffffffULL);
+            });
+
+        m_transfer.Setup(send_index, send_ranks, send_counts, recv_ranks,
+                         recv_counts);
+        m_transfer.Begin(particles);
+        // The packed buffers are independent of the container from here on
+        particles.Compact(keep);
+        const std::size_t n_keep = particles.Size();
+        particles.Resize(n_keep + m_transfer.NumRecv());
+        m_transfer.End(particles, n_keep);
+        return particles.Size();
+    }
+
+   private:
+    /**
+     * @brief MPI communicator.
+     */
+    MPI_Comm m_comm;
+    /**
+     * @brief MPI rank.
+     */
+    int m_rank = 0;
+    /**
+     * @brief Number of MPI ranks.
+     */
+    int m_size = 1;
+    /**
+     * @brief Point-to-point transfer of the migrating particles.
+     */
+    ParticleTransfer m_transfer;
+};
@@ -0,0 +1,199 @@
+#pragma once
+
+#include <type_traits>
+
+// Kokkos includes
+#include <Kokkos_Core.hpp>
+
+#include "device_arena.hpp"
+
+/**
+ * @file particle_permutation.hpp
+ * @brief Defines the ParticlePermutation class used to reorder particle
+ * fields.
+ *
+ * This file provides the `ParticlePermutation` class, which stores a particle
+ * reordering together with its inverse and applies it to Kokkos views of
+ * particle fields, so that data can be processed in a sorted order and still
+ * be written back in the original order.
+ */
+
+/**
+ * @class ParticlePermutation
+ * @brief Particle reordering with its inverse.
+ *
+ * `Permute()(i)` is the index, in the previous ordering, of the particle
+ * stored at position `i` of the new ordering. `Inverse()(j)` is the new
+ * position of the particle previously stored at position `j`.
+ */
+class ParticlePermutation {
+   public:
+    /**
+     * @brief Default constructor (empty permutation).
+     */
+    ParticlePermutation() = default;
+
+    /**
+     * @brief Constructor for ParticlePermutation.
+     *
+     * Takes ownership of a new-to-old index map and computes its inverse.
+     *
+     * @param permute New-to-old index map (must be a permutation of
+     * [0, N)).
+     */
+    explicit ParticlePermutation(Kokkos::View<int*> permute)
+        : m_permute(permute),
+          m_inverse(Kokkos::view_alloc(Kokkos::WithoutInitializing,
+                                       "inverse_permutation"),
+                    permute.extent(0)) {
+        Invert(m_permute, m_inverse);
+    }
+
+    /**
+     * @brief Computes the inverse of an index map.
+     *
+     * @param permute Index map (permutation of [0, N)).
+     * @param inverse Inverse index map (output).
+     */
+    static void Invert(Kokkos::View<const int*> permute,
+                       Kokkos::View<int*> inverse) {
+        Kokkos::parallel_for(
+            "ParticlePermutation::Invert", permute.extent(0),
+            KOKKOS_LAMBDA(const int i) { inverse(permute(i)) = i; });
+    }
+
+    /**
+     * @brief Builds the identity permutation.
+     *
+     * @param n Number of particles.
+     * @return Identity permutation of size `n`.
+     */
+    static ParticlePermutation Identity(const int n) {
+        Kokkos::View<int*> permute(
+            Kokkos::view_alloc(Kokkos::WithoutInitializing, "permutation"), n);
+        Kokkos::parallel_for(
+            "ParticlePermutation::Identity", n,
+            KOKKOS_LAMBDA(const int i) { permute(i) = i; });
+        return ParticlePermutation(permute);
+    }
+
+    /**
+     * @brief Chains this permutation with a subsequent one.
+     *
+     * The result maps the ordering obtained after applying `next` directly
+     * to the ordering that preceded this permutation.
+     *
+     * @param next Permutation applied after this one.
+     * @return Composed permutation.
+     */
+    ParticlePermutation Compose(const ParticlePermutation& next) const {
+        const auto first  = m_permute;
+        const auto second = next.m_permute;
+        Kokkos::View<int*> permute(
+            Kokkos::view_alloc(Kokkos::WithoutInitializing, "permutation"),
+            second.extent(0));
+        Kokkos::parallel_for(
+            "ParticlePermutation::Compose", second.extent(0),
+            KOKKOS_LAMBDA(const int i) { permute(i) = first(second(i)); });
+        return ParticlePermutation(permute);
+    }
+
+    /**
+     * @brief Reorders particle fields in place (old to new ordering).
+     *
+     * Rank-1 views hold scalar fields, rank-2 views hold vector fields with
+     * the particle index as first dimension.
+     *
+     * @param fields Particle field Kokkos views.
+     */
+    template <class... ViewTypes>
+    void Apply(const ViewTypes&... fields) const {
+        (Gather(fields, m_permute), ...);
+    }
+
+    /**
+     * @brief Restores particle fields in place (new to old ordering).
+     *
+     * @param fields Particle field Kokkos views.
+     */
+    template <class... ViewTypes>
+    void Revert(const ViewTypes&... fields) const {
+        (Gather(fields, m_inverse), ...);
+    }
+
+    /**
+     * @brief Gathers `field(map(i))` into position `i` through a temporary.
+     *
+     * Building block of `Apply` and `Revert`. The temporary is taken from
+     * `DeviceArena::Global()` for the duration of the call.
+     *
+     * @param field Particle field Kokkos view (modified in place).
+     * @param map Index map (permutation of [0, N)).
+     */
+    template <class ViewType>
+    static void Gather(const ViewType& field, Kokkos::View<const int*> map) {
+        static_assert(ViewType::rank == 1 || ViewType::rank == 2,
+                      "ParticlePermutation: only rank-1 and rank-2 particle "
+                      "fields are supported");
+        // Strided fields (heads of LayoutLeft vectors) get a LayoutRight
+        // temporary
+        using Layout = std::conditional_t<
+            std::is_same_v<typename ViewType::array_layout,
+                           Kokkos::LayoutStride>,
+            Kokkos::LayoutRight, typename ViewType::array_layout>;
+        using Buffer =
+            ArenaView<typename ViewType::non_const_data_type, Layout>;
+        auto& arena = DeviceArena::Global();
+        const DeviceArena::Scope scope(arena);
+        Buffer buffer;
+        if constexpr (ViewType::rank_dynamic == 2) {
+            buffer = arena.Allocate<Buffer>(field.extent(0), field.extent(1));
+        } else {
+            buffer = arena.Allocate<Buffer>(field.extent(0));
+        }
+        const int ncomp = static_cast<int>(field.extent(1));
+        Kokkos::parallel_for(
+            "ParticlePermutation::Gather", map.extent(0),
+            KOKKOS_LAMBDA(const int i) {
+                if constexpr (ViewType::rank == 1) {
+                    buffer(i) = field(map(i));
+                } else {
+                    for (int d = 0; d < ncomp; ++d) {
+                        buffer(i, d) = field(map(i), d);
+                    }
+                }
+            });
+        Kokkos::deep_copy(field, buffer);
+    }
+
+    /**
+     * @brief Returns the number of particles.
+     *
+     * @return Size of the permutation.
+     */
+    int Size() const { return static_cast<int>(m_permute.extent(0)); }
+
+    /**
+     * @brief Returns the new-to-old index map.
+     *
+     * @return Device view of the permutation.
+     */
+    Kokkos::View<const int*> Permute() const { return m_permute; }
+
+    /**
+     * @brief Returns the old-to-new index map.
+     *
+     * @return Device view of the inverse permutation.
+     */
+    Kokkos::View<const int*> Inverse() const { return m_inverse; }
+
+   private:
+    /**
+     * @brief New-to-old index map (device memory).
+     */
+    Kokkos::View<int*> m_permute;
+    /**
+     * @brief Old-to-new index map (device memory).
+     */
+    Kokkos::View<int*> m_inverse;
+};
@@ -0,0 +1,455 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <limits>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+// mpi includes
+#include <mpi.h>
+// Kokkos includes
+#include <Kokkos_Core.hpp>
+
+#include "host_mirror_pool.hpp"
+
+/**
+ * @file particle_transfer.hpp
+ * @brief Defines the ParticleTransfer class for sending particle fields
+ * between MPI ranks.
+ *
+ * This file provides the `ParticleTransfer` class, the point-to-point layer
+ * shared by the halo exchange (`HaloExchange`) and the particle migration
+ * (`ParticleMigration`).
+ */
+
+/**
+ * @class ParticleTransfer
+ * @brief Non-blocking transfer of selected particles to other ranks.
+ *
+ * All the fields of a particle container (see `ParticleData::ForEachField`)
+ * are packed into one buffer, field after field, so that every field is
+ * gathered by a single kernel. Each peer then gets one message described by
+ * an MPI hindexed datatype over the field segments. Buffers live in the
+ * default memory space: with `SPHIROS_GPU_AWARE_MPI` their device pointers
+ * are handed to MPI directly, otherwise device buffers are staged through
+ * host-pinned mirrors borrowed from `HostMirrorPool::Global()`.
+ *
+ * The packing, staging copies and unpacking run on an execution space
+ * instance of their own (the default instance unless one is given, e.g. by
+ * `Kokkos::Experimental::partition_space`): `Begin` and `End` only fence
+ * that instance, so kernels enqueued on other instances keep running while
+ * the buffers are prepared.
+ */
+class ParticleTransfer {
+   public:
+    /**
+     * @brief Whether MPI accepts device pointers (`SPHIROS_GPU_AWARE_MPI`).
+     */
+#ifdef SPHIROS_GPU_AWARE_MPI
+    static constexpr bool gpu_aware_mpi = true;
+#else
+    static constexpr bool gpu_aware_mpi = false;
+#endif
+
+    /**
+     * @brief Constructor for ParticleTransfer.
+     *
+     * @param comm MPI communicator.
+     * @param tag MPI tag of the messages.
+     * @param exec Execution space instance of the transfer kernels and
+     * copies.
+     */
+    explicit ParticleTransfer(
+        MPI_Comm comm = MPI_COMM_WORLD, int tag = 0,
+        const Kokkos::DefaultExecutionSpace& exec = {})
+        : m_comm(comm), m_tag(tag), m_exec(exec) {}
+
+    ParticleTransfer(const ParticleTransfer&)            = delete;
+    ParticleTransfer& operator=(const ParticleTransfer&) = delete;
+
+    /**
+     * @brief Destructor for ParticleTransfer (waits for pending messages).
+     */
+    ~ParticleTransfer() { Wait(); }
+
+    /**
+     * @brief Sets the particles to send and the number of particles to
+     * receive from each peer.
+     *
+     * Every rank listed in `recv_ranks` must list this rank in its own
+     * `send_ranks` with the same count.
+     *
+     * @param send_index Local indices of the particles to send, grouped by
+     * destination in the order of `send_ranks`.
+     * @param send_ranks Destination ranks.
+     * @param send_counts Number of particles sent to each destination.
+     * @param recv_ranks Source ranks.
+     * @param recv_counts Number of particles received from each source.
+     * @throws std::invalid_argument On inconsistent sizes.
+     */
+    void Setup(Kokkos::View<const int*> send_index,
+               const std::vector<int>& send_ranks,
+               const std::vector<int>& send_counts,
+               const std::vector<int>& recv_ranks,
+               const std::vector<int>& recv_counts) {
+        if (send_ranks.size() != send_counts.size() ||
+            recv_ranks.size() != recv_counts.size()) {
+            throw std::invalid_argument(
+                "ParticleTransfer: one count is needed per peer");
+        }
+        m_send_index  = send_index;
+        m_send_ranks  = send_ranks;
+        m_recv_ranks  = recv_ranks;
+        m_send_offset = Offsets(send_counts);
+        m_recv_offset = Offsets(recv_counts);
+        if (m_send_offset.back() != send_index.extent(0)) {
+            throw std::invalid_argument(
+                "ParticleTransfer: send counts do not match the send indices");
+        }
+    }
+
+    /**
+     * @brief Packs the particles to send and posts the messages.
+     *
+     * The fields must be complete on the transfer instance (only reading
+     * them from other instances is safe meanwhile). The packing kernels and
+     * the staging copy run on the transfer instance, which is fenced before
+     * the messages are posted.
+     *
+     * @param particles Particle container providing `ForEachField`.
+     * @throws std::runtime_error If a transfer is already in flight.
+     */
+    template <class Particles>
+    void Begin(const Particles& particles) {
+        if (!m_requests.empty()) {
+            throw std::runtime_error(
+                "ParticleTransfer: previous transfer not completed");
+        }
+        m_field_bytes.clear();
+        particles.ForEachField([&](const std::string&, const auto& field) {
+            using ViewType = std::decay_t<decltype(field)>;
+            using T        = typename ViewType::non_const_value_type;
+            const std::size_t nc = ViewType::rank == 1 ? 1 : field.extent(1);
+            m_field_bytes.push_back(nc * sizeof(T));
+        });
+        const std::size_t n_send = m_send_offset.back();
+        const std::size_t n_recv = m_recv_offset.back();
+        Reserve(m_send, m_host_send, "transfer_send", SegmentStart(n_send));
+        Reserve(m_recv, m_host_recv, "transfer_recv", SegmentStart(n_recv));
+
+        std::size_t f = 0;
+        particles.ForEachField([&](const std::string&, const auto& field) {
+            Pack(field, m_send_index, m_send, SegmentStart(n_send, f++),
+                 m_exec);
+        });
+        if (Staged()) Kokkos::deep_copy(m_exec, m_host_send.view, m_send);
+        m_exec.fence("ParticleTransfer::Begin");
+
+        char* send = Staged() ? reinterpret_cast<char*>(m_host_send.view.data())
+                              : reinterpret_cast<char*>(m_send.data());
+        char* recv = Staged() ? reinterpret_cast<char*>(m_host_recv.view.data())
+                              : reinterpret_cast<char*>(m_recv.data());
+        for (std::size_t k = 0; k < m_recv_ranks.size(); ++k) {
+            Post(recv, m_recv_offset, n_recv, k, m_recv_ranks[k], false);
+        }
+        for (std::size_t k = 0; k < m_send_ranks.size(); ++k) {
+            Post(send, m_send_offset, n_send, k, m_send_ranks[k], true);
+        }
+    }
+
+    /**
+     * @brief Waits for the messages and unpacks the received particles.
+     *
+     * The unpacking runs on the transfer instance, which is fenced before
+     * returning: the received rows are then visible to every instance.
+     *
+     * @param particles Particle container providing `ForEachField`, with at
+     * least `first + NumRecv()` particles.
+     * @param first Row of the first received particle.
+     */
+    template <class Particles>
+    void End(const Particles& particles, const std::size_t first) {
+        Wait();
+        const std::size_t n_recv = m_recv_offset.back();
+        if (Staged()) Kokkos::deep_copy(m_exec, m_recv, m_host_recv.view);
+        std::size_t f = 0;
+        particles.ForEachField([&](const std::string&, const auto& field) {
+            Unpack(field, first, n_recv, m_recv, SegmentStart(n_recv, f++),
+                   m_exec);
+        });
+        m_exec.fence("ParticleTransfer::End");
+    }
+
+    /**
+     * @brief Waits for the pending messages without unpacking.
+     */
+    void Wait() {
+        if (m_requests.empty()) return;
+        MPI_Waitall(static_cast<int>(m_requests.size()), m_requests.data(),
+                    MPI_STATUSES_IGNORE);
+        m_requests.clear();
+    }
+
+    /**
+     * @brief Returns the number of particles sent.
+     *
+     * @return Number of sent particles.
+     */
+    std::size_t NumSend() const { return m_send_offset.back(); }
+
+    /**
+     * @brief Returns the number of particles received.
+     *
+     * @return Number of received particles.
+     */
+    std::size_t NumRecv() const { return m_recv_offset.back(); }
+
+    /**
+     * @brief Gathers `field(index(k))` into a segment of a buffer.
+     *
+     * Building block of `Begin`.
+     *
+     * @param field Particle field Kokkos view (rank 1 or 2).
+     * @param index Local indices of the particles to pack.
+     * @param buffer Transfer buffer.
+     * @param offset Byte offset of the segment (multiple of 8).
+     * @param exec Execution space instance running the kernel.
+     */
+    template <class ViewType>
+    static void Pack(const ViewType& field, Kokkos::View<const int*> index,
+                     const Kokkos::View<double*>& buffer,
+                     const std::size_t offset,
+                     const Kokkos::DefaultExecutionSpace& exec = {}) {
+        using T      = typename ViewType::non_const_value_type;
+        const int nc = ViewType::rank == 1 ? 1 : field.extent(1);
+        T* segment   = reinterpret_cast<T*>(
+            reinterpret_cast<char*>(buffer.data()) + offset);
+        Kokkos::parallel_for(
+            "ParticleTransfer::Pack",
+            Kokkos::RangePolicy<>(exec, 0, index.extent(0)),
+            KOKKOS_LAMBDA(const int k) {
+                if constexpr (ViewType::rank == 1) {
+                    segment[k] = field(index(k));
+                } else {
+                    for (int c = 0; c < nc; ++c) {
+                        segment[k * nc + c] = field(index(k), c);
+                    }
+                }
+            });
+    }
+
+    /**
+     * @brief Scatters a segment of a buffer into consecutive rows.
+     *
+     * Building block of `End`.
+     *
+     * @param field Particle field Kokkos view (rank 1 or 2).
+     * @param first First row to write.
+     * @param n Number of rows to write.
+     * @param buffer Transfer buffer.
+     * @param offset Byte offset of the segment (multiple of 8).
+     * @param exec Execution space instance running the kernel.
+     */
+    template <class ViewType>
+    static void Unpack(const ViewType& field, const std::size_t first,
+                       const std::size_t n,
+                       const Kokkos::View<double*>& buffer,
+                       const std::size_t offset,
+                       const Kokkos::DefaultExecutionSpace& exec = {}) {
+        using T       = typename ViewType::non_const_value_type;
+        const int nc  = ViewType::rank == 1 ? 1 : field.extent(1);
+        const T* data = reinterpret_cast<const T*>(
+            reinterpret_cast<const char*>(buffer.data()) + offset);
+        Kokkos::parallel_for(
+            "ParticleTransfer::Unpack", Kokkos::RangePolicy<>(exec, 0, n),
+            KOKKOS_LAMBDA(const int k) {
+                if constexpr (ViewType::rank == 1) {
+                    field(first + k) = data[k];
+                } else {
+                    for (int c = 0; c < nc; ++c) {
+                        field(first + k, c) = data[k * nc + c];
+                    }
+                }
+            });
+    }
+
+   private:
+    /**
+     * @brief Pooled host-pinned mirror type of the transfer buffers.
+     */
+    using HostBuffer =
+        HostMirrorPool::Mirrored<PooledView<Kokkos::View<double*>>>;
+
+    /**
+     * @brief Returns whether the buffers are staged through host mirrors.
+     *
+     * @return True if MPI cannot read the device buffers.
+     */
+    static constexpr bool Staged() {
+        return !gpu_aware_mpi &&
+               !Kokkos::SpaceAccessibility<
+                   Kokkos::HostSpace,
+                   Kokkos::DefaultExecutionSpace::memory_space>::accessible;
+    }
+
+    /**
+     * @brief Returns the exclusive prefix sum of per-peer counts.
+     *
+     * @param counts Per-peer counts.
+     * @return Offsets (size `counts.size() + 1`).
+     */
+    static std::vector<std::size_t> Offsets(const std::vector<int>& counts) {
+        std::vector<std::size_t> offsets(counts.size() + 1, 0);
+        for (std::size_t k = 0; k < counts.size(); ++k) {
+            offsets[k + 1] = offsets[k] + counts[k];
+        }
+        return offsets;
+    }
+
+    /**
+     * @brief Returns the byte offset of a field segment.
+     *
+     * Segments are padded to 8 bytes; `f` equal to the number of fields
+     * gives the total buffer size.
+     *
+     * @param n Number of particles in the buffer.
+     * @param f Field index.
+     * @return Byte offset.
+     */
+    std::size_t SegmentStart(const std::size_t n,
+                             const std::size_t f = std::size_t(-1)) const {
+        std::size_t offset = 0;
+        for (std::size_t g = 0; g < m_field_bytes.size() && g < f; ++g) {
+            offset += (n * m_field_bytes[g] + 7) / 8 * 8;
+        }
+        return offset;
+    }
+
+    /**
+     * @brief Grows a transfer buffer (and its host mirror) if needed.
+     *
+     * @param buffer Device buffer.
+     * @param host Host mirror (only borrowed when staging).
+     * @param label Buffer label.
+     * @param bytes Requested size in bytes.
+     */
+    static void Reserve(Kokkos::View<double*>& buffer, HostBuffer& host,
+                        const char* label, const std::size_t bytes) {
+        const std::size_t n = Kokkos::max((bytes + 7) / 8, std::size_t(1));
+        if (buffer.extent(0) >= n) return;
+        buffer = Kokkos::View<double*>(
+            Kokkos::view_alloc(Kokkos::WithoutInitializing, label), n);
+        if (Staged()) host = HostMirrorPool::Global().Mirror(buffer);
+    }
+
+    /**
+     * @brief Posts the message of one peer.
+     *
+     * The message is one `hindexed` datatype with a block per field; the
+     * block lengths are `int`, so a field segment of more than `INT_MAX`
+     * bytes is split into several blocks.
+     *
+     * @param base Buffer address.
+     * @param offset Per-peer particle offsets.
+     * @param n Number of particles in the buffer.
+     * @param k Peer index.
+     * @param rank Peer rank.
+     * @param send True to send, false to receive.
+     */
+    void Post(char* base, const std::vector<std::size_t>& offset,
+              const std::size_t n, const std::size_t k, const int rank,
+              const bool send) {
+        const std::size_t count = offset[k + 1] - offset[k];
+        if (count == 0) return;
+        constexpr std::size_t max_block = std::numeric_limits<int>::max();
+        std::vector<int> lengths;
+        std::vector<MPI_Aint> displacements;
+        for (std::size_t f = 0; f < m_field_bytes.size(); ++f) {
+            const std::size_t size = m_field_bytes[f];
+            std::size_t start      = SegmentStart(n, f) + offset[k] * size;
+            std::size_t bytes      = count * size;
+            while (bytes > 0) {
+                const std::size_t block = std::min(bytes, max_block);
+                lengths.push_back(static_cast<int>(block));
+                displacements.push_back(static_cast<MPI_Aint>(start));
+                start += block;
+                bytes -= block;
+            }
+        }
+        MPI_Datatype type;
+        MPI_Type_create_hindexed(static_cast<int>(lengths.size()),
+                                 lengths.data(), displacements.data(),
+                                 MPI_BYTE, &type);
+        MPI_Type_commit(&type);
+
+        MPI_Request request;
+        if (send) {
+            MPI_Isend(base, 1, type, rank, m_tag, m_comm, &request);
+        } else {
+            MPI_Irecv(base, 1, type, rank, m_tag, m_comm, &request);
+        }
+        m_requests.push_back(request);
+        // Pending messages keep using the datatype after it is freed
+        MPI_Type_free(&type);
+    }
+
+    /**
+     * @brief MPI communicator.
+     */
+    MPI_Comm m_comm;
+    /**
+     * @brief MPI tag of the messages.
+     */
+    int m_tag;
+    /**
+     * @brief Execution space instance of the transfer kernels and copies.
+     */
+    Kokkos::DefaultExecutionSpace m_exec;
+    /**
+     * @brief Local indices of the particles to send.
+     */
+    Kokkos::View<const int*> m_send_index;
+    /**
+     * @brief Destination ranks.
+     */
+    std::vector<int> m_send_ranks;
+    /**
+     * @brief Source ranks.
+     */
+    std::vector<int> m_recv_ranks;
+    /**
+     * @brief Per-destination offsets in the sent particles.
+     */
+    std::vector<std::size_t> m_send_offset = {0};
+    /**
+     * @brief Per-source offsets in the received particles.
+     */
+    std::vector<std::size_t> m_recv_offset = {0};
+    /**
+     * @brief Bytes per particle of each field.
+     */
+    std::vector<std::size_t> m_field_bytes;
+    /**
+     * @brief Send buffer (default memory space).
+     */
+    Kokkos::View<double*> m_send;
+    /**
+     * @brief Receive buffer (default memory space).
+     */
+    Kokkos::View<double*> m_recv;
+    /**
+     * @brief Host mirror of the send buffer (staging only).
+     */
+    HostBuffer m_host_send;
+    /**
+     * @brief Host mirror of the receive buffer (staging only).
+     */
+    HostBuffer m_host_recv;
+    /**
+     * @brief Pending requests.
+     */
+    std::vector<MPI_Request> m_requests;
+};
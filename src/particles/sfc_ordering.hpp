@@ -0,0 +1,125 @@
+#pragma once
+
+#include <cstdint>
+#include <stdexcept>
+
+// Kokkos includes
+#include <Kokkos_Core.hpp>
+#include <Kokkos_Sort.hpp>
+
+#include "morton.hpp"
+#include "particle_permutation.hpp"
+
+/**
+ * @file sfc_ordering.hpp
+ * @brief Defines the SFCOrdering class for space-filling-curve particle
+ * reordering.
+ *
+ * This file provides the `SFCOrdering` class, which sorts particles along the
+ * Morton curve so that spatial neighbors are also neighbors in memory, and
+ * triggers this re-sort periodically as particles move.
+ */
+
+/**
+ * @class SFCOrdering
+ * @brief Periodic Morton-curve reordering of particles.
+ *
+ * `Build` computes the Morton key of each particle, sorts the keys and
+ * returns the permutation to apply to all particle fields. The sorted keys
+ * are kept so that they can be reused as partitioning keys (see
+ * `SFCPartition`).
+ */
+class SFCOrdering {
+   public:
+    /**
+     * @brief Constructor for SFCOrdering.
+     *
+     * @param reorder_every Number of steps between two re-sorts.
+     * @throws std::invalid_argument If `reorder_every` is not positive.
+     */
+    explicit SFCOrdering(int reorder_every = 100)
+        : m_reorder_every(reorder_every) {
+        if (reorder_every < 1) {
+            throw std::invalid_argument(
+                "SFCOrdering: reorder_every must be at least 1");
+        }
+    }
+
+    /**
+     * @brief Checks whether a re-sort is due at a given step.
+     *
+     * @param step Time step index.
+     * @return True every `reorder_every` steps.
+     */
+    bool IsDue(const int step) const { return step % m_reorder_every == 0; }
+
+    /**
+     * @brief Computes the Morton ordering of the particles.
+     *
+     * @param x Particle positions Kokkos view (N x 3).
+     * @param box Bounding box used for the keys (e.g. the global box, so that
+     * keys are comparable across MPI ranks).
+     * @return Permutation from the current to the Morton ordering.
+     */
+    template <class PositionView>
+    ParticlePermutation Build(const PositionView& x, const BoundingBox& box) {
+        const auto N = static_cast<int>(x.extent(0));
+        m_encoder    = MortonEncoder(box);
+        if (static_cast<int>(m_keys.extent(0)) != N) {
+            m_keys = Kokkos::View<std::uint64_t*>(
+                Kokkos::view_alloc(Kokkos::WithoutInitializing, "sfc_keys"), N);
+        }
+        m_encoder.Keys(x, m_keys);
+
+        Kokkos::View<int*> permute(
+            Kokkos::view_alloc(Kokkos::WithoutInitializing, "permutation"), N);
+        Kokkos::parallel_for(
+            "SFCOrdering::Identity", N,
+            KOKKOS_LAMBDA(const int i) { permute(i) = i; });
+        Kokkos::Experimental::sort_by_key(Kokkos::DefaultExecutionSpace(),
+                                          m_keys, permute);
+        return ParticlePermutation(permute);
+    }
+
+    /**
+     * @brief Computes the Morton ordering over the local bounding box.
+     *
+     * @param x Particle positions Kokkos view (N x 3).
+     * @return Permutation from the current to the Morton ordering.
+     */
+    template <class PositionView>
+    ParticlePermutation Build(const PositionView& x) {
+        return Build(x, BoundingBox::Of(x));
+    }
+
+    /**
+     * @brief Returns the sorted Morton keys of the last build.
+     *
+     * Entry `i` is the key of the particle stored at position `i` once the
+     * permutation has been applied.
+     *
+     * @return Device view of sorted keys.
+     */
+    Kokkos::View<const std::uint64_t*> Keys() const { return m_keys; }
+
+    /**
+     * @brief Returns the encoder of the last build.
+     *
+     * @return Morton encoder.
+     */
+    const MortonEncoder& Encoder() const { return m_encoder; }
+
+   private:
+    /**
+     * @brief Number of steps between two re-sorts.
+     */
+    int m_reorder_every;
+    /**
+     * @brief Encoder of the last build.
+     */
+    MortonEncoder m_encoder;
+    /**
+     * @brief Sorted Morton keys of the last build.
+     */
+    Kokkos::View<std::uint64_t*> m_keys;
+};
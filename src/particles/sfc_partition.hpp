@@ -0,0 +1,231 @@
+#pragma once
+
+#include <cstdint>
+#include <limits>
+#include <stdexcept>
+#include <vector>
+
+// mpi includes
+#include <mpi.h>
+// Kokkos includes
+#include <Kokkos_Core.hpp>
+
+#include "host_mirror_pool.hpp"
+#include "morton.hpp"
+
+/**
+ * @file sfc_partition.hpp
+ * @brief Defines the SFCPartition class for space-filling-curve domain
+ * decomposition.
+ *
+ * This file provides the `SFCPartition` class, which cuts the Morton curve
+ * into contiguous key ranges of (nearly) equal weight, one per MPI rank. The
+ * same keys as those used for the cache-friendly ordering (`SFCOrdering`) are
+ * used, so a rank owns a compact region of space.
+ */
+
+/**
+ * @class SFCPartition
+ * @brief Splitting of the Morton curve into weighted key ranges.
+ *
+ * The weights of the particles are accumulated into a global histogram of the
+ * `histogram_bits` leading bits of their key (one `MPI_Allreduce`), and the
+ * curve is cut at the histogram bins where the cumulative weight reaches
+ * multiples of `total / n_parts`. Part `r` owns the keys in
+ * [`Splitters()(r)`, `Splitters()(r + 1)`).
+ */
+class SFCPartition {
+   public:
+    /**
+     * @brief Constructor for SFCPartition.
+     *
+     * @param comm MPI communicator.
+     * @param n_parts Number of parts (defaults to the communicator size).
+     * @param histogram_bits Number of leading key bits of the histogram
+     * (controls the granularity of the cuts).
+     */
+    explicit SFCPartition(MPI_Comm comm = MPI_COMM_WORLD, int n_parts = -1,
+                          int histogram_bits = 16)
+        : m_comm(comm), m_n_parts(n_parts), m_histogram_bits(histogram_bits) {
+        if (m_n_parts < 1) MPI_Comm_size(m_comm, &m_n_parts);
+        if (histogram_bits < 1 || histogram_bits > 24) {
+            throw std::invalid_argument(
+                "SFCPartition: histogram_bits must be in [1, 24]");
+        }
+    }
+
+    /**
+     * @brief Computes the global bounding box of the particles of all ranks.
+     *
+     * @param x Local particle positions Kokkos view (N x 3).
+     * @param comm MPI communicator.
+     * @return Global bounding box.
+     */
+    template <class PositionView>
+    static BoundingBox GlobalBox(const PositionView& x, MPI_Comm comm) {
+        BoundingBox box = BoundingBox::Of(x);
+        double lo[3], hi[3];
+        for (int d = 0; d < 3; ++d) {
+            lo[d] = x.extent(0) > 0 ? box.lo[d]
+                                    : std::numeric_limits<double>::max();
+            hi[d] = x.extent(0) > 0 ? box.hi[d]
+                                    : std::numeric_limits<double>::lowest();
+        }
+        MPI_Allreduce(MPI_IN_PLACE, lo, 3, MPI_DOUBLE, MPI_MIN, comm);
+        MPI_Allreduce(MPI_IN_PLACE, hi, 3, MPI_DOUBLE, MPI_MAX, comm);
+        for (int d = 0; d < 3; ++d) {
+            box.lo[d] = lo[d];
+            box.hi[d] = hi[d];
+        }
+        return box;
+    }
+
+    /**
+     * @brief Computes the splitters with unit particle weights.
+     *
+     * @param keys Local Morton keys Kokkos view.
+     */
+    void Build(Kokkos::View<const std::uint64_t*> keys) {
+        Kokkos::View<double*> weights("sfc_weights", keys.extent(0));
+        Kokkos::deep_copy(weights, 1.0);
+        Build(keys, weights);
+    }
+
+    /**
+     * @brief Computes the splitters with per-particle weights.
+     *
+     * Collective over the communicator.
+     *
+     * @param keys Local Morton keys Kokkos view.
+     * @param weights Local particle weights Kokkos view (e.g. cost
+     * estimates).
+     */
+    void Build(Kokkos::View<const std::uint64_t*> keys,
+               Kokkos::View<const double*> weights) {
+        const int n_bins = 1 << m_histogram_bits;
+        const int shift  = 3 * MortonEncoder::bits - m_histogram_bits;
+
+        Kokkos::View<double*> histogram("sfc_histogram", n_bins);
+        Kokkos::parallel_for(
+            "SFCPartition::Histogram", keys.extent(0),
+            KOKKOS_LAMBDA(const int i) {
+                const auto bin = static_cast<int>(keys(i) >> shift);
+                Kokkos::atomic_add(&histogram(bin), weights(i));
+            });
+        const auto pooled = HostMirrorPool::Global().Mirror(histogram);
+        const auto host_histogram = pooled.view;
+        Kokkos::deep_copy(host_histogram, histogram);
+        MPI_Allreduce(MPI_IN_PLACE, host_histogram.data(), n_bins, MPI_DOUBLE,
+                      MPI_SUM, m_comm);
+
+        double total = 0.0;
+        for (int b = 0; b < n_bins; ++b) total += host_histogram(b);
+
+        // Cut the curve where the cumulative weight reaches r * total / P
+        m_host_splitters.assign(m_n_parts + 1, 0);
+        m_host_splitters[m_n_parts] = std::numeric_limits<std::uint64_t>::max();
+        double cumulative = 0.0;
+        int b             = 0;
+        for (int r = 1; r < m_n_parts; ++r) {
+            const double target = total * r / m_n_parts;
+            while (b < n_bins && cumulative < target) {
+                cumulative += host_histogram(b);
+                ++b;
+            }
+            m_host_splitters[r] = static_cast<std::uint64_t>(b) << shift;
+        }
+
+        m_splitters = Kokkos::View<std::uint64_t*>(
+            Kokkos::view_alloc(Kokkos::WithoutInitializing, "sfc_splitters"),
+            m_n_parts + 1);
+        Kokkos::View<const std::uint64_t*, Kokkos::HostSpace,
+                     Kokkos::MemoryTraits<Kokkos::Unmanaged>>
+            host_splitters(m_host_splitters.data(), m_n_parts + 1);
+        Kokkos::deep_copy(m_splitters, host_splitters);
+    }
+
+    /**
+     * @brief Returns the part owning a key.
+     *
+     * Device-callable binary search in the splitters.
+     *
+     * @param splitters Splitters Kokkos view (size n_parts + 1).
+     * @param key Morton key.
+     * @return Part (rank) index.
+     */
+    KOKKOS_INLINE_FUNCTION static int Owner(
+        const Kokkos::View<const std::uint64_t*>& splitters,
+        const std::uint64_t key) {
+        int lo = 0;
+        int hi = static_cast<int>(splitters.extent(0)) - 2;
+        while (lo < hi) {
+            const int mid = (lo + hi + 1) / 2;
+            if (splitters(mid) <= key) {
+                lo = mid;
+            } else {
+                hi = mid - 1;
+            }
+        }
+        return lo;
+    }
+
+    /**
+     * @brief Computes the owning part of each key.
+     *
+     * @param keys Morton keys Kokkos view.
+     * @param owner Owning part Kokkos view (output, same size as `keys`).
+     */
+    void Owners(Kokkos::View<const std::uint64_t*> keys,
+                Kokkos::View<int*> owner) const {
+        const Kokkos::View<const std::uint64_t*> splitters = m_splitters;
+        Kokkos::parallel_for(
+            "SFCPartition::Owners", keys.extent(0), KOKKOS_LAMBDA(const int i) {
+                owner(i) = Owner(splitters, keys(i));
+            });
+    }
+
+    /**
+     * @brief Returns the number of parts.
+     *
+     * @return Number of parts.
+     */
+    int NumParts() const { return m_n_parts; }
+
+    /**
+     * @brief Returns the splitters (device memory, size n_parts + 1).
+     *
+     * @return Device view of the first key of each part.
+     */
+    Kokkos::View<const std::uint64_t*> Splitters() const { return m_splitters; }
+
+    /**
+     * @brief Returns the splitters (host memory, size n_parts + 1).
+     *
+     * @return First key of each part.
+     */
+    const std::vector<std::uint64_t>& HostSplitters() const {
+        return m_host_splitters;
+    }
+
+   private:
+    /**
+     * @brief MPI communicator.
+     */
+    MPI_Comm m_comm;
+    /**
+     * @brief Number of parts.
+     */
+    int m_n_parts;
+    /**
+     * @brief Number of leading key bits of the histogram.
+     */
+    int m_histogram_bits;
+    /**
+     * @brief First key of each part (device memory).
+     */
+    Kokkos::View<std::uint64_t*> m_splitters;
+    /**
+     * @brief First key of each part (host memory).
+     */
+    std::vector<std::uint64_t> m_host_splitters;
+};
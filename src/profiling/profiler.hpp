@@ -0,0 +1,163 @@
+#pragma once
+
+#include <map>
+#include <string>
+#include <utility>
+
+// Kokkos includes
+#include <Kokkos_Core.hpp>
+
+/**
+ * @file profiler.hpp
+ * @brief Defines the Profiler registry and the ProfilingRegion scope guard.
+ *
+ * This file provides the built-in instrumentation of SPHiros. Every phase of
+ * a step is wrapped in a `ProfilingRegion`, which opens a named
+ * `Kokkos::Profiling` region (visible in Kokkos Tools and nsys traces) and
+ * accumulates its wall time in the process-wide `Profiler`. The phases are:
+ *
+ * - `EOS`: pressure and speed of sound,
+ * - `NeighborBuild`: cell and neighbor lists,
+ * - `Density` and `Forces`: SPH right-hand side,
+ * - `SmoothingLength`: adaptive h-rho solve (one nested
+ *   `SmoothingLength::Newton` call per pass),
+ * - `Integrate`: time integrator updates,
+ * - `Halo` and `Migration`: particle exchanges between ranks,
+ * - `IO`: mesh, output and checkpoint files.
+ *
+ * Regions nest; the time of a region includes its nested regions.
+ */
+
+/**
+ * @class Profiler
+ * @brief Per-process accumulator of the region timings.
+ */
+class Profiler {
+   public:
+    /**
+     * @struct Entry
+     * @brief Accumulated timing of one region.
+     */
+    struct Entry {
+        /**
+         * @brief Total wall time in seconds.
+         */
+        double seconds = 0.0;
+        /**
+         * @brief Number of times the region was entered.
+         */
+        long calls = 0;
+    };
+
+    /**
+     * @brief Returns the process-wide profiler.
+     *
+     * @return Profiler used by `ProfilingRegion`.
+     */
+    static Profiler& Global() {
+        static Profiler profiler;
+        return profiler;
+    }
+
+    /**
+     * @brief Records one execution of a region.
+     *
+     * @param name Region name.
+     * @param seconds Wall time of the execution.
+     */
+    void Add(const std::string& name, const double seconds) {
+        Entry& entry = m_entries[name];
+        entry.seconds += seconds;
+        ++entry.calls;
+    }
+
+    /**
+     * @brief Selects whether regions fence the device before being closed.
+     *
+     * Without fences the time of asynchronous kernels is charged to the
+     * region that waits for them; fences give exact per-phase times but
+     * serialize the phases (e.g. the halo exchange overlap).
+     *
+     * @param fence True to fence at the end of every region.
+     */
+    void SetFence(const bool fence) { m_fence = fence; }
+
+    /**
+     * @brief Returns whether regions fence the device before being closed.
+     *
+     * @return True if regions fence.
+     */
+    bool Fence() const { return m_fence; }
+
+    /**
+     * @brief Returns the accumulated timings, sorted by region name.
+     *
+     * @return Entries by region name.
+     */
+    const std::map<std::string, Entry>& Entries() const { return m_entries; }
+
+    /**
+     * @brief Clears the accumulated timings.
+     */
+    void Reset() { m_entries.clear(); }
+
+   private:
+    /**
+     * @brief Accumulated timings by region name.
+     */
+    std::map<std::string, Entry> m_entries;
+    /**
+     * @brief Whether regions fence the device before being closed.
+     */
+    bool m_fence = false;
+};
+
+/**
+ * @class ProfilingRegion
+ * @brief Scope guard of a named, timed profiling region.
+ *
+ *     {
+ *         ProfilingRegion region("EOS");
+ *         eos.PressureSoS(particles);
+ *     }
+ */
+class ProfilingRegion {
+   public:
+    /**
+     * @brief Opens the region.
+     *
+     * @param name Region name.
+     * @param profiler Profiler receiving the timing.
+     */
+    explicit ProfilingRegion(std::string name,
+                             Profiler& profiler = Profiler::Global())
+        : m_name(std::move(name)), m_profiler(profiler) {
+        Kokkos::Profiling::pushRegion(m_name);
+    }
+
+    ProfilingRegion(const ProfilingRegion&)            = delete;
+    ProfilingRegion& operator=(const ProfilingRegion&) = delete;
+
+    /**
+     * @brief Closes the region and records its wall time.
+     */
+    ~ProfilingRegion() {
+        if (m_profiler.Fence()) Kokkos::fence(m_name);
+        m_profiler.Add(m_name, m_timer.seconds());
+        Kokkos::Profiling::popRegion();
+    }
+
+   private:
+    /**
+     * @brief Region name.
+     */
+    std::string m_name;
+    /**
+     * @brief Profiler receiving the timing.
+     */
+    Profiler& m_profiler;
+    /**
+     * @brief Wall clock started when the region was opened.
+     */
+    Kokkos::Timer m_timer;
+};
@@ -0,0 +1,196 @@
+#pragma once
+
+#include <algorithm>
+#include <cstdio>
+#include <fstream>
+#include <ostream>
+#include <set>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+// mpi includes
+#include <mpi.h>
+
+#include "profiler.hpp"
+
+/**
+ * @file timing_report.hpp
+ * @brief Defines the TimingReport class for cross-rank timing summaries.
+ *
+ * This file provides the `TimingReport` class, which reduces the region
+ * timings of a `Profiler` over the ranks and prints them as a table or dumps
+ * them as JSON.
+ */
+
+/**
+ * @class TimingReport
+ * @brief Minimum, maximum and average time of every region over the ranks.
+ *
+ * Ranks that never entered a region count with a zero time. The rows are
+ * sorted by region name.
+ */
+class TimingReport {
+   public:
+    /**
+     * @struct Row
+     * @brief Reduced timing of one region.
+     */
+    struct Row {
+        /**
+         * @brief Region name.
+         */
+        std::string name;
+        /**
+         * @brief Largest number of calls on a rank.
+         */
+        long calls = 0;
+        /**
+         * @brief Smallest time on a rank (seconds).
+         */
+        double min = 0.0;
+        /**
+         * @brief Largest time on a rank (seconds).
+         */
+        double max = 0.0;
+        /**
+         * @brief Average time over the ranks (seconds).
+         */
+        double avg = 0.0;
+    };
+
+    /**
+     * @brief Reduces the timings of a profiler (collective).
+     *
+     * @param profiler Profiler to summarize.
+     * @param comm MPI communicator.
+     */
+    explicit TimingReport(const Profiler& profiler = Profiler::Global(),
+                          MPI_Comm comm = MPI_COMM_WORLD)
+        : m_comm(comm) {
+        MPI_Comm_rank(m_comm, &m_rank);
+        MPI_Comm_size(m_comm, &m_size);
+
+        const std::vector<std::string> names = Names(profiler);
+        const int n = static_cast<int>(names.size());
+        std::vector<double> seconds(n, 0.0);
+        std::vector<long> calls(n, 0);
+        for (int k = 0; k < n; ++k) {
+            const auto entry = profiler.Entries().find(names[k]);
+            if (entry == profiler.Entries().end()) continue;
+            seconds[k] = entry->second.seconds;
+            calls[k]   = entry->second.calls;
+        }
+        std::vector<double> min(seconds), max(seconds), sum(seconds);
+        MPI_Allreduce(MPI_IN_PLACE, min.data(), n, MPI_DOUBLE, MPI_MIN, m_comm);
+        MPI_Allreduce(MPI_IN_PLACE, max.data(), n, MPI_DOUBLE, MPI_MAX, m_comm);
+        MPI_Allreduce(MPI_IN_PLACE, sum.data(), n, MPI_DOUBLE, MPI_SUM, m_comm);
+        MPI_Allreduce(MPI_IN_PLACE, calls.data(), n, MPI_LONG, MPI_MAX,
+                      m_comm);
+        for (int k = 0; k < n; ++k) {
+            m_rows.push_back({names[k], calls[k], min[k], max[k],
+                              sum[k] / m_size});
+        }
+    }
+
+    /**
+     * @brief Returns the reduced timings.
+     *
+     * @return One row per region, sorted by name.
+     */
+    const std::vector<Row>& Rows() const { return m_rows; }
+
+    /**
+     * @brief Prints the table on rank 0.
+     *
+     * @param os Output stream.
+     */
+    void Print(std::ostream& os) const {
+        if (m_rank != 0) return;
+        std::size_t width = 6;
+        for (const Row& row : m_rows) width = std::max(width, row.name.size());
+        char line[256];
+        std::snprintf(line, sizeof(line), "%-*s %10s %12s %12s %12s\n",
+                      static_cast<int>(width), "Region", "Calls", "Min [s]",
+                      "Max [s]", "Avg [s]");
+        os << "Timings over " << m_size << " ranks\n" << line;
+        for (const Row& row : m_rows) {
+            std::snprintf(line, sizeof(line),
+                          "%-*s %10ld %12.4e %12.4e %12.4e\n",
+                          static_cast<int>(width), row.name.c_str(), row.calls,
+                          row.min, row.max, row.avg);
+            os << line;
+        }
+        os.flush();
+    }
+
+    /**
+     * @brief Writes the timings as JSON on rank 0.
+     *
+     * @param filename Output path.
+     * @throws std::runtime_error If the file cannot be written.
+     */
+    void WriteJSON(const std::string& filename) const {
+        if (m_rank != 0) return;
+        std::ofstream file(filename);
+        if (!file) {
+            throw std::runtime_error("TimingReport: cannot open " + filename);
+        }
+        file.precision(17);
+        file << "{\n  \"ranks\": " << m_size << ",\n  \"regions\": [";
+        for (std::size_t k = 0; k < m_rows.size(); ++k) {
+            const Row& row = m_rows[k];
+            file << (k == 0 ? "\n" : ",\n") << "    {\"name\": \"" << row.name
+                 << "\", \"calls\": " << row.calls << ", \"min\": " << row.min
+                 << ", \"max\": " << row.max << ", \"avg\": " << row.avg
+                 << "}";
+        }
+        file << "\n  ]\n}\n";
+    }
+
+   private:
+    /**
+     * @brief Returns the union of the region names of all the ranks.
+     *
+     * @param profiler Local profiler.
+     * @return Sorted region names, identical on every rank.
+     */
+    std::vector<std::string> Names(const Profiler& profiler) const {
+        std::string local;
+        for (const auto& [name, entry] : profiler.Entries()) {
+            local += name + '\n';
+        }
+        int length = static_cast<int>(local.size());
+        std::vector<int> lengths(m_size), displacements(m_size, 0);
+        MPI_Allgather(&length, 1, MPI_INT, lengths.data(), 1, MPI_INT, m_comm);
+        for (int r = 1; r < m_size; ++r) {
+            displacements[r] = displacements[r - 1] + lengths[r - 1];
+        }
+        std::string all(displacements.back() + lengths.back(), '\0');
+        MPI_Allgatherv(local.data(), length, MPI_CHAR, all.data(),
+                       lengths.data(), displacements.data(), MPI_CHAR, m_comm);
+
+        std::set<std::string> names;
+        std::istringstream stream(all);
+        for (std::string name; std::getline(stream, name);) names.insert(name);
+        return {names.begin(), names.end()};
+    }
+
+    /**
+     * @brief MPI communicator.
+     */
+    MPI_Comm m_comm;
+    /**
+     * @brief MPI rank.
+     */
+    int m_rank = 0;
+    /**
+     * @brief Number of MPI ranks.
+     */
+    int m_size = 1;
+    /**
+     * @brief Reduced timings.
+     */
+    std::vector<Row> m_rows;
+};
@@ -0,0 +1,814 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <stdexcept>
+
+// Kokkos includes
+#include <Kokkos_Core.hpp>
+#include <Kokkos_Sort.hpp>
+
+#include "profiler.hpp"
+
+/**
+ * @file neighbor_search.hpp
+ * @brief Defines the NeighborSearch class for cell-linked-list neighbor
+ * search.
+ *
+ * This file provides the `NeighborSearch` class, which bins particles into
+ * cells (uniform grid or spatial hash) with Kokkos sort/scan primitives and
+ * builds a compressed sparse row (CSR) neighbor list. The list is built with
+ * a Verlet skin so that it can be reused for several time steps. The cell
+ * lists themselves are exposed as a `CellList` for cell-per-team pair
+ * kernels, and a half list (each pair once) can be kept for symmetric pair
+ * kernels.
+ */
+
+/**
+ * @enum CellIndexing
+ * @brief Cell indexing strategy of the neighbor search.
+ */
+enum class CellIndexing {
+    UniformGrid,  ///< Dense grid over the particle bounding box.
+    SpatialHash   ///< Hashed cells, suited to unbounded or sparse domains.
+};
+
+/**
+ * @struct CellGrid
+ * @brief Device-copyable description of the cell decomposition.
+ */
+struct CellGrid {
+    /**
+     * @brief Cell indexing strategy.
+     */
+    CellIndexing indexing = CellIndexing::UniformGrid;
+    /**
+     * @brief Lower corner of the grid (zero for the spatial hash).
+     */
+    Kokkos::Array<double, 3> origin = {0.0, 0.0, 0.0};
+    /**
+     * @brief Inverse of the cell edge length.
+     */
+    double inv_cell_size = 1.0;
+    /**
+     * @brief Number of cells per direction (uniform grid only).
+     */
+    Kokkos::Array<int, 3> dims = {1, 1, 1};
+    /**
+     * @brief Total number of cells (power of two for the spatial hash).
+     */
+    int n_cells = 1;
+
+    /**
+     * @brief Returns the integer cell coordinate of a position component.
+     *
+     * @param x Position component.
+     * @param d Direction.
+     * @return Cell coordinate.
+     */
+    KOKKOS_INLINE_FUNCTION int Coord(const double x, const int d) const {
+        return static_cast<int>(Kokkos::floor((x - origin[d]) * inv_cell_size));
+    }
+
+    /**
+     * @brief Returns the cell index of integer cell coordinates.
+     *
+     * @param cx Cell coordinate along x.
+     * @param cy Cell coordinate along y.
+     * @param cz Cell coordinate along z.
+     * @return Cell index, or -1 if the cell lies outside the uniform grid.
+     */
+    KOKKOS_INLINE_FUNCTION int Index(const int cx, const int cy,
+                                     const int cz) const {
+        if (indexing == CellIndexing::SpatialHash) {
+            const std::uint32_t h =
+                (static_cast<std::uint32_t>(cx) * 73856093u) ^
+                (static_cast<std::uint32_t>(cy) * 19349663u) ^
+                (static_cast<std::uint32_t>(cz) * 83492791u);
+            const auto mask = static_cast<std::uint32_t>(n_cells - 1);
+            return static_cast<int>(h & mask);
+        }
+        if (cx < 0 || cy < 0 || cz < 0 || cx >= dims[0] || cy >= dims[1] ||
+            cz >= dims[2]) {
+            return -1;
+        }
+        return cx + dims[0] * (cy + dims[1] * cz);
+    }
+
+    /**
+     * @brief Returns the integer cell coordinates of a cell index (uniform
+     * grid only).
+     *
+     * @param c Cell index.
+     * @param cx Cell coordinate along x (output).
+     * @param cy Cell coordinate along y (output).
+     * @param cz Cell coordinate along z (output).
+     */
+    KOKKOS_INLINE_FUNCTION void Coords(const int c, int& cx, int& cy,
+                                       int& cz) const {
+        cx = c % dims[0];
+        cy = c / dims[0] % dims[1];
+        cz = c / (dims[0] * dims[1]);
+    }
+};
+
+/**
+ * @struct CellList
+ * @brief Device-copyable cell lists of a uniform grid.
+ *
+ * The particles of cell `c` are `particles(p)` for `p` in [`offsets(c)`,
+ * `offsets(c + 1)`). The cells have the edge `cutoff + skin` and are binned
+ * from the positions of the last build, so like the neighbor list they hold
+ * every pair closer than the cutoff in adjacent cells as long as no particle
+ * moved by more than `skin / 2`.
+ */
+struct CellList {
+    /**
+     * @brief Cell decomposition (uniform grid).
+     */
+    CellGrid grid;
+    /**
+     * @brief Offsets of each cell in `particles` (size n_cells + 1).
+     */
+    Kokkos::View<const std::size_t*> offsets;
+    /**
+     * @brief Particle indices sorted by cell.
+     */
+    Kokkos::View<const int*> particles;
+    /**
+     * @brief Largest number of particles in a cell.
+     */
+    int max_occupancy = 0;
+
+    /**
+     * @brief Runs the pair loop of the cell of a team, one neighbor tile at
+     * a time.
+     *
+     * The particles of cell `team.league_rank()` ("own" particles) are
+     * processed in chunks of `tile`; for each chunk, the particles of the 27
+     * surrounding cells are staged in tiles of at most `tile` particles,
+     * typically into team scratch memory, and every own particle interacts
+     * with the whole tile:
+     *
+     *     start(q, i)        // TeamThreadRange over the own chunk
+     *     stage(s, j)        // TeamThreadRange over a neighbor tile
+     *     interact(q, i, n)  // TeamThreadRange over the own chunk
+     *     finish(q, i)       // TeamThreadRange over the own chunk
+     *
+     * where `q` and `s` are slots in [0, `tile`), `i` and `j` particle
+     * indices and `n` the number of staged particles. Consecutive stages are
+     * separated by team barriers. The tile contains the own particles too.
+     *
+     * @param team Team handle (one team per cell).
+     * @param tile Tile size (> 0).
+     * @param start Callback initializing the slot of an own particle.
+     * @param stage Callback staging a neighbor particle.
+     * @param interact Callback accumulating the staged tile.
+     * @param finish Callback storing the result of an own particle.
+     */
+    template <class Member, class Start, class Stage, class Interact,
+              class Finish>
+    KOKKOS_INLINE_FUNCTION void TeamTiles(const Member& team, const int tile,
+                                          Start&& start, Stage&& stage,
+                                          Interact&& interact,
+                                          Finish&& finish) const {
+        const int c     = team.league_rank();
+        const int begin = static_cast<int>(offsets(c));
+        const int end   = static_cast<int>(offsets(c + 1));
+        int ci[3];
+        grid.Coords(c, ci[0], ci[1], ci[2]);
+        for (int o0 = begin; o0 < end; o0 += tile) {
+            const int n_own = Kokkos::min(tile, end - o0);
+            Kokkos::parallel_for(
+                Kokkos::TeamThreadRange(team, n_own),
+                [&](const int q) { start(q, particles(o0 + q)); });
+            for (int dz = -1; dz <= 1; ++dz) {
+                for (int dy = -1; dy <= 1; ++dy) {
+                    for (int dx = -1; dx <= 1; ++dx) {
+                        const int nc =
+                            grid.Index(ci[0] + dx, ci[1] + dy, ci[2] + dz);
+                        if (nc < 0) continue;
+                        const int n_end = static_cast<int>(offsets(nc + 1));
+                        for (int s0 = static_cast<int>(offsets(nc));
+                             s0 < n_end; s0 += tile) {
+                            const int n = Kokkos::min(tile, n_end - s0);
+                            team.team_barrier();
+                            Kokkos::parallel_for(
+                                Kokkos::TeamThreadRange(team, n),
+                                [&](const int s) {
+                                    stage(s, particles(s0 + s));
+                                });
+                            team.team_barrier();
+                            Kokkos::parallel_for(
+                                Kokkos::TeamThreadRange(team, n_own),
+                                [&](const int q) {
+                                    interact(q, particles(o0 + q), n);
+                                });
+                        }
+                    }
+                }
+            }
+            team.team_barrier();
+            Kokkos::parallel_for(
+                Kokkos::TeamThreadRange(team, n_own),
+                [&](const int q) { finish(q, particles(o0 + q)); });
+            team.team_barrier();
+        }
+    }
+};
+
+/**
+ * @struct NeighborList
+ * @brief Device-copyable CSR neighbor list.
+ *
+ * The neighbors of particle `i` are `neighbors(k)` for `k` in
+ * [`offsets(i)`, `offsets(i + 1)`). A particle is not its own neighbor. A
+ * full list holds both `(i, j)` and `(j, i)`; a half list only holds the
+ * pairs with `i < j`.
+ */
+struct NeighborList {
+    /**
+     * @brief Row offsets (size N + 1).
+     */
+    Kokkos::View<const std::size_t*> offsets;
+    /**
+     * @brief Concatenated neighbor indices.
+     */
+    Kokkos::View<const int*> neighbors;
+
+    /**
+     * @brief Returns the number of neighbors of a particle.
+     *
+     * @param i Particle index.
+     * @return Number of neighbors.
+     */
+    KOKKOS_INLINE_FUNCTION int NumNeighbors(const int i) const {
+        return static_cast<int>(offsets(i + 1) - offsets(i));
+    }
+
+    /**
+     * @brief Returns the k-th neighbor of a particle.
+     *
+     * @param i Particle index.
+     * @param k Neighbor rank in [0, NumNeighbors(i)).
+     * @return Neighbor particle index.
+     */
+    KOKKOS_INLINE_FUNCTION int Neighbor(const int i, const int k) const {
+        return neighbors(offsets(i) + k);
+    }
+};
+
+/**
+ * @class NeighborSearch
+ * @brief Cell-linked-list neighbor search with Verlet skin.
+ *
+ * Particles are binned in cells of edge `cutoff + skin`, sorted by cell with
+ * `Kokkos::sort` and indexed with a `parallel_scan`. The neighbor list keeps
+ * all pairs closer than `cutoff + skin`; it stays valid as long as no
+ * particle moved by more than `skin / 2`. `Update` rebuilds it every
+ * `rebuild_every` steps, or earlier if that displacement bound is exceeded.
+ * Cell binning ("build") and neighbor list construction ("query") are timed
+ * separately. With `SetHalfList(true)`, every build also extracts the half
+ * list from the full list.
+ */
+class NeighborSearch {
+   public:
+    /**
+     * @brief Constructor for NeighborSearch.
+     *
+     * @param cutoff Interaction radius (kernel support).
+     * @param skin Verlet skin added to the cutoff.
+     * @param rebuild_every Maximum number of steps between two rebuilds.
+     * @param indexing Cell indexing strategy.
+     */
+    NeighborSearch(double cutoff, double skin = 0.0, int rebuild_every = 1,
+                   CellIndexing indexing = CellIndexing::UniformGrid)
+        : m_cutoff(cutoff),
+          m_skin(skin),
+          m_rebuild_every(rebuild_every),
+          m_indexing(indexing) {
+        if (cutoff <= 0.0 || skin < 0.0 || rebuild_every < 1) {
+            throw std::invalid_argument(
+                "NeighborSearch: cutoff must be positive, skin non-negative "
+                "and rebuild_every at least 1");
+        }
+    }
+
+    /**
+     * @brief Builds the cell lists and the neighbor list.
+     *
+     * @param x Particle positions Kokkos view (N x 3).
+     */
+    template <class PositionView>
+    void Build(const PositionView& x) {
+        ProfilingRegion region("NeighborBuild");
+        Kokkos::Timer timer;
+        BuildCells(x);
+        Kokkos::fence("NeighborSearch::Build");
+        m_build_time += timer.seconds();
+
+        timer.reset();
+        BuildNeighbors(x);
+        Kokkos::fence("NeighborSearch::Query");
+        m_query_time += timer.seconds();
+
+        SavePositions(x);
+        m_steps_since_build = 0;
+        ++m_num_builds;
+    }
+
+    /**
+     * @brief Advances the step counter and rebuilds the list if needed.
+     *
+     * @param x Particle positions Kokkos view (N x 3).
+     * @return True if the neighbor list was rebuilt.
+     */
+    template <class PositionView>
+    bool Update(const PositionView& x) {
+        ++m_steps_since_build;
+        if (NeedsRebuild(x)) {
+            Build(x);
+            return true;
+        }
+        return false;
+    }
+
+    /**
+     * @brief Checks whether the neighbor list must be rebuilt.
+     *
+     * @param x Particle positions Kokkos view (N x 3).
+     * @return True if no list was built yet, if the particle count changed,
+     * if `rebuild_every` steps elapsed or if a particle moved by more than
+     * half the skin since the last build.
+     */
+    template <class PositionView>
+    bool NeedsRebuild(const PositionView& x) const {
+        if (m_num_builds == 0 || x.extent(0) != m_x0.extent(0) ||
+            m_steps_since_build >= m_rebuild_every) {
+            return true;
+        }
+        const auto x0    = m_x0;
+        double max_disp2 = 0.0;
+        Kokkos::parallel_reduce(
+            "NeighborSearch::Displacement", x.extent(0),
+            KOKKOS_LAMBDA(const int i, double& local_max) {
+                double d2 = 0.0;
+                for (int d = 0; d < 3; ++d) {
+                    const double dx = x(i, d) - x0(i, d);
+                    d2 += dx * dx;
+                }
+                local_max = Kokkos::max(local_max, d2);
+            },
+            Kokkos::Max<double>(max_disp2));
+        const double half_skin = 0.5 * m_skin;
+        return max_disp2 > half_skin * half_skin;
+    }
+
+    /**
+     * @brief Bins the particles into cells (first stage of `Build`).
+     *
+     * @param x Particle positions Kokkos view (N x 3).
+     */
+    template <class PositionView>
+    void BuildCells(const PositionView& x) {
+        const auto N = static_cast<int>(x.extent(0));
+        SetupGrid(x);
+        const CellGrid grid = m_grid;
+
+        Kokkos::View<std::uint64_t*> keys(
+            Kokkos::view_alloc(Kokkos::WithoutInitializing, "cell_keys"), N);
+        Kokkos::View<std::size_t*> cell_offsets("cell_offsets",
+                                                grid.n_cells + 1);
+        Kokkos::parallel_for(
+            "NeighborSearch::BinParticles", N, KOKKOS_LAMBDA(const int i) {
+                const int c = grid.Index(grid.Coord(x(i, 0), 0),
+                                         grid.Coord(x(i, 1), 1),
+                                         grid.Coord(x(i, 2), 2));
+                keys(i) = (static_cast<std::uint64_t>(c) << 32) |
+                          static_cast<std::uint64_t>(i);
+                Kokkos::atomic_add(&cell_offsets(c + 1), std::size_t(1));
+            });
+        Kokkos::sort(keys);
+
+        Kokkos::View<int*> sorted(
+            Kokkos::view_alloc(Kokkos::WithoutInitializing, "cell_particles"),
+            N);
+        Kokkos::parallel_for(
+            "NeighborSearch::SortedParticles", N, KOKKOS_LAMBDA(const int i) {
+                sorted(i) = static_cast<int>(keys(i) & 0xffffffffULL);
+            });
+        Kokkos::parallel_scan(
+            "NeighborSearch::CellOffsets", grid.n_cells + 1,
+            KOKKOS_LAMBDA(const int c, std::size_t& update, const bool final) {
+                update += cell_offsets(c);
+                if (final) cell_offsets(c) = update;
+            });
+        int max_occupancy = 0;
+        Kokkos::parallel_reduce(
+            "NeighborSearch::MaxOccupancy", grid.n_cells,
+            KOKKOS_LAMBDA(const int c, int& local_max) {
+                local_max = Kokkos::max(
+                    local_max,
+                    static_cast<int>(cell_offsets(c + 1) - cell_offsets(c)));
+            },
+            Kokkos::Max<int>(max_occupancy));
+
+        m_max_occupancy  = max_occupancy;
+        m_cell_offsets   = cell_offsets;
+        m_cell_particles = sorted;
+    }
+
+    /**
+     * @brief Builds the CSR neighbor list from the cell lists (second stage
+     * of `Build`).
+     *
+     * @param x Particle positions Kokkos view (N x 3).
+     */
+    template <class PositionView>
+    void BuildNeighbors(const PositionView& x) {
+        const auto N              = static_cast<int>(x.extent(0));
+        const CellGrid grid       = m_grid;
+        const auto cell_offsets   = m_cell_offsets;
+        const auto cell_particles = m_cell_particles;
+        const double r2 = (m_cutoff + m_skin) * (m_cutoff + m_skin);
+
+        Kokkos::View<std::size_t*> offsets("neighbor_offsets", N + 1);
+        Kokkos::parallel_for(
+            "NeighborSearch::CountNeighbors", N, KOKKOS_LAMBDA(const int i) {
+                std::size_t count = 0;
+                ForEachCandidate(grid, cell_offsets, cell_particles, x, i, r2,
+                                 [&](const int) { ++count; });
+                offsets(i + 1) = count;
+            });
+        std::size_t n_pairs = 0;
+        Kokkos::parallel_scan(
+            "NeighborSearch::NeighborOffsets", N + 1,
+            KOKKOS_LAMBDA(const int i, std::size_t& update, const bool final) {
+                update += offsets(i);
+                if (final) offsets(i) = update;
+            },
+            n_pairs);
+
+        Kokkos::View<int*> neighbors(
+            Kokkos::view_alloc(Kokkos::WithoutInitializing, "neighbors"),
+            n_pairs);
+        Kokkos::parallel_for(
+            "NeighborSearch::FillNeighbors", N, KOKKOS_LAMBDA(const int i) {
+                std::size_t k = offsets(i);
+                ForEachCandidate(grid, cell_offsets, cell_particles, x, i, r2,
+                                 [&](const int j) { neighbors(k++) = j; });
+            });
+
+        m_offsets   = offsets;
+        m_neighbors = neighbors;
+        m_num_pairs = n_pairs;
+        if (m_keep_half) BuildHalfList();
+    }
+
+    /**
+     * @brief Extracts the half list (pairs `i < j`) from the full list
+     * (last stage of `Build` with `SetHalfList(true)`).
+     */
+    void BuildHalfList() {
+        const NeighborList full = List();
+        const auto N            = static_cast<int>(m_offsets.extent(0)) - 1;
+        Kokkos::View<std::size_t*> offsets("half_neighbor_offsets", N + 1);
+        Kokkos::parallel_for(
+            "NeighborSearch::CountHalfNeighbors", N,
+            KOKKOS_LAMBDA(const int i) {
+                std::size_t count = 0;
+                for (int k = 0; k < full.NumNeighbors(i); ++k) {
+                    count += full.Neighbor(i, k) > i;
+                }
+                offsets(i + 1) = count;
+            });
+        std::size_t n_pairs = 0;
+        Kokkos::parallel_scan(
+            "NeighborSearch::HalfNeighborOffsets", N + 1,
+            KOKKOS_LAMBDA(const int i, std::size_t& update, const bool final) {
+                update += offsets(i);
+                if (final) offsets(i) = update;
+            },
+            n_pairs);
+
+        Kokkos::View<int*> neighbors(
+            Kokkos::view_alloc(Kokkos::WithoutInitializing, "half_neighbors"),
+            n_pairs);
+        Kokkos::parallel_for(
+            "NeighborSearch::FillHalfNeighbors", N,
+            KOKKOS_LAMBDA(const int i) {
+                std::size_t h = offsets(i);
+                for (int k = 0; k < full.NumNeighbors(i); ++k) {
+                    const int j = full.Neighbor(i, k);
+                    if (j > i) neighbors(h++) = j;
+                }
+            });
+
+        m_half_offsets   = offsets;
+        m_half_neighbors = neighbors;
+    }
+
+    /**
+     * @brief Calls `f(j)` for every particle `j != i` closer than `sqrt(r2)`.
+     *
+     * Device-callable loop over the 27 cells surrounding particle `i`. With
+     * the spatial hash, buckets reached twice through hash collisions are
+     * visited once.
+     *
+     * @param grid Cell decomposition.
+     * @param cell_offsets Offsets of each cell in `cell_particles`.
+     * @param cell_particles Particle indices sorted by cell.
+     * @param x Particle positions Kokkos view (N x 3).
+     * @param i Particle index.
+     * @param r2 Squared search radius.
+     * @param f Callback taking the neighbor index.
+     */
+    template <class PositionView, class Functor>
+    KOKKOS_INLINE_FUNCTION static void ForEachCandidate(
+        const CellGrid& grid, const Kokkos::View<std::size_t*>& cell_offsets,
+        const Kokkos::View<int*>& cell_particles, const PositionView& x,
+        const int i, const double r2, Functor&& f) {
+        const double xi[3] = {x(i, 0), x(i, 1), x(i, 2)};
+        const int ci[3]    = {grid.Coord(xi[0], 0), grid.Coord(xi[1], 1),
+                              grid.Coord(xi[2], 2)};
+        int visited[27];
+        int n_visited = 0;
+        for (int dz = -1; dz <= 1; ++dz) {
+            for (int dy = -1; dy <= 1; ++dy) {
+                for (int dx = -1; dx <= 1; ++dx) {
+                    const int c =
+                        grid.Index(ci[0] + dx, ci[1] + dy, ci[2] + dz);
+                    if (c < 0) continue;
+                    bool seen = false;
+                    for (int v = 0; v < n_visited; ++v) {
+                        seen = seen || (visited[v] == c);
+                    }
+                    if (seen) continue;
+                    visited[n_visited++] = c;
+                    for (std::size_t p = cell_offsets(c);
+                         p < cell_offsets(c + 1); ++p) {
+                        const int j = cell_particles(p);
+                        if (j == i) continue;
+                        double d2 = 0.0;
+                        for (int d = 0; d < 3; ++d) {
+                            const double dxd = x(j, d) - xi[d];
+                            d2 += dxd * dxd;
+                        }
+                        if (d2 < r2) f(j);
+                    }
+                }
+            }
+        }
+    }
+
+    /**
+     * @brief Computes the cell decomposition for the current positions.
+     *
+     * @param x Particle positions Kokkos view (N x 3).
+     * @throws std::runtime_error If the uniform grid has too many cells.
+     */
+    template <class PositionView>
+    void SetupGrid(const PositionView& x) {
+        const auto N         = static_cast<int>(x.extent(0));
+        const double cell    = m_cutoff + m_skin;
+        m_grid               = CellGrid();
+        m_grid.indexing      = m_indexing;
+        m_grid.inv_cell_size = 1.0 / cell;
+
+        if (m_indexing == CellIndexing::SpatialHash) {
+            int n_cells = 1;
+            while (n_cells < N) n_cells *= 2;
+            m_grid.n_cells = n_cells;
+            return;
+        }
+
+        double lo[3] = {0.0, 0.0, 0.0};
+        double hi[3] = {0.0, 0.0, 0.0};
+        if (N > 0) {
+            Kokkos::parallel_reduce(
+                "NeighborSearch::BoundingBox", N,
+                KOKKOS_LAMBDA(const int i, double& xmin, double& ymin,
+                              double& zmin, double& xmax, double& ymax,
+                              double& zmax) {
+                    xmin = Kokkos::min(xmin, x(i, 0));
+                    ymin = Kokkos::min(ymin, x(i, 1));
+                    zmin = Kokkos::min(zmin, x(i, 2));
+                    xmax = Kokkos::max(xmax, x(i, 0));
+                    ymax = Kokkos::max(ymax, x(i, 1));
+                    zmax = Kokkos::max(zmax, x(i, 2));
+                },
+                Kokkos::Min<double>(lo[0]), Kokkos::Min<double>(lo[1]),
+                Kokkos::Min<double>(lo[2]), Kokkos::Max<double>(hi[0]),
+                Kokkos::Max<double>(hi[1]), Kokkos::Max<double>(hi[2]));
+        }
+        std::int64_t n_cells = 1;
+        for (int d = 0; d < 3; ++d) {
+            m_grid.origin[d] = lo[d];
+            m_grid.dims[d] =
+                static_cast<int>(Kokkos::floor((hi[d] - lo[d]) / cell)) + 1;
+            n_cells *= m_grid.dims[d];
+        }
+        if (n_cells >= std::numeric_limits<int>::max()) {
+            throw std::runtime_error(
+                "NeighborSearch: too many cells for a uniform grid, use "
+                "CellIndexing::SpatialHash");
+        }
+        m_grid.n_cells = static_cast<int>(n_cells);
+    }
+
+    /**
+     * @brief Stores the positions used for the last build.
+     *
+     * @param x Particle positions Kokkos view (N x 3).
+     */
+    template <class PositionView>
+    void SavePositions(const PositionView& x) {
+        if (m_x0.extent(0) != x.extent(0)) {
+            m_x0 = Kokkos::View<double* [3]>(
+                Kokkos::view_alloc(Kokkos::WithoutInitializing,
+                                   "neighbor_positions"),
+                x.extent(0));
+        }
+        const auto x0 = m_x0;
+        Kokkos::parallel_for(
+            "NeighborSearch::SavePositions", x.extent(0),
+            KOKKOS_LAMBDA(const int i) {
+                for (int d = 0; d < 3; ++d) x0(i, d) = x(i, d);
+            });
+    }
+
+    /**
+     * @brief Returns the CSR neighbor list.
+     *
+     * @return Device-copyable neighbor list.
+     */
+    NeighborList List() const { return NeighborList{m_offsets, m_neighbors}; }
+
+    /**
+     * @brief Selects whether the builds also keep the half list.
+     *
+     * Takes effect at the next build.
+     *
+     * @param keep True to keep the half list.
+     */
+    void SetHalfList(const bool keep) { m_keep_half = keep; }
+
+    /**
+     * @brief Returns the half neighbor list (pairs `i < j`).
+     *
+     * @return Device-copyable neighbor list.
+     * @throws std::runtime_error If no build kept the half list.
+     */
+    NeighborList HalfList() const {
+        if (!m_keep_half || m_half_offsets.extent(0) != m_offsets.extent(0)) {
+            throw std::runtime_error(
+                "NeighborSearch: no half list, call SetHalfList(true) before "
+                "Build");
+        }
+        return NeighborList{m_half_offsets, m_half_neighbors};
+    }
+
+    /**
+     * @brief Returns the cell lists of the last build.
+     *
+     * @return Device-copyable cell lists.
+     * @throws std::runtime_error If the cells use the spatial hash (buckets
+     * are not geometric cells).
+     */
+    CellList Cells() const {
+        if (m_grid.indexing != CellIndexing::UniformGrid) {
+            throw std::runtime_error(
+                "NeighborSearch: cell lists need CellIndexing::UniformGrid");
+        }
+        return CellList{m_grid, m_cell_offsets, m_cell_particles,
+                        m_max_occupancy};
+    }
+
+    /**
+     * @brief Returns the cell decomposition of the last build.
+     *
+     * @return Cell grid.
+     */
+    const CellGrid& Grid() const { return m_grid; }
+
+    /**
+     * @brief Returns the number of stored (directed) pairs.
+     *
+     * @return Number of neighbor entries.
+     */
+    std::size_t NumPairs() const { return m_num_pairs; }
+
+    /**
+     * @brief Returns the number of builds performed so far.
+     *
+     * @return Number of builds.
+     */
+    int NumBuilds() const { return m_num_builds; }
+
+    /**
+     * @brief Returns the accumulated cell-binning time.
+     *
+     * @return Time in seconds.
+     */
+    double BuildTime() const { return m_build_time; }
+
+    /**
+     * @brief Returns the accumulated neighbor list construction time.
+     *
+     * @return Time in seconds.
+     */
+    double QueryTime() const { return m_query_time; }
+
+    /**
+     * @brief Returns the interaction radius.
+     *
+     * @return Cutoff radius.
+     */
+    double Cutoff() const { return m_cutoff; }
+
+    /**
+     * @brief Returns the Verlet skin.
+     *
+     * @return Skin thickness.
+     */
+    double Skin() const { return m_skin; }
+
+   private:
+    /**
+     * @brief Interaction radius.
+     */
+    double m_cutoff;
+    /**
+     * @brief Verlet skin.
+     */
+    double m_skin;
+    /**
+     * @brief Maximum number of steps between two rebuilds.
+     */
+    int m_rebuild_every;
+    /**
+     * @brief Cell indexing strategy.
+     */
+    CellIndexing m_indexing;
+    /**
+     * @brief Cell decomposition of the last build.
+     */
+    CellGrid m_grid;
+    /**
+     * @brief Offsets of each cell in `m_cell_particles` (size n_cells + 1).
+     */
+    Kokkos::View<std::size_t*> m_cell_offsets;
+    /**
+     * @brief Particle indices sorted by cell.
+     */
+    Kokkos::View<int*> m_cell_particles;
+    /**
+     * @brief Largest number of particles in a cell.
+     */
+    int m_max_occupancy = 0;
+    /**
+     * @brief CSR neighbor offsets (size N + 1).
+     */
+    Kokkos::View<std::size_t*> m_offsets;
+    /**
+     * @brief CSR neighbor indices.
+     */
+    Kokkos::View<int*> m_neighbors;
+    /**
+     * @brief Whether the builds keep the half list.
+     */
+    bool m_keep_half = false;
+    /**
+     * @brief Half list offsets (size N + 1).
+     */
+    Kokkos::View<std::size_t*> m_half_offsets;
+    /**
+     * @brief Half list neighbor indices.
+     */
+    Kokkos::View<int*> m_half_neighbors;
+    /**
+     * @brief Positions at the last build.
+     */
+    Kokkos::View<double* [3]> m_x0;
+    /**
+     * @brief Number of stored (directed) pairs.
+     */
+    std::size_t m_num_pairs = 0;
+    /**
+     * @brief Steps elapsed since the last build.
+     */
+    int m_steps_since_build = 0;
+    /**
+     * @brief Number of builds performed so far.
+     */
+    int m_num_builds = 0;
+    /**
+     * @brief Accumulated cell-binning time (s).
+     */
+    double m_build_time = 0.0;
+    /**
+     * @brief Accumulated neighbor list construction time (s).
+     */
+    double m_query_time = 0.0;
+};
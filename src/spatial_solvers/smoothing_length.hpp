@@ -0,0 +1,275 @@
+#pragma once
+
+#include <cstddef>
+#include <stdexcept>
+
+// Kokkos includes
+#include <Kokkos_Core.hpp>
+
+#include "neighbor_search.hpp"
+#include "profiler.hpp"
+#include "sph_kernel.hpp"
+
+/**
+ * @file smoothing_length.hpp
+ * @brief Defines the SmoothingLength class for adaptive smoothing lengths.
+ *
+ * This file provides the `SmoothingLength` class, which solves the smoothing
+ * length and the summation density of every particle consistently with
+ * batched Newton-Raphson passes over a fixed neighbor list.
+ */
+
+/**
+ * @class SmoothingLength
+ * @brief Iterative h-rho solve of variable-h SPH.
+ *
+ * The smoothing length of particle `i` is tied to its density by
+ * `h_i = eta (m_i / rho_i)^(1/3)`, with the gather density
+ * `rho_i = sum_j m_j W(r_ij, h_i)` (self included). Each pass performs one
+ * Newton-Raphson step on
+ *
+ *     f(h_i) = sum_j m_j W(r_ij, h_i) - m_i (eta / h_i)^3,
+ *
+ * where `dW/dh = -(3 W + r dW/dr) / h`, and only visits the particles that
+ * have not converged yet: after every pass the unconverged rows are
+ * compacted with a `parallel_scan`, so the later passes cost a fraction of
+ * the first one. Steps are limited to a factor 2 and fall back to the
+ * fixed-point update `eta (m_i / rho_i)^(1/3)` where the derivative is not
+ * positive.
+ *
+ * No neighbor search runs during the solve. The neighbor list must be a
+ * full list built with a cutoff of `Kernel::support * h_max`, where `h_max`
+ * is the largest expected smoothing length, and its skin covering the
+ * displacements since the build; the smoothing lengths are capped at
+ * `h_max` so that the list always holds the whole kernel support.
+ *
+ * The solve is the `SmoothingLength` profiling region, and each pass a
+ * nested `SmoothingLength::Newton` region, so the timing report shows the
+ * number of passes as the number of calls of the latter.
+ *
+ * @tparam Kernel Smoothing kernel (e.g. `CubicSplineKernel`).
+ */
+template <class Kernel = CubicSplineKernel>
+class SmoothingLength {
+   public:
+    /**
+     * @brief Constructor for SmoothingLength.
+     *
+     * @param eta Smoothing length in units of the mean particle spacing
+     * `(m / rho)^(1/3)` (about 1.2 for the cubic spline).
+     * @param tolerance Relative change of `h` below which a particle is
+     * converged.
+     * @param max_iterations Maximum number of passes of a solve.
+     * @param h_min Smallest smoothing length.
+     * @throws std::invalid_argument If `eta` or `tolerance` is not positive,
+     * `max_iterations` is below 1 or `h_min` is negative.
+     */
+    explicit SmoothingLength(const double eta         = 1.2,
+                             const double tolerance   = 1e-4,
+                             const int max_iterations = 30,
+                             const double h_min       = 0.0)
+        : m_eta(eta),
+          m_tolerance(tolerance),
+          m_max_iterations(max_iterations),
+          m_h_min(h_min) {
+        if (!(eta > 0.0) || !(tolerance > 0.0) || max_iterations < 1 ||
+            !(h_min >= 0.0)) {
+            throw std::invalid_argument(
+                "SmoothingLength: eta and tolerance must be positive, "
+                "max_iterations at least 1 and h_min non-negative");
+        }
+    }
+
+    /**
+     * @brief Solves the smoothing lengths and densities.
+     *
+     * @param particles Particle container providing `X`, `Mass`, `H` and
+     * `Rho` (e.g. `ParticleData`); `H` holds the initial guesses and both
+     * are updated.
+     * @param search Neighbor search of the particles; its full list is used
+     * and `h` is capped at `search.Cutoff() / Kernel::support`.
+     * @param first First updated particle.
+     * @return Number of passes.
+     */
+    template <class Particles>
+    int Solve(const Particles& particles, const NeighborSearch& search,
+              const std::size_t first = 0) {
+        return Solve(particles, search.List(),
+                     search.Cutoff() / Kernel::support, first);
+    }
+
+    /**
+     * @brief Solves the smoothing lengths and densities over a neighbor
+     * list.
+     *
+     * @param particles Particle container providing `X`, `Mass`, `H` and
+     * `Rho`.
+     * @param list Full neighbor list holding every pair closer than
+     * `Kernel::support * h_max`.
+     * @param h_max Largest smoothing length.
+     * @param first First updated particle.
+     * @return Number of passes.
+     */
+    template <class Particles>
+    int Solve(const Particles& particles, const NeighborList& list,
+              const double h_max, const std::size_t first = 0) {
+        ProfilingRegion region("SmoothingLength");
+        const auto x        = particles.X();
+        const auto mass     = particles.Mass();
+        const auto h        = particles.H();
+        const auto rho      = particles.Rho();
+        const std::size_t N = rho.extent(0);
+        if (m_active[0].extent(0) < N) {
+            for (auto& active : m_active) {
+                active = Kokkos::View<int*>(
+                    Kokkos::view_alloc(Kokkos::WithoutInitializing,
+                                       "smoothing_length_active"),
+                    N);
+            }
+            m_converged = Kokkos::View<int*>(
+                Kokkos::view_alloc(Kokkos::WithoutInitializing,
+                                   "smoothing_length_converged"),
+                N);
+        }
+
+        const double eta     = m_eta;
+        const double eta3    = eta * eta * eta;
+        const double tol     = m_tolerance;
+        const double h_lo    = m_h_min;
+        const double h_hi    = h_max;
+        const auto converged = m_converged;
+        std::size_t n_active = N > first ? N - first : 0;
+        {
+            const auto active = m_active[0];
+            Kokkos::parallel_for(
+                "SmoothingLength::Initialize", n_active,
+                KOKKOS_LAMBDA(const int k) {
+                    active(k) = static_cast<int>(first) + k;
+                });
+        }
+
+        m_evaluations = 0;
+        int pass      = 0;
+        for (; pass < m_max_iterations && n_active > 0; ++pass) {
+            ProfilingRegion newton("SmoothingLength::Newton");
+            const auto active = m_active[pass % 2];
+            const auto next   = m_active[(pass + 1) % 2];
+            m_evaluations += n_active;
+            Kokkos::parallel_for(
+                "SmoothingLength::Newton", n_active,
+                KOKKOS_LAMBDA(const int k) {
+                    const int i     = active(k);
+                    const double hi = h(i);
+                    double rho_i    = mass(i) * Kernel::W(0.0, hi);
+                    double drho_dh  = -3.0 * rho_i / hi;
+                    for (int n = 0; n < list.NumNeighbors(i); ++n) {
+                        const int j = list.Neighbor(i, n);
+                        double r2   = 0.0;
+                        for (int d = 0; d < 3; ++d) {
+                            const double dx = x(i, d) - x(j, d);
+                            r2 += dx * dx;
+                        }
+                        const double r = Kokkos::sqrt(r2);
+                        const double w = Kernel::W(r, hi);
+                        rho_i += mass(j) * w;
+                        drho_dh -= mass(j) *
+                                   (3.0 * w + r2 * Kernel::GradWOverR(r, hi)) /
+                                   hi;
+                    }
+                    // f(h) = rho_sum(h) - m (eta / h)^3
+                    const double rho_h = mass(i) * eta3 / (hi * hi * hi);
+                    const double f     = rho_i - rho_h;
+                    const double df    = drho_dh + 3.0 * rho_h / hi;
+                    double h_new       = df > 0.0 ? hi - f / df
+                                                  : eta * Kokkos::cbrt(
+                                                              mass(i) / rho_i);
+                    h_new = Kokkos::min(Kokkos::max(h_new, 0.5 * hi), 2.0 * hi);
+                    h_new = Kokkos::min(Kokkos::max(h_new, h_lo), h_hi);
+                    h(i)  = h_new;
+                    rho(i)       = rho_i;
+                    converged(k) = Kokkos::abs(h_new - hi) <= tol * hi;
+                });
+            std::size_t n_next = 0;
+            Kokkos::parallel_scan(
+                "SmoothingLength::Compact", n_active,
+                KOKKOS_LAMBDA(const int k, std::size_t& offset,
+                              const bool final) {
+                    if (converged(k)) return;
+                    if (final) next(offset) = active(k);
+                    ++offset;
+                },
+                n_next);
+            n_active = n_next;
+        }
+        m_iterations  = pass;
+        m_unconverged = n_active;
+        return pass;
+    }
+
+    /**
+     * @brief Returns the number of passes of the last solve.
+     *
+     * @return Newton passes.
+     */
+    int NumIterations() const { return m_iterations; }
+
+    /**
+     * @brief Returns the number of particle updates of the last solve.
+     *
+     * @return Sum over the passes of the active particles.
+     */
+    std::size_t NumEvaluations() const { return m_evaluations; }
+
+    /**
+     * @brief Returns the number of particles left unconverged by the last
+     * solve (`max_iterations` reached).
+     *
+     * @return Unconverged particles.
+     */
+    std::size_t NumUnconverged() const { return m_unconverged; }
+
+    /**
+     * @brief Returns the smoothing length factor.
+     *
+     * @return eta.
+     */
+    double Eta() const { return m_eta; }
+
+   private:
+    /**
+     * @brief Smoothing length in units of the mean particle spacing.
+     */
+    double m_eta;
+    /**
+     * @brief Relative convergence tolerance on `h`.
+     */
+    double m_tolerance;
+    /**
+     * @brief Maximum number of passes of a solve.
+     */
+    int m_max_iterations;
+    /**
+     * @brief Smallest smoothing length.
+     */
+    double m_h_min;
+    /**
+     * @brief Active rows of the current and the next pass.
+     */
+    Kokkos::View<int*> m_active[2];
+    /**
+     * @brief Convergence flag of every active row of the current pass.
+     */
+    Kokkos::View<int*> m_converged;
+    /**
+     * @brief Number of passes of the last solve.
+     */
+    int m_iterations = 0;
+    /**
+     * @brief Number of particle updates of the last solve.
+     */
+    std::size_t m_evaluations = 0;
+    /**
+     * @brief Number of unconverged particles of the last solve.
+     */
+    std::size_t m_unconverged = 0;
+};
@@ -0,0 +1,109 @@
+#pragma once
+
+// Kokkos includes
+#include <Kokkos_Core.hpp>
+
+#include "simd_ops.hpp"
+
+/**
+ * @file sph_kernel.hpp
+ * @brief Defines the CubicSplineKernel smoothing kernel.
+ *
+ * This file provides the `CubicSplineKernel` structure, the M4 cubic B-spline
+ * smoothing kernel (Monaghan & Lattanzio, 1985) in three dimensions.
+ */
+
+/**
+ * @struct CubicSplineKernel
+ * @brief Three-dimensional M4 cubic spline kernel with support `2 h`.
+ *
+ * All functions are device-callable and return zero outside the support.
+ * The `Kokkos::Experimental::simd` overloads evaluate one pack of pairs
+ * branch-free (host only).
+ */
+struct CubicSplineKernel {
+    /**
+     * @brief Support radius in units of the smoothing length.
+     */
+    static constexpr double support = 2.0;
+
+    /**
+     * @brief Evaluates the kernel.
+     *
+     * @param r Distance between the particles.
+     * @param h Smoothing length.
+     * @return W(r, h).
+     */
+    KOKKOS_INLINE_FUNCTION static double W(const double r, const double h) {
+        const double q     = r / h;
+        const double sigma = 1.0 / (Kokkos::numbers::pi * h * h * h);
+        if (q < 1.0) return sigma * (1.0 - 1.5 * q * q + 0.75 * q * q * q);
+        if (q < 2.0) return sigma * 0.25 * (2.0 - q) * (2.0 - q) * (2.0 - q);
+        return 0.0;
+    }
+
+    /**
+     * @brief Evaluates the kernel for a pack of pairs.
+     *
+     * @param r Distances between the particles.
+     * @param h Smoothing lengths.
+     * @return W(r, h) in every lane.
+     */
+    template <class T, class Abi>
+    static Kokkos::Experimental::simd<T, Abi> W(
+        const Kokkos::Experimental::simd<T, Abi>& r,
+        const Kokkos::Experimental::simd<T, Abi>& h) {
+        using Pack       = Kokkos::Experimental::simd<T, Abi>;
+        const Pack q     = r / h;
+        const Pack sigma = Pack(1.0) / (Pack(Kokkos::numbers::pi) * h * h * h);
+        const Pack two_q = Pack(2.0) - q;
+        const Pack inner = sigma * (Pack(1.0) - Pack(1.5) * q * q +
+                                    Pack(0.75) * q * q * q);
+        const Pack outer = sigma * Pack(0.25) * two_q * two_q * two_q;
+        return SIMDOps::Select(
+            q < Pack(1.0), inner,
+            SIMDOps::Select(q < Pack(2.0), outer, Pack(0.0)));
+    }
+
+    /**
+     * @brief Evaluates the radial derivative of the kernel divided by `r`.
+     *
+     * The gradient with respect to the first particle is
+     * `GradWOverR(r, h) * (x_i - x_j)`. The expression is finite at `r = 0`.
+     *
+     * @param r Distance between the particles.
+     * @param h Smoothing length.
+     * @return (dW/dr)(r, h) / r.
+     */
+    KOKKOS_INLINE_FUNCTION static double GradWOverR(const double r,
+                                                    const double h) {
+        const double q     = r / h;
+        const double sigma = 1.0 / (Kokkos::numbers::pi * h * h * h);
+        if (q < 1.0) return sigma / (h * h) * (-3.0 + 2.25 * q);
+        if (q < 2.0) return -0.75 * sigma * (2.0 - q) * (2.0 - q) / (h * h * q);
+        return 0.0;
+    }
+
+    /**
+     * @brief Evaluates the radial derivative of the kernel divided by `r` for
+     * a pack of pairs.
+     *
+     * @param r Distances between the particles.
+     * @param h Smoothing lengths.
+     * @return (dW/dr)(r, h) / r in every lane.
+     */
+    template <class T, class Abi>
+    static Kokkos::Experimental::simd<T, Abi> GradWOverR(
+        const Kokkos::Experimental::simd<T, Abi>& r,
+        const Kokkos::Experimental::simd<T, Abi>& h) {
+        using Pack       = Kokkos::Experimental::simd<T, Abi>;
+        const Pack q     = r / h;
+        const Pack sigma = Pack(1.0) / (Pack(Kokkos::numbers::pi) * h * h * h);
+        const Pack two_q = Pack(2.0) - q;
+        const Pack inner = sigma / (h * h) * (Pack(-3.0) + Pack(2.25) * q);
+        const Pack outer = Pack(-0.75) * sigma * two_q * two_q / (h * h * q);
+        return SIMDOps::Select(
+            q < Pack(1.0), inner,
+            SIMDOps::Select(q < Pack(2.0), outer, Pack(0.0)));
+    }
+};
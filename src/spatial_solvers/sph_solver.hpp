@@ -0,0 +1,1107 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+
+// Kokkos includes
+#include <Kokkos_Core.hpp>
+#include <Kokkos_ScatterView.hpp>
+
+#include "eos_lazy.hpp"
+#include "eos_multi_material.hpp"
+#include "neighbor_search.hpp"
+#include "sph_kernel.hpp"
+
+/**
+ * @file sph_solver.hpp
+ * @brief Defines the SPHSolver class for the SPH density, momentum and energy
+ * equations.
+ *
+ * This file provides the `SPHSolver` class, which evaluates the summation
+ * density and the pressure and artificial viscosity forces of compressible
+ * SPH, either with hierarchical cell-per-team kernels over the cell lists or
+ * over a CSR neighbor list.
+ */
+
+/**
+ * @enum EOSCoupling
+ * @brief Coupling of the EOS evaluation with the force kernel.
+ */
+enum class EOSCoupling {
+    Separate,  ///< `EOSMultiMaterial::PressureSoS`, then the pair loop.
+    Fused,     ///< EOS evaluated inline for every particle of the pair loop.
+    Lazy       ///< `EOSLazy::PressureSoS` (changed particles), then the loop.
+};
+
+/**
+ * @enum PairLoop
+ * @brief Pair loop of the `NeighborSearch` overloads of `SPHSolver`.
+ */
+enum class PairLoop {
+    CellTeams,    ///< One team per cell (CSR list with the spatial hash).
+    FullList,     ///< One thread per particle over the full CSR list.
+    HalfScatter,  ///< Each pair once, accumulated through a `ScatterView`.
+    HalfColoring  ///< Each pair once, 27-color cell sweeps without atomics.
+};
+
+/**
+ * @struct ArtificialViscosity
+ * @brief Coefficients of the Monaghan artificial viscosity.
+ */
+struct ArtificialViscosity {
+    /**
+     * @brief Linear (bulk) coefficient.
+     */
+    double alpha = 1.0;
+    /**
+     * @brief Quadratic (von Neumann-Richtmyer) coefficient.
+     */
+    double beta = 2.0;
+};
+
+/**
+ * @struct TeamTuning
+ * @brief Launch parameters of the cell-per-team pair kernels.
+ *
+ * Zero values are chosen per backend: `Kokkos::AUTO` for the team size and
+ * the vector length, and for the tile the largest cell occupancy that fits
+ * the level-0 scratch memory.
+ */
+struct TeamTuning {
+    /**
+     * @brief Threads per team (0 for `Kokkos::AUTO`).
+     */
+    int team_size = 0;
+    /**
+     * @brief Vector length, a power of two (0 for `Kokkos::AUTO`).
+     */
+    int vector_length = 0;
+    /**
+     * @brief Neighbor particles staged per tile (0 for automatic).
+     */
+    int tile = 0;
+};
+
+/**
+ * @struct PairForce
+ * @brief Acceleration and internal energy rate summed over the neighbors of
+ * a particle (`ThreadVectorRange` reduction value).
+ */
+struct PairForce {
+    /**
+     * @brief Acceleration.
+     */
+    double a[3] = {0.0, 0.0, 0.0};
+    /**
+     * @brief Internal energy rate.
+     */
+    double de = 0.0;
+
+    /**
+     * @brief Adds the contributions of other neighbors.
+     *
+     * @param other Partial sum.
+     * @return This sum.
+     */
+    KOKKOS_INLINE_FUNCTION PairForce& operator+=(const PairForce& other) {
+        for (int d = 0; d < 3; ++d) a[d] += other.a[d];
+        de += other.de;
+        return *this;
+    }
+};
+
+namespace Kokkos {
+/**
+ * @brief Identity of the sum of `PairForce` values.
+ */
+template <>
+struct reduction_identity<PairForce> {
+    KOKKOS_FORCEINLINE_FUNCTION static PairForce sum() { return PairForce(); }
+};
+}  // namespace Kokkos
+
+/**
+ * @class SPHSolver
+ * @brief Compressible SPH right-hand side on a neighbor list.
+ *
+ * `Forces` computes, for every particle `i` and its neighbors `j`,
+ *
+ * a_i = -sum_j m_j (p_i / rho_i^2 + p_j / rho_j^2 + Pi_ij) grad_i W_ij,
+ * deint_dt_i = 1/2 sum_j m_j (p_i / rho_i^2 + p_j / rho_j^2 + Pi_ij)
+ * v_ij . grad_i W_ij,
+ *
+ * with the symmetrized smoothing length `h_ij = (h_i + h_j) / 2` and the
+ * Monaghan viscosity of approaching pairs (`v_ij . x_ij < 0`)
+ *
+ * Pi_ij = (-alpha c_ij mu_ij + beta mu_ij^2) / rho_ij,
+ * mu_ij = h_ij v_ij . x_ij / (|x_ij|^2 + 0.01 h_ij^2),
+ *
+ * where `c_ij` and `rho_ij` are the mean speed of sound (`sqrt(sos)`, the
+ * EOS store its square) and density of the pair. With
+ * `EOSCoupling::Separate` the pressure and speed of sound are computed by
+ * `EOSMultiMaterial::PressureSoS` and read back from global memory for every
+ * pair. With `EOSCoupling::Fused` they are evaluated from `rho`, `eint` and
+ * the EOS table inside the pair loop, which trades the pair-wise reads of
+ * `p` and `sos` for a few flops; `p_i / rho_i^2` is kept in registers for
+ * the whole row, and `p` and `sos` of particle `i` are still written once so
+ * that the fields stay up to date. `EOSCoupling::Lazy` is the separate
+ * coupling through `EOSLazy`, which only re-evaluates the particles whose
+ * state changed (see `LazyEOS` for its tolerance).
+ *
+ * The neighbor list must contain all pairs closer than the kernel support
+ * (`2 h`) of the largest smoothing length.
+ *
+ * Both functions can be restricted to the rows `first, ..., N - 1` (e.g. the
+ * active time bins of `TimeBins`); the other particles are read as
+ * neighbors with their last computed density, pressure and speed of sound.
+ *
+ * Given a `NeighborSearch`, both functions use the cell-per-team kernels
+ * when the cells form a uniform grid, and the CSR list otherwise. A team
+ * handles the particles of one cell: the data of the neighbor cells is
+ * staged tile by tile in team scratch memory (`CellList::TeamTiles`), the
+ * particles of the cell are spread over the threads of the team
+ * (`TeamThreadRange`) and the pairs of a particle over the vector lanes
+ * (`ThreadVectorRange`). Each neighbor is read from global memory once per
+ * cell instead of once per pair, and the fused EOS runs once per staged
+ * particle instead of once per pair. The team size, vector length and tile
+ * are set by `TeamTuning`. The cells contain all the pairs of the neighbor
+ * list, so both paths agree up to the summation order.
+ *
+ * The forces are antisymmetric, so `ForcesHalf` visits every pair of a half
+ * list once and adds its contribution to both particles, which halves the
+ * pair flops. Without a `CellList` the contributions go through a
+ * `Kokkos::Experimental::ScatterView`, which duplicates the output on host
+ * backends and uses atomics on GPUs. With a `CellList`, the cells are swept
+ * in 27 colors (cell coordinates modulo 3): the cells of a color are three
+ * cells apart, so their neighborhoods are disjoint and one thread per cell
+ * writes both particles of its pairs without atomics. `SetLoop` selects
+ * the loop of the `NeighborSearch` overloads, so that every backend can use
+ * the fastest one; the density always uses a full loop.
+ *
+ * @tparam Kernel Smoothing kernel (e.g. `CubicSplineKernel`).
+ */
+template <class Kernel = CubicSplineKernel>
+class SPHSolver {
+   public:
+    /**
+     * @brief Constructor for SPHSolver.
+     *
+     * @param eos Multi-material EOS.
+     * @param coupling Coupling of the EOS with the force kernel.
+     * @param viscosity Artificial viscosity coefficients.
+     * @param tuning Launch parameters of the cell-per-team kernels.
+     * @param eos_tolerance Relative change of `rho` or `eint` re-evaluating
+     * the EOS of a particle (`EOSCoupling::Lazy`).
+     * @throws std::invalid_argument If a viscosity coefficient or the
+     * tolerance is negative, or the tuning is invalid.
+     */
+    explicit SPHSolver(const EOSMultiMaterial& eos,
+                       const EOSCoupling coupling = EOSCoupling::Separate,
+                       const ArtificialViscosity viscosity = {},
+                       const TeamTuning tuning             = {},
+                       const double eos_tolerance          = 1e-6)
+        : m_eos(eos),
+          m_lazy(eos, eos_tolerance),
+          m_coupling(coupling),
+          m_viscosity(viscosity) {
+        if (viscosity.alpha < 0.0 || viscosity.beta < 0.0) {
+            throw std::invalid_argument(
+                "SPHSolver: viscosity coefficients must be non-negative");
+        }
+        SetTuning(tuning);
+    }
+
+    /**
+     * @brief Computes the summation density with the default pair loop.
+     *
+     * @param particles Particle container providing `X`, `Mass`, `H` and
+     * `Rho` (e.g. `ParticleData`).
+     * @param search Neighbor search of the particles.
+     * @param first First updated particle.
+     */
+    template <class Particles>
+    void Density(const Particles& particles, const NeighborSearch& search,
+                 const std::size_t first = 0) const {
+        if (m_pair_loop != PairLoop::FullList &&
+            search.Grid().indexing == CellIndexing::UniformGrid) {
+            Density(particles, search.Cells(), first);
+        } else {
+            Density(particles, search.List(), first);
+        }
+    }
+
+    /**
+     * @brief Computes the accelerations and internal energy rates with the
+     * default pair loop.
+     *
+     * @param particles Particle container providing `X`, `V`, `A`, `Mass`,
+     * `H`, `Rho`, `Eint`, `DEintDt`, `P`, `SoS` and `EOSId` (e.g.
+     * `ParticleData`).
+     * @param search Neighbor search of the particles (with the half list
+     * for the half loops).
+     * @param first First updated particle.
+     * @throws std::runtime_error If a half loop is selected and the search
+     * keeps no half list.
+     */
+    template <class Particles>
+    void Forces(const Particles& particles, const NeighborSearch& search,
+                const std::size_t first = 0) const {
+        const bool grid = search.Grid().indexing == CellIndexing::UniformGrid;
+        switch (m_pair_loop) {
+            case PairLoop::CellTeams:
+                if (grid) {
+                    Forces(particles, search.Cells(), first);
+                } else {
+                    Forces(particles, search.List(), first);
+                }
+                break;
+            case PairLoop::FullList:
+                Forces(particles, search.List(), first);
+                break;
+            case PairLoop::HalfScatter:
+                ForcesHalf(particles, search.HalfList(), first);
+                break;
+            case PairLoop::HalfColoring:
+                if (grid) {
+                    ForcesHalf(particles, search.HalfList(), search.Cells(),
+                               first);
+                } else {
+                    ForcesHalf(particles, search.HalfList(), first);
+                }
+                break;
+        }
+    }
+
+    /**
+     * @brief Computes the summation density.
+     *
+     * rho_i = m_i W(0, h_i) + sum_j m_j W(r_ij, h_ij).
+     *
+     * @param particles Particle container providing `X`, `Mass`, `H` and
+     * `Rho` (e.g. `ParticleData`).
+     * @param list Neighbor list of the particles.
+     * @param first First updated particle.
+     */
+    template <class Particles>
+    void Density(const Particles& particles, const NeighborList& list,
+                 const std::size_t first = 0) const {
+        ProfilingRegion region("Density");
+        const auto x    = particles.X();
+        const auto mass = particles.Mass();
+        const auto h    = particles.H();
+        const auto rho  = particles.Rho();
+        Kokkos::parallel_for(
+            "SPHSolver::Density",
+            Kokkos::RangePolicy<>(first, rho.extent(0)),
+            KOKKOS_LAMBDA(const int i) {
+                double rho_i = mass(i) * Kernel::W(0.0, h(i));
+                for (int k = 0; k < list.NumNeighbors(i); ++k) {
+                    const int j = list.Neighbor(i, k);
+                    double r2   = 0.0;
+                    for (int d = 0; d < 3; ++d) {
+                        const double dx = x(i, d) - x(j, d);
+                        r2 += dx * dx;
+                    }
+                    rho_i += mass(j) * Kernel::W(Kokkos::sqrt(r2),
+                                                 0.5 * (h(i) + h(j)));
+                }
+                rho(i) = rho_i;
+            });
+    }
+
+    /**
+     * @brief Computes the accelerations and internal energy rates.
+     *
+     * @param particles Particle container providing `X`, `V`, `A`, `Mass`,
+     * `H`, `Rho`, `Eint`, `DEintDt`, `P`, `SoS` and `EOSId` (e.g.
+     * `ParticleData`).
+     * @param list Neighbor list of the particles.
+     * @param first First updated particle.
+     */
+    template <class Particles>
+    void Forces(const Particles& particles, const NeighborList& list,
+                const std::size_t first = 0) const {
+        ProfilingRegion region("Forces");
+        const auto x        = particles.X();
+        const auto v        = particles.V();
+        const auto a        = particles.A();
+        const auto mass     = particles.Mass();
+        const auto h        = particles.H();
+        const auto rho      = particles.Rho();
+        const auto eint     = particles.Eint();
+        const auto deint_dt = particles.DEintDt();
+        const auto p        = particles.P();
+        const auto sos      = particles.SoS();
+        const auto eos_id   = particles.EOSId();
+        const auto table    = m_eos.Table();
+        const bool fused    = m_coupling == EOSCoupling::Fused;
+        const double alpha  = m_viscosity.alpha;
+        const double beta   = m_viscosity.beta;
+
+        if (!fused) SeparatePressureSoS(particles, first);
+        Kokkos::parallel_for(
+            "SPHSolver::Forces", Kokkos::RangePolicy<>(first, rho.extent(0)),
+            KOKKOS_LAMBDA(const int i) {
+                double p_i   = fused ? 0.0 : p(i);
+                double sos_i = fused ? 0.0 : sos(i);
+                if (fused) {
+                    EOSMultiMaterial::PressureSoSPoint(
+                        table, eos_id(i), rho(i), eint(i), p_i, sos_i);
+                }
+                const double pr_i = p_i / (rho(i) * rho(i));
+                // The EOS store the squared speed of sound
+                const double c_i = Kokkos::sqrt(sos_i);
+
+                double a_i[3] = {0.0, 0.0, 0.0};
+                double de_i   = 0.0;
+                for (int k = 0; k < list.NumNeighbors(i); ++k) {
+                    const int j  = list.Neighbor(i, k);
+                    double p_j   = fused ? 0.0 : p(j);
+                    double sos_j = fused ? 0.0 : sos(j);
+                    if (fused) {
+                        EOSMultiMaterial::PressureSoSPoint(
+                            table, eos_id(j), rho(j), eint(j), p_j, sos_j);
+                    }
+
+                    double dx[3];
+                    double r2 = 0.0;
+                    double vr = 0.0;
+                    for (int d = 0; d < 3; ++d) {
+                        dx[d] = x(i, d) - x(j, d);
+                        r2 += dx[d] * dx[d];
+                        vr += (v(i, d) - v(j, d)) * dx[d];
+                    }
+                    const double h_ij = 0.5 * (h(i) + h(j));
+                    const double grad =
+                        Kernel::GradWOverR(Kokkos::sqrt(r2), h_ij);
+
+                    // Monaghan viscosity, active for approaching particles
+                    double visc = 0.0;
+                    if (vr < 0.0) {
+                        const double mu =
+                            h_ij * vr / (r2 + 0.01 * h_ij * h_ij);
+                        const double c_ij = 0.5 * (c_i + Kokkos::sqrt(sos_j));
+                        visc = (-alpha * c_ij * mu + beta * mu * mu) /
+                               (0.5 * (rho(i) + rho(j)));
+                    }
+
+                    const double f =
+                        mass(j) * (pr_i + p_j / (rho(j) * rho(j)) + visc) *
+                        grad;
+                    for (int d = 0; d < 3; ++d) a_i[d] -= f * dx[d];
+                    de_i += 0.5 * f * vr;
+                }
+                for (int d = 0; d < 3; ++d) a(i, d) = a_i[d];
+                deint_dt(i) = de_i;
+                if (fused) {
+                    p(i)   = p_i;
+                    sos(i) = sos_i;
+                }
+            });
+    }
+
+    /**
+     * @brief Computes the summation density with one team per cell.
+     *
+     * A particle is one of its own staged neighbors, so its self
+     * contribution comes from the pair loop. On host execution spaces the
+     * staged neighbors go by SIMD packs (`SIMDOps`).
+     *
+     * @param particles Particle container providing `X`, `Mass`, `H` and
+     * `Rho` (e.g. `ParticleData`).
+     * @param cells Cell lists of the particles.
+     * @param first First updated particle.
+     */
+    template <class Particles>
+    void Density(const Particles& particles, const CellList& cells,
+                 const std::size_t first = 0) const {
+        ProfilingRegion region("Density");
+        const auto x    = particles.X();
+        const auto mass = particles.Mass();
+        const auto h    = particles.H();
+        const auto rho  = particles.Rho();
+        // Staged: x, y, z, h, mass; own: partial density
+        const int tile = Tile(cells, 5, 1);
+        Kokkos::parallel_for(
+            "SPHSolver::DensityTeams",
+            Policy(cells.grid.n_cells)
+                .set_scratch_size(0, Kokkos::PerTeam(ScratchBytes(tile, 5, 1))),
+            KOKKOS_LAMBDA(const Member& team) {
+                if (!HasActive(team, cells, first)) return;
+                const ScratchMatrix staged(team.team_scratch(0), tile, 5);
+                const ScratchMatrix own(team.team_scratch(0), tile, 1);
+                cells.TeamTiles(
+                    team, tile,
+                    [&](const int q, const int) { own(q, 0) = 0.0; },
+                    [&](const int s, const int j) {
+                        for (int d = 0; d < 3; ++d) staged(s, d) = x(j, d);
+                        staged(s, 3) = h(j);
+                        staged(s, 4) = mass(j);
+                    },
+                    [&](const int q, const int i, const int n) {
+                        if (static_cast<std::size_t>(i) < first) return;
+                        const double xi[3] = {x(i, 0), x(i, 1), x(i, 2)};
+                        const double h_i   = h(i);
+                        // Density of a staged neighbor or of a pack of them
+                        const auto pair = [&](const auto& load, auto& sum) {
+                            using T = std::decay_t<decltype(sum)>;
+                            T r2    = T(0.0);
+                            for (int d = 0; d < 3; ++d) {
+                                const T dx = T(xi[d]) - load(d);
+                                r2 += dx * dx;
+                            }
+                            sum += load(4) *
+                                   Kernel::W(Kokkos::sqrt(r2),
+                                             T(0.5) * (T(h_i) + load(3)));
+                        };
+                        double rho_i = 0.0;
+                        int s0       = 0;
+                        if constexpr (SIMDOps::enabled) {
+                            SIMDOps::Pack<double> sum(0.0);
+                            s0 = StagedPacks(staged, n, [&](const auto& l) {
+                                pair(l, sum);
+                            });
+                            rho_i = SIMDOps::Sum(sum);
+                        }
+                        double rho_tail = 0.0;
+                        Kokkos::parallel_reduce(
+                            Kokkos::ThreadVectorRange(team, s0, n),
+                            [&](const int s, double& sum) {
+                                pair([&](const int c) { return staged(s, c); },
+                                     sum);
+                            },
+                            rho_tail);
+                        Kokkos::single(Kokkos::PerThread(team), [&]() {
+                            own(q, 0) += rho_i + rho_tail;
+                        });
+                    },
+                    [&](const int q, const int i) {
+                        if (static_cast<std::size_t>(i) >= first) {
+                            rho(i) = own(q, 0);
+                        }
+                    });
+            });
+    }
+
+    /**
+     * @brief Computes the accelerations and internal energy rates with one
+     * team per cell.
+     *
+     * The self pair of a particle is staged too and contributes exactly
+     * zero. On host execution spaces the staged neighbors go by SIMD packs
+     * (`SIMDOps`).
+     *
+     * @param particles Particle container providing `X`, `V`, `A`, `Mass`,
+     * `H`, `Rho`, `Eint`, `DEintDt`, `P`, `SoS` and `EOSId` (e.g.
+     * `ParticleData`).
+     * @param cells Cell lists of the particles.
+     * @param first First updated particle.
+     */
+    template <class Particles>
+    void Forces(const Particles& particles, const CellList& cells,
+                const std::size_t first = 0) const {
+        ProfilingRegion region("Forces");
+        const auto x        = particles.X();
+        const auto v        = particles.V();
+        const auto a        = particles.A();
+        const auto mass     = particles.Mass();
+        const auto h        = particles.H();
+        const auto rho      = particles.Rho();
+        const auto eint     = particles.Eint();
+        const auto deint_dt = particles.DEintDt();
+        const auto p        = particles.P();
+        const auto sos      = particles.SoS();
+        const auto eos_id   = particles.EOSId();
+        const auto table    = m_eos.Table();
+        const bool fused    = m_coupling == EOSCoupling::Fused;
+        const double alpha  = m_viscosity.alpha;
+        const double beta   = m_viscosity.beta;
+
+        if (!fused) SeparatePressureSoS(particles, first);
+        // Staged: x (3), v (3), mass, h, rho, p / rho^2, c = sqrt(sos); own:
+        // p, sos, p / rho^2, a (3), deint_dt
+        const int tile = Tile(cells, 11, 7);
+        Kokkos::parallel_for(
+            "SPHSolver::ForcesTeams",
+            Policy(cells.grid.n_cells)
+                .set_scratch_size(0,
+                                  Kokkos::PerTeam(ScratchBytes(tile, 11, 7))),
+            KOKKOS_LAMBDA(const Member& team) {
+                if (!HasActive(team, cells, first)) return;
+                const ScratchMatrix staged(team.team_scratch(0), tile, 11);
+                const ScratchMatrix own(team.team_scratch(0), tile, 7);
+                // Pressure and speed of sound, from the EOS table if fused
+                const auto state = [&](const int i, double& p_i,
+                                       double& sos_i) {
+                    p_i   = fused ? 0.0 : p(i);
+                    sos_i = fused ? 0.0 : sos(i);
+                    if (fused) {
+                        EOSMultiMaterial::PressureSoSPoint(
+                            table, eos_id(i), rho(i), eint(i), p_i, sos_i);
+                    }
+                };
+                cells.TeamTiles(
+                    team, tile,
+                    [&](const int q, const int i) {
+                        state(i, own(q, 0), own(q, 1));
+                        own(q, 2) = own(q, 0) / (rho(i) * rho(i));
+                        for (int c = 3; c < 7; ++c) own(q, c) = 0.0;
+                    },
+                    [&](const int s, const int j) {
+                        double p_j, sos_j;
+                        state(j, p_j, sos_j);
+                        for (int d = 0; d < 3; ++d) {
+                            staged(s, d)     = x(j, d);
+                            staged(s, 3 + d) = v(j, d);
+                        }
+                        staged(s, 6)  = mass(j);
+                        staged(s, 7)  = h(j);
+                        staged(s, 8)  = rho(j);
+                        staged(s, 9)  = p_j / (rho(j) * rho(j));
+                        staged(s, 10) = Kokkos::sqrt(sos_j);
+                    },
+                    [&](const int q, const int i, const int n) {
+                        if (static_cast<std::size_t>(i) < first) return;
+                        const double xi[3] = {x(i, 0), x(i, 1), x(i, 2)};
+                        const double vi[3] = {v(i, 0), v(i, 1), v(i, 2)};
+                        const double h_i   = h(i);
+                        const double rho_i = rho(i);
+                        const double c_i   = Kokkos::sqrt(own(q, 1));
+                        const double pr_i  = own(q, 2);
+                        // Forces of a staged neighbor or of a pack of them
+                        const auto pair = [&](const auto& load, auto* acc,
+                                              auto& de) {
+                            using T = std::decay_t<decltype(de)>;
+                            T dx[3];
+                            T r2 = T(0.0);
+                            T vr = T(0.0);
+                            for (int d = 0; d < 3; ++d) {
+                                dx[d] = T(xi[d]) - load(d);
+                                r2 += dx[d] * dx[d];
+                                vr += (T(vi[d]) - load(3 + d)) * dx[d];
+                            }
+                            const T h_ij = T(0.5) * (T(h_i) + load(7));
+                            const T grad =
+                                Kernel::GradWOverR(Kokkos::sqrt(r2), h_ij);
+
+                            // Monaghan viscosity, active for approaching
+                            // particles
+                            const T mu =
+                                h_ij * vr / (r2 + T(0.01) * h_ij * h_ij);
+                            const T visc = SIMDOps::Select(
+                                vr < T(0.0),
+                                (T(-alpha * 0.5) * (T(c_i) + load(10)) * mu +
+                                 T(beta) * mu * mu) /
+                                    (T(0.5) * (T(rho_i) + load(8))),
+                                T(0.0));
+
+                            const T f =
+                                load(6) * (T(pr_i) + load(9) + visc) * grad;
+                            for (int d = 0; d < 3; ++d) acc[d] -= f * dx[d];
+                            de += T(0.5) * f * vr;
+                        };
+                        PairForce force;
+                        int s0 = 0;
+                        if constexpr (SIMDOps::enabled) {
+                            using Pack  = SIMDOps::Pack<double>;
+                            Pack acc[3] = {Pack(0.0), Pack(0.0), Pack(0.0)};
+                            Pack de(0.0);
+                            s0 = StagedPacks(staged, n, [&](const auto& l) {
+                                pair(l, acc, de);
+                            });
+                            for (int d = 0; d < 3; ++d) {
+                                force.a[d] = SIMDOps::Sum(acc[d]);
+                            }
+                            force.de = SIMDOps::Sum(de);
+                        }
+                        PairForce tail;
+                        Kokkos::parallel_reduce(
+                            Kokkos::ThreadVectorRange(team, s0, n),
+                            [&](const int s, PairForce& sum) {
+                                pair([&](const int c) { return staged(s, c); },
+                                     sum.a, sum.de);
+                            },
+                            tail);
+                        force += tail;
+                        Kokkos::single(Kokkos::PerThread(team), [&]() {
+                            for (int d = 0; d < 3; ++d) {
+                                own(q, 3 + d) += force.a[d];
+                            }
+                            own(q, 6) += force.de;
+                        });
+                    },
+                    [&](const int q, const int i) {
+                        if (static_cast<std::size_t>(i) < first) return;
+                        for (int d = 0; d < 3; ++d) a(i, d) = own(q, 3 + d);
+                        deint_dt(i) = own(q, 6);
+                        if (fused) {
+                            p(i)   = own(q, 0);
+                            sos(i) = own(q, 1);
+                        }
+                    });
+            });
+    }
+
+    /**
+     * @brief Computes the accelerations and internal energy rates over a
+     * half list, accumulated through a `ScatterView`.
+     *
+     * @param particles Particle container providing `X`, `V`, `A`, `Mass`,
+     * `H`, `Rho`, `Eint`, `DEintDt`, `P`, `SoS` and `EOSId` (e.g.
+     * `ParticleData`).
+     * @param half_list Half neighbor list of the particles.
+     * @param first First updated particle.
+     */
+    template <class Particles>
+    void ForcesHalf(const Particles& particles, const NeighborList& half_list,
+                    const std::size_t first = 0) const {
+        ProfilingRegion region("Forces");
+        const HalfRows<Particles> rows = MakeHalfRows(particles, half_list,
+                                                      first);
+        Kokkos::View<double* [4]> rhs("sph_half_rhs", rows.rho.extent(0));
+        auto scatter = Kokkos::Experimental::create_scatter_view(rhs);
+        Kokkos::parallel_for(
+            "SPHSolver::ForcesHalfScatter", rows.rho.extent(0),
+            KOKKOS_LAMBDA(const int i) { rows(i, scatter.access()); });
+        Kokkos::Experimental::contribute(rhs, scatter);
+        StoreHalf(particles, rows, rhs);
+    }
+
+    /**
+     * @brief Computes the accelerations and internal energy rates over a
+     * half list, with colored cell sweeps.
+     *
+     * @param particles Particle container providing `X`, `V`, `A`, `Mass`,
+     * `H`, `Rho`, `Eint`, `DEintDt`, `P`, `SoS` and `EOSId` (e.g.
+     * `ParticleData`).
+     * @param half_list Half neighbor list of the particles.
+     * @param cells Cell lists of the build of `half_list`.
+     * @param first First updated particle.
+     */
+    template <class Particles>
+    void ForcesHalf(const Particles& particles, const NeighborList& half_list,
+                    const CellList& cells, const std::size_t first = 0) const {
+        ProfilingRegion region("Forces");
+        const HalfRows<Particles> rows = MakeHalfRows(particles, half_list,
+                                                      first);
+        Kokkos::View<double* [4]> rhs("sph_half_rhs", rows.rho.extent(0));
+        const CellGrid& grid = cells.grid;
+        for (int color = 0; color < 27; ++color) {
+            const int o[3] = {color % 3, color / 3 % 3, color / 9};
+            int n[3];
+            for (int d = 0; d < 3; ++d) n[d] = (grid.dims[d] - o[d] + 2) / 3;
+            Kokkos::parallel_for(
+                "SPHSolver::ForcesHalfColoring", n[0] * n[1] * n[2],
+                KOKKOS_LAMBDA(const int t) {
+                    const int c = grid.Index(o[0] + 3 * (t % n[0]),
+                                             o[1] + 3 * (t / n[0] % n[1]),
+                                             o[2] + 3 * (t / (n[0] * n[1])));
+                    for (std::size_t k = cells.offsets(c);
+                         k < cells.offsets(c + 1); ++k) {
+                        rows(cells.particles(k), rhs);
+                    }
+                });
+        }
+        StoreHalf(particles, rows, rhs);
+    }
+
+    /**
+     * @brief Returns the coupling of the EOS with the force kernel.
+     *
+     * @return EOS coupling.
+     */
+    EOSCoupling Coupling() const { return m_coupling; }
+
+    /**
+     * @brief Selects the coupling of the EOS with the force kernel.
+     *
+     * @param coupling EOS coupling.
+     */
+    void SetCoupling(const EOSCoupling coupling) { m_coupling = coupling; }
+
+    /**
+     * @brief Returns the incremental EOS of `EOSCoupling::Lazy`.
+     *
+     * Its reference states are particle fields, so they follow every
+     * reordering of the particles.
+     *
+     * @return Incremental EOS.
+     */
+    EOSLazy& LazyEOS() { return m_lazy; }
+
+    /**
+     * @brief Returns the pair loop of the `NeighborSearch` overloads.
+     *
+     * @return Pair loop.
+     */
+    PairLoop Loop() const { return m_pair_loop; }
+
+    /**
+     * @brief Selects the pair loop of the `NeighborSearch` overloads.
+     *
+     * @param loop Pair loop.
+     */
+    void SetLoop(const PairLoop loop) { m_pair_loop = loop; }
+
+    /**
+     * @brief Returns the launch parameters of the cell-per-team kernels.
+     *
+     * @return Team tuning.
+     */
+    const TeamTuning& Tuning() const { return m_tuning; }
+
+    /**
+     * @brief Sets the launch parameters of the cell-per-team kernels.
+     *
+     * @param tuning Team tuning.
+     * @throws std::invalid_argument On negative values or a vector length
+     * that is not a power of two.
+     */
+    void SetTuning(const TeamTuning tuning) {
+        const int vector = tuning.vector_length;
+        if (tuning.team_size < 0 || tuning.tile < 0 || vector < 0 ||
+            (vector & (vector - 1)) != 0) {
+            throw std::invalid_argument(
+                "SPHSolver: team_size and tile must be non-negative and "
+                "vector_length a power of two (0 for automatic)");
+        }
+        m_tuning = tuning;
+    }
+
+   private:
+    /**
+     * @struct HalfRows
+     * @brief Device functor of the half-list pair loop.
+     *
+     * `rows(i, target)` visits the pairs `(i, j > i)` of the half list and
+     * adds `a` and `deint_dt` of both particles to `target(., 0..2)` and
+     * `target(., 3)`, skipping the rows before `first`.
+     */
+    template <class Particles>
+    struct HalfRows {
+        using Ref = const Particles&;
+        decltype(std::declval<Ref>().X()) x;           ///< Positions.
+        decltype(std::declval<Ref>().V()) v;           ///< Velocities.
+        decltype(std::declval<Ref>().Mass()) mass;     ///< Masses.
+        decltype(std::declval<Ref>().H()) h;           ///< Smoothing lengths.
+        decltype(std::declval<Ref>().Rho()) rho;       ///< Densities.
+        decltype(std::declval<Ref>().Eint()) eint;     ///< Internal energies.
+        decltype(std::declval<Ref>().P()) p;           ///< Pressures.
+        decltype(std::declval<Ref>().SoS()) sos;       ///< Speeds of sound.
+        decltype(std::declval<Ref>().EOSId()) eos_id;  ///< EOS ids.
+        Kokkos::View<const EOSParams*> table;          ///< EOS table.
+        NeighborList list;                             ///< Half list.
+        std::size_t first;                             ///< First updated row.
+        bool fused;                                    ///< Inline EOS.
+        double alpha;                                  ///< Linear viscosity.
+        double beta;                                   ///< Quadratic viscosity.
+
+        /**
+         * @brief Returns the pressure and speed of sound of a particle.
+         *
+         * @param i Particle index.
+         * @param p_i Pressure (output).
+         * @param sos_i Speed of sound (output).
+         */
+        KOKKOS_INLINE_FUNCTION void State(const int i, double& p_i,
+                                          double& sos_i) const {
+            if (fused) {
+                p_i   = 0.0;
+                sos_i = 0.0;
+                EOSMultiMaterial::PressureSoSPoint(table, eos_id(i), rho(i),
+                                                   eint(i), p_i, sos_i);
+            } else {
+                p_i   = p(i);
+                sos_i = sos(i);
+            }
+        }
+
+        /**
+         * @brief Accumulates the pairs of a row of the half list.
+         *
+         * @param i Particle index.
+         * @param target Accumulator (N x 4 view or `ScatterView` access).
+         */
+        template <class Target>
+        KOKKOS_INLINE_FUNCTION void operator()(const int i,
+                                               const Target& target) const {
+            double p_i, sos_i;
+            State(i, p_i, sos_i);
+            const double pr_i = p_i / (rho(i) * rho(i));
+            // The EOS store the squared speed of sound
+            const double c_i  = Kokkos::sqrt(sos_i);
+            double a_i[3]     = {0.0, 0.0, 0.0};
+            double de_i       = 0.0;
+            for (int k = 0; k < list.NumNeighbors(i); ++k) {
+                // j > i, so both rows are before `first` if j is
+                const int j = list.Neighbor(i, k);
+                if (static_cast<std::size_t>(j) < first) continue;
+                double p_j, sos_j;
+                State(j, p_j, sos_j);
+
+                double dx[3];
+                double r2 = 0.0;
+                double vr = 0.0;
+                for (int d = 0; d < 3; ++d) {
+                    dx[d] = x(i, d) - x(j, d);
+                    r2 += dx[d] * dx[d];
+                    vr += (v(i, d) - v(j, d)) * dx[d];
+                }
+                const double h_ij = 0.5 * (h(i) + h(j));
+                const double grad = Kernel::GradWOverR(Kokkos::sqrt(r2), h_ij);
+
+                // Monaghan viscosity, active for approaching particles
+                double visc = 0.0;
+                if (vr < 0.0) {
+                    const double mu = h_ij * vr / (r2 + 0.01 * h_ij * h_ij);
+                    const double c_ij = 0.5 * (c_i + Kokkos::sqrt(sos_j));
+                    visc = (-alpha * c_ij * mu + beta * mu * mu) /
+                           (0.5 * (rho(i) + rho(j)));
+                }
+
+                // Symmetric pair term, scaled by the mass of the partner
+                const double g =
+                    (pr_i + p_j / (rho(j) * rho(j)) + visc) * grad;
+                for (int d = 0; d < 3; ++d) {
+                    a_i[d] -= mass(j) * g * dx[d];
+                    target(j, d) += mass(i) * g * dx[d];
+                }
+                de_i += 0.5 * mass(j) * g * vr;
+                target(j, 3) += 0.5 * mass(i) * g * vr;
+            }
+            if (static_cast<std::size_t>(i) < first) return;
+            for (int d = 0; d < 3; ++d) target(i, d) += a_i[d];
+            target(i, 3) += de_i;
+        }
+    };
+
+    /**
+     * @brief Evaluates the separate EOS and returns the half-list functor.
+     *
+     * Building block of `ForcesHalf`.
+     *
+     * @param particles Particle container.
+     * @param half_list Half neighbor list of the particles.
+     * @param first First updated particle.
+     * @return Half-list functor.
+     */
+    template <class Particles>
+    HalfRows<Particles> MakeHalfRows(const Particles& particles,
+                                     const NeighborList& half_list,
+                                     const std::size_t first) const {
+        const bool fused = m_coupling == EOSCoupling::Fused;
+        HalfRows<Particles> rows{particles.X(),    particles.V(),
+                                 particles.Mass(), particles.H(),
+                                 particles.Rho(),  particles.Eint(),
+                                 particles.P(),    particles.SoS(),
+                                 particles.EOSId(), m_eos.Table(),
+                                 half_list,        first,
+                                 fused,            m_viscosity.alpha,
+                                 m_viscosity.beta};
+        if (!fused) {
+            SeparatePressureSoS(particles, first);
+        }
+        return rows;
+    }
+
+    /**
+     * @brief Stores the accumulated right-hand side of the updated rows.
+     *
+     * Building block of `ForcesHalf`; with the fused EOS, also stores the
+     * pressure and speed of sound.
+     *
+     * @param particles Particle container providing `A` and `DEintDt`.
+     * @param rows Half-list functor.
+     * @param rhs Accumulated accelerations and internal energy rates.
+     */
+    template <class Particles>
+    static void StoreHalf(const Particles& particles,
+                          const HalfRows<Particles>& rows,
+                          const Kokkos::View<double* [4]>& rhs) {
+        const auto a        = particles.A();
+        const auto deint_dt = particles.DEintDt();
+        Kokkos::parallel_for(
+            "SPHSolver::ForcesHalfStore",
+            Kokkos::RangePolicy<>(rows.first, rhs.extent(0)),
+            KOKKOS_LAMBDA(const int i) {
+                for (int d = 0; d < 3; ++d) a(i, d) = rhs(i, d);
+                deint_dt(i) = rhs(i, 3);
+                if (rows.fused) {
+                    double p_i, sos_i;
+                    rows.State(i, p_i, sos_i);
+                    rows.p(i)   = p_i;
+                    rows.sos(i) = sos_i;
+                }
+            });
+    }
+
+    /**
+     * @brief Team policy of the cell-per-team kernels.
+     */
+    using TeamPolicy = Kokkos::TeamPolicy<>;
+    /**
+     * @brief Team handle of the cell-per-team kernels.
+     */
+    using Member = TeamPolicy::member_type;
+    /**
+     * @brief Scratch memory space of the default execution space.
+     */
+    using ScratchSpace = Kokkos::DefaultExecutionSpace::scratch_memory_space;
+    /**
+     * @brief Per-slot values staged in team scratch memory, slot-contiguous
+     * so that a column loads as a SIMD pack.
+     */
+    using ScratchMatrix = Kokkos::View<double**, Kokkos::LayoutLeft,
+                                       ScratchSpace, Kokkos::MemoryUnmanaged>;
+
+    /**
+     * @brief Returns the team policy over the cells.
+     *
+     * @param n_cells Number of cells (league size).
+     * @return Team policy with the tuned or automatic team size and vector
+     * length.
+     */
+    TeamPolicy Policy(const int n_cells) const {
+        const int team   = m_tuning.team_size;
+        const int vector = m_tuning.vector_length;
+        if (team > 0 && vector > 0) return TeamPolicy(n_cells, team, vector);
+        if (team > 0) return TeamPolicy(n_cells, team, Kokkos::AUTO);
+        if (vector > 0) return TeamPolicy(n_cells, Kokkos::AUTO, vector);
+        return TeamPolicy(n_cells, Kokkos::AUTO, Kokkos::AUTO);
+    }
+
+    /**
+     * @brief Returns the team scratch size of a kernel.
+     *
+     * @param tile Tile size.
+     * @param n_staged Values per staged particle.
+     * @param n_own Values per own particle.
+     * @return Bytes of level-0 scratch memory per team.
+     */
+    static std::size_t ScratchBytes(const int tile, const int n_staged,
+                                    const int n_own) {
+        return ScratchMatrix::shmem_size(tile, n_staged) +
+               ScratchMatrix::shmem_size(tile, n_own);
+    }
+
+    /**
+     * @brief Calls `pair(load)` on the full SIMD packs of the staged slots
+     * `[0, n)`, `load(c)` returning the pack of column `c`.
+     *
+     * Building block of the cell-per-team kernels on host execution spaces.
+     *
+     * @param staged Staged values.
+     * @param n Number of staged slots.
+     * @param pair Callable on a column loader.
+     * @return First slot left for the scalar loop.
+     */
+    template <class Pair>
+    static int StagedPacks(const ScratchMatrix& staged, const int n,
+                           const Pair& pair) {
+        constexpr int width = SIMDOps::Width<double>();
+        int s               = 0;
+        for (; s + width <= n; s += width) {
+            pair([&](const int c) { return SIMDOps::Load(&staged(s, c)); });
+        }
+        return s;
+    }
+
+    /**
+     * @brief Returns the tile size of a kernel.
+     *
+     * @param cells Cell lists.
+     * @param n_staged Values per staged particle.
+     * @param n_own Values per own particle.
+     * @return Tuned tile, or the largest cell occupancy that fits the
+     * level-0 scratch memory.
+     */
+    int Tile(const CellList& cells, const int n_staged,
+             const int n_own) const {
+        if (m_tuning.tile > 0) return m_tuning.tile;
+        const std::size_t capacity = TeamPolicy::scratch_size_max(0);
+        int tile = std::max(cells.max_occupancy, 1);
+        while (tile > 1 && ScratchBytes(tile, n_staged, n_own) > capacity) {
+            tile /= 2;
+        }
+        return tile;
+    }
+
+    /**
+     * @brief Returns whether the cell of a team holds updated particles.
+     *
+     * @param team Team handle.
+     * @param cells Cell lists.
+     * @param first First updated particle.
+     * @return True if a particle of the cell has an index >= `first`.
+     */
+    KOKKOS_INLINE_FUNCTION static bool HasActive(const Member& team,
+                                                 const CellList& cells,
+                                                 const std::size_t first) {
+        const int c  = team.league_rank();
+        int n_active = 0;
+        Kokkos::parallel_reduce(
+            Kokkos::TeamThreadRange(team, static_cast<int>(cells.offsets(c)),
+                                    static_cast<int>(cells.offsets(c + 1))),
+            [&](const int k, int& count) {
+                count += static_cast<std::size_t>(cells.particles(k)) >= first;
+            },
+            n_active);
+        return n_active > 0;
+    }
+
+    /**
+     * @brief Computes pressure and speed of sound of the rows from `first`
+     * when the EOS is not fused.
+     *
+     * Building block of `Forces` and `ForcesHalf`.
+     *
+     * @param particles Particle container providing `EOSId`, `Rho`,
+     * `Eint`, `P` and `SoS` (and `RhoEOS` and `EintEOS` for
+     * `EOSCoupling::Lazy`).
+     * @param first First updated particle.
+     */
+    template <class Particles>
+    void SeparatePressureSoS(const Particles& particles,
+                             const std::size_t first) const {
+        if (m_coupling == EOSCoupling::Lazy) {
+            m_lazy.PressureSoS(particles, first);
+            return;
+        }
+        const auto rows =
+            Kokkos::make_pair(first, particles.Rho().extent(0));
+        m_eos.PressureSoS(Kokkos::subview(particles.EOSId(), rows),
+                          Kokkos::subview(particles.Rho(), rows),
+                          Kokkos::subview(particles.Eint(), rows),
+                          Kokkos::subview(particles.P(), rows),
+                          Kokkos::subview(particles.SoS(), rows));
+    }
+
+    /**
+     * @brief Multi-material EOS.
+     */
+    EOSMultiMaterial m_eos;
+    /**
+     * @brief Incremental EOS of `EOSCoupling::Lazy` (its cache is updated by
+     * the const force kernels).
+     */
+    mutable EOSLazy m_lazy;
+    /**
+     * @brief Coupling of the EOS with the force kernel.
+     */
+    EOSCoupling m_coupling;
+    /**
+     * @brief Artificial viscosity coefficients.
+     */
+    ArtificialViscosity m_viscosity;
+    /**
+     * @brief Launch parameters of the cell-per-team kernels.
+     */
+    TeamTuning m_tuning;
+    /**
+     * @brief Pair loop of the `NeighborSearch` overloads.
+     */
+    PairLoop m_pair_loop = PairLoop::CellTeams;
+};
@@ -3,28 +3,53 @@
  * @brief Main entry point for the SPHiros application.
  *
  * This file initializes the MPI and Kokkos runtimes, parses command-line
- * arguments, and demonstrates the usage of various EOS (Equation of State)
- * implementations. It also includes examples of using Kokkos views and
- * performing computations with EOS objects.
+ * arguments, reads the YAML input file into a validated `SimulationConfig`,
+ * and demonstrates the usage of the EOS (Equation of State) tables built from
+ * it. It also includes examples of using Kokkos views and performing
+ * computations with EOS objects.
  */
 
 // std includes
+#include <algorithm>
+#include <filesystem>
 #include <iostream>
+#include <optional>
+#include <stdexcept>
 #include <vector>
-#include <typeinfo>
 // mpi includes
 #include <mpi.h>
 // kokkos includes
 #include <Kokkos_Core.hpp>
-// yaml-cpp includes
-#include <yaml-cpp/yaml.h>
 // CLI includes
 #include <CLI/CLI.hpp>
-// eos includes (test-only)
-#include "eos_linear_gas.hpp"
-#include "eos_stiffened_gas.hpp"
-// io includes (test-only)
+// config includes
+#include "material_table.hpp"
+#include "simulation_config.hpp"
+// particles includes
+#include "halo_exchange.hpp"
+#include "load_balancer.hpp"
+#include "material_sort.hpp"
+#include "particle_data.hpp"
+// time integrators includes
+// io includes
+#include "checkpoint.hpp"
+#include "collective_read.hpp"
+#include "diagnostics.hpp"
+#include "pvtu_reader.hpp"
+#include "vtu_writer.hpp"
+#ifdef SPHIROS_PYTHON
 #include "pymeshio_wrapper.hpp"
+#endif
+// memory includes
+#include "host_mirror_pool.hpp"
+// profiling includes
+#include "timing_report.hpp"
+
+/**
+ * @brief Particle container of the application (EOS outputs stored as
+ * `EOSScalar`).
+ */
+using Particles = ParticleData<Kokkos::LayoutRight, EOSScalar>;
 
 /**
  * @brief Main function for the SPHiros application.
@@ -52,6 +77,9 @@ int main(int argc, char** argv) {
     app.add_option("-i,--input", input_file, "Input YAML file")->required();
     std::string output_file;
     app.add_option("-o,--output", output_file, "Output file");
+    std::string checkpoint_file;
+    app.add_option("-c,--checkpoint", checkpoint_file,
+                   "Checkpoint file written after the initial output");
     bool verbose = false;
     app.add_flag("-v,--verbose", verbose, "Enable verbose output");
 
@@ -73,103 +101,239 @@ int main(int argc, char** argv) {
                   << std::endl;
     }
 
-    {
-        // Create a container of std::variant to hold EOSLinearGas and
-        // EOSStiffenedGas
-        using EOSVariant = std::variant<EOSLinearGas, EOSStiffenedGas>;
-        std::vector<EOSVariant> eos_vector;
-
-        // Add EOSLinearGas and EOSStiffenedGas instances to the container
-        eos_vector.emplace_back(EOSLinearGas(0, 1.4, 1e-6));
-        eos_vector.emplace_back(EOSStiffenedGas(1, 1.4, 1e-6, 0.0));
-        eos_vector.emplace_back(EOSLinearGas(2, 1.4, 1e-6));
-        eos_vector.emplace_back(EOSLinearGas(3, 1.4, 1e-6));
-
-        // Example Kokkos views
-        Kokkos::View<double*> rho("rho", 10);
-        Kokkos::View<double*> eint("eint", 10);
-        Kokkos::View<double*> p("p", 10);
-        Kokkos::View<double*> sos("sos", 10);
-
-        // Copy data from host to device
-        Kokkos::deep_copy(rho, 1.0);
-        Kokkos::deep_copy(eint, 1.0);
-
-        // Call PressureSoS for each EOS object using std::visit
-        for (const auto& eos : eos_vector) {
-            std::visit(
-                [&](const auto& obj) {
-                    std::string type_name = typeid(obj).name();
-                    if (type_name.length() > 20) {
-                        type_name = type_name.substr(0, 20) + "...";
-                    }
-                    std::cout << "EOS Type: " << type_name << std::endl;
-                    obj.PressureSoSImpl(rho, eint, p, sos);
-                    auto host_p   = Kokkos::create_mirror_view(p);
-                    auto host_sos = Kokkos::create_mirror_view(p);
-
-                    Kokkos::deep_copy(host_p, p);
-                    Kokkos::deep_copy(host_sos, sos);
-
-                    std::cout << "p: " << host_p(0) << std::endl;
-                    std::cout << "sos: " << host_sos(0) << std::endl;
-                },
-                eos);
+    // Rank 0 reads the input file, every rank parses the broadcast copy
+    std::optional<SimulationConfig> config;
+    try {
+        config.emplace(SimulationConfig::FromString(
+            CollectiveRead::Broadcast(input_file), input_file));
+    } catch (const std::exception& e) {
+        if (world_rank == 0) std::cerr << e.what() << std::endl;
+        Kokkos::finalize();
+        MPI_Finalize();
+        return 1;
+    }
+    // Every rank parsed the same deck, so all of them stop here
+    if (config->Mesh().empty()) {
+        if (world_rank == 0) {
+            std::cerr << "Error: 'mesh' section not found in the YAML file."
+                      << std::endl;
         }
+        Kokkos::finalize();
+        MPI_Finalize();
+        return 1;
     }
+    Profiler::Global().SetFence(config->Profiling().fence);
+
+    // Flat device tables part_id -> eos_id -> EOS parameters (released
+    // before Kokkos::finalize)
+    std::optional<MaterialTable> tables;
+    tables.emplace(*config);
+
+    if (!config->Parts().empty()) {
+        const auto& eos = tables->EOS();
+
+        // Example particle container
+        const int n_particles = 10;
+        Particles particles(n_particles);
+
+        // Assign the particles to the parts in a round-robin fashion
+        const int n_parts = static_cast<int>(config->Parts().size());
+        Kokkos::View<int*> part_ids("part_ids", n_parts);
+        auto host_part_ids = Kokkos::create_mirror_view(part_ids);
+        for (int k = 0; k < n_parts; ++k) {
+            host_part_ids(k) = config->Parts()[k].part_id;
+        }
+        Kokkos::deep_copy(part_ids, host_part_ids);
+        auto part_id = particles.PartId();
+        Kokkos::parallel_for(
+            "InitializePartId", n_particles,
+            KOKKOS_LAMBDA(const int i) { part_id(i) = part_ids(i % n_parts); });
+        tables->AssignEOSIds(particles);
+        auto eos_id     = particles.EOSId();
+        const int n_eos = eos.TableSize();
+
+        // Copy data from host to device
+        Kokkos::deep_copy(particles.Rho(), 1.0);
+        Kokkos::deep_copy(particles.Eint(), 1.0);
+
+        // Sort the particles by material so that each EOS reads a
+        // contiguous block of memory
+        MaterialSort material_sort;
+        material_sort.Build(eos_id, n_eos);
+        const auto& permutation = material_sort.Permutation();
+        particles.Apply(permutation);
 
-    // Read the mesh using meshio (if specified)
-    std::filesystem::path yaml_path(input_file);
-    std::string yaml_folder = yaml_path.parent_path().string();
+        // Evaluate all materials in a single fused kernel
+        eos.PressureSoS(particles);
 
-    YAML::Node config = YAML::LoadFile(input_file);
+        // Restore the original particle ordering for output
+        particles.Revert(permutation);
 
-    std::string mesh_file = yaml_folder + "/";
-    if (config["mesh"]) {
-        auto mesh_prefix = config["mesh"].as<std::string>();
-        mesh_file += mesh_prefix + "/" + mesh_prefix + "_" +
-                     std::to_string(world_rank) + ".vtu";
-    } else {
+        // Borrow pinned host buffers instead of allocating mirrors
+        auto& pool             = HostMirrorPool::Global();
+        const auto host_eos_id = pool.Mirror(particles.EOSId());
+        const auto host_p      = pool.Mirror(particles.P());
+        const auto host_sos    = pool.Mirror(particles.SoS());
+
+        Kokkos::deep_copy(host_eos_id.view, particles.EOSId());
+        Kokkos::deep_copy(host_p.view, particles.P());
+        Kokkos::deep_copy(host_sos.view, particles.SoS());
+
+        // One line per part, as long as there are particles to show it
         if (world_rank == 0) {
-            std::cerr << "Error: 'mesh' section not found in the YAML file."
-                      << std::endl;
+            for (int i = 0; i < std::min(n_parts, n_particles); ++i) {
+                std::cout << "EOS id: " << host_eos_id.view(i)
+                          << ", p: " << host_p.view(i)
+                          << ", sos: " << host_sos.view(i) << std::endl;
+            }
         }
     }
 
-    auto res_file = "results_" + std::to_string(world_rank) + ".vtu";
+    // Read the mesh, relative to the input file
+    const std::filesystem::path yaml_path(input_file);
+
+    // A mesh without extension is the prefix of a .pvtu file
+    std::string mesh_file = (yaml_path.parent_path() / config->Mesh()).string();
+    if (!std::filesystem::path(mesh_file).has_extension()) {
+        mesh_file += ".pvtu";
+    }
 
     if (world_rank == 0) {
         std::cout << "Mesh File: " << mesh_file << std::endl;
-        std::cout << "Output File: " << res_file << std::endl;
     }
-    // use_meshio(mesh_file, "results_" + std::to_string(world_rank) + ".vtu");
+    int exit_code = 0;
     try {
-        std::cout << "Ramzi0" << std::endl;
-        pybind11::scoped_interpreter guard{};  // Start the Python interpreter
-
-        // Import the meshio library
-        std::cout << "Ramzi1" << std::endl;
-        pybind11::module meshio = pybind11::module::import("meshio");
-
-        // Read the mesh file
-        std::cout << "Ramzi2" << std::endl;
-        pybind11::object mesh = meshio.attr("read")(mesh_file);
-
-        // Write the mesh to a new file
-        std::cout << "Ramzi3" << std::endl;
-        meshio.attr("write")(res_file, mesh);
-
-        std::cout << "Ramzi4" << std::endl;
-        std::cout << "Mesh successfully read from " << input_file
-                  << " and written to " << res_file << std::endl;
-    } catch (const pybind11::error_already_set& e) {
-        std::cerr << "Python error: " << e.what() << std::endl;
+        // Native formats: the .pvtu index is read once and broadcast, the
+        // pieces by one MPI-IO client per node, and each rank decodes its
+        // own pieces straight into Kokkos views. Single files (.vtu, or
+        // other formats converted by meshio) are read by rank 0 and
+        // spread by the decomposition below. A failure of any load phase
+        // is rethrown on every rank.
+        const std::string extension =
+            std::filesystem::path(mesh_file).extension().string();
+        std::vector<VTUReader> pieces;
+        std::size_t n_pieces = 1;
+        if (extension == ".pvtu") {
+            CollectiveRead::Checked([&] {
+                PVTUReader pvtu(mesh_file, MPI_COMM_WORLD);
+                pieces   = pvtu.Open(MPI_COMM_WORLD);
+                n_pieces = pvtu.NumPieces();
+            });
+        } else {
+            if (extension != ".vtu") {
+#ifdef SPHIROS_PYTHON
+                // Only rank 0 starts the interpreter, and only here
+                const std::string converted =
+                    (std::filesystem::path(mesh_file).replace_extension(
+                         ".meshio.vtu"))
+                        .string();
+                CollectiveRead::Checked([&] {
+                    if (world_rank == 0) use_meshio(mesh_file, converted);
+                });
+                mesh_file = converted;
+#else
+                throw std::runtime_error(
+                    "mesh format " + extension +
+                    " needs meshio (build with -DSPHIROS_PYTHON=ON)");
+#endif
+            }
+            CollectiveRead::Checked([&] {
+                if (world_rank == 0) pieces.emplace_back(mesh_file);
+            });
+        }
+        Particles particles(VTUReader::TotalPoints(pieces));
+        VTUReader::Concatenate(pieces, "Points", particles.X());
+        VTUReader::Concatenate(pieces, "partId", particles.PartId());
+        tables->AssignEOSIds(particles);
+
+        // Space-filling-curve domain decomposition, repartitioned when the
+        // max/mean cost ratio exceeds the threshold (checked every cadence
+        // steps)
+        const LoadBalanceConfig& lb = config->LoadBalance();
+        LoadBalancer balancer(lb.threshold, lb.cadence, MPI_COMM_WORLD);
+        balancer.Decompose(particles);
+
+        // Ghost particles within the interaction radius (if specified)
+        if (config->HaloRadius() > 0.0) {
+            HaloExchange halo(config->HaloRadius());
+            halo.Build(particles);
+            halo.Exchange(particles);
+            if (verbose) {
+                std::cout << "Rank " << world_rank << ": "
+                          << halo.NumLocal() << " local particles, "
+                          << halo.NumGhosts() << " ghosts from "
+                          << halo.Peers().size() << " ranks" << std::endl;
+            }
+            // Only the owned particles are written
+            halo.RemoveGhosts(particles);
+        }
+
+        unsigned long n_local  = particles.Size();
+        unsigned long n_global = 0;
+        MPI_Reduce(&n_local, &n_global, 1, MPI_UNSIGNED_LONG, MPI_SUM, 0,
+                   MPI_COMM_WORLD);
+        if (world_rank == 0) {
+            std::cout << "Mesh successfully read from " << mesh_file << " ("
+                      << n_pieces << " pieces, " << n_global
+                      << " points)" << std::endl;
+        }
+
+        // Global integrals appended every cadence steps, instead of full
+        // field dumps (if requested)
+        const DiagnosticsConfig& diag = config->Diagnostics();
+        if (!diag.file.empty()) {
+            std::vector<DiagnosticsGroup> groups;
+            for (const auto& group : diag.groups) {
+                groups.push_back({group.name, group.parts});
+            }
+            Diagnostics diagnostics(diag.file, diag.cadence, diag.quantities,
+                                    groups, diag.shock_pressure,
+                                    diag.shock_axis);
+            diagnostics.Sample(0, 0.0, particles);
+            if (world_rank == 0) {
+                std::cout << "Diagnostics File: " << diag.file << std::endl;
+            }
+        }
+
+        // Write the particles back in parallel (one piece per rank)
+        const std::string res_prefix =
+            output_file.empty() ? "results" : output_file;
+        VTUWriter writer(res_prefix);
+        writer.WriteParticles(0, particles);
+        writer.Wait();
+        if (world_rank == 0) {
+            std::cout << "Output File: " << writer.PVTUFile(0) << std::endl;
+        }
+
+        // Single shared checkpoint file, restartable on any rank count
+        if (!checkpoint_file.empty()) {
+            CheckpointWriter checkpoint;
+            checkpoint.AddParticles(particles);
+            checkpoint.AddRecord("step", std::vector<int>{0});
+            checkpoint.Write(checkpoint_file);
+            if (world_rank == 0) {
+                std::cout << "Checkpoint File: " << checkpoint_file
+                          << std::endl;
+            }
+        }
+    } catch (const std::exception& e) {
+        std::cerr << "Mesh error: " << e.what() << std::endl;
+        exit_code = 1;
+    }
+
+    // Min/max/avg time of every phase over the ranks
+    {
+        const TimingReport report;
+        report.Print(std::cout);
+        const std::string& json = config->Profiling().json;
+        if (!json.empty()) report.WriteJSON(json);
     }
 
+    tables.reset();
     // Finalize the Kokkos runtime
     Kokkos::finalize();
     // Finalize the MPI runtime
     MPI_Finalize();
 
-    return 0;
+    return exit_code;
 }
\ No newline at end of file
@@ -0,0 +1,287 @@
+#pragma once
+
+#include <algorithm>
+#include <limits>
+#include <stdexcept>
+
+// mpi includes
+#include <mpi.h>
+// Kokkos includes
+#include <Kokkos_Core.hpp>
+
+#include "profiler.hpp"
+
+/**
+ * @file leap_frog.hpp
+ * @brief Defines the LeapFrog class for kick-drift-kick time integration.
+ *
+ * This file provides the `LeapFrog` class, a second-order symplectic
+ * integrator of the SPH equations of motion with a CFL-limited, globally
+ * uniform time step.
+ */
+
+/**
+ * @class LeapFrog
+ * @brief Kick-drift-kick leap-frog integrator with a CFL time step.
+ *
+ * A step of size `dt` is
+ *
+ * v += a dt / 2, eint += deint_dt dt / 2, x += v dt (`KickDrift`),
+ * a, deint_dt = forces(x, v, eint),
+ * v += a dt / 2, eint += deint_dt dt / 2 (`KickTimestep`).
+ *
+ * The three updates of the first half are a single kernel. The closing kick
+ * is a `parallel_reduce` that also computes the candidate time step from the
+ * updated velocities and the freshly computed speed of sound and
+ * accelerations,
+ *
+ * dt_i = cfl * min(h_i / (c_i + |v_i|), sqrt(h_i / |a_i|)),
+ *
+ * where `c_i = sqrt(sos_i)`: the EOS store the squared speed of sound in
+ * `SoS` (e.g. `gamma p / rho`). Each step reads the particle state twice
+ * and needs one `MPI_Allreduce`. The next step is the global minimum,
+ * limited to `max_growth` times the previous step and to `dt_max`.
+ */
+class LeapFrog {
+   public:
+    /**
+     * @brief Constructor for LeapFrog.
+     *
+     * @param cfl Courant number.
+     * @param max_growth Largest ratio of two consecutive time steps.
+     * @param dt_max Largest time step.
+     * @param comm MPI communicator.
+     * @throws std::invalid_argument On non-positive parameters or a growth
+     * factor below one.
+     */
+    explicit LeapFrog(double cfl = 0.5, double max_growth = 1.1,
+                      double dt_max = std::numeric_limits<double>::max(),
+                      MPI_Comm comm = MPI_COMM_WORLD)
+        : m_cfl(cfl),
+          m_max_growth(max_growth),
+          m_dt_max(dt_max),
+          m_comm(comm) {
+        if (cfl <= 0.0 || dt_max <= 0.0) {
+            throw std::invalid_argument(
+                "LeapFrog: cfl and dt_max must be positive");
+        }
+        if (max_growth < 1.0) {
+            throw std::invalid_argument(
+                "LeapFrog: max_growth must be at least 1");
+        }
+    }
+
+    /**
+     * @brief Computes the first time step (collective).
+     *
+     * The accelerations, internal energy rates and speeds of sound must be
+     * up to date (e.g. by `SPHSolver::Forces`).
+     *
+     * @param particles Particle container providing `V`, `A`, `Eint`,
+     * `DEintDt`, `H` and `SoS`.
+     * @return First time step.
+     */
+    template <class Particles>
+    double Start(const Particles& particles) {
+        m_dt = Limit(KickTimestep(particles, 0.0), false);
+        return m_dt;
+    }
+
+    /**
+     * @brief Advances the particles by one time step (collective).
+     *
+     * @param particles Particle container providing `X`, `V`, `A`, `Eint`,
+     * `DEintDt`, `H` and `SoS`.
+     * @param forces Callable `forces(particles)` updating `A`, `DEintDt` and
+     * `SoS` from the drifted state (halo exchange, density, EOS, ...).
+     * @param t_end The step is shortened so as not to pass this time.
+     * @return Time step taken (0 without stepping if `t_end` is reached).
+     * @throws std::runtime_error If `Start` did not set a positive time
+     * step.
+     */
+    template <class Particles, class Forces>
+    double Step(Particles& particles, Forces&& forces,
+                const double t_end = std::numeric_limits<double>::max()) {
+        if (!(m_dt > 0.0)) {
+            throw std::runtime_error(
+                "LeapFrog: Step needs a positive time step from Start");
+        }
+        if (!(t_end > m_time)) return 0.0;
+        const double dt = std::min(m_dt, t_end - m_time);
+        KickDrift(particles, dt);
+        forces(particles);
+        const double dt_local = KickTimestep(particles, dt);
+        m_time += dt;
+        ++m_n_steps;
+        m_dt = Limit(dt_local, true);
+        return dt;
+    }
+
+    /**
+     * @brief Applies a half kick then a drift in a single kernel.
+     *
+     * Building block of `Step`.
+     *
+     * @param particles Particle container providing `X`, `V`, `A`, `Eint`
+     * and `DEintDt`.
+     * @param dt Time step.
+     */
+    template <class Particles>
+    static void KickDrift(const Particles& particles, const double dt) {
+        ProfilingRegion region("Integrate");
+        const auto x        = particles.X();
+        const auto v        = particles.V();
+        const auto a        = particles.A();
+        const auto eint     = particles.Eint();
+        const auto deint_dt = particles.DEintDt();
+        const double half   = 0.5 * dt;
+        Kokkos::parallel_for(
+            "LeapFrog::KickDrift", x.extent(0), KOKKOS_LAMBDA(const int i) {
+                for (int d = 0; d < 3; ++d) {
+                    const double v_half = v(i, d) + half * a(i, d);
+                    v(i, d)             = v_half;
+                    x(i, d) += dt * v_half;
+                }
+                eint(i) += half * deint_dt(i);
+            });
+    }
+
+    /**
+     * @brief Applies a half kick and computes the local CFL time step.
+     *
+     * Building block of `Step`.
+     *
+     * @param particles Particle container providing `V`, `A`, `Eint`,
+     * `DEintDt`, `H` and `SoS`.
+     * @param dt Time step (zero to compute the time step only).
+     * @return Smallest time step of the local particles (without the growth
+     * and `dt_max` limits).
+     */
+    template <class Particles>
+    double KickTimestep(const Particles& particles, const double dt) const {
+        ProfilingRegion region("Integrate");
+        const auto v        = particles.V();
+        const auto a        = particles.A();
+        const auto eint     = particles.Eint();
+        const auto deint_dt = particles.DEintDt();
+        const auto h        = particles.H();
+        const auto sos      = particles.SoS();
+        const double half   = 0.5 * dt;
+        const double cfl    = m_cfl;
+        double dt_local     = std::numeric_limits<double>::max();
+        Kokkos::parallel_reduce(
+            "LeapFrog::KickTimestep", v.extent(0),
+            KOKKOS_LAMBDA(const int i, double& dt_min) {
+                double v2 = 0.0;
+                double a2 = 0.0;
+                for (int d = 0; d < 3; ++d) {
+                    const double v_new = v(i, d) + half * a(i, d);
+                    v(i, d)            = v_new;
+                    v2 += v_new * v_new;
+                    a2 += a(i, d) * a(i, d);
+                }
+                eint(i) += half * deint_dt(i);
+                dt_min = Kokkos::min(dt_min,
+                                     CFLTimestep(cfl, h(i), sos(i), v2, a2));
+            },
+            Kokkos::Min<double>(dt_local));
+        return dt_local;
+    }
+
+    /**
+     * @brief Returns the CFL time step of a particle.
+     *
+     * @param cfl Courant number.
+     * @param h Smoothing length.
+     * @param sos Squared speed of sound (the `SoS` field).
+     * @param v2 Squared velocity norm.
+     * @param a2 Squared acceleration norm.
+     * @return cfl * min(h / (sqrt(sos) + |v|), sqrt(h / |a|)).
+     */
+    KOKKOS_INLINE_FUNCTION static double CFLTimestep(
+        const double cfl, const double h, const double sos, const double v2,
+        const double a2) {
+        double dt = h / (Kokkos::sqrt(sos) + Kokkos::sqrt(v2));
+        if (a2 > 0.0) dt = Kokkos::min(dt, Kokkos::sqrt(h / Kokkos::sqrt(a2)));
+        return cfl * dt;
+    }
+
+    /**
+     * @brief Returns the current time.
+     *
+     * @return Simulation time.
+     */
+    double Time() const { return m_time; }
+
+    /**
+     * @brief Sets the current time (e.g. on restart).
+     *
+     * @param time Simulation time.
+     */
+    void SetTime(const double time) { m_time = time; }
+
+    /**
+     * @brief Returns the next time step.
+     *
+     * @return Time step of the next call to `Step`.
+     */
+    double Dt() const { return m_dt; }
+
+    /**
+     * @brief Returns the number of steps taken.
+     *
+     * @return Number of calls to `Step`.
+     */
+    int NumSteps() const { return m_n_steps; }
+
+    /**
+     * @brief Returns the Courant number.
+     *
+     * @return CFL number.
+     */
+    double CFL() const { return m_cfl; }
+
+   private:
+    /**
+     * @brief Reduces the local time steps and applies the limits.
+     *
+     * @param dt_local Smallest local time step.
+     * @param grow True to limit the growth with respect to the current step.
+     * @return Next time step.
+     */
+    double Limit(double dt_local, const bool grow) const {
+        MPI_Allreduce(MPI_IN_PLACE, &dt_local, 1, MPI_DOUBLE, MPI_MIN, m_comm);
+        double dt = std::min(dt_local, m_dt_max);
+        if (grow) dt = std::min(dt, m_max_growth * m_dt);
+        return dt;
+    }
+
+    /**
+     * @brief Courant number.
+     */
+    double m_cfl;
+    /**
+     * @brief Largest ratio of two consecutive time steps.
+     */
+    double m_max_growth;
+    /**
+     * @brief Largest time step.
+     */
+    double m_dt_max;
+    /**
+     * @brief MPI communicator.
+     */
+    MPI_Comm m_comm;
+    /**
+     * @brief Simulation time.
+     */
+    double m_time = 0.0;
+    /**
+     * @brief Next time step.
+     */
+    double m_dt = 0.0;
+    /**
+     * @brief Number of steps taken.
+     */
+    int m_n_steps = 0;
+};
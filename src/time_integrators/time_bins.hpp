@@ -0,0 +1,338 @@
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <limits>
+#include <stdexcept>
+
+// mpi includes
+#include <mpi.h>
+// Kokkos includes
+#include <Kokkos_Core.hpp>
+
+#include "leap_frog.hpp"
+#include "material_sort.hpp"
+
+/**
+ * @file time_bins.hpp
+ * @brief Defines the TimeBins class for multi-rate particle time stepping.
+ *
+ * This file provides the `TimeBins` class, a hierarchical (block) time
+ * stepping scheme where each particle advances with a power-of-two fraction
+ * of a global base step.
+ */
+
+/**
+ * @class TimeBins
+ * @brief Kick-drift-kick leap-frog with power-of-two time bins.
+ *
+ * `Assign` puts every particle in the bin `b` whose step `dt_b = dt / 2^b`
+ * fits its `LeapFrog::CFLTimestep`, then sorts the particles by bin with a
+ * `MaterialSort` on the bin indices. A base step `dt` is made of `2^B`
+ * substeps, `B` being the deepest occupied bin on any rank. The bins active
+ * at a substep boundary `s` are those with `s % 2^(B - b) == 0`, i.e. the
+ * bins `b >= b_min(s)`: after the sort the active particles
+ * are always the contiguous tail starting at `FirstActive(s)`, so the
+ * forces and the EOS only run on a subview.
+ *
+ * At each substep the active particles get their opening half kick, all
+ * the particles drift, and the particles whose step ends get their forces
+ * and their closing half kick. A particle of bin `b` is evaluated `2^b`
+ * times per base step instead of `2^B`.
+ */
+class TimeBins {
+   public:
+    /**
+     * @brief Constructor for TimeBins.
+     *
+     * @param cfl Courant number.
+     * @param max_bins Number of bins (the smallest step is
+     * `dt / 2^(max_bins - 1)`).
+     * @param comm MPI communicator.
+     * @throws std::invalid_argument If `cfl` is not positive or `max_bins`
+     * is not in [1, 30].
+     */
+    explicit TimeBins(double cfl = 0.5, int max_bins = 8,
+                      MPI_Comm comm = MPI_COMM_WORLD)
+        : m_cfl(cfl), m_max_bins(max_bins), m_comm(comm) {
+        if (cfl <= 0.0) {
+            throw std::invalid_argument("TimeBins: cfl must be positive");
+        }
+        if (max_bins < 1 || max_bins > 30) {
+            throw std::invalid_argument(
+                "TimeBins: max_bins must be in [1, 30]");
+        }
+    }
+
+    /**
+     * @brief Assigns the particles to bins and sorts them by bin
+     * (collective).
+     *
+     * The accelerations and speeds of sound must be up to date. Views and
+     * neighbor lists taken from the container before the call must be
+     * refreshed; `Permutation()` restores the previous ordering.
+     *
+     * @param particles Particle container providing `V`, `A`, `H`, `SoS`
+     * and `Apply`.
+     * @param dt_max Largest base step.
+     * @return Base step.
+     */
+    template <class Particles>
+    double Assign(Particles& particles,
+                  const double dt_max = std::numeric_limits<double>::max()) {
+        ProfilingRegion region("Integrate");
+        const auto v     = particles.V();
+        const auto a     = particles.A();
+        const auto h     = particles.H();
+        const auto sos   = particles.SoS();
+        const auto N     = v.extent(0);
+        const double cfl = m_cfl;
+        Kokkos::View<double*> dt(
+            Kokkos::view_alloc(Kokkos::WithoutInitializing, "bins_dt"), N);
+        double dt_min = std::numeric_limits<double>::max();
+        double dt_big = 0.0;
+        Kokkos::parallel_reduce(
+            "TimeBins::Timestep", N,
+            KOKKOS_LAMBDA(const int i, double& lo, double& hi) {
+                double v2 = 0.0;
+                double a2 = 0.0;
+                for (int d = 0; d < 3; ++d) {
+                    v2 += v(i, d) * v(i, d);
+                    a2 += a(i, d) * a(i, d);
+                }
+                dt(i) = LeapFrog::CFLTimestep(cfl, h(i), sos(i), v2, a2);
+                lo    = Kokkos::min(lo, dt(i));
+                hi    = Kokkos::max(hi, dt(i));
+            },
+            Kokkos::Min<double>(dt_min), Kokkos::Max<double>(dt_big));
+        MPI_Allreduce(MPI_IN_PLACE, &dt_min, 1, MPI_DOUBLE, MPI_MIN, m_comm);
+        MPI_Allreduce(MPI_IN_PLACE, &dt_big, 1, MPI_DOUBLE, MPI_MAX, m_comm);
+
+        // The deepest bin must hold the smallest step
+        m_dt = std::min({dt_max, dt_big, std::ldexp(dt_min, m_max_bins - 1)});
+        m_bins = Kokkos::View<int*>(
+            Kokkos::view_alloc(Kokkos::WithoutInitializing, "bins"), N);
+        const auto bins   = m_bins;
+        const double base = m_dt;
+        const int deepest = m_max_bins - 1;
+        int local_max_bin = 0;
+        Kokkos::parallel_reduce(
+            "TimeBins::Assign", N,
+            KOKKOS_LAMBDA(const int i, int& max_bin) {
+                int b = 0;
+                while (b < deepest && dt(i) < base / (1 << b)) ++b;
+                bins(i) = b;
+                max_bin = Kokkos::max(max_bin, b);
+            },
+            Kokkos::Max<int>(local_max_bin));
+        m_deepest = std::max(local_max_bin, 0);
+        MPI_Allreduce(MPI_IN_PLACE, &m_deepest, 1, MPI_INT, MPI_MAX, m_comm);
+
+        m_sort.Build(m_bins, m_max_bins);
+        particles.Apply(m_sort.Permutation());
+        m_sort.Permutation().Apply(m_bins);
+        return m_dt;
+    }
+
+    /**
+     * @brief Advances the particles by one base step (collective).
+     *
+     * @param particles Particle container providing `X`, `V`, `A`, `Eint`
+     * and `DEintDt`, sorted by the last `Assign`.
+     * @param forces Callable `forces(particles, first)` updating `A`,
+     * `DEintDt` and `SoS` of the rows `first, ..., N - 1` from the drifted
+     * state (e.g. `SPHSolver::Forces`).
+     * @return Base step.
+     */
+    template <class Particles, class Forces>
+    double Step(Particles& particles, Forces&& forces) {
+        const int n_sub  = NumSubsteps();
+        const double dts = m_dt / n_sub;
+        for (int s = 0; s < n_sub; ++s) {
+            KickDrift(particles, FirstActive(s), dts);
+            const std::size_t first = FirstActive(s + 1);
+            forces(particles, first);
+            Kick(particles, first);
+            m_n_evaluations += m_bins.extent(0) - first;
+        }
+        m_time += m_dt;
+        return m_dt;
+    }
+
+    /**
+     * @brief Opening half kick of the rows from `first`, then drift of all
+     * the particles, in a single kernel.
+     *
+     * Building block of `Step`.
+     *
+     * @param particles Particle container providing `X`, `V`, `A`, `Eint`
+     * and `DEintDt`.
+     * @param first First particle starting its step.
+     * @param dts Substep.
+     */
+    template <class Particles>
+    void KickDrift(const Particles& particles, const std::size_t first,
+                   const double dts) const {
+        ProfilingRegion region("Integrate");
+        const auto x        = particles.X();
+        const auto v        = particles.V();
+        const auto a        = particles.A();
+        const auto eint     = particles.Eint();
+        const auto deint_dt = particles.DEintDt();
+        const auto bins     = m_bins;
+        const double base   = m_dt;
+        Kokkos::parallel_for(
+            "TimeBins::KickDrift", x.extent(0), KOKKOS_LAMBDA(const int i) {
+                const bool kick   = static_cast<std::size_t>(i) >= first;
+                const double half = kick ? 0.5 * base / (1 << bins(i)) : 0.0;
+                for (int d = 0; d < 3; ++d) {
+                    v(i, d) += half * a(i, d);
+                    x(i, d) += dts * v(i, d);
+                }
+                eint(i) += half * deint_dt(i);
+            });
+    }
+
+    /**
+     * @brief Closing half kick of the rows from `first`.
+     *
+     * Building block of `Step`.
+     *
+     * @param particles Particle container providing `V`, `A`, `Eint` and
+     * `DEintDt`.
+     * @param first First particle ending its step.
+     */
+    template <class Particles>
+    void Kick(const Particles& particles, const std::size_t first) const {
+        ProfilingRegion region("Integrate");
+        const auto v        = particles.V();
+        const auto a        = particles.A();
+        const auto eint     = particles.Eint();
+        const auto deint_dt = particles.DEintDt();
+        const auto bins     = m_bins;
+        const double base   = m_dt;
+        Kokkos::parallel_for(
+            "TimeBins::Kick", Kokkos::RangePolicy<>(first, v.extent(0)),
+            KOKKOS_LAMBDA(const int i) {
+                const double half = 0.5 * base / (1 << bins(i));
+                for (int d = 0; d < 3; ++d) v(i, d) += half * a(i, d);
+                eint(i) += half * deint_dt(i);
+            });
+    }
+
+    /**
+     * @brief Returns the first particle active at a substep boundary.
+     *
+     * @param s Substep boundary in [0, `NumSubsteps()`].
+     * @return First row of the active tail (0 when all bins are active).
+     */
+    std::size_t FirstActive(const int s) const {
+        int b_min = 0;
+        if (s % NumSubsteps() != 0) {
+            int trailing = 0;
+            while ((s >> trailing & 1) == 0) ++trailing;
+            b_min = m_deepest - trailing;
+        }
+        return m_sort.Range(b_min).first;
+    }
+
+    /**
+     * @brief Returns the number of substeps of a base step.
+     *
+     * @return 2^B, B being the deepest occupied bin.
+     */
+    int NumSubsteps() const { return 1 << m_deepest; }
+
+    /**
+     * @brief Returns the deepest occupied bin (over all ranks).
+     *
+     * @return Bin index.
+     */
+    int DeepestBin() const { return m_deepest; }
+
+    /**
+     * @brief Returns the base step of the last `Assign`.
+     *
+     * @return Base step.
+     */
+    double Dt() const { return m_dt; }
+
+    /**
+     * @brief Returns the current time.
+     *
+     * @return Simulation time.
+     */
+    double Time() const { return m_time; }
+
+    /**
+     * @brief Returns the number of particle force evaluations so far.
+     *
+     * @return Sum of the active particles over the substeps.
+     */
+    std::size_t NumEvaluations() const { return m_n_evaluations; }
+
+    /**
+     * @brief Returns the bin of each particle (sorted ordering).
+     *
+     * @return Device view of bin indices.
+     */
+    Kokkos::View<const int*> Bins() const { return m_bins; }
+
+    /**
+     * @brief Returns the index range of a bin in the sorted ordering.
+     *
+     * @param bin Bin index.
+     * @return Half-open index range [first, second).
+     */
+    Kokkos::pair<int, int> Range(const int bin) const {
+        return m_sort.Range(bin);
+    }
+
+    /**
+     * @brief Returns the permutation applied by the last `Assign`.
+     *
+     * @return Particle permutation and its inverse.
+     */
+    const ParticlePermutation& Permutation() const {
+        return m_sort.Permutation();
+    }
+
+   private:
+    /**
+     * @brief Courant number.
+     */
+    double m_cfl;
+    /**
+     * @brief Number of bins.
+     */
+    int m_max_bins;
+    /**
+     * @brief MPI communicator.
+     */
+    MPI_Comm m_comm;
+    /**
+     * @brief Base step.
+     */
+    double m_dt = 0.0;
+    /**
+     * @brief Deepest occupied bin.
+     */
+    int m_deepest = 0;
+    /**
+     * @brief Simulation time.
+     */
+    double m_time = 0.0;
+    /**
+     * @brief Number of particle force evaluations.
+     */
+    std::size_t m_n_evaluations = 0;
+    /**
+     * @brief Bin of each particle (sorted ordering).
+     */
+    Kokkos::View<int*> m_bins;
+    /**
+     * @brief Sort of the particles by bin.
+     */
+    MaterialSort m_sort;
+};
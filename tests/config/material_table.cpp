@@ -0,0 +1,51 @@
+#include <gtest/gtest.h>
+#include "material_table.hpp"
+#include <Kokkos_Core.hpp>
+
+#include <stdexcept>
+#include <vector>
+
+// Test MaterialTable
+TEST(MaterialTableTest, PartToEOSLookup) {
+    Kokkos::initialize();
+    {
+        std::vector<EOSVariant> eos_vector;
+        eos_vector.emplace_back(EOSLinearGas(0, 1.4, 1e-6));
+        eos_vector.emplace_back(EOSStiffenedGas(1, 4.4, 1e-6, 6e8));
+        const std::vector<PartConfig> parts = {{"SPHPart", 0, 1},
+                                               {"SPHPart", 2, 0}};
+        const MaterialTable tables(eos_vector, parts);
+        EXPECT_EQ(tables.NumParts(), 3);
+        EXPECT_EQ(tables.EOS().TableSize(), 2);
+
+        auto host_part_eos = Kokkos::create_mirror_view_and_copy(
+            Kokkos::HostSpace(), tables.PartEOS());
+        EXPECT_EQ(host_part_eos(0), 1);
+        EXPECT_EQ(host_part_eos(1), -1);
+        EXPECT_EQ(host_part_eos(2), 0);
+
+        const int n = 6;
+        Kokkos::View<int*> part_id("part_id", n);
+        Kokkos::View<int*> eos_id("eos_id", n);
+        Kokkos::parallel_for(
+            "FillPartId", n,
+            KOKKOS_LAMBDA(const int i) { part_id(i) = i % 2 == 0 ? 0 : 2; });
+        tables.AssignEOSIds(part_id, eos_id);
+        auto host_eos_id =
+            Kokkos::create_mirror_view_and_copy(Kokkos::HostSpace(), eos_id);
+        for (int i = 0; i < n; ++i) {
+            EXPECT_EQ(host_eos_id(i), i % 2 == 0 ? 1 : 0);
+        }
+
+        // Particles of an unused or out-of-range part are reported
+        Kokkos::deep_copy(part_id, 1);
+        EXPECT_THROW(tables.AssignEOSIds(part_id, eos_id), std::runtime_error);
+        Kokkos::deep_copy(part_id, 5);
+        EXPECT_THROW(tables.AssignEOSIds(part_id, eos_id), std::runtime_error);
+
+        // Parts must reference a defined EOS
+        const std::vector<PartConfig> bad = {{"SPHPart", 0, 4}};
+        EXPECT_THROW(MaterialTable(eos_vector, bad), std::invalid_argument);
+    }
+    Kokkos::finalize();
+}
@@ -0,0 +1,127 @@
+#include <gtest/gtest.h>
+#include "simulation_config.hpp"
+#include <Kokkos_Core.hpp>
+
+#include <stdexcept>
+#include <string>
+#include <variant>
+#include <vector>
+
+// Test SimulationConfig
+TEST(SimulationConfigTest, ParseAndValidate) {
+    Kokkos::initialize();
+    {
+        const std::string input = R"(
+mesh: "sphere"
+eos:
+  - type: ["EOSIdealGas", "EOSIdealGas"]
+    eos_id: [0, 1]
+    gamma: [1.4, 1.4]
+    pcutoff: [1e-6, 1e-6]
+  - type: ["EOSStiffenedGas"]
+    eos_id: [2]
+    gamma: [4.4]
+    pcutoff: [1e-6]
+    pinf: [6e8]
+part:
+  - type: "SPHPart"
+    part_id: 0
+    eos_id: 2
+  - type: "SPHPart"
+    part_id: 3
+    eos_id: 0
+solver:
+  - type: "SPHEuler"
+  - scheme: "NumberDensity"
+  - pair_loop: "HalfColoring"
+  - vector_length: 8
+  - eos_tolerance: 1e-4
+time_integration:
+  - cfl: 0.3
+  - end_time: 2.0
+load_balance:
+  cadence: 5
+halo_radius: 0.1
+diagnostics:
+  file: "diag.dat"
+  cadence: 4
+  quantities: ["mass", "shock_position"]
+  groups: [{name: "all"}, {name: "water", parts: [3]}]
+  shock_axis: 1
+)";
+        const SimulationConfig config(YAML::Load(input));
+        EXPECT_EQ(config.Mesh(), "sphere");
+        const auto& eos = config.EOS();
+        ASSERT_EQ(eos.size(), 3u);
+        EXPECT_TRUE(std::holds_alternative<EOSLinearGas<double>>(eos[0]));
+        ASSERT_TRUE(std::holds_alternative<EOSStiffenedGas<double>>(eos[2]));
+        const auto& water = std::get<EOSStiffenedGas<double>>(eos[2]);
+        EXPECT_DOUBLE_EQ(water.Params().pinf, 6e8);
+        ASSERT_EQ(config.Parts().size(), 2u);
+        EXPECT_EQ(config.Parts()[1].part_id, 3);
+        EXPECT_EQ(config.Parts()[1].eos_id, 0);
+        EXPECT_EQ(config.Solver().scheme, "NumberDensity");
+        EXPECT_EQ(config.Solver().pair_loop, PairLoop::HalfColoring);
+        EXPECT_EQ(config.Solver().team_size, 0);
+        EXPECT_EQ(config.Solver().vector_length, 8);
+        EXPECT_EQ(config.Solver().Tuning().vector_length, 8);
+        EXPECT_EQ(config.Solver().Tuning().tile, 0);
+        EXPECT_DOUBLE_EQ(config.Solver().eos_tolerance, 1e-4);
+        EXPECT_DOUBLE_EQ(config.TimeIntegration().cfl, 0.3);
+        EXPECT_DOUBLE_EQ(config.TimeIntegration().end_time, 2.0);
+        EXPECT_DOUBLE_EQ(config.LoadBalance().threshold, 1.2);
+        EXPECT_EQ(config.LoadBalance().cadence, 5);
+        EXPECT_DOUBLE_EQ(config.HaloRadius(), 0.1);
+        EXPECT_FALSE(config.Profiling().fence);
+        const auto& diag = config.Diagnostics();
+        EXPECT_EQ(diag.file, "diag.dat");
+        EXPECT_EQ(diag.cadence, 4);
+        ASSERT_EQ(diag.quantities.size(), 2u);
+        EXPECT_EQ(diag.quantities[1], "shock_position");
+        ASSERT_EQ(diag.groups.size(), 2u);
+        EXPECT_TRUE(diag.groups[0].parts.empty());
+        EXPECT_EQ(diag.groups[1].name, "water");
+        EXPECT_EQ(diag.groups[1].parts, std::vector<int>{3});
+        EXPECT_EQ(diag.shock_axis, 1);
+
+        // Optional sections keep their defaults
+        const SimulationConfig empty(YAML::Load("{}"));
+        EXPECT_TRUE(empty.Mesh().empty());
+        EXPECT_TRUE(empty.EOS().empty());
+        EXPECT_DOUBLE_EQ(empty.TimeIntegration().cfl, 0.5);
+        EXPECT_TRUE(empty.Diagnostics().file.empty());
+
+        // Broadcast contents parse like the file
+        const SimulationConfig text =
+            SimulationConfig::FromString(input, "input.yaml");
+        EXPECT_EQ(text.Mesh(), "sphere");
+        EXPECT_EQ(text.Parts().size(), 2u);
+        EXPECT_THROW(SimulationConfig::FromString("eos: [", "input.yaml"),
+                     std::invalid_argument);
+
+        // Invalid inputs are reported at startup
+        const auto invalid = [](const std::string& yaml) {
+            EXPECT_THROW(SimulationConfig(YAML::Load(yaml)),
+                         std::invalid_argument)
+                << yaml;
+        };
+        invalid("eos: [{type: [EOSFoo], eos_id: [0], gamma: [1.4]}]");
+        invalid("eos: [{type: [EOSIdealGas], eos_id: [0, 1], gamma: [1.4]}]");
+        invalid("eos: [{type: [EOSIdealGas], eos_id: [0], gamma: [0.9]}]");
+        invalid(
+            "eos: [{type: [EOSIdealGas, EOSIdealGas], eos_id: [1, 1], "
+            "gamma: [1.4, 1.4]}]");
+        invalid("part: [{part_id: 0, eos_id: 7}]");
+        invalid("solver: [{type: SPHLagrange}]");
+        invalid("solver: [{vector_length: 6}]");
+        invalid("solver: [{pair_loop: HalfAtomic}]");
+        invalid("solver: [{eos_tolerance: -1e-3}]");
+        invalid("time_integration: [{cfl: 0}]");
+        invalid("load_balance: {threshold: 0.5}");
+        invalid("halo_radius: -1");
+        invalid("diagnostics: {cadence: 0}");
+        invalid("diagnostics: {shock_axis: 3}");
+        invalid("time_integration: [{cfl: fast}]");
+    }
+    Kokkos::finalize();
+}
@@ -0,0 +1,77 @@
+#include <gtest/gtest.h>
+#include "eos_fixed_registry.hpp"
+#include <Kokkos_Core.hpp>
+
+#include "eos_multi_material.hpp"
+
+// Test EOSFixedRegistry
+TEST(EOSFixedRegistryTest, Specialize) {
+    Kokkos::initialize();
+    {
+        EXPECT_EQ(EOSFixedMaterials::size, 3);
+        EXPECT_EQ(EOSFixedMaterials::Find(EOSLinearGas(0, 1.4, 1e-6).Params()),
+                  0);
+        EXPECT_EQ(
+            EOSFixedMaterials::Find(EOSStiffenedGas(0, 1.4, 1e-6).Params()),
+            0);
+        const EOSStiffenedGas water_eos(0, 4.4, 1e-6, 6e8);
+        EXPECT_EQ(EOSFixedMaterials::Find(water_eos.Params()), 2);
+        EXPECT_EQ(EOSFixedMaterials::Find(EOSLinearGas(0, 1.3, 1e-6).Params()),
+                  -1);
+
+        // Unmatched parameters fall back to the runtime version
+        const EOSParams fallback = EOSFixedMaterials::Specialize(
+            EOSStiffenedGas(0, 1.4, 1e-6, 0.1).Params());
+        EXPECT_EQ(fallback.type, EOSType::StiffenedGas);
+        const EOSParams water =
+            EOSFixedMaterials::Specialize(water_eos.Params());
+        EXPECT_EQ(water.type, EOSType::Fixed);
+        EXPECT_EQ(water.fixed, 2);
+
+        // Specialized and runtime tables give the same results
+        std::vector<EOSVariant> eos_vector;
+        eos_vector.emplace_back(EOSLinearGas(0, 1.4, 1e-6));
+        eos_vector.emplace_back(EOSStiffenedGas(1, 4.4, 1e-6, 6e8));
+        eos_vector.emplace_back(EOSStiffenedGas(2, 1.4, 1e-6, 0.1));
+        EOSMultiMaterial fixed(eos_vector);
+        EOSMultiMaterial runtime(eos_vector, false);
+
+        auto host_table = Kokkos::create_mirror_view_and_copy(
+            Kokkos::HostSpace(), fixed.Table());
+        EXPECT_EQ(host_table(0).type, EOSType::Fixed);
+        EXPECT_EQ(host_table(1).type, EOSType::Fixed);
+        EXPECT_EQ(host_table(2).type, EOSType::StiffenedGas);
+
+        const int N = 3;
+        Kokkos::View<int*> eos_id("eos_id", N);
+        Kokkos::View<double*> rho("rho", N);
+        Kokkos::View<double*> eint("eint", N);
+        Kokkos::View<double*> p("p", N);
+        Kokkos::View<double*> sos("sos", N);
+        Kokkos::View<double*> p_runtime("p_runtime", N);
+        Kokkos::View<double*> sos_runtime("sos_runtime", N);
+
+        auto host_eos_id = Kokkos::create_mirror_view(eos_id);
+        for (int i = 0; i < N; ++i) host_eos_id(i) = i;
+        Kokkos::deep_copy(eos_id, host_eos_id);
+        Kokkos::deep_copy(rho, 1000.0);
+        Kokkos::deep_copy(eint, 776500.0);
+
+        fixed.PressureSoS(eos_id, rho, eint, p, sos);
+        runtime.PressureSoS(eos_id, rho, eint, p_runtime, sos_runtime);
+
+        auto host_p =
+            Kokkos::create_mirror_view_and_copy(Kokkos::HostSpace(), p);
+        auto host_sos =
+            Kokkos::create_mirror_view_and_copy(Kokkos::HostSpace(), sos);
+        auto host_p_runtime =
+            Kokkos::create_mirror_view_and_copy(Kokkos::HostSpace(), p_runtime);
+        auto host_sos_runtime = Kokkos::create_mirror_view_and_copy(
+            Kokkos::HostSpace(), sos_runtime);
+        for (int i = 0; i < N; ++i) {
+            EXPECT_DOUBLE_EQ(host_p(i), host_p_runtime(i));
+            EXPECT_DOUBLE_EQ(host_sos(i), host_sos_runtime(i));
+        }
+    }
+    Kokkos::finalize();
+}
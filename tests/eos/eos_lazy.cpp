@@ -0,0 +1,115 @@
+#include <gtest/gtest.h>
+#include "eos_lazy.hpp"
+#include <Kokkos_Core.hpp>
+
+#include <limits>
+#include <stdexcept>
+#include <vector>
+
+// Test EOSLazy
+TEST(EOSLazyTest, PressureSoS) {
+    Kokkos::initialize();
+    {
+        std::vector<EOSVariant> eos_vector;
+        eos_vector.emplace_back(EOSLinearGas(0, 1.4, 1e-6));
+        eos_vector.emplace_back(EOSStiffenedGas(1, 1.4, 1e-6, 0.1));
+        const EOSMultiMaterial eos(eos_vector);
+        EXPECT_THROW(EOSLazy(eos, -1.0), std::invalid_argument);
+        EOSLazy lazy(eos, 1e-3);
+
+        const int N = 8;
+        Kokkos::View<int*> eos_id("eos_id", N);
+        Kokkos::View<double*> rho("rho", N);
+        Kokkos::View<double*> eint("eint", N);
+        Kokkos::View<double*> rho_eos("rho_eos", N);
+        Kokkos::View<double*> eint_eos("eint_eos", N);
+        Kokkos::View<double*> p("p", N);
+        Kokkos::View<double*> sos("sos", N);
+        Kokkos::View<double*> p_ref("p_ref", N);
+        Kokkos::View<double*> sos_ref("sos_ref", N);
+        auto host_id   = Kokkos::create_mirror_view(eos_id);
+        auto host_rho  = Kokkos::create_mirror_view(rho);
+        auto host_eint = Kokkos::create_mirror_view(eint);
+        for (int i = 0; i < N; ++i) {
+            host_id(i)   = i % 2;
+            host_rho(i)  = 1.0 + 0.1 * i;
+            host_eint(i) = 2.0 + 0.2 * i;
+        }
+        Kokkos::deep_copy(eos_id, host_id);
+        Kokkos::deep_copy(rho, host_rho);
+        Kokkos::deep_copy(eint, host_eint);
+
+        const auto check = [&]() {
+            eos.PressureSoS(eos_id, rho, eint, p_ref, sos_ref);
+            const auto host_p = Kokkos::create_mirror_view_and_copy(
+                Kokkos::HostSpace(), p);
+            const auto host_p_ref = Kokkos::create_mirror_view_and_copy(
+                Kokkos::HostSpace(), p_ref);
+            const auto host_sos = Kokkos::create_mirror_view_and_copy(
+                Kokkos::HostSpace(), sos);
+            const auto host_sos_ref = Kokkos::create_mirror_view_and_copy(
+                Kokkos::HostSpace(), sos_ref);
+            for (int i = 0; i < N; ++i) {
+                EXPECT_DOUBLE_EQ(host_p(i), host_p_ref(i)) << i;
+                EXPECT_DOUBLE_EQ(host_sos(i), host_sos_ref(i)) << i;
+            }
+        };
+
+        const auto evaluate = [&](const std::size_t first = 0) {
+            return lazy.PressureSoS(eos_id, rho, eint, rho_eos, eint_eos, p,
+                                    sos, first);
+        };
+
+        // The first call evaluates every particle, the next one none
+        EXPECT_EQ(evaluate(), 8u);
+        check();
+        EXPECT_EQ(evaluate(), 0u);
+        EXPECT_EQ(lazy.NumEvaluated(), 0u);
+
+        // Changes within the tolerance keep the cached values
+        host_rho(2) *= 1.0 + 1e-4;
+        Kokkos::deep_copy(rho, host_rho);
+        EXPECT_EQ(evaluate(), 0u);
+
+        // Larger changes of either value are re-evaluated
+        host_rho(2) *= 1.01;
+        host_eint(5) *= 0.9;
+        host_eint(7) *= 1.1;
+        Kokkos::deep_copy(rho, host_rho);
+        Kokkos::deep_copy(eint, host_eint);
+        EXPECT_EQ(evaluate(), 3u);
+        check();
+
+        // The rows before first are ignored
+        host_rho(1) *= 2.0;
+        host_rho(6) *= 2.0;
+        Kokkos::deep_copy(rho, host_rho);
+        EXPECT_EQ(evaluate(4), 1u);
+        EXPECT_EQ(evaluate(), 1u);
+        check();
+
+        // NaN references evaluate every particle again; the references
+        // belong to the rows, so a subset of the rows keeps them
+        Kokkos::deep_copy(rho_eos, std::numeric_limits<double>::quiet_NaN());
+        EXPECT_EQ(evaluate(), 8u);
+        const auto sub = Kokkos::make_pair(0, 4);
+        EXPECT_EQ(lazy.PressureSoS(Kokkos::subview(eos_id, sub),
+                                   Kokkos::subview(rho, sub),
+                                   Kokkos::subview(eint, sub),
+                                   Kokkos::subview(rho_eos, sub),
+                                   Kokkos::subview(eint_eos, sub),
+                                   Kokkos::subview(p, sub),
+                                   Kokkos::subview(sos, sub)),
+                  0u);
+
+        // A zero tolerance re-evaluates any change
+        lazy.SetTolerance(0.0);
+        EXPECT_DOUBLE_EQ(lazy.Tolerance(), 0.0);
+        EXPECT_EQ(evaluate(), 0u);
+        host_eint(3) *= 1.0 + 1e-12;
+        Kokkos::deep_copy(eint, host_eint);
+        EXPECT_EQ(evaluate(), 1u);
+        check();
+    }
+    Kokkos::finalize();
+}
@@ -25,6 +25,54 @@ TEST(EOSLinearGasTest, PressureSoSImpl) {
 
         EXPECT_NEAR(host_p(0), 0.8, 1e-8);
         EXPECT_NEAR(host_sos(0), 1.12, 1e-8);
+
+        // Single precision storage and arithmetic
+        EOSLinearGas eos_float(0, 1.4f, 1e-6f);
+        static_assert(std::is_same_v<decltype(eos_float)::scalar_type, float>);
+
+        Kokkos::View<float*> rho_float("rho_float", 1);
+        Kokkos::View<float*> eint_float("eint_float", 1);
+        Kokkos::View<float*> p_float("p_float", 1);
+        Kokkos::View<float*> sos_float("sos_float", 1);
+
+        Kokkos::deep_copy(rho_float, 1.0f);
+        Kokkos::deep_copy(eint_float, 2.0f);
+
+        eos_float.PressureSoSImpl(rho_float, eint_float, p_float, sos_float);
+
+        auto host_p_float = Kokkos::create_mirror_view(p_float);
+        Kokkos::deep_copy(host_p_float, p_float);
+        EXPECT_FLOAT_EQ(host_p_float(0), 0.8f);
+
+        // Packed evaluation with a partial last pack matches the point
+        // function, including the cutoff lanes
+        const int n = 2 * SIMDOps::Width<double>() + 1;
+        Kokkos::View<double*> rho_n("rho_n", n);
+        Kokkos::View<double*> eint_n("eint_n", n);
+        Kokkos::View<double*> p_n("p_n", n);
+        Kokkos::View<double*> sos_n("sos_n", n);
+        auto host_rho  = Kokkos::create_mirror_view(rho_n);
+        auto host_eint = Kokkos::create_mirror_view(eint_n);
+        for (int i = 0; i < n; ++i) {
+            host_rho(i)  = 1.0 + 0.1 * i;
+            host_eint(i) = i % 3 == 0 ? 0.0 : 0.5 * i;
+        }
+        Kokkos::deep_copy(rho_n, host_rho);
+        Kokkos::deep_copy(eint_n, host_eint);
+
+        eos.PressureSoSImpl(rho_n, eint_n, p_n, sos_n);
+
+        auto host_p_n   = Kokkos::create_mirror_view(p_n);
+        auto host_sos_n = Kokkos::create_mirror_view(sos_n);
+        Kokkos::deep_copy(host_p_n, p_n);
+        Kokkos::deep_copy(host_sos_n, sos_n);
+        for (int i = 0; i < n; ++i) {
+            double p_i, sos_i;
+            EOSLinearGas<>::PressureSoSPoint(eos.Params(), host_rho(i),
+                                             host_eint(i), p_i, sos_i);
+            EXPECT_DOUBLE_EQ(host_p_n(i), p_i);
+            EXPECT_DOUBLE_EQ(host_sos_n(i), sos_i);
+        }
     }
     Kokkos::finalize();
 }
\ No newline at end of file
@@ -0,0 +1,76 @@
+#include <gtest/gtest.h>
+#include "eos_multi_material.hpp"
+#include <Kokkos_Core.hpp>
+
+// Test EOSMultiMaterial
+TEST(EOSMultiMaterialTest, PressureSoS) {
+    Kokkos::initialize();
+    {
+        std::vector<EOSVariant> eos_vector;
+        eos_vector.emplace_back(EOSLinearGas(0, 1.4, 1e-6));
+        eos_vector.emplace_back(EOSStiffenedGas(2, 1.4, 1e-6, 0.1));
+
+        EOSMultiMaterial eos(eos_vector);
+        EXPECT_EQ(eos.TableSize(), 3);
+
+        Kokkos::View<int*> eos_id("eos_id", 4);
+        Kokkos::View<double*> rho("rho", 4);
+        Kokkos::View<double*> eint("eint", 4);
+        Kokkos::View<double*> p("p", 4);
+        Kokkos::View<double*> sos("sos", 4);
+
+        auto host_eos_id = Kokkos::create_mirror_view(eos_id);
+        host_eos_id(0)   = 0;
+        host_eos_id(1)   = 2;
+        host_eos_id(2)   = 2;
+        host_eos_id(3)   = 0;
+        Kokkos::deep_copy(eos_id, host_eos_id);
+        Kokkos::deep_copy(rho, 1.0);
+        Kokkos::deep_copy(eint, 2.0);
+
+        eos.PressureSoS(eos_id, rho, eint, p, sos);
+
+        auto host_p   = Kokkos::create_mirror_view(p);
+        auto host_sos = Kokkos::create_mirror_view(sos);
+        Kokkos::deep_copy(host_p, p);
+        Kokkos::deep_copy(host_sos, sos);
+
+        EXPECT_NEAR(host_p(0), 0.8, 1e-8);
+        EXPECT_NEAR(host_sos(0), 1.12, 1e-8);
+        EXPECT_NEAR(host_p(1), 0.66, 1e-8);
+        EXPECT_NEAR(host_sos(1), 1.064, 1e-8);
+        EXPECT_NEAR(host_p(2), 0.66, 1e-8);
+        EXPECT_NEAR(host_sos(2), 1.064, 1e-8);
+        EXPECT_NEAR(host_p(3), 0.8, 1e-8);
+        EXPECT_NEAR(host_sos(3), 1.12, 1e-8);
+
+        // One execution space instance per material group
+        const auto instances = Kokkos::Experimental::partition_space(
+            Kokkos::DefaultExecutionSpace(), std::vector<int>{1, 1});
+        const std::vector<Kokkos::pair<int, int>> groups = {{0, 1}, {1, 4}};
+        Kokkos::deep_copy(p, 0.0);
+        eos.PressureSoS(eos_id, rho, eint, p, sos, groups, instances);
+        Kokkos::deep_copy(host_p, p);
+        EXPECT_NEAR(host_p(0), 0.8, 1e-8);
+        EXPECT_NEAR(host_p(2), 0.66, 1e-8);
+        EXPECT_NEAR(host_p(3), 0.8, 1e-8);
+        EXPECT_THROW(eos.PressureSoS(eos_id, rho, eint, p, sos, groups, {}),
+                     std::invalid_argument);
+
+        // Ids outside the table are left untouched
+        host_eos_id(1) = -1;
+        host_eos_id(2) = eos.TableSize();
+        Kokkos::deep_copy(eos_id, host_eos_id);
+        Kokkos::deep_copy(p, -7.0);
+        eos.PressureSoS(eos_id, rho, eint, p, sos);
+        Kokkos::deep_copy(host_p, p);
+        EXPECT_NEAR(host_p(0), 0.8, 1e-8);
+        EXPECT_EQ(host_p(1), -7.0);
+        EXPECT_EQ(host_p(2), -7.0);
+
+        // Duplicated EOS ids are rejected
+        eos_vector.emplace_back(EOSLinearGas(2, 1.4, 1e-6));
+        EXPECT_THROW(EOSMultiMaterial{eos_vector}, std::invalid_argument);
+    }
+    Kokkos::finalize();
+}
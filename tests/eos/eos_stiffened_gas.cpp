@@ -25,6 +25,29 @@ TEST(EOSStiffenedGasTest, PressureSoSImpl) {
 
         EXPECT_NEAR(host_p(0), 0.66, 1e-8);
         EXPECT_NEAR(host_sos(0), 1.064, 1e-8);
+
+        // Single precision storage of a stiff material (water): the pressure
+        // is accumulated in double, so only the output is rounded
+        EOSStiffenedGas water(0, 4.4f, 1e-6f, 6e8f);
+        constexpr float rho_water  = 1000.0f;
+        constexpr float eint_water = 776500.0f;
+
+        Kokkos::View<float*> rho_float("rho_float", 1);
+        Kokkos::View<float*> eint_float("eint_float", 1);
+        Kokkos::View<float*> p_float("p_float", 1);
+        Kokkos::View<float*> sos_float("sos_float", 1);
+
+        Kokkos::deep_copy(rho_float, rho_water);
+        Kokkos::deep_copy(eint_float, eint_water);
+
+        water.PressureSoSImpl(rho_float, eint_float, p_float, sos_float);
+
+        auto host_p_float = Kokkos::create_mirror_view(p_float);
+        Kokkos::deep_copy(host_p_float, p_float);
+        const double gamma   = 4.4f;
+        const double p_water = (gamma - 1.0) * rho_water * eint_water -
+                               gamma * 6e8f;
+        EXPECT_NEAR(host_p_float(0), p_water, 1e-6 * p_water);
     }
     Kokkos::finalize();
 }
\ No newline at end of file
@@ -0,0 +1,52 @@
+#include <gtest/gtest.h>
+#include "eos_stiffened_gas_fixed.hpp"
+#include <Kokkos_Core.hpp>
+
+#include "eos_stiffened_gas.hpp"
+
+// Test EOSStiffenedGasFixed
+TEST(EOSStiffenedGasFixedTest, PressureSoSImpl) {
+    Kokkos::initialize();
+    {
+        EOSStiffenedGasFixed<1.4, 0.1> eos(0, 1e-6);
+        EXPECT_EQ(eos.Params().type, EOSType::StiffenedGas);
+        EXPECT_DOUBLE_EQ(eos.Params().pinf, 0.1);
+
+        Kokkos::View<double*> rho("rho", 1);
+        Kokkos::View<double*> eint("eint", 1);
+        Kokkos::View<double*> p("p", 1);
+        Kokkos::View<double*> sos("sos", 1);
+
+        Kokkos::deep_copy(rho, 1.0);
+        Kokkos::deep_copy(eint, 2.0);
+
+        eos.PressureSoSImpl(rho, eint, p, sos);
+
+        auto host_p   = Kokkos::create_mirror_view(p);
+        auto host_sos = Kokkos::create_mirror_view(sos);
+        Kokkos::deep_copy(host_p, p);
+        Kokkos::deep_copy(host_sos, sos);
+
+        EXPECT_NEAR(host_p(0), 0.66, 1e-8);
+        EXPECT_NEAR(host_sos(0), 1.064, 1e-8);
+
+        // The ideal gas specialization matches the runtime version
+        EOSStiffenedGasFixed<1.4> air(0, 1e-6);
+        EOSStiffenedGas runtime_air(0, 1.4, 1e-6);
+        air.PressureSoSImpl(rho, eint, p, sos);
+        Kokkos::deep_copy(host_p, p);
+        Kokkos::deep_copy(host_sos, sos);
+        double p_runtime, sos_runtime;
+        EOSStiffenedGas<>::PressureSoSPointImpl(runtime_air.Params(), 1.0,
+                                                2.0, p_runtime, sos_runtime);
+        EXPECT_DOUBLE_EQ(host_p(0), p_runtime);
+        EXPECT_DOUBLE_EQ(host_sos(0), sos_runtime);
+
+        // Cutoff pressure
+        Kokkos::deep_copy(eint, 0.0);
+        air.PressureSoSImpl(rho, eint, p, sos);
+        Kokkos::deep_copy(host_p, p);
+        EXPECT_DOUBLE_EQ(host_p(0), 1e-6);
+    }
+    Kokkos::finalize();
+}
@@ -0,0 +1,126 @@
+#include <gtest/gtest.h>
+#include "eos_tabulated.hpp"
+#include <Kokkos_Core.hpp>
+
+#include <cstdio>
+#include <fstream>
+
+#include "eos_stiffened_gas.hpp"
+
+// Test EOSTabulated
+TEST(EOSTabulatedTest, PressureSoSImpl) {
+    Kokkos::initialize();
+    {
+        // Tabulated stiffened gas: exact on the nodes, close in between
+        EOSStiffenedGas gas(0, 1.4, 1e-6, 0.1);
+        const EOSTableAxis rho_axis{0.1, 10.0, 65};
+        const EOSTableAxis eint_axis{0.01, 100.0, 97};
+        const EOSTabulated eos =
+            EOSTabulated<>::Tabulate(3, gas, rho_axis, eint_axis);
+        EXPECT_EQ(eos.Id(), 3);
+
+        const int n = 5;
+        Kokkos::View<double*> rho("rho", n);
+        Kokkos::View<double*> eint("eint", n);
+        Kokkos::View<double*> p("p", n);
+        Kokkos::View<double*> sos("sos", n);
+        auto host_rho  = Kokkos::create_mirror_view(rho);
+        auto host_eint = Kokkos::create_mirror_view(eint);
+        host_rho(0)    = rho_axis.Value(10);
+        host_eint(0)   = eint_axis.Value(20);
+        host_rho(1)    = 1.0;
+        host_eint(1)   = 2.0;
+        host_rho(2)    = 3.7;
+        host_eint(2)   = 0.45;
+        // Clamped to the table corners
+        host_rho(3)    = 50.0;
+        host_eint(3)   = 1e3;
+        host_rho(4)    = 0.0;
+        host_eint(4)   = -1.0;
+        Kokkos::deep_copy(rho, host_rho);
+        Kokkos::deep_copy(eint, host_eint);
+
+        eos.PressureSoSImpl(rho, eint, p, sos);
+
+        auto host_p   = Kokkos::create_mirror_view(p);
+        auto host_sos = Kokkos::create_mirror_view(sos);
+        Kokkos::deep_copy(host_p, p);
+        Kokkos::deep_copy(host_sos, sos);
+        const auto exact = [&](const double r, const double e, double& p_e,
+                               double& sos_e) {
+            EOSStiffenedGas<>::PressureSoSPoint(gas.Params(), r, e, p_e,
+                                                sos_e);
+        };
+        double p_e, sos_e;
+        exact(host_rho(0), host_eint(0), p_e, sos_e);
+        EXPECT_NEAR(host_p(0), p_e, 1e-12 * p_e);
+        EXPECT_NEAR(host_sos(0), sos_e, 1e-12 * sos_e);
+        for (int i = 1; i < 3; ++i) {
+            exact(host_rho(i), host_eint(i), p_e, sos_e);
+            EXPECT_NEAR(host_p(i), p_e, 1e-2 * p_e);
+            EXPECT_NEAR(host_sos(i), sos_e, 1e-2 * sos_e);
+        }
+        exact(rho_axis.max, eint_axis.max, p_e, sos_e);
+        EXPECT_NEAR(host_p(3), p_e, 1e-12 * p_e);
+        exact(rho_axis.min, eint_axis.min, p_e, sos_e);
+        EXPECT_NEAR(host_p(4), p_e, 1e-12);
+        EXPECT_NEAR(host_sos(4), sos_e, 1e-12 * sos_e);
+
+        // Single-precision views read the same table
+        const auto eos_float =
+            EOSTabulated<float>::Tabulate(3, gas, rho_axis, eint_axis);
+        Kokkos::View<float*> rho_float("rho_float", n);
+        Kokkos::View<float*> eint_float("eint_float", n);
+        Kokkos::View<float*> p_float("p_float", n);
+        Kokkos::View<float*> sos_float("sos_float", n);
+        auto host_rho_float  = Kokkos::create_mirror_view(rho_float);
+        auto host_eint_float = Kokkos::create_mirror_view(eint_float);
+        for (int i = 0; i < n; ++i) {
+            host_rho_float(i)  = static_cast<float>(host_rho(i));
+            host_eint_float(i) = static_cast<float>(host_eint(i));
+        }
+        Kokkos::deep_copy(rho_float, host_rho_float);
+        Kokkos::deep_copy(eint_float, host_eint_float);
+        eos_float.PressureSoSImpl(rho_float, eint_float, p_float, sos_float);
+        auto host_p_float = Kokkos::create_mirror_view_and_copy(
+            Kokkos::HostSpace(), p_float);
+        for (int i = 1; i < 4; ++i) {
+            EXPECT_NEAR(host_p_float(i), host_p(i), 1e-5 * host_p(i));
+        }
+
+        // Text table: 2 x 2 nodes, bilinear in the logarithms
+        const std::string filename = "eos_tabulated_test.txt";
+        {
+            std::ofstream file(filename);
+            file << "# n_rho rho_min rho_max\n2 1 100\n"
+                 << "2 1 10000 # n_eint eint_min eint_max\n"
+                 << "0 1\n2 1\n4 1\n6 1\n";
+        }
+        const EOSTabulated table = EOSTabulated<>::FromFile(0, filename, 0.5);
+        std::remove(filename.c_str());
+        host_rho(0)  = 10.0;
+        host_eint(0) = 100.0;
+        host_rho(1)  = 1.0;
+        host_eint(1) = 1.0;
+        Kokkos::deep_copy(rho, host_rho);
+        Kokkos::deep_copy(eint, host_eint);
+        table.PressureSoSImpl(rho, eint, p, sos);
+        Kokkos::deep_copy(host_p, p);
+        Kokkos::deep_copy(host_sos, sos);
+        EXPECT_NEAR(host_p(0), 3.0, 1e-12);
+        EXPECT_NEAR(host_sos(0), 1.0, 1e-12);
+        // Below the cutoff pressure
+        EXPECT_EQ(host_p(1), 0.5);
+
+        // Invalid tables
+        EXPECT_THROW(EOSTabulated(0, {1.0, 1.0, 2}, {1.0, 2.0, 2},
+                                  {0, 0, 0, 0}, {0, 0, 0, 0}, 0.0),
+                     std::invalid_argument);
+        EXPECT_THROW(EOSTabulated(0, {1.0, 2.0, 2}, {1.0, 2.0, 2}, {0, 0},
+                                  {0, 0}, 0.0),
+                     std::invalid_argument);
+        EXPECT_THROW(EOSTabulated<>::FromFile(0, "missing_table.txt", 0.0),
+                     std::runtime_error);
+    }
+    Kokkos::finalize();
+}
@@ -0,0 +1,59 @@
+#include <gtest/gtest.h>
+#include "simd_ops.hpp"
+#include <Kokkos_Core.hpp>
+
+#include <type_traits>
+
+// Test SIMDOps
+TEST(SIMDOpsTest, PacksAndTail) {
+    Kokkos::initialize();
+    {
+        using Pack              = SIMDOps::Pack<double>;
+        constexpr std::size_t W = SIMDOps::Width<double>();
+        static_assert(std::is_same_v<SIMDOps::Double<float>, double>);
+        static_assert(std::is_same_v<SIMDOps::Double<Pack>, Pack>);
+
+        // Lane-wise operations against their scalar overloads
+        double a[W], b[W], out[W];
+        for (std::size_t l = 0; l < W; ++l) {
+            a[l] = 1.0 + l;
+            b[l] = 2.5 - l;
+        }
+        const Pack pa = SIMDOps::Load(a);
+        const Pack pb = SIMDOps::Load(b);
+        SIMDOps::Store(SIMDOps::Max(pa, pb), out);
+        for (std::size_t l = 0; l < W; ++l) {
+            EXPECT_EQ(out[l], SIMDOps::Max(a[l], b[l]));
+        }
+        SIMDOps::Store(SIMDOps::Select(pa < pb, pa - pb, Pack(0.0)), out);
+        double sum = 0.0;
+        for (std::size_t l = 0; l < W; ++l) {
+            EXPECT_EQ(out[l], SIMDOps::Select(a[l] < b[l], a[l] - b[l], 0.0));
+            sum += a[l];
+        }
+        EXPECT_DOUBLE_EQ(SIMDOps::Sum(pa), sum);
+
+        // Every element is visited once, the partial pack by the tail (host
+        // backends only)
+        if constexpr (SIMDOps::enabled) {
+            const std::size_t n = 2 * W + 3;
+            Kokkos::View<int*> packed("packed", n);
+            Kokkos::View<int*> tail("tail", n);
+            SIMDOps::ForEach<double>(
+                "SIMDOpsTest::ForEach", Kokkos::DefaultExecutionSpace(), n,
+                [=](const std::size_t i) {
+                    for (std::size_t l = 0; l < W; ++l) packed(i + l) += 1;
+                },
+                [=](const std::size_t i) { tail(i) += 1; });
+            auto host_packed = Kokkos::create_mirror_view(packed);
+            auto host_tail   = Kokkos::create_mirror_view(tail);
+            Kokkos::deep_copy(host_packed, packed);
+            Kokkos::deep_copy(host_tail, tail);
+            for (std::size_t i = 0; i < n; ++i) {
+                EXPECT_EQ(host_packed(i) + host_tail(i), 1);
+                EXPECT_EQ(host_tail(i), i >= 2 * W ? 1 : 0);
+            }
+        }
+    }
+    Kokkos::finalize();
+}
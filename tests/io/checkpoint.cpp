@@ -0,0 +1,104 @@
+#include <gtest/gtest.h>
+#include "checkpoint.hpp"
+#include <Kokkos_Core.hpp>
+#include <mpi.h>
+
+#include <filesystem>
+
+// Plain-old-data record
+struct TestState {
+    int id;
+    double gamma;
+};
+
+// Test CheckpointWriter and CheckpointReader
+TEST(CheckpointTest, WriteRead) {
+    MPI_Init(nullptr, nullptr);
+    Kokkos::initialize();
+    {
+        const int N = 1000;
+        Kokkos::View<double* [3]> x("x", N);
+        Kokkos::View<double*> rho("rho", N);
+        Kokkos::View<int*> part_id("part_id", N);
+        Kokkos::parallel_for(
+            "InitializeFields", N, KOKKOS_LAMBDA(const int i) {
+                for (int d = 0; d < 3; ++d) x(i, d) = 3 * i + d;
+                rho(i)     = 0.5 * i;
+                part_id(i) = i % 7;
+            });
+
+        const std::string filename =
+            (std::filesystem::temp_directory_path() / "sphiros_checkpoint.bin")
+                .string();
+        const std::size_t stripe = 4096;
+        {
+            CheckpointWriter writer(MPI_COMM_WORLD, stripe);
+            writer.AddField("x", x);
+            writer.AddField("rho", rho);
+            writer.AddField("part_id", part_id);
+            writer.AddRecord("time", std::vector<double>{1.25});
+            writer.AddRecord("state", std::vector<TestState>{{0, 1.4},
+                                                             {1, 5.0}});
+            EXPECT_THROW(writer.AddField("rho", rho), std::invalid_argument);
+            Kokkos::View<double*> short_field("short", N - 1);
+            EXPECT_THROW(writer.AddField("short", short_field),
+                         std::invalid_argument);
+            writer.Write(filename);
+
+            // Every data region starts on a stripe boundary
+            for (const auto& entry : writer.Entries()) {
+                EXPECT_EQ(entry.offset % stripe, 0u);
+            }
+        }
+
+        CheckpointReader reader(filename);
+        EXPECT_EQ(reader.NumParticles(), static_cast<std::size_t>(N));
+        EXPECT_EQ(reader.NumRanksWritten(), 1);
+        EXPECT_TRUE(reader.Has("rho"));
+        EXPECT_FALSE(reader.Has("p"));
+        EXPECT_EQ(reader.ReadRecord<double>("time"), std::vector<double>{1.25});
+        const auto state = reader.ReadRecord<TestState>("state");
+        ASSERT_EQ(state.size(), 2u);
+        EXPECT_EQ(state[1].id, 1);
+        EXPECT_EQ(state[1].gamma, 5.0);
+        EXPECT_THROW(reader.ReadRecord<float>("time"), std::invalid_argument);
+
+        // Restart on three ranks: each reads a contiguous third
+        std::size_t first = 0;
+        for (int rank = 0; rank < 3; ++rank) {
+            const std::size_t n = N * (rank + 1) / 3 - first;
+            Kokkos::View<double**, Kokkos::LayoutLeft> x_part("x_part", n, 3);
+            Kokkos::View<int*> id_part("id_part", n);
+            reader.ReadRows("x", x_part, first);
+            reader.ReadRows("part_id", id_part, first);
+            auto host_x  = Kokkos::create_mirror_view_and_copy(
+                Kokkos::HostSpace(), x_part);
+            auto host_id = Kokkos::create_mirror_view_and_copy(
+                Kokkos::HostSpace(), id_part);
+            for (std::size_t i = 0; i < n; ++i) {
+                const std::size_t g = first + i;
+                for (int d = 0; d < 3; ++d) {
+                    EXPECT_EQ(host_x(i, d), static_cast<double>(3 * g + d));
+                }
+                EXPECT_EQ(host_id(i), static_cast<int>(g % 7));
+            }
+            first += n;
+        }
+
+        // Local range of the current communicator
+        const auto [local_first, n_local] = reader.LocalRange();
+        EXPECT_EQ(local_first, 0u);
+        Kokkos::View<double*> rho_restart("rho_restart", n_local);
+        reader.ReadField("rho", rho_restart);
+        auto host_rho = Kokkos::create_mirror_view_and_copy(Kokkos::HostSpace(),
+                                                            rho_restart);
+        for (std::size_t i = 0; i < n_local; ++i) {
+            EXPECT_EQ(host_rho(i), 0.5 * i);
+        }
+        Kokkos::View<float*> rho_float("rho_float", n_local);
+        EXPECT_THROW(reader.ReadField("rho", rho_float),
+                     std::invalid_argument);
+    }
+    Kokkos::finalize();
+    MPI_Finalize();
+}
@@ -0,0 +1,80 @@
+#include <gtest/gtest.h>
+#include "collective_read.hpp"
+#include <Kokkos_Core.hpp>
+#include <mpi.h>
+
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <vector>
+
+#include "pvtu_reader.hpp"
+
+// Test CollectiveRead
+TEST(CollectiveReadTest, BroadcastAndAggregate) {
+    MPI_Init(nullptr, nullptr);
+    Kokkos::initialize();
+    {
+        int rank, size;
+        MPI_Comm_rank(MPI_COMM_WORLD, &rank);
+        MPI_Comm_size(MPI_COMM_WORLD, &size);
+        const auto folder = std::filesystem::temp_directory_path();
+        const auto name   = [&](const int r) {
+            return (folder / ("sphiros_collective_" + std::to_string(r)))
+                .string();
+        };
+
+        // Every rank writes its own file, with a NUL byte
+        {
+            std::ofstream file(name(rank), std::ios::binary);
+            file << "rank " << rank << '\0' << "end";
+        }
+        MPI_Barrier(MPI_COMM_WORLD);
+        const std::string expected0 = std::string("rank 0") + '\0' + "end";
+
+        // Only rank 0 reads, every rank gets the contents
+        EXPECT_EQ(CollectiveRead::Broadcast(name(0)), expected0);
+        EXPECT_THROW(CollectiveRead::Broadcast(name(-1)), std::runtime_error);
+
+        // Rank r reads the files of ranks r and 0; the last rank none
+        std::vector<std::string> files;
+        if (rank != size - 1 || size == 1) files = {name(rank), name(0)};
+        const auto contents = CollectiveRead::NodeAggregated(files);
+        ASSERT_EQ(contents.size(), files.size());
+        if (!files.empty()) {
+            EXPECT_EQ(contents[0], std::string("rank ") +
+                                       std::to_string(rank) + '\0' + "end");
+            EXPECT_EQ(contents[1], expected0);
+        }
+        // A file missing on rank 0 throws on every rank
+        const std::vector<std::string> missing =
+            rank == 0 ? std::vector<std::string>{name(-1)}
+                      : std::vector<std::string>{};
+        EXPECT_THROW(CollectiveRead::NodeAggregated(missing),
+                     std::runtime_error);
+        EXPECT_TRUE(CollectiveRead::NodeAggregated({}).empty());
+
+        // So does a phase failing on the last rank only
+        EXPECT_THROW(CollectiveRead::Checked([&] {
+                         if (rank == size - 1) {
+                             throw std::invalid_argument("last rank");
+                         }
+                     }),
+                     std::runtime_error);
+        EXPECT_NO_THROW(CollectiveRead::Checked([] {}));
+
+        // Collective .pvtu index and pieces match the per-rank reads
+        const std::string pvtu_file =
+            std::string(SPHIROS_EXAMPLES_DIR) + "/sphere.pvtu";
+        const PVTUReader pvtu(pvtu_file, MPI_COMM_WORLD);
+        EXPECT_EQ(pvtu.Pieces(), PVTUReader(pvtu_file).Pieces());
+        const auto pieces = pvtu.Open(MPI_COMM_WORLD);
+        EXPECT_EQ(VTUReader::TotalPoints(pieces),
+                  VTUReader::TotalPoints(pvtu.Open(rank, size)));
+
+        MPI_Barrier(MPI_COMM_WORLD);
+        std::filesystem::remove(name(rank));
+    }
+    Kokkos::finalize();
+    MPI_Finalize();
+}
@@ -0,0 +1,120 @@
+#include <gtest/gtest.h>
+#include "diagnostics.hpp"
+#include <Kokkos_Core.hpp>
+#include <mpi.h>
+
+#include <cmath>
+#include <filesystem>
+#include <fstream>
+#include <string>
+
+// Minimal particle storage
+struct TestParticles {
+    Kokkos::View<double* [3]> x, v;
+    Kokkos::View<double*> mass, rho, eint, p;
+    Kokkos::View<int*> part_id;
+
+    std::size_t Size() const { return x.extent(0); }
+    auto X() const { return x; }
+    auto V() const { return v; }
+    auto Mass() const { return mass; }
+    auto Rho() const { return rho; }
+    auto Eint() const { return eint; }
+    auto P() const { return p; }
+    auto PartId() const { return part_id; }
+};
+
+// Test Diagnostics
+TEST(DiagnosticsTest, Reduce) {
+    MPI_Init(nullptr, nullptr);
+    Kokkos::initialize();
+    {
+        int rank, size;
+        MPI_Comm_rank(MPI_COMM_WORLD, &rank);
+        MPI_Comm_size(MPI_COMM_WORLD, &size);
+
+        // Rank r holds particles at x = 10 r + i: part 0 at high pressure
+        // below x = 10 r + 5, part 1 at low pressure above
+        const int N = 10;
+        TestParticles particles{
+            Kokkos::View<double* [3]>("x", N),
+            Kokkos::View<double* [3]>("v", N),
+            Kokkos::View<double*>("mass", N),
+            Kokkos::View<double*>("rho", N),
+            Kokkos::View<double*>("eint", N),
+            Kokkos::View<double*>("p", N),
+            Kokkos::View<int*>("part_id", N)};
+        const auto x = particles.x, v = particles.v;
+        const auto mass = particles.mass, rho = particles.rho;
+        const auto eint = particles.eint, p = particles.p;
+        const auto part_id = particles.part_id;
+        const double offset = 10.0 * rank;
+        Kokkos::parallel_for(
+            "InitializeFields", N, KOKKOS_LAMBDA(const int i) {
+                x(i, 0)    = offset + i;
+                x(i, 1)    = 0.0;
+                x(i, 2)    = 0.0;
+                v(i, 0)    = 1.0;
+                v(i, 1)    = -2.0;
+                v(i, 2)    = 0.0;
+                mass(i)    = 0.5;
+                rho(i)     = 1.0 + i;
+                eint(i)    = 2.0;
+                p(i)       = i < 5 ? 1.0 : 0.1;
+                part_id(i) = i < 5 ? 0 : 1;
+            });
+
+        const std::string filename =
+            (std::filesystem::temp_directory_path() / "sphiros_diag.dat")
+                .string();
+        const std::vector<DiagnosticsGroup> groups = {{"all", {}},
+                                                      {"low", {1}}};
+        Diagnostics diag(filename, 2,
+                         {"mass", "momentum_y", "total_energy", "min_density",
+                          "max_pressure", "shock_position"},
+                         groups, 0.5);
+        ASSERT_EQ(diag.Columns().size(), 12u);
+        EXPECT_EQ(diag.Columns()[0], "all.mass");
+        EXPECT_EQ(diag.Columns()[11], "low.shock_position");
+        EXPECT_TRUE(std::isnan(diag.Values()[0]));
+
+        EXPECT_TRUE(diag.Sample(0, 0.0, particles));
+        EXPECT_FALSE(diag.Sample(1, 0.1, particles));
+        EXPECT_TRUE(diag.Sample(2, 0.2, particles));
+        const auto& values = diag.Values();
+        EXPECT_DOUBLE_EQ(values[0], 5.0 * size);
+        EXPECT_DOUBLE_EQ(values[1], -10.0 * size);
+        // 0.5 m |v|^2 + m eint per particle
+        EXPECT_DOUBLE_EQ(values[2], N * size * (1.25 + 1.0));
+        EXPECT_DOUBLE_EQ(values[3], 1.0);
+        EXPECT_DOUBLE_EQ(values[4], 1.0);
+        EXPECT_DOUBLE_EQ(values[5], 10.0 * (size - 1) + 4.0);
+        EXPECT_DOUBLE_EQ(values[6], 2.5 * size);
+        EXPECT_DOUBLE_EQ(values[9], 6.0);
+        EXPECT_DOUBLE_EQ(values[10], 0.1);
+        // No low pressure particle is above the shock pressure
+        EXPECT_TRUE(std::isnan(values[11]));
+
+        if (rank == 0) {
+            std::ifstream file(filename);
+            std::string header, line;
+            std::getline(file, header);
+            EXPECT_EQ(header.rfind("# step time all.mass all.momentum_y", 0),
+                      0u);
+            int n_lines = 0;
+            while (std::getline(file, line)) ++n_lines;
+            EXPECT_EQ(n_lines, 2);
+            std::filesystem::remove(filename);
+        }
+
+        EXPECT_THROW(Diagnostics(filename, 0), std::invalid_argument);
+        EXPECT_THROW(Diagnostics(filename, 1, {"entropy"}),
+                     std::invalid_argument);
+        EXPECT_THROW(Diagnostics(filename, 1, {}, {{"bad", {-1}}}),
+                     std::invalid_argument);
+        EXPECT_THROW(Diagnostics("missing_folder/diagnostics.dat", 1),
+                     std::runtime_error);
+    }
+    Kokkos::finalize();
+    MPI_Finalize();
+}
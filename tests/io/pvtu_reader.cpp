@@ -0,0 +1,48 @@
+#include <gtest/gtest.h>
+#include "pvtu_reader.hpp"
+#include <Kokkos_Core.hpp>
+
+// Test PVTUReader
+TEST(PVTUReaderTest, Pieces) {
+    Kokkos::initialize();
+    {
+        const std::string folder = SPHIROS_EXAMPLES_DIR;
+        PVTUReader pvtu(folder + "/sphere.pvtu");
+        ASSERT_EQ(pvtu.NumPieces(), 1u);
+        EXPECT_EQ(pvtu.Pieces()[0], folder + "/sphere/sphere_0.vtu");
+        EXPECT_EQ(pvtu.PointDataNames(), std::vector<std::string>{"partId"});
+        EXPECT_EQ(pvtu.GhostLevel(), 1);
+
+        // Single rank, more ranks than pieces
+        EXPECT_EQ(pvtu.PiecesOfRank(0, 1).size(), 1u);
+        EXPECT_EQ(pvtu.PiecesOfRank(0, 2).size(), 0u);
+        EXPECT_EQ(pvtu.PiecesOfRank(1, 2).size(), 1u);
+
+        // Concatenation of the pieces of a rank
+        const auto pieces = pvtu.Open(0, 1);
+        ASSERT_EQ(pieces.size(), 1u);
+        EXPECT_EQ(VTUReader::TotalPoints(pieces), 362u);
+        auto part_id = VTUReader::ReadPointData<int>(pieces, "partId");
+        auto host_part_id =
+            Kokkos::create_mirror_view_and_copy(Kokkos::HostSpace(), part_id);
+        int sum = 0;
+        for (int i = 0; i < 362; ++i) sum += host_part_id(i);
+        EXPECT_EQ(sum, 543);
+
+        // The same piece twice is concatenated
+        const std::vector<VTUReader> twice = {pieces[0], pieces[0]};
+        auto x      = VTUReader::ReadPoints(twice);
+        auto host_x = Kokkos::create_mirror_view_and_copy(Kokkos::HostSpace(),
+                                                          x);
+        ASSERT_EQ(x.extent(0), 724u);
+        for (int i = 0; i < 362; ++i) {
+            for (int d = 0; d < 3; ++d) {
+                EXPECT_EQ(host_x(i, d), host_x(362 + i, d));
+            }
+        }
+
+        EXPECT_THROW(PVTUReader(folder + "/sphere/sphere_0.vtu"),
+                     std::runtime_error);
+    }
+    Kokkos::finalize();
+}
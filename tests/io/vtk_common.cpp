@@ -0,0 +1,58 @@
+#include <gtest/gtest.h>
+#include "vtk_common.hpp"
+#include <Kokkos_Core.hpp>
+
+// Test VTKBase64, VTKTag and VTKType
+TEST(VTKCommonTest, Helpers) {
+    Kokkos::initialize();
+    {
+        // Base64 round trip for all padding cases
+        const std::string samples[] = {"", "f", "fo", "foo", "foob", "fooba",
+                                       "foobar"};
+        const std::string encoded[] = {"",         "Zg==",     "Zm8=",
+                                       "Zm9v",     "Zm9vYg==", "Zm9vYmE=",
+                                       "Zm9vYmFy"};
+        for (int k = 0; k < 7; ++k) {
+            EXPECT_EQ(VTKBase64::Encode(samples[k].data(), samples[k].size()),
+                      encoded[k]);
+            EXPECT_EQ(VTKBase64::EncodedSize(samples[k].size()),
+                      encoded[k].size());
+            const auto bytes = VTKBase64::Decode(encoded[k]);
+            EXPECT_EQ(std::string(bytes.begin(), bytes.end()), samples[k]);
+        }
+        const auto bytes = VTKBase64::Decode(" Zm9v\n YmFy ");
+        EXPECT_EQ(std::string(bytes.begin(), bytes.end()), "foobar");
+        EXPECT_THROW(VTKBase64::Decode("Zm9*"), std::runtime_error);
+
+        // Tag parsing
+        const std::string xml =
+            "<DataArray type=\"Float32\" Name='Points' "
+            "NumberOfComponents=\"3\" format=\"binary\"/></Points>";
+        const VTKTag tag = VTKTag::Parse(xml, 0);
+        EXPECT_EQ(tag.name, "DataArray");
+        EXPECT_FALSE(tag.closing);
+        EXPECT_TRUE(tag.self_closing);
+        EXPECT_EQ(tag.Get("type"), "Float32");
+        EXPECT_EQ(tag.Get("Name"), "Points");
+        EXPECT_EQ(tag.Get("NumberOfComponents"), "3");
+        EXPECT_EQ(tag.Get("offset", "0"), "0");
+        const VTKTag closing = VTKTag::Parse(xml, tag.end);
+        EXPECT_EQ(closing.name, "Points");
+        EXPECT_TRUE(closing.closing);
+        EXPECT_EQ(closing.end, xml.size());
+
+        // Type mapping
+        EXPECT_EQ(VTKType::Size("Float64"), 8u);
+        EXPECT_EQ(VTKType::Size("UInt8"), 1u);
+        EXPECT_THROW(VTKType::Size("Float16"), std::runtime_error);
+        EXPECT_EQ(VTKType::Name<double>(), "Float64");
+        EXPECT_EQ(VTKType::Name<float>(), "Float32");
+        EXPECT_EQ(VTKType::Name<int>(), "Int32");
+        EXPECT_EQ(VTKType::Name<std::uint64_t>(), "UInt64");
+        std::size_t visited = 0;
+        VTKType::Visit("Int16",
+                       [&](auto value) { visited = sizeof(value); });
+        EXPECT_EQ(visited, 2u);
+    }
+    Kokkos::finalize();
+}
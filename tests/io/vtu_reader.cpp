@@ -0,0 +1,152 @@
+#include <gtest/gtest.h>
+#include "vtu_reader.hpp"
+#include <Kokkos_Core.hpp>
+
+#include <cmath>
+#include <filesystem>
+#include <fstream>
+
+// Coordinates and scalars of the synthetic pieces
+static const float points[3][3] = {
+    {0.0f, 1.0f, 2.0f}, {3.0f, 4.0f, 5.0f}, {6.0f, 7.0f, 8.0f}};
+static const std::int32_t ids[3] = {7, -1, 42};
+
+// Returns the base64 encoding of a block with a separately encoded header
+template <typename H>
+static std::string SeparateBlock(const void* data, const std::size_t size) {
+    const H header = static_cast<H>(size);
+    return VTKBase64::Encode(&header, sizeof(H)) +
+           VTKBase64::Encode(data, size);
+}
+
+// Returns the raw bytes of a block (header + data)
+static std::string RawBlock(const void* data, const std::size_t size) {
+    const std::uint64_t header = size;
+    return std::string(reinterpret_cast<const char*>(&header), 8) +
+           std::string(static_cast<const char*>(data), size);
+}
+
+// Writes a synthetic three-point piece
+static std::string WritePiece(const std::string& name,
+                              const std::string& header,
+                              const std::string& point_data,
+                              const std::string& points_array,
+                              const std::string& appended = "") {
+    const auto path = std::filesystem::temp_directory_path() / name;
+    std::ofstream file(path, std::ios::binary);
+    file << "<?xml version=\"1.0\"?>\n"
+         << "<VTKFile type=\"UnstructuredGrid\" version=\"1.0\" " << header
+         << ">\n<UnstructuredGrid>\n"
+         << "<Piece NumberOfPoints=\"3\" NumberOfCells=\"0\">\n"
+         << "<PointData>" << point_data << "</PointData>\n"
+         << "<Points>" << points_array << "</Points>\n"
+         << "</Piece>\n</UnstructuredGrid>\n"
+         << appended << "</VTKFile>\n";
+    return path.string();
+}
+
+// Checks the contents of a synthetic piece
+static void CheckPiece(const VTUReader& reader) {
+    ASSERT_EQ(reader.NumPoints(), 3u);
+    ASSERT_TRUE(reader.HasPointData("id"));
+    EXPECT_EQ(reader.Array("Points").n_components, 3);
+
+    auto x      = reader.ReadPoints();
+    auto host_x = Kokkos::create_mirror_view_and_copy(Kokkos::HostSpace(), x);
+    auto id     = reader.ReadPointData<int>("id");
+    auto host_id =
+        Kokkos::create_mirror_view_and_copy(Kokkos::HostSpace(), id);
+    for (int i = 0; i < 3; ++i) {
+        for (int d = 0; d < 3; ++d) EXPECT_EQ(host_x(i, d), points[i][d]);
+        EXPECT_EQ(host_id(i), ids[i]);
+    }
+}
+
+// Test VTUReader
+TEST(VTUReaderTest, Read) {
+    Kokkos::initialize();
+    {
+        // Sample mesh (inline binary, UInt64 headers, Float32 points)
+        VTUReader sphere(std::string(SPHIROS_EXAMPLES_DIR) +
+                         "/sphere/sphere_0.vtu");
+        ASSERT_EQ(sphere.NumPoints(), 362u);
+        ASSERT_EQ(sphere.PointDataNames(),
+                  std::vector<std::string>{"partId"});
+        auto x      = sphere.ReadPoints();
+        auto host_x = Kokkos::create_mirror_view_and_copy(Kokkos::HostSpace(),
+                                                          x);
+        EXPECT_EQ(host_x(0, 2), 0.5);
+        EXPECT_EQ(host_x(1, 2), -0.5);
+        for (int i = 0; i < 362; ++i) {
+            const double r = std::sqrt(host_x(i, 0) * host_x(i, 0) +
+                                       host_x(i, 1) * host_x(i, 1) +
+                                       host_x(i, 2) * host_x(i, 2));
+            EXPECT_NEAR(r, 0.5, 1e-6);
+        }
+        auto part_id      = sphere.ReadPointData("partId");
+        auto host_part_id = Kokkos::create_mirror_view_and_copy(
+            Kokkos::HostSpace(), part_id);
+        int n_part_1 = 0;
+        for (int i = 0; i < 362; ++i) {
+            EXPECT_TRUE(host_part_id(i) == 1.0 || host_part_id(i) == 2.0);
+            n_part_1 += host_part_id(i) == 1.0;
+        }
+        EXPECT_EQ(n_part_1, 181);
+        EXPECT_THROW(sphere.ReadPointData("rho"), std::invalid_argument);
+
+        // ASCII
+        CheckPiece(VTUReader(WritePiece(
+            "sphiros_ascii.vtu", "byte_order=\"LittleEndian\"",
+            "<DataArray type=\"Int32\" Name=\"id\" format=\"ascii\">\n"
+            "7 -1 42\n</DataArray>",
+            "<DataArray type=\"Float32\" NumberOfComponents=\"3\" "
+            "format=\"ascii\">0 1 2 3 4 5\n6 7 8</DataArray>")));
+
+        // Inline binary with separately encoded UInt32 headers
+        CheckPiece(VTUReader(WritePiece(
+            "sphiros_binary.vtu", "byte_order=\"LittleEndian\"",
+            "<DataArray type=\"Int32\" Name=\"id\" format=\"binary\">\n" +
+                SeparateBlock<std::uint32_t>(ids, sizeof(ids)) +
+                "\n</DataArray>",
+            "<DataArray type=\"Float32\" NumberOfComponents=\"3\" "
+            "format=\"binary\">" +
+                SeparateBlock<std::uint32_t>(points, sizeof(points)) +
+                "</DataArray>")));
+
+        // Raw appended data with UInt64 headers
+        const std::string raw_ids = RawBlock(ids, sizeof(ids));
+        CheckPiece(VTUReader(WritePiece(
+            "sphiros_raw.vtu",
+            "byte_order=\"LittleEndian\" header_type=\"UInt64\"",
+            "<DataArray type=\"Int32\" Name=\"id\" format=\"appended\" "
+            "offset=\"0\"/>",
+            "<DataArray type=\"Float32\" NumberOfComponents=\"3\" "
+            "format=\"appended\" offset=\"" +
+                std::to_string(raw_ids.size()) + "\"/>",
+            "<AppendedData encoding=\"raw\">\n_" + raw_ids +
+                RawBlock(points, sizeof(points)) + "\n</AppendedData>\n")));
+
+        // Base64 appended data with UInt64 headers
+        const std::string base64_ids =
+            SeparateBlock<std::uint64_t>(ids, sizeof(ids));
+        CheckPiece(VTUReader(WritePiece(
+            "sphiros_base64.vtu",
+            "byte_order=\"LittleEndian\" header_type=\"UInt64\"",
+            "<DataArray type=\"Int32\" Name=\"id\" format=\"appended\" "
+            "offset=\"0\"/>",
+            "<DataArray type=\"Float32\" NumberOfComponents=\"3\" "
+            "format=\"appended\" offset=\"" +
+                std::to_string(base64_ids.size()) + "\"/>",
+            "<AppendedData encoding=\"base64\">\n_" + base64_ids +
+                SeparateBlock<std::uint64_t>(points, sizeof(points)) +
+                "\n</AppendedData>\n")));
+
+        // Unsupported files
+        EXPECT_THROW(VTUReader("missing.vtu"), std::runtime_error);
+        EXPECT_THROW(VTUReader(WritePiece(
+                         "sphiros_zlib.vtu",
+                         "compressor=\"vtkZLibDataCompressor\"", "", "")),
+                     std::runtime_error);
+    }
+    Kokkos::finalize();
+}
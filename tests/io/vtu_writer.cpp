@@ -0,0 +1,80 @@
+#include <gtest/gtest.h>
+#include "vtu_writer.hpp"
+#include <Kokkos_Core.hpp>
+#include <mpi.h>
+
+#include "pvtu_reader.hpp"
+
+// Test VTUWriter
+TEST(VTUWriterTest, Write) {
+    MPI_Init(nullptr, nullptr);
+    Kokkos::initialize();
+    {
+        const int N = 100;
+        Kokkos::View<double* [3]> x("x", N);
+        Kokkos::View<double*> rho("rho", N);
+        Kokkos::View<float*> p("p", N);
+        Kokkos::View<double**, Kokkos::LayoutLeft> v("v", N, 3);
+        Kokkos::parallel_for(
+            "InitializeFields", N, KOKKOS_LAMBDA(const int i) {
+                for (int d = 0; d < 3; ++d) {
+                    x(i, d) = i + 0.1 * d;
+                    v(i, d) = -i - 0.1 * d;
+                }
+                rho(i) = 1.0 + i;
+                p(i)   = 0.5f * i;
+            });
+
+        const std::string prefix =
+            (std::filesystem::temp_directory_path() / "sphiros_output")
+                .string();
+        {
+            VTUWriter writer(prefix);
+            for (int step = 0; step < 3; ++step) {
+                writer.AddField("rho", rho);
+                writer.AddField("p", p);
+                writer.AddField("velocity", v);
+                writer.Write(step, x);
+
+                // The solver may overwrite the fields right away
+                Kokkos::deep_copy(rho, -1.0);
+                Kokkos::parallel_for(
+                    "UpdateFields", N,
+                    KOKKOS_LAMBDA(const int i) { rho(i) = 1.0 + i; });
+            }
+            writer.Wait();
+            EXPECT_EQ(writer.PVTUFile(2), prefix + "_2.pvtu");
+        }
+
+        PVTUReader pvtu(prefix + "_2.pvtu");
+        ASSERT_EQ(pvtu.NumPieces(), 1u);
+        EXPECT_EQ(pvtu.PointDataNames(),
+                  (std::vector<std::string>{"rho", "p", "velocity"}));
+        const auto pieces = pvtu.Open(0, 1);
+        const VTUReader& piece = pieces[0];
+        ASSERT_EQ(piece.NumPoints(), static_cast<std::size_t>(N));
+        EXPECT_EQ(piece.Array("p").type, "Float32");
+        EXPECT_EQ(piece.Array("velocity").n_components, 3);
+
+        auto host_x = Kokkos::create_mirror_view_and_copy(
+            Kokkos::HostSpace(), piece.ReadPoints());
+        auto host_rho = Kokkos::create_mirror_view_and_copy(
+            Kokkos::HostSpace(), piece.ReadPointData("rho"));
+        auto host_p = Kokkos::create_mirror_view_and_copy(
+            Kokkos::HostSpace(), piece.ReadPointData<float>("p"));
+        Kokkos::View<double* [3]> velocity("velocity", N);
+        piece.Read("velocity", velocity);
+        auto host_v =
+            Kokkos::create_mirror_view_and_copy(Kokkos::HostSpace(), velocity);
+        for (int i = 0; i < N; ++i) {
+            EXPECT_EQ(host_rho(i), 1.0 + i);
+            EXPECT_EQ(host_p(i), 0.5f * i);
+            for (int d = 0; d < 3; ++d) {
+                EXPECT_EQ(host_x(i, d), i + 0.1 * d);
+                EXPECT_EQ(host_v(i, d), -i - 0.1 * d);
+            }
+        }
+    }
+    Kokkos::finalize();
+    MPI_Finalize();
+}
@@ -0,0 +1,101 @@
+#include <gtest/gtest.h>
+#include "device_arena.hpp"
+#include <Kokkos_Core.hpp>
+
+#include <cstdint>
+#include <sstream>
+
+// Test DeviceArena
+TEST(DeviceArenaTest, SteadyStateSteps) {
+    Kokkos::initialize();
+    {
+        EXPECT_EQ(DeviceArena::AlignUp(0), 0u);
+        EXPECT_EQ(DeviceArena::AlignUp(1), DeviceArena::alignment);
+        EXPECT_EQ(DeviceArena::AlignUp(256), 256u);
+
+        const int N = 1000;
+        const std::size_t step_bytes =
+            DeviceArena::AlignUp(N * sizeof(int)) +
+            DeviceArena::AlignUp(3 * N * sizeof(double)) +
+            DeviceArena::AlignUp(N * sizeof(std::uint64_t));
+
+        // The first step overflows the empty arena, the reset regrows it to
+        // the high-water mark and the next steps no longer allocate
+        DeviceArena arena;
+        for (int step = 0; step < 4; ++step) {
+            arena.Reset();
+            auto ids  = arena.Allocate<ArenaView<int*>>(N);
+            auto x    = arena.Allocate<ArenaView<double* [3]>>(N);
+            auto keys = arena.Allocate<ArenaView<std::uint64_t*>>(N);
+            EXPECT_EQ(x.extent(0), static_cast<std::size_t>(N));
+            EXPECT_EQ(reinterpret_cast<std::uintptr_t>(x.data()) %
+                          DeviceArena::alignment,
+                      0u);
+            EXPECT_EQ(arena.Used(), step_bytes);
+
+            // The views do not overlap
+            Kokkos::parallel_for(
+                "FillArenaViews", N, KOKKOS_LAMBDA(const int i) {
+                    ids(i)  = i;
+                    keys(i) = 2 * i;
+                    for (int d = 0; d < 3; ++d) x(i, d) = -1.0;
+                });
+            int errors = 0;
+            Kokkos::parallel_reduce(
+                "CheckArenaViews", N,
+                KOKKOS_LAMBDA(const int i, int& count) {
+                    if (ids(i) != i || keys(i) != 2u * i || x(i, 2) != -1.0) {
+                        ++count;
+                    }
+                },
+                errors);
+            EXPECT_EQ(errors, 0);
+        }
+        EXPECT_EQ(arena.HighWaterMark(), step_bytes);
+        EXPECT_EQ(arena.Capacity(), step_bytes);
+        EXPECT_EQ(arena.NumAllocations(), 4u);
+        EXPECT_EQ(arena.NumRequests(), 12u);
+
+        // A larger step grows the buffer once more
+        arena.Reset();
+        arena.AllocateBytes(2 * step_bytes);
+        arena.Reset();
+        EXPECT_EQ(arena.HighWaterMark(), 2 * step_bytes);
+        EXPECT_EQ(arena.Capacity(), 2 * step_bytes);
+        EXPECT_EQ(arena.NumAllocations(), 6u);
+
+        // Scopes hand their workspace back; without a reset, the outermost
+        // one regrows the buffer after an overflow
+        arena.Reset();
+        const std::size_t n_alloc = arena.NumAllocations();
+        {
+            const DeviceArena::Scope outer(arena);
+            arena.AllocateBytes(step_bytes);
+            {
+                const DeviceArena::Scope inner(arena);
+                arena.AllocateBytes(step_bytes);
+                EXPECT_EQ(arena.Used(), 2 * step_bytes);
+            }
+            EXPECT_EQ(arena.Used(), step_bytes);
+            arena.AllocateBytes(2 * step_bytes);
+            EXPECT_EQ(arena.NumAllocations(), n_alloc + 1);
+        }
+        EXPECT_EQ(arena.Used(), 0u);
+        EXPECT_EQ(arena.Capacity(), 3 * step_bytes);
+        EXPECT_EQ(arena.NumAllocations(), n_alloc + 2);
+        {
+            const DeviceArena::Scope scope(arena);
+            arena.AllocateBytes(3 * step_bytes);
+        }
+        EXPECT_EQ(arena.NumAllocations(), n_alloc + 2);
+
+        std::ostringstream report;
+        arena.Print(report);
+        EXPECT_NE(report.str().find("high-water mark"), std::string::npos);
+
+        arena.Release();
+        EXPECT_EQ(arena.Capacity(), 0u);
+        EXPECT_EQ(&DeviceArena::Global(), &DeviceArena::Global());
+    }
+    Kokkos::finalize();
+}
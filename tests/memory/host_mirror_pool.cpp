@@ -0,0 +1,46 @@
+#include <gtest/gtest.h>
+#include "host_mirror_pool.hpp"
+#include <Kokkos_Core.hpp>
+
+// Test HostMirrorPool
+TEST(HostMirrorPoolTest, SteadyStateReuse) {
+    Kokkos::initialize();
+    {
+        EXPECT_EQ(HostMirrorPool::SizeClass(1), 8);
+        EXPECT_EQ(HostMirrorPool::SizeClass(256), 8);
+        EXPECT_EQ(HostMirrorPool::SizeClass(257), 9);
+
+        HostMirrorPool pool;
+        Kokkos::View<double*> rho("rho", 100);
+        Kokkos::View<double* [3], Kokkos::LayoutLeft> x("x", 100);
+        Kokkos::deep_copy(rho, 2.0);
+
+        // Every visit borrows the same sizes: only the first one allocates
+        for (int visit = 0; visit < 5; ++visit) {
+            auto host_rho = pool.Mirror(rho);
+            auto host_x   = pool.Mirror(x);
+            EXPECT_EQ(host_rho.view.extent(0), 100u);
+            EXPECT_EQ(host_x.view.extent(1), 3u);
+            EXPECT_GE(host_x.block.Bytes(), 300 * sizeof(double));
+            EXPECT_EQ(pool.NumBorrowed(), 2u);
+            Kokkos::deep_copy(host_rho.view, rho);
+            EXPECT_DOUBLE_EQ(host_rho.view(99), 2.0);
+        }
+        EXPECT_EQ(pool.NumAllocations(), 2u);
+        EXPECT_EQ(pool.NumBorrowed(), 0u);
+
+        // Requests of the same size class share the buffers
+        {
+            auto block = pool.Acquire(400 * sizeof(double));
+            EXPECT_EQ(pool.NumAllocations(), 2u);
+            auto moved = std::move(block);
+            EXPECT_EQ(block.Data(), nullptr);
+            EXPECT_EQ(pool.NumBorrowed(), 1u);
+        }
+        EXPECT_EQ(pool.NumBorrowed(), 0u);
+        pool.Release();
+        auto block = pool.Acquire(16);
+        EXPECT_EQ(pool.NumAllocations(), 3u);
+    }
+    Kokkos::finalize();
+}
@@ -0,0 +1,87 @@
+#include <gtest/gtest.h>
+#include "halo_exchange.hpp"
+#include <Kokkos_Core.hpp>
+#include <mpi.h>
+
+#include "particle_data.hpp"
+
+// Test HaloExchange
+TEST(HaloExchangeTest, SlabGhosts) {
+    MPI_Init(nullptr, nullptr);
+    Kokkos::initialize();
+    {
+        int rank, size;
+        MPI_Comm_rank(MPI_COMM_WORLD, &rank);
+        MPI_Comm_size(MPI_COMM_WORLD, &size);
+        EXPECT_THROW(HaloExchange(0.0), std::invalid_argument);
+
+        // Each rank owns a 5 x 5 x 5 lattice (spacing 0.2) in [rank, rank + 1)
+        const int N = 125;
+        ParticleData<> particles(N);
+        auto x       = particles.X();
+        auto part_id = particles.PartId();
+        auto rho     = particles.Rho();
+        Kokkos::parallel_for(
+            "InitializeParticles", N, KOKKOS_LAMBDA(const int i) {
+                x(i, 0)    = rank + 0.2 * (i % 5);
+                x(i, 1)    = 0.2 * ((i / 5) % 5);
+                x(i, 2)    = 0.2 * (i / 25);
+                part_id(i) = rank * N + i;
+                rho(i)     = 1000.0 + rank;
+            });
+
+        // The slabs are 0.2 apart: only the adjacent ranks are peers
+        HaloExchange halo(0.25);
+        halo.Build(particles);
+        const int n_peers = (rank > 0) + (rank < size - 1);
+        EXPECT_EQ(static_cast<int>(halo.Peers().size()), n_peers);
+        EXPECT_EQ(halo.Boundary().extent(0) + halo.Interior().extent(0), N);
+        EXPECT_EQ(static_cast<int>(halo.Boundary().extent(0)),
+                  25 * n_peers);
+
+        // Interior work overlaps with the messages
+        halo.Begin(particles);
+        EXPECT_EQ(particles.Size(), N + halo.NumGhosts());
+        EXPECT_EQ(static_cast<int>(halo.NumGhosts()), 25 * n_peers);
+        rho                 = particles.Rho();
+        const auto interior = halo.Interior();
+        Kokkos::parallel_for(
+            "InteriorWork", interior.extent(0),
+            KOKKOS_LAMBDA(const int k) { rho(interior(k)) += 1.0; });
+        halo.End(particles);
+
+        x            = particles.X();
+        part_id      = particles.PartId();
+        auto host_x  = Kokkos::create_mirror_view(x);
+        auto host_id = Kokkos::create_mirror_view(part_id);
+        auto host_rho = Kokkos::create_mirror_view(rho);
+        Kokkos::deep_copy(host_x, x);
+        Kokkos::deep_copy(host_id, part_id);
+        Kokkos::deep_copy(host_rho, rho);
+        for (std::size_t g = N; g < particles.Size(); ++g) {
+            const int source = host_id(g) / N;
+            EXPECT_EQ(std::abs(source - rank), 1);
+            EXPECT_NEAR(host_x(g, 0), source + 0.2 * (host_id(g) % N % 5),
+                        1e-12);
+            EXPECT_LT(std::abs(host_x(g, 0) - (rank + 0.4)), 0.8);
+            // Ghosts are boundary particles: untouched by the interior work
+            EXPECT_DOUBLE_EQ(host_rho(g), 1000.0 + source);
+        }
+
+        // A second exchange replaces the ghosts
+        halo.Exchange(particles);
+        EXPECT_EQ(particles.Size(), N + halo.NumGhosts());
+        halo.RemoveGhosts(particles);
+        EXPECT_EQ(particles.Size(), N);
+
+        // Ghost packing on a dedicated execution space instance
+        const auto instances = Kokkos::Experimental::partition_space(
+            Kokkos::DefaultExecutionSpace(), std::vector<int>{1, 1});
+        HaloExchange stream_halo(0.25, MPI_COMM_WORLD, instances[1]);
+        stream_halo.Build(particles);
+        stream_halo.Exchange(particles);
+        EXPECT_EQ(stream_halo.NumGhosts(), halo.NumGhosts());
+    }
+    Kokkos::finalize();
+    MPI_Finalize();
+}
@@ -0,0 +1,60 @@
+#include <gtest/gtest.h>
+#include "load_balancer.hpp"
+#include <Kokkos_Core.hpp>
+#include <mpi.h>
+
+#include "particle_data.hpp"
+
+// Test LoadBalancer
+TEST(LoadBalancerTest, Rebalance) {
+    MPI_Init(nullptr, nullptr);
+    Kokkos::initialize();
+    {
+        int rank, size;
+        MPI_Comm_rank(MPI_COMM_WORLD, &rank);
+        MPI_Comm_size(MPI_COMM_WORLD, &size);
+        EXPECT_THROW(LoadBalancer(0.9), std::invalid_argument);
+        EXPECT_THROW(LoadBalancer(1.2, 0), std::invalid_argument);
+
+        // Rank r holds 200 (r + 1) scattered particles of the slab [r, r + 1)
+        const int N = 200 * (rank + 1);
+        ParticleData<> particles(N);
+        auto x       = particles.X();
+        auto part_id = particles.PartId();
+        Kokkos::parallel_for(
+            "InitializeParticles", N, KOKKOS_LAMBDA(const int i) {
+                const double t = i + 0.5;
+                x(i, 0) = rank + t * 0.6180339887 - int(t * 0.6180339887);
+                x(i, 1) = t * 0.4142135623 - int(t * 0.4142135623);
+                x(i, 2) = t * 0.7320508075 - int(t * 0.7320508075);
+                part_id(i) = i;
+            });
+
+        long n_total = 0;
+        long n_local = N;
+        MPI_Allreduce(&n_local, &n_total, 1, MPI_LONG, MPI_SUM,
+                      MPI_COMM_WORLD);
+
+        LoadBalancer balancer(1.1, 2);
+        EXPECT_NEAR(balancer.Imbalance(N), 2.0 * size / (size + 1), 1e-12);
+        // Off-cadence steps are skipped
+        EXPECT_FALSE(balancer.Update(3, particles, double(N)));
+        EXPECT_EQ(balancer.Update(4, particles, double(N)), size > 1);
+        EXPECT_EQ(balancer.NumRebalances(), size > 1 ? 1 : 0);
+
+        n_local = particles.Size();
+        long n_after = 0;
+        MPI_Allreduce(&n_local, &n_after, 1, MPI_LONG, MPI_SUM,
+                      MPI_COMM_WORLD);
+        EXPECT_EQ(n_after, n_total);
+        EXPECT_LT(balancer.Imbalance(double(particles.Size())), 1.1);
+
+        // Balanced per-particle weights do not trigger a migration
+        Kokkos::View<double*> weights("weights", particles.Size());
+        Kokkos::deep_copy(weights, 1.0);
+        EXPECT_FALSE(balancer.Update(6, particles, weights));
+        EXPECT_LT(balancer.LastImbalance(), 1.1);
+    }
+    Kokkos::finalize();
+    MPI_Finalize();
+}
@@ -0,0 +1,70 @@
+#include <gtest/gtest.h>
+#include "material_sort.hpp"
+#include "eos_linear_gas.hpp"
+#include <Kokkos_Core.hpp>
+
+// Test MaterialSort
+TEST(MaterialSortTest, BuildRange) {
+    Kokkos::initialize();
+    {
+        const int N        = 6;
+        const int host_m[] = {1, 0, 2, 1, 0, 1};
+        Kokkos::View<int*> material_id("material_id", N);
+        Kokkos::View<double*> rho("rho", N);
+        auto host_material_id = Kokkos::create_mirror_view(material_id);
+        auto host_rho         = Kokkos::create_mirror_view(rho);
+        for (int i = 0; i < N; ++i) {
+            host_material_id(i) = host_m[i];
+            host_rho(i)         = 1.0 + i;
+        }
+        Kokkos::deep_copy(material_id, host_material_id);
+        Kokkos::deep_copy(rho, host_rho);
+
+        MaterialSort sort;
+        sort.Build(material_id, 3);
+        EXPECT_EQ(sort.NumMaterials(), 3);
+        EXPECT_EQ(sort.Range(0).first, 0);
+        EXPECT_EQ(sort.Range(0).second, 2);
+        EXPECT_EQ(sort.Range(1).first, 2);
+        EXPECT_EQ(sort.Range(1).second, 5);
+        EXPECT_EQ(sort.Range(2).first, 5);
+        EXPECT_EQ(sort.Range(2).second, 6);
+
+        sort.Permutation().Apply(material_id);
+        sort.Permutation().Apply(rho);
+        Kokkos::deep_copy(host_material_id, material_id);
+        Kokkos::deep_copy(host_rho, rho);
+
+        // Stable ordering: 0 0 1 1 1 2 with original indices 1 4 0 3 5 2
+        const int expected[] = {1, 4, 0, 3, 5, 2};
+        for (int i = 0; i < N; ++i) {
+            EXPECT_EQ(host_material_id(i), host_m[expected[i]]);
+            EXPECT_DOUBLE_EQ(host_rho(i), 1.0 + expected[i]);
+        }
+
+        // EOS evaluation on a contiguous material subview
+        Kokkos::View<double*> eint("eint", N);
+        Kokkos::View<double*> p("p", N);
+        Kokkos::View<double*> sos("sos", N);
+        Kokkos::deep_copy(eint, 2.0);
+        const auto range = sort.Range(1);
+        EOSLinearGas eos(1, 1.4, 1e-6);
+        eos.PressureSoSImpl(Kokkos::subview(rho, range),
+                            Kokkos::subview(eint, range),
+                            Kokkos::subview(p, range),
+                            Kokkos::subview(sos, range));
+
+        // Back to the original ordering for output
+        sort.Permutation().Revert(p);
+        auto host_p = Kokkos::create_mirror_view(p);
+        Kokkos::deep_copy(host_p, p);
+        for (int i = 0; i < N; ++i) {
+            const double expected_p = host_m[i] == 1 ? 0.8 * (1.0 + i) : 0.0;
+            EXPECT_NEAR(host_p(i), expected_p, 1e-8);
+        }
+
+        // Out-of-range material ids are rejected
+        EXPECT_THROW(sort.Build(material_id, 2), std::invalid_argument);
+    }
+    Kokkos::finalize();
+}
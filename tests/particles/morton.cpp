@@ -0,0 +1,62 @@
+#include <gtest/gtest.h>
+#include "morton.hpp"
+#include <Kokkos_Core.hpp>
+
+// Reference bit interleaving
+static std::uint64_t NaiveInterleave(std::uint32_t ix, std::uint32_t iy,
+                                     std::uint32_t iz) {
+    std::uint64_t key = 0;
+    for (int b = 0; b < MortonEncoder::bits; ++b) {
+        key |= static_cast<std::uint64_t>((ix >> b) & 1u) << (3 * b);
+        key |= static_cast<std::uint64_t>((iy >> b) & 1u) << (3 * b + 1);
+        key |= static_cast<std::uint64_t>((iz >> b) & 1u) << (3 * b + 2);
+    }
+    return key;
+}
+
+// Test MortonEncoder
+TEST(MortonEncoderTest, Keys) {
+    Kokkos::initialize();
+    {
+        const std::uint32_t samples[] = {0u, 1u, 2u, 5u, 1023u, 123456u,
+                                         0x1fffffu};
+        for (auto ix : samples) {
+            for (auto iy : samples) {
+                for (auto iz : samples) {
+                    EXPECT_EQ(MortonEncoder::Interleave(ix, iy, iz),
+                              NaiveInterleave(ix, iy, iz));
+                }
+            }
+        }
+
+        Kokkos::View<double* [3]> x("x", 3);
+        auto host_x  = Kokkos::create_mirror_view(x);
+        host_x(0, 0) = 0.0;
+        host_x(0, 1) = 0.0;
+        host_x(0, 2) = 0.0;
+        host_x(1, 0) = 2.0;
+        host_x(1, 1) = 1.0;
+        host_x(1, 2) = 0.5;
+        host_x(2, 0) = 1.0;
+        host_x(2, 1) = 1.0;
+        host_x(2, 2) = 1.0;
+        Kokkos::deep_copy(x, host_x);
+
+        const BoundingBox box = BoundingBox::Of(x);
+        EXPECT_DOUBLE_EQ(box.lo[0], 0.0);
+        EXPECT_DOUBLE_EQ(box.hi[0], 2.0);
+        EXPECT_DOUBLE_EQ(box.hi[2], 1.0);
+
+        MortonEncoder encoder(box);
+        Kokkos::View<std::uint64_t*> keys("keys", 3);
+        encoder.Keys(x, keys);
+        auto host_keys = Kokkos::create_mirror_view(keys);
+        Kokkos::deep_copy(host_keys, keys);
+        EXPECT_EQ(host_keys(0), 0u);
+        // Largest coordinate maps to the last lattice cell
+        EXPECT_EQ(encoder.Quantize(2.0, 0), (1u << MortonEncoder::bits) - 1);
+        EXPECT_EQ(host_keys(2), encoder(1.0, 1.0, 1.0));
+        EXPECT_LT(host_keys(2), host_keys(1));
+    }
+    Kokkos::finalize();
+}
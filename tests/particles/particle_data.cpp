@@ -0,0 +1,145 @@
+#include <gtest/gtest.h>
+#include "particle_data.hpp"
+#include "eos_lazy.hpp"
+#include "eos_multi_material.hpp"
+#include <Kokkos_Core.hpp>
+
+// Test ParticleData
+TEST(ParticleDataTest, GrowCompactPermute) {
+    Kokkos::initialize();
+    {
+        ParticleData<> particles(4);
+        EXPECT_EQ(particles.Size(), 4);
+        EXPECT_EQ(particles.X().extent(0), 4);
+        EXPECT_THROW(ParticleData<>(0, 1.0), std::invalid_argument);
+
+        auto rho      = particles.Rho();
+        auto host_rho = Kokkos::create_mirror_view(rho);
+        for (int i = 0; i < 4; ++i) host_rho(i) = 10.0 * i;
+        Kokkos::deep_copy(rho, host_rho);
+
+        // Appending one particle at a time reallocates a few times only
+        int n_reallocations = 0;
+        for (int i = 0; i < 1000; ++i) {
+            const std::size_t capacity = particles.Capacity();
+            EXPECT_EQ(particles.Add(1), 4 + i);
+            n_reallocations += particles.Capacity() != capacity;
+        }
+        EXPECT_EQ(particles.Size(), 1004);
+        EXPECT_LT(n_reallocations, 20);
+
+        // Growth keeps the existing particles
+        rho      = particles.Rho();
+        host_rho = Kokkos::create_mirror_view(rho);
+        Kokkos::deep_copy(host_rho, rho);
+        for (int i = 0; i < 4; ++i) EXPECT_DOUBLE_EQ(host_rho(i), 10.0 * i);
+
+        // Compact keeps the even particles, in order
+        particles.Resize(6);
+        Kokkos::View<int*> keep("keep", 6);
+        auto host_keep = Kokkos::create_mirror_view(keep);
+        rho            = particles.Rho();
+        host_rho       = Kokkos::create_mirror_view(rho);
+        auto x         = particles.X();
+        auto host_x    = Kokkos::create_mirror_view(x);
+        for (int i = 0; i < 6; ++i) {
+            host_keep(i) = i % 2 == 0;
+            host_rho(i)  = 10.0 * i;
+            for (int d = 0; d < 3; ++d) host_x(i, d) = i + 0.1 * d;
+        }
+        Kokkos::deep_copy(keep, host_keep);
+        Kokkos::deep_copy(rho, host_rho);
+        Kokkos::deep_copy(x, host_x);
+        particles.Compact(keep);
+        EXPECT_EQ(particles.Size(), 3);
+        rho      = particles.Rho();
+        host_rho = Kokkos::create_mirror_view(rho);
+        x        = particles.X();
+        host_x   = Kokkos::create_mirror_view(x);
+        Kokkos::deep_copy(host_rho, rho);
+        Kokkos::deep_copy(host_x, x);
+        for (int i = 0; i < 3; ++i) {
+            EXPECT_DOUBLE_EQ(host_rho(i), 20.0 * i);
+            EXPECT_DOUBLE_EQ(host_x(i, 2), 2 * i + 0.2);
+        }
+
+        // Apply and Revert reorder every field consistently
+        Kokkos::View<int*> permute("permute", 3);
+        auto host_permute = Kokkos::create_mirror_view(permute);
+        host_permute(0)   = 2;
+        host_permute(1)   = 0;
+        host_permute(2)   = 1;
+        Kokkos::deep_copy(permute, host_permute);
+        ParticlePermutation perm(permute);
+        particles.Apply(perm);
+        Kokkos::deep_copy(host_rho, rho);
+        Kokkos::deep_copy(host_x, x);
+        for (int i = 0; i < 3; ++i) {
+            EXPECT_DOUBLE_EQ(host_rho(i), 20.0 * host_permute(i));
+            EXPECT_DOUBLE_EQ(host_x(i, 0), 2 * host_permute(i));
+        }
+        particles.Revert(perm);
+        Kokkos::deep_copy(host_rho, rho);
+        for (int i = 0; i < 3; ++i) EXPECT_DOUBLE_EQ(host_rho(i), 20.0 * i);
+
+        // Column-major vectors and single precision derived fields
+        ParticleData<Kokkos::LayoutLeft, float> soa(3);
+        soa.Reserve(8);
+        Kokkos::View<double* [3], Kokkos::LayoutLeft> packed("packed", 3);
+        auto host_packed = Kokkos::create_mirror_view(packed);
+        for (int i = 0; i < 3; ++i) {
+            for (int d = 0; d < 3; ++d) host_packed(i, d) = i + 0.1 * d;
+        }
+        Kokkos::deep_copy(packed, host_packed);
+        Kokkos::deep_copy(soa.V(), packed);
+        soa.Add(1);
+        EXPECT_EQ(soa.Capacity(), 8);
+        Kokkos::deep_copy(host_packed, 0.0);
+        const auto first = Kokkos::make_pair(0, 3);
+        Kokkos::deep_copy(packed, Kokkos::subview(soa.V(), first, Kokkos::ALL));
+        Kokkos::deep_copy(host_packed, packed);
+        EXPECT_DOUBLE_EQ(host_packed(2, 1), 2.1);
+
+        std::vector<EOSVariant> eos_vector;
+        eos_vector.emplace_back(EOSLinearGas(0, 1.4, 1e-6));
+        EOSMultiMaterial eos(eos_vector);
+        Kokkos::deep_copy(soa.Rho(), 2.0);
+        Kokkos::deep_copy(soa.Eint(), 0.5);
+        Kokkos::deep_copy(soa.EOSId(), 0);
+        eos.PressureSoS(soa);
+        auto host_p = Kokkos::create_mirror_view(soa.P());
+        Kokkos::deep_copy(host_p, soa.P());
+        EXPECT_FLOAT_EQ(host_p(3), 0.4f);
+
+        // A row reused after Compact is evaluated by the lazy EOS, even in
+        // the state of the removed particle
+        eos_vector.emplace_back(EOSLinearGas(1, 2.0, 1e-6));
+        EOSLazy lazy(EOSMultiMaterial(eos_vector), 1e-3);
+        ParticleData<> reused(3);
+        Kokkos::deep_copy(reused.Rho(), 1.0);
+        Kokkos::deep_copy(reused.Eint(), 1.0);
+        Kokkos::deep_copy(reused.EOSId(), 0);
+        EXPECT_EQ(lazy.PressureSoS(reused), 3u);
+        Kokkos::View<int*> keep_first("keep_first", 3);
+        Kokkos::deep_copy(keep_first, 1);
+        Kokkos::deep_copy(Kokkos::subview(keep_first, 2), 0);
+        reused.Compact(keep_first);
+        EXPECT_EQ(reused.Add(1), 2u);
+        Kokkos::deep_copy(Kokkos::subview(reused.Rho(), 2), 1.0);
+        Kokkos::deep_copy(Kokkos::subview(reused.Eint(), 2), 1.0);
+        Kokkos::deep_copy(Kokkos::subview(reused.EOSId(), 2), 1);
+        EXPECT_EQ(lazy.PressureSoS(reused), 1u);
+        auto host_reused_p = Kokkos::create_mirror_view_and_copy(
+            Kokkos::HostSpace(), reused.P());
+        EXPECT_DOUBLE_EQ(host_reused_p(0), 0.4);
+        EXPECT_DOUBLE_EQ(host_reused_p(2), 1.0);
+        // Same after shrinking, which keeps the values of the removed rows
+        reused.Resize(2);
+        EXPECT_EQ(reused.Add(1), 2u);
+        Kokkos::deep_copy(Kokkos::subview(reused.EOSId(), 2), 0);
+        EXPECT_EQ(lazy.PressureSoS(reused), 1u);
+        Kokkos::deep_copy(host_reused_p, reused.P());
+        EXPECT_DOUBLE_EQ(host_reused_p(2), 0.4);
+    }
+    Kokkos::finalize();
+}
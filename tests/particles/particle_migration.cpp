@@ -0,0 +1,68 @@
+#include <gtest/gtest.h>
+#include "particle_migration.hpp"
+#include <Kokkos_Core.hpp>
+#include <mpi.h>
+
+#include <vector>
+
+#include "particle_data.hpp"
+
+// Test ParticleMigration
+TEST(ParticleMigrationTest, RoundRobin) {
+    MPI_Init(nullptr, nullptr);
+    Kokkos::initialize();
+    {
+        int rank, size;
+        MPI_Comm_rank(MPI_COMM_WORLD, &rank);
+        MPI_Comm_size(MPI_COMM_WORLD, &size);
+
+        // Particle i of each rank goes to rank i % size
+        const int N = 12 * size;
+        ParticleData<Kokkos::LayoutLeft, float> particles(N);
+        auto x       = particles.X();
+        auto p       = particles.P();
+        auto part_id = particles.PartId();
+        Kokkos::View<int*> owner("owner", N);
+        Kokkos::parallel_for(
+            "InitializeParticles", N, KOKKOS_LAMBDA(const int i) {
+                part_id(i) = rank * N + i;
+                p(i)       = 0.5f * (rank * N + i);
+                for (int d = 0; d < 3; ++d) x(i, d) = rank * N + i + 0.1 * d;
+                owner(i) = i % size;
+            });
+
+        ParticleMigration migration;
+        EXPECT_THROW(migration.Migrate(particles, Kokkos::View<int*>("o", 1)),
+                     std::invalid_argument);
+        EXPECT_EQ(migration.Migrate(particles, owner), N);
+
+        x            = particles.X();
+        p            = particles.P();
+        part_id      = particles.PartId();
+        auto host_x  = Kokkos::create_mirror_view(x);
+        auto host_p  = Kokkos::create_mirror_view(p);
+        auto host_id = Kokkos::create_mirror_view(part_id);
+        Kokkos::deep_copy(host_x, x);
+        Kokkos::deep_copy(host_p, p);
+        Kokkos::deep_copy(host_id, part_id);
+        // Kept particles first, then grouped by source rank, in order
+        std::vector<int> expected;
+        for (int i = rank; i < N; i += size) expected.push_back(rank * N + i);
+        for (int source = 0; source < size; ++source) {
+            if (source == rank) continue;
+            for (int i = rank; i < N; i += size) {
+                expected.push_back(source * N + i);
+            }
+        }
+        for (int i = 0; i < N; ++i) {
+            const int id = host_id(i);
+            EXPECT_EQ(id, expected[i]);
+            EXPECT_FLOAT_EQ(host_p(i), 0.5f * id);
+            for (int d = 0; d < 3; ++d) {
+                EXPECT_DOUBLE_EQ(host_x(i, d), id + 0.1 * d);
+            }
+        }
+    }
+    Kokkos::finalize();
+    MPI_Finalize();
+}
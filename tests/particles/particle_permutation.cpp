@@ -0,0 +1,56 @@
+#include <gtest/gtest.h>
+#include "particle_permutation.hpp"
+#include <Kokkos_Core.hpp>
+
+// Test ParticlePermutation
+TEST(ParticlePermutationTest, ApplyRevertCompose) {
+    Kokkos::initialize();
+    {
+        const int N = 4;
+        Kokkos::View<int*> permute("permute", N);
+        auto host_permute = Kokkos::create_mirror_view(permute);
+        host_permute(0)   = 2;
+        host_permute(1)   = 0;
+        host_permute(2)   = 3;
+        host_permute(3)   = 1;
+        Kokkos::deep_copy(permute, host_permute);
+
+        ParticlePermutation perm(permute);
+        EXPECT_EQ(perm.Size(), N);
+
+        Kokkos::View<double*> rho("rho", N);
+        Kokkos::View<double* [3]> x("x", N);
+        auto host_rho = Kokkos::create_mirror_view(rho);
+        auto host_x   = Kokkos::create_mirror_view(x);
+        for (int i = 0; i < N; ++i) {
+            host_rho(i) = 10.0 * i;
+            for (int d = 0; d < 3; ++d) host_x(i, d) = i + 0.1 * d;
+        }
+        Kokkos::deep_copy(rho, host_rho);
+        Kokkos::deep_copy(x, host_x);
+
+        perm.Apply(rho);
+        perm.Apply(x);
+        Kokkos::deep_copy(host_rho, rho);
+        Kokkos::deep_copy(host_x, x);
+        for (int i = 0; i < N; ++i) {
+            EXPECT_DOUBLE_EQ(host_rho(i), 10.0 * host_permute(i));
+            EXPECT_DOUBLE_EQ(host_x(i, 2), host_permute(i) + 0.2);
+        }
+
+        // Applying the same permutation twice is undone by the composition
+        perm.Apply(rho);
+        perm.Compose(perm).Revert(rho);
+        Kokkos::deep_copy(host_rho, rho);
+        for (int i = 0; i < N; ++i) {
+            EXPECT_DOUBLE_EQ(host_rho(i), 10.0 * i);
+        }
+
+        perm.Revert(x);
+        Kokkos::deep_copy(host_x, x);
+        for (int i = 0; i < N; ++i) {
+            EXPECT_DOUBLE_EQ(host_x(i, 1), i + 0.1);
+        }
+    }
+    Kokkos::finalize();
+}
@@ -0,0 +1,58 @@
+#include <gtest/gtest.h>
+#include "sfc_ordering.hpp"
+#include <Kokkos_Core.hpp>
+
+// Test SFCOrdering
+TEST(SFCOrderingTest, Build) {
+    Kokkos::initialize();
+    {
+        // 4x4x4 lattice stored in reverse lexicographic order
+        const int n = 4;
+        const int N = n * n * n;
+        Kokkos::View<double* [3]> x("x", N);
+        Kokkos::View<double*> id("id", N);
+        auto host_x  = Kokkos::create_mirror_view(x);
+        auto host_id = Kokkos::create_mirror_view(id);
+        for (int p = 0; p < N; ++p) {
+            const int q  = N - 1 - p;
+            host_x(p, 0) = q % n;
+            host_x(p, 1) = (q / n) % n;
+            host_x(p, 2) = q / (n * n);
+            host_id(p)   = p;
+        }
+        Kokkos::deep_copy(x, host_x);
+        Kokkos::deep_copy(id, host_id);
+
+        SFCOrdering ordering(10);
+        EXPECT_TRUE(ordering.IsDue(0));
+        EXPECT_FALSE(ordering.IsDue(5));
+        EXPECT_TRUE(ordering.IsDue(20));
+
+        const auto permutation = ordering.Build(x);
+        permutation.Apply(x, id);
+
+        auto host_keys = Kokkos::create_mirror_view_and_copy(
+            Kokkos::HostSpace(), ordering.Keys());
+        Kokkos::deep_copy(host_x, x);
+        Kokkos::deep_copy(host_id, id);
+        for (int p = 1; p < N; ++p) {
+            EXPECT_LE(host_keys(p - 1), host_keys(p));
+        }
+        for (int p = 0; p < N; ++p) {
+            EXPECT_EQ(ordering.Encoder()(host_x(p, 0), host_x(p, 1),
+                                         host_x(p, 2)),
+                      host_keys(p));
+        }
+        // The first octant (2x2x2 block) comes first along the curve
+        for (int p = 0; p < 8; ++p) {
+            EXPECT_LT(host_x(p, 0), 2.0);
+            EXPECT_LT(host_x(p, 1), 2.0);
+            EXPECT_LT(host_x(p, 2), 2.0);
+        }
+
+        permutation.Revert(id);
+        Kokkos::deep_copy(host_id, id);
+        for (int p = 0; p < N; ++p) EXPECT_DOUBLE_EQ(host_id(p), p);
+    }
+    Kokkos::finalize();
+}
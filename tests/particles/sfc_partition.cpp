@@ -0,0 +1,60 @@
+#include <gtest/gtest.h>
+#include "sfc_partition.hpp"
+#include <Kokkos_Core.hpp>
+#include <mpi.h>
+
+// Test SFCPartition
+TEST(SFCPartitionTest, Build) {
+    MPI_Init(nullptr, nullptr);
+    Kokkos::initialize();
+    {
+        const int N = 1000;
+        Kokkos::View<double* [3]> x("x", N);
+        Kokkos::parallel_for(
+            "InitializePositions", N, KOKKOS_LAMBDA(const int i) {
+                x(i, 0) = (i % 10) * 0.1;
+                x(i, 1) = ((i / 10) % 10) * 0.1;
+                x(i, 2) = (i / 100) * 0.1;
+            });
+
+        const BoundingBox box = SFCPartition::GlobalBox(x, MPI_COMM_WORLD);
+        EXPECT_DOUBLE_EQ(box.lo[0], 0.0);
+        EXPECT_NEAR(box.hi[2], 0.9, 1e-12);
+
+        Kokkos::View<std::uint64_t*> keys("keys", N);
+        MortonEncoder(box).Keys(x, keys);
+
+        // Four parts with unit weights: balanced within one histogram bin
+        SFCPartition partition(MPI_COMM_WORLD, 4);
+        partition.Build(keys);
+        Kokkos::View<int*> owner("owner", N);
+        partition.Owners(keys, owner);
+        auto host_owner = Kokkos::create_mirror_view(owner);
+        Kokkos::deep_copy(host_owner, owner);
+        int counts[4] = {0, 0, 0, 0};
+        for (int i = 0; i < N; ++i) ++counts[host_owner(i)];
+        for (int r = 0; r < 4; ++r) EXPECT_EQ(counts[r], N / 4);
+
+        // Weighted: particles with x < 0.5 cost three times more
+        Kokkos::View<double*> weights("weights", N);
+        Kokkos::parallel_for(
+            "InitializeWeights", N, KOKKOS_LAMBDA(const int i) {
+                weights(i) = x(i, 0) < 0.45 ? 3.0 : 1.0;
+            });
+        SFCPartition weighted(MPI_COMM_WORLD, 2);
+        weighted.Build(keys, weights);
+        weighted.Owners(keys, owner);
+        Kokkos::deep_copy(host_owner, owner);
+        auto host_weights = Kokkos::create_mirror_view(weights);
+        Kokkos::deep_copy(host_weights, weights);
+        double load[2] = {0.0, 0.0};
+        for (int i = 0; i < N; ++i) load[host_owner(i)] += host_weights(i);
+        EXPECT_NEAR(load[0], load[1], 0.05 * (load[0] + load[1]));
+
+        const auto& splitters = weighted.HostSplitters();
+        EXPECT_EQ(splitters.size(), 3u);
+        EXPECT_EQ(splitters[0], 0u);
+    }
+    Kokkos::finalize();
+    MPI_Finalize();
+}
@@ -0,0 +1,44 @@
+#include <gtest/gtest.h>
+#include "profiler.hpp"
+#include <Kokkos_Core.hpp>
+
+#include "eos_multi_material.hpp"
+
+// Test Profiler
+TEST(ProfilerTest, NestedRegions) {
+    Kokkos::initialize();
+    {
+        Profiler profiler;
+        EXPECT_FALSE(profiler.Fence());
+        profiler.SetFence(true);
+        for (int step = 0; step < 3; ++step) {
+            ProfilingRegion outer("Forces", profiler);
+            {
+                ProfilingRegion inner("EOS", profiler);
+            }
+        }
+        const auto& entries = profiler.Entries();
+        ASSERT_EQ(entries.size(), 2u);
+        EXPECT_EQ(entries.at("Forces").calls, 3);
+        EXPECT_EQ(entries.at("EOS").calls, 3);
+        // The outer region includes the nested one
+        EXPECT_GE(entries.at("Forces").seconds, entries.at("EOS").seconds);
+        profiler.Reset();
+        EXPECT_TRUE(profiler.Entries().empty());
+
+        // The EOS kernels are recorded in the process-wide profiler
+        Profiler::Global().Reset();
+        const int N = 4;
+        Kokkos::View<double*> rho("rho", N), eint("eint", N), p("p", N),
+            sos("sos", N);
+        Kokkos::deep_copy(rho, 1.0);
+        Kokkos::deep_copy(eint, 1.0);
+        EOSLinearGas(3, 1.4, 1e-6).PressureSoSImpl(rho, eint, p, sos);
+        std::vector<EOSVariant> eos_vector{EOSLinearGas(0, 1.4, 0.0)};
+        EOSMultiMaterial eos(eos_vector);
+        Kokkos::View<int*> eos_id("eos_id", N);
+        eos.PressureSoS(eos_id, rho, eint, p, sos);
+        EXPECT_EQ(Profiler::Global().Entries().at("EOS").calls, 2);
+    }
+    Kokkos::finalize();
+}
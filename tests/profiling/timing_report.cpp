@@ -0,0 +1,58 @@
+#include <gtest/gtest.h>
+#include "timing_report.hpp"
+#include <Kokkos_Core.hpp>
+#include <mpi.h>
+
+#include <cstdio>
+#include <fstream>
+#include <iterator>
+#include <sstream>
+#include <string>
+
+// Test TimingReport
+TEST(TimingReportTest, ReduceOverRanks) {
+    MPI_Init(nullptr, nullptr);
+    Kokkos::initialize();
+    {
+        int rank, size;
+        MPI_Comm_rank(MPI_COMM_WORLD, &rank);
+        MPI_Comm_size(MPI_COMM_WORLD, &size);
+
+        // Rank r spends r + 1 seconds in "Forces"; only rank 0 does I/O
+        Profiler profiler;
+        profiler.Add("Forces", rank + 1.0);
+        profiler.Add("Forces", 0.0);
+        if (rank == 0) profiler.Add("IO", 2.0);
+
+        const TimingReport report(profiler, MPI_COMM_WORLD);
+        const auto& rows = report.Rows();
+        ASSERT_EQ(rows.size(), 2u);
+        EXPECT_EQ(rows[0].name, "Forces");
+        EXPECT_EQ(rows[0].calls, 2);
+        EXPECT_DOUBLE_EQ(rows[0].min, 1.0);
+        EXPECT_DOUBLE_EQ(rows[0].max, size);
+        EXPECT_DOUBLE_EQ(rows[0].avg, 0.5 * (size + 1));
+        EXPECT_EQ(rows[1].name, "IO");
+        EXPECT_DOUBLE_EQ(rows[1].min, size > 1 ? 0.0 : 2.0);
+        EXPECT_DOUBLE_EQ(rows[1].max, 2.0);
+
+        std::ostringstream table;
+        report.Print(table);
+        EXPECT_EQ(table.str().find("Forces") != std::string::npos, rank == 0);
+
+        const std::string json = "timing_report_test.json";
+        report.WriteJSON(json);
+        if (rank == 0) {
+            std::ifstream file(json);
+            const std::string text((std::istreambuf_iterator<char>(file)),
+                                   std::istreambuf_iterator<char>());
+            EXPECT_NE(text.find("\"ranks\": " + std::to_string(size)),
+                      std::string::npos);
+            EXPECT_NE(text.find("{\"name\": \"IO\", \"calls\": 1"),
+                      std::string::npos);
+            std::remove(json.c_str());
+        }
+    }
+    Kokkos::finalize();
+    MPI_Finalize();
+}
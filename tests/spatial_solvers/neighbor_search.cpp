@@ -0,0 +1,142 @@
+#include <gtest/gtest.h>
+#include "neighbor_search.hpp"
+#include <Kokkos_Core.hpp>
+
+#include <algorithm>
+#include <stdexcept>
+#include <vector>
+
+// Test NeighborSearch
+TEST(NeighborSearchTest, BuildQueryUpdate) {
+    Kokkos::initialize();
+    {
+        // Jittered 6x6x6 lattice
+        const int n    = 6;
+        const int N    = n * n * n;
+        const double h = 1.2;
+        Kokkos::View<double* [3]> x("x", N);
+        auto host_x = Kokkos::create_mirror_view(x);
+        for (int k = 0; k < n; ++k) {
+            for (int j = 0; j < n; ++j) {
+                for (int i = 0; i < n; ++i) {
+                    const int p  = i + n * (j + n * k);
+                    host_x(p, 0) = i + 0.1 * ((p * 7) % 5) / 5.0;
+                    host_x(p, 1) = j + 0.1 * ((p * 11) % 5) / 5.0;
+                    host_x(p, 2) = k - 0.1 * ((p * 13) % 5) / 5.0;
+                }
+            }
+        }
+        Kokkos::deep_copy(x, host_x);
+
+        // Brute-force reference with the same search radius
+        const double skin = 0.2;
+        const double r2   = (h + skin) * (h + skin);
+        std::vector<std::vector<int>> reference(N);
+        for (int p = 0; p < N; ++p) {
+            for (int q = 0; q < N; ++q) {
+                double d2 = 0.0;
+                for (int d = 0; d < 3; ++d) {
+                    d2 += (host_x(p, d) - host_x(q, d)) *
+                          (host_x(p, d) - host_x(q, d));
+                }
+                if (q != p && d2 < r2) reference[p].push_back(q);
+            }
+        }
+
+        for (const auto indexing :
+             {CellIndexing::UniformGrid, CellIndexing::SpatialHash}) {
+            NeighborSearch search(h, skin, 10, indexing);
+            EXPECT_THROW(search.HalfList(), std::runtime_error);
+            search.SetHalfList(true);
+            search.Build(x);
+
+            const auto list = search.List();
+            auto host_offsets =
+                Kokkos::create_mirror_view_and_copy(Kokkos::HostSpace(),
+                                                    list.offsets);
+            auto host_neighbors =
+                Kokkos::create_mirror_view_and_copy(Kokkos::HostSpace(),
+                                                    list.neighbors);
+            std::size_t n_pairs = 0;
+            for (int p = 0; p < N; ++p) {
+                std::vector<int> found(
+                    host_neighbors.data() + host_offsets(p),
+                    host_neighbors.data() + host_offsets(p + 1));
+                std::sort(found.begin(), found.end());
+                EXPECT_EQ(found, reference[p]);
+                n_pairs += reference[p].size();
+            }
+            EXPECT_EQ(search.NumPairs(), n_pairs);
+            EXPECT_EQ(search.NumBuilds(), 1);
+
+            // Half list: the neighbors j > i of the full list
+            const auto half = search.HalfList();
+            auto host_half_offsets = Kokkos::create_mirror_view_and_copy(
+                Kokkos::HostSpace(), half.offsets);
+            auto host_half_neighbors = Kokkos::create_mirror_view_and_copy(
+                Kokkos::HostSpace(), half.neighbors);
+            EXPECT_EQ(2 * host_half_offsets(N), n_pairs);
+            for (int p = 0; p < N; ++p) {
+                std::vector<int> found(
+                    host_half_neighbors.data() + host_half_offsets(p),
+                    host_half_neighbors.data() + host_half_offsets(p + 1));
+                std::vector<int> expected;
+                for (const int q : reference[p]) {
+                    if (q > p) expected.push_back(q);
+                }
+                std::sort(found.begin(), found.end());
+                EXPECT_EQ(found, expected);
+            }
+
+            // Cell lists: every particle once, in the cell of its position
+            if (indexing == CellIndexing::SpatialHash) {
+                EXPECT_THROW(search.Cells(), std::runtime_error);
+            } else {
+                const CellList cells = search.Cells();
+                auto host_cell_offsets = Kokkos::create_mirror_view_and_copy(
+                    Kokkos::HostSpace(), cells.offsets);
+                auto host_cell_particles = Kokkos::create_mirror_view_and_copy(
+                    Kokkos::HostSpace(), cells.particles);
+                const CellGrid& grid = cells.grid;
+                std::vector<int> seen(N, 0);
+                int max_occupancy = 0;
+                for (int c = 0; c < grid.n_cells; ++c) {
+                    int cx, cy, cz;
+                    grid.Coords(c, cx, cy, cz);
+                    EXPECT_EQ(grid.Index(cx, cy, cz), c);
+                    const auto b = host_cell_offsets(c);
+                    const auto e = host_cell_offsets(c + 1);
+                    max_occupancy = std::max(max_occupancy, int(e - b));
+                    for (auto k = b; k < e; ++k) {
+                        const int q = host_cell_particles(k);
+                        ++seen[q];
+                        EXPECT_EQ(grid.Coord(host_x(q, 0), 0), cx);
+                        EXPECT_EQ(grid.Coord(host_x(q, 2), 2), cz);
+                    }
+                }
+                EXPECT_EQ(seen, std::vector<int>(N, 1));
+                EXPECT_EQ(cells.max_occupancy, max_occupancy);
+            }
+            EXPECT_GE(search.BuildTime(), 0.0);
+            EXPECT_GE(search.QueryTime(), 0.0);
+
+            // Small displacement: the list is reused
+            EXPECT_FALSE(search.Update(x));
+            // Displacement beyond half the skin: the list is rebuilt
+            auto shifted_x = Kokkos::create_mirror(x);
+            Kokkos::deep_copy(shifted_x, host_x);
+            shifted_x(0, 0) += 0.15;
+            Kokkos::View<double* [3]> y("y", N);
+            Kokkos::deep_copy(y, shifted_x);
+            EXPECT_TRUE(search.Update(y));
+            EXPECT_EQ(search.NumBuilds(), 2);
+        }
+
+        // Rebuild cadence
+        NeighborSearch search(h, skin, 2);
+        search.Build(x);
+        EXPECT_FALSE(search.Update(x));
+        EXPECT_TRUE(search.Update(x));
+    }
+    Kokkos::finalize();
+}
@@ -0,0 +1,83 @@
+#include <gtest/gtest.h>
+#include "smoothing_length.hpp"
+#include <Kokkos_Core.hpp>
+
+#include <cmath>
+#include <stdexcept>
+
+#include "particle_data.hpp"
+
+// Test SmoothingLength
+TEST(SmoothingLengthTest, Solve) {
+    Kokkos::initialize();
+    {
+        // Unit-mass particles on an 8x8x8 unit lattice, h guessed too small
+        const int n = 8;
+        const int N = n * n * n;
+        ParticleData<> particles(N);
+        auto host_x = Kokkos::create_mirror_view(particles.X());
+        for (int k = 0; k < n; ++k) {
+            for (int j = 0; j < n; ++j) {
+                for (int i = 0; i < n; ++i) {
+                    const int q  = i + n * (j + n * k);
+                    host_x(q, 0) = i;
+                    host_x(q, 1) = j;
+                    host_x(q, 2) = k;
+                }
+            }
+        }
+        Kokkos::deep_copy(particles.X(), host_x);
+        Kokkos::deep_copy(particles.Mass(), 1.0);
+        Kokkos::deep_copy(particles.H(), 0.9);
+
+        // The list covers the support of the largest expected h
+        const double h_max = 2.0;
+        NeighborSearch search(CubicSplineKernel::support * h_max);
+        search.Build(particles.X());
+
+        EXPECT_THROW(SmoothingLength<>(0.0), std::invalid_argument);
+        EXPECT_THROW(SmoothingLength<>(1.2, 1e-4, 0), std::invalid_argument);
+        const double eta = 1.2;
+        SmoothingLength<> smoothing(eta, 1e-6);
+        Profiler::Global().Reset();
+        const int passes = smoothing.Solve(particles, search);
+        EXPECT_GT(passes, 1);
+        EXPECT_EQ(smoothing.NumUnconverged(), 0u);
+        // Compaction: the later passes only visit unconverged particles
+        EXPECT_LT(smoothing.NumEvaluations(),
+                  static_cast<std::size_t>(passes) * N);
+
+        // h and rho are consistent, interior densities close to one
+        auto host_h   = Kokkos::create_mirror_view_and_copy(
+            Kokkos::HostSpace(), particles.H());
+        auto host_rho = Kokkos::create_mirror_view_and_copy(
+            Kokkos::HostSpace(), particles.Rho());
+        for (int q = 0; q < N; ++q) {
+            EXPECT_LE(host_h(q), h_max);
+            if (host_h(q) < h_max) {
+                EXPECT_NEAR(host_h(q), eta * std::cbrt(1.0 / host_rho(q)),
+                            1e-4 * host_h(q));
+            }
+        }
+        const int center = n / 2 * (1 + n + n * n);
+        EXPECT_NEAR(host_rho(center), 1.0, 0.02);
+        EXPECT_GT(host_h(0), host_h(center));
+
+        // A converged state is confirmed in a single pass
+        EXPECT_EQ(smoothing.Solve(particles, search), 1);
+        EXPECT_EQ(smoothing.NumEvaluations(), static_cast<std::size_t>(N));
+
+        // The passes are reported in the profiling output
+        const auto& entries = Profiler::Global().Entries();
+        EXPECT_EQ(entries.at("SmoothingLength").calls, 2);
+        EXPECT_EQ(entries.at("SmoothingLength::Newton").calls, passes + 1);
+
+        // The rows before first are left untouched
+        Kokkos::deep_copy(particles.H(), 0.9);
+        smoothing.Solve(particles, search.List(), h_max, N / 2);
+        Kokkos::deep_copy(host_h, particles.H());
+        EXPECT_EQ(host_h(0), 0.9);
+        EXPECT_NE(host_h(N - 1), 0.9);
+    }
+    Kokkos::finalize();
+}
@@ -0,0 +1,60 @@
+#include <gtest/gtest.h>
+#include "sph_kernel.hpp"
+#include <Kokkos_Core.hpp>
+
+// Test CubicSplineKernel
+TEST(CubicSplineKernelTest, NormalizationGradient) {
+    Kokkos::initialize();
+    {
+        using Kernel = CubicSplineKernel;
+
+        // The kernel integrates to one (midpoint rule on a fine lattice)
+        const double h  = 1.0;
+        const double dx = 0.05;
+        const int n     = static_cast<int>(Kernel::support * h / dx);
+        double integral = 0.0;
+        for (int i = -n; i < n; ++i) {
+            for (int j = -n; j < n; ++j) {
+                for (int k = -n; k < n; ++k) {
+                    const double r = dx * Kokkos::sqrt((i + 0.5) * (i + 0.5) +
+                                                       (j + 0.5) * (j + 0.5) +
+                                                       (k + 0.5) * (k + 0.5));
+                    integral += Kernel::W(r, h) * dx * dx * dx;
+                }
+            }
+        }
+        EXPECT_NEAR(integral, 1.0, 1e-3);
+
+        // Compact support and continuity across the spline pieces
+        EXPECT_EQ(Kernel::W(2.0 * h, h), 0.0);
+        EXPECT_EQ(Kernel::GradWOverR(2.5 * h, h), 0.0);
+        EXPECT_NEAR(Kernel::W(1.0 - 1e-12, h), Kernel::W(1.0 + 1e-12, h),
+                    1e-10);
+
+        // Gradient against a centered finite difference
+        const double eps = 1e-6;
+        for (const double r : {0.3, 0.9, 1.1, 1.7}) {
+            const double dwdr =
+                (Kernel::W(r + eps, h) - Kernel::W(r - eps, h)) / (2 * eps);
+            EXPECT_NEAR(Kernel::GradWOverR(r, h) * r, dwdr, 1e-6);
+        }
+        EXPECT_LT(Kernel::GradWOverR(0.0, h), 0.0);
+
+        // Packed evaluation matches the scalar pieces, lane by lane
+        using Pack = SIMDOps::Pack<double>;
+        constexpr std::size_t width = SIMDOps::Width<double>();
+        double r_lanes[width], w_lanes[width], grad_lanes[width];
+        for (std::size_t l = 0; l < width; ++l) {
+            r_lanes[l] = 0.7 * l * h;
+        }
+        const Pack r_pack = SIMDOps::Load(r_lanes);
+        SIMDOps::Store(Kernel::W(r_pack, Pack(h)), w_lanes);
+        SIMDOps::Store(Kernel::GradWOverR(r_pack, Pack(h)), grad_lanes);
+        for (std::size_t l = 0; l < width; ++l) {
+            EXPECT_DOUBLE_EQ(w_lanes[l], Kernel::W(r_lanes[l], h));
+            EXPECT_DOUBLE_EQ(grad_lanes[l],
+                             Kernel::GradWOverR(r_lanes[l], h));
+        }
+    }
+    Kokkos::finalize();
+}
@@ -0,0 +1,237 @@
+#include <gtest/gtest.h>
+#include "sph_solver.hpp"
+#include <Kokkos_Core.hpp>
+
+#include <cmath>
+#include <stdexcept>
+#include <vector>
+
+#include "particle_data.hpp"
+
+// Test SPHSolver
+TEST(SPHSolverTest, DensityForces) {
+    Kokkos::initialize();
+    {
+        // Unit-mass particles on a 7x7x7 unit lattice, with a shear flow
+        const int n    = 7;
+        const int N    = n * n * n;
+        const double h = 1.3;
+        ParticleData<> particles(N);
+        auto host_x = Kokkos::create_mirror_view(particles.X());
+        auto host_v = Kokkos::create_mirror_view(particles.V());
+        for (int k = 0; k < n; ++k) {
+            for (int j = 0; j < n; ++j) {
+                for (int i = 0; i < n; ++i) {
+                    const int q  = i + n * (j + n * k);
+                    host_x(q, 0) = i;
+                    host_x(q, 1) = j;
+                    host_x(q, 2) = k;
+                    host_v(q, 0) = 0.1 * j;
+                    host_v(q, 1) = -0.05 * k;
+                    host_v(q, 2) = 0.02 * ((q * 7) % 5);
+                }
+            }
+        }
+        Kokkos::deep_copy(particles.X(), host_x);
+        Kokkos::deep_copy(particles.V(), host_v);
+        Kokkos::deep_copy(particles.Mass(), 1.0);
+        Kokkos::deep_copy(particles.H(), h);
+        Kokkos::deep_copy(particles.Eint(), 2.0);
+        Kokkos::deep_copy(particles.EOSId(), 0);
+
+        NeighborSearch search(CubicSplineKernel::support * h);
+        search.Build(particles.X());
+
+        std::vector<EOSVariant> eos_vector;
+        eos_vector.emplace_back(EOSLinearGas(0, 1.4, 1e-6));
+        SPHSolver solver{EOSMultiMaterial(eos_vector)};
+        EXPECT_EQ(solver.Coupling(), EOSCoupling::Separate);
+        SPHSolver lazy_solver{EOSMultiMaterial(eos_vector),
+                              EOSCoupling::Lazy, {}, {}, 1e-3};
+        EXPECT_DOUBLE_EQ(lazy_solver.LazyEOS().Tolerance(), 1e-3);
+        EXPECT_THROW(SPHSolver(EOSMultiMaterial(eos_vector),
+                               EOSCoupling::Lazy, {}, {}, -1.0),
+                     std::invalid_argument);
+
+        // Interior particles of a unit lattice have a density close to one
+        solver.Density(particles, search.List());
+        auto host_rho = Kokkos::create_mirror_view_and_copy(
+            Kokkos::HostSpace(), particles.Rho());
+        const int center = n / 2 * (1 + n + n * n);
+        EXPECT_NEAR(host_rho(center), 1.0, 0.02);
+        EXPECT_LT(host_rho(0), host_rho(center));
+
+        solver.Forces(particles, search.List());
+        auto host_a = Kokkos::create_mirror_view_and_copy(Kokkos::HostSpace(),
+                                                          particles.A());
+        auto host_de = Kokkos::create_mirror_view_and_copy(
+            Kokkos::HostSpace(), particles.DEintDt());
+
+        // Pairwise antisymmetric forces conserve momentum and energy
+        double momentum[3] = {0.0, 0.0, 0.0};
+        double energy      = 0.0;
+        for (int q = 0; q < N; ++q) {
+            for (int d = 0; d < 3; ++d) {
+                momentum[d] += host_a(q, d);
+                energy += host_v(q, d) * host_a(q, d);
+            }
+            energy += host_de(q);
+        }
+        for (int d = 0; d < 3; ++d) EXPECT_NEAR(momentum[d], 0.0, 1e-10);
+        EXPECT_NEAR(energy, 0.0, 1e-10);
+
+        // Boundary particles are pushed outwards
+        EXPECT_LT(host_a(0, 0), 0.0);
+
+        // The fused EOS path gives the same right-hand side
+        auto host_a_separate  = Kokkos::create_mirror(particles.A());
+        auto host_de_separate = Kokkos::create_mirror(particles.DEintDt());
+        Kokkos::deep_copy(host_a_separate, host_a);
+        Kokkos::deep_copy(host_de_separate, host_de);
+        Kokkos::deep_copy(particles.P(), 0.0);
+        Kokkos::deep_copy(particles.SoS(), 0.0);
+        solver.SetCoupling(EOSCoupling::Fused);
+        solver.Forces(particles, search.List());
+        Kokkos::deep_copy(host_a, particles.A());
+        Kokkos::deep_copy(host_de, particles.DEintDt());
+        for (int q = 0; q < N; ++q) {
+            EXPECT_DOUBLE_EQ(host_de(q), host_de_separate(q));
+            for (int d = 0; d < 3; ++d) {
+                EXPECT_DOUBLE_EQ(host_a(q, d), host_a_separate(q, d));
+            }
+        }
+        auto host_p = Kokkos::create_mirror_view_and_copy(Kokkos::HostSpace(),
+                                                          particles.P());
+        EXPECT_NEAR(host_p(center), 0.8 * host_rho(center), 1e-12);
+
+        // The cell-per-team kernels agree with the neighbor list, also when
+        // the cells are split into several tiles
+        EXPECT_THROW(solver.SetTuning({0, 3, 0}), std::invalid_argument);
+        for (const int tile : {0, 3}) {
+            solver.SetTuning({0, 0, tile});
+            for (const auto coupling :
+                 {EOSCoupling::Separate, EOSCoupling::Fused,
+                  EOSCoupling::Lazy}) {
+                solver.SetCoupling(coupling);
+                solver.Density(particles, search);
+                solver.Forces(particles, search);
+                const auto host_rho_team = Kokkos::create_mirror_view_and_copy(
+                    Kokkos::HostSpace(), particles.Rho());
+                Kokkos::deep_copy(host_a, particles.A());
+                Kokkos::deep_copy(host_de, particles.DEintDt());
+                for (int q = 0; q < N; ++q) {
+                    EXPECT_NEAR(host_rho_team(q), host_rho(q), 1e-12);
+                    EXPECT_NEAR(host_de(q), host_de_separate(q), 1e-12);
+                    for (int d = 0; d < 3; ++d) {
+                        EXPECT_NEAR(host_a(q, d), host_a_separate(q, d), 1e-12);
+                    }
+                }
+            }
+        }
+
+        // Each pair once, through a ScatterView or colored cell sweeps
+        EXPECT_EQ(solver.Loop(), PairLoop::CellTeams);
+        solver.SetLoop(PairLoop::HalfScatter);
+        EXPECT_THROW(solver.Forces(particles, search), std::runtime_error);
+        search.SetHalfList(true);
+        search.Build(particles.X());
+        for (const auto loop :
+             {PairLoop::HalfScatter, PairLoop::HalfColoring}) {
+            solver.SetLoop(loop);
+            for (const auto coupling :
+                 {EOSCoupling::Separate, EOSCoupling::Fused,
+                  EOSCoupling::Lazy}) {
+                solver.SetCoupling(coupling);
+                solver.Forces(particles, search);
+                Kokkos::deep_copy(host_a, particles.A());
+                Kokkos::deep_copy(host_de, particles.DEintDt());
+                for (int q = 0; q < N; ++q) {
+                    EXPECT_NEAR(host_de(q), host_de_separate(q), 1e-12);
+                    for (int d = 0; d < 3; ++d) {
+                        EXPECT_NEAR(host_a(q, d), host_a_separate(q, d), 1e-12);
+                    }
+                }
+            }
+        }
+
+        // The lazy EOS references move with the rows, so a reordering keeps
+        // the particles up to date
+        auto& lazy = solver.LazyEOS();
+        EXPECT_EQ(lazy.PressureSoS(particles), 0u);
+        Kokkos::View<int*> reverse("reverse", N);
+        Kokkos::parallel_for(
+            N, KOKKOS_LAMBDA(const int i) { reverse(i) = N - 1 - i; });
+        const ParticlePermutation permutation(reverse);
+        particles.Apply(permutation);
+        EXPECT_EQ(lazy.PressureSoS(particles), 0u);
+        Kokkos::deep_copy(host_p, particles.P());
+        EXPECT_NEAR(host_p(N - 1 - center), 0.8 * host_rho(center), 1e-12);
+        particles.Revert(permutation);
+        EOSLazy::Invalidate(particles);
+        EXPECT_EQ(lazy.PressureSoS(particles), static_cast<std::size_t>(N));
+
+        // Only the rows from `first` are updated
+        const std::size_t first = N / 2;
+        Kokkos::deep_copy(particles.A(), 0.0);
+        solver.Forces(particles, search, first);
+        Kokkos::deep_copy(host_a, particles.A());
+        EXPECT_EQ(host_a(first - 1, 0), 0.0);
+        for (int q = first; q < N; ++q) {
+            EXPECT_NEAR(host_a(q, 0), host_a_separate(q, 0), 1e-12);
+        }
+        Kokkos::deep_copy(particles.Rho(), 0.0);
+        solver.Density(particles, search, first);
+        Kokkos::deep_copy(host_rho, particles.Rho());
+        EXPECT_EQ(host_rho(first - 1), 0.0);
+        EXPECT_GT(host_rho(first), 0.0);
+
+        // The viscosity of an approaching pair uses the speed of sound,
+        // sqrt(gamma p / rho), not its square
+        ParticleData<> pair(2);
+        auto host_pair_x = Kokkos::create_mirror_view(pair.X());
+        auto host_pair_v = Kokkos::create_mirror_view(pair.V());
+        Kokkos::deep_copy(host_pair_x, 0.0);
+        Kokkos::deep_copy(host_pair_v, 0.0);
+        host_pair_x(1, 0) = 0.5;
+        host_pair_v(0, 0) = 1.0;
+        host_pair_v(1, 0) = -1.0;
+        Kokkos::deep_copy(pair.X(), host_pair_x);
+        Kokkos::deep_copy(pair.V(), host_pair_v);
+        Kokkos::deep_copy(pair.Mass(), 1.0);
+        Kokkos::deep_copy(pair.H(), 1.0);
+        Kokkos::deep_copy(pair.Rho(), 1.0);
+        Kokkos::deep_copy(pair.Eint(), 10.0);
+        Kokkos::deep_copy(pair.EOSId(), 0);
+        const double p_pair = 0.4 * 10.0;
+        const double c_pair = std::sqrt(1.4 * p_pair);
+        const double mu     = -1.0 / (0.25 + 0.01);
+        const double visc   = -1.0 * c_pair * mu + 2.0 * mu * mu;
+        const double a_pair = -(2.0 * p_pair + visc) *
+                              CubicSplineKernel::GradWOverR(0.5, 1.0) * -0.5;
+        const double tolerance = 1e-12 * std::abs(a_pair);
+        auto host_pair_a       = Kokkos::create_mirror_view(pair.A());
+        SPHSolver pair_solver{EOSMultiMaterial(eos_vector),
+                              EOSCoupling::Separate,
+                              {1.0, 2.0}};
+        NeighborSearch pair_search(CubicSplineKernel::support);
+        for (const bool half : {false, true}) {
+            pair_search.SetHalfList(half);
+            pair_search.Build(pair.X());
+            for (const auto loop : half ? std::vector{PairLoop::HalfScatter,
+                                                      PairLoop::HalfColoring}
+                                        : std::vector{PairLoop::CellTeams,
+                                                      PairLoop::FullList}) {
+                pair_solver.SetLoop(loop);
+                for (const auto coupling :
+                     {EOSCoupling::Separate, EOSCoupling::Fused}) {
+                    pair_solver.SetCoupling(coupling);
+                    pair_solver.Forces(pair, pair_search);
+                    Kokkos::deep_copy(host_pair_a, pair.A());
+                    EXPECT_NEAR(host_pair_a(0, 0), a_pair, tolerance);
+                    EXPECT_NEAR(host_pair_a(1, 0), -a_pair, tolerance);
+                }
+            }
+        }
+    }
+    Kokkos::finalize();
+}
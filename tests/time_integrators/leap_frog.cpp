@@ -0,0 +1,90 @@
+#include <gtest/gtest.h>
+#include "leap_frog.hpp"
+#include <Kokkos_Core.hpp>
+#include <mpi.h>
+
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+
+#include "particle_data.hpp"
+
+// Test LeapFrog
+TEST(LeapFrogTest, HarmonicOscillator) {
+    MPI_Init(nullptr, nullptr);
+    Kokkos::initialize();
+    {
+        EXPECT_THROW(LeapFrog(0.0), std::invalid_argument);
+        EXPECT_THROW(LeapFrog(0.5, 0.9), std::invalid_argument);
+
+        // Unit oscillators a = -x with a constant heating rate
+        const int N = 8;
+        ParticleData<> particles(N);
+        auto x = particles.X();
+        Kokkos::parallel_for(
+            "InitializeParticles", N, KOKKOS_LAMBDA(const int i) {
+                x(i, 0) = 1.0 + i;
+                x(i, 1) = 0.0;
+                x(i, 2) = 0.0;
+            });
+        Kokkos::deep_copy(particles.V(), 0.0);
+        Kokkos::deep_copy(particles.Eint(), 0.0);
+        Kokkos::deep_copy(particles.DEintDt(), 1.0);
+        Kokkos::deep_copy(particles.H(), 0.01);
+        Kokkos::deep_copy(particles.SoS(), 1.0);
+        auto forces = [](const ParticleData<>& p) {
+            const auto x = p.X();
+            const auto a = p.A();
+            Kokkos::parallel_for(
+                "Forces", x.extent(0), KOKKOS_LAMBDA(const int i) {
+                    for (int d = 0; d < 3; ++d) a(i, d) = -x(i, d);
+                });
+        };
+        forces(particles);
+
+        // The slowest particle (at rest) sets the first step: cfl h / sos,
+        // and the growth limit applies from then on
+        // The EOS store the squared speed of sound
+        EXPECT_DOUBLE_EQ(LeapFrog::CFLTimestep(0.5, 1.0, 4.0, 1.0, 0.0),
+                         0.5 / 3.0);
+
+        LeapFrog integrator(0.5, 1.1);
+        EXPECT_THROW(integrator.Step(particles, forces), std::runtime_error);
+        EXPECT_DOUBLE_EQ(integrator.Start(particles), 0.5 * 0.01 / 1.0);
+
+        const double t_end = 2.0 * Kokkos::numbers::pi;
+        double dt_min      = integrator.Dt();
+        double dt_previous = integrator.Dt();
+        while (integrator.Time() < t_end) {
+            integrator.Step(particles, forces, t_end);
+            EXPECT_LE(integrator.Dt(), 1.1 * dt_previous * (1.0 + 1e-12));
+            dt_previous = integrator.Dt();
+            dt_min      = std::min(dt_min, integrator.Dt());
+        }
+        EXPECT_DOUBLE_EQ(integrator.Time(), t_end);
+        EXPECT_GT(integrator.NumSteps(), 100);
+
+        // No step past the end time
+        const int n_steps = integrator.NumSteps();
+        EXPECT_EQ(integrator.Step(particles, forces, t_end), 0.0);
+        EXPECT_EQ(integrator.Step(particles, forces, 0.5 * t_end), 0.0);
+        EXPECT_EQ(integrator.NumSteps(), n_steps);
+        EXPECT_DOUBLE_EQ(integrator.Time(), t_end);
+
+        // Back to the initial state after one period (second order)
+        auto host_x    = Kokkos::create_mirror_view(particles.X());
+        auto host_v    = Kokkos::create_mirror_view(particles.V());
+        auto host_eint = Kokkos::create_mirror_view(particles.Eint());
+        Kokkos::deep_copy(host_x, particles.X());
+        Kokkos::deep_copy(host_v, particles.V());
+        Kokkos::deep_copy(host_eint, particles.Eint());
+        for (int i = 0; i < N; ++i) {
+            EXPECT_NEAR(host_x(i, 0), 1.0 + i, 1e-3 * (1.0 + i));
+            EXPECT_NEAR(host_v(i, 0), 0.0, 1e-3 * (1.0 + i));
+            EXPECT_NEAR(host_eint(i), t_end, 1e-12);
+        }
+        EXPECT_GT(dt_min, 0.0);
+    }
+    Kokkos::finalize();
+    MPI_Finalize();
+}
@@ -0,0 +1,84 @@
+#include <gtest/gtest.h>
+#include "time_bins.hpp"
+#include <Kokkos_Core.hpp>
+#include <mpi.h>
+
+#include <cmath>
+
+#include "particle_data.hpp"
+
+// Test TimeBins
+TEST(TimeBinsTest, TwoRateOscillators) {
+    MPI_Init(nullptr, nullptr);
+    Kokkos::initialize();
+    {
+        EXPECT_THROW(TimeBins(0.0), std::invalid_argument);
+        EXPECT_THROW(TimeBins(0.5, 0), std::invalid_argument);
+
+        // Unit oscillators; every fourth particle has an 8 times larger
+        // speed of sound (the field holds its square)
+        const int N = 16;
+        ParticleData<> particles(N);
+        auto x    = particles.X();
+        auto sos  = particles.SoS();
+        auto p_id = particles.PartId();
+        Kokkos::parallel_for(
+            "InitializeParticles", N, KOKKOS_LAMBDA(const int i) {
+                x(i, 0) = 1.0 + i;
+                x(i, 1) = 0.0;
+                x(i, 2) = 0.0;
+                sos(i)  = i % 4 == 0 ? 64.0 : 1.0;
+                p_id(i) = i;
+            });
+        Kokkos::deep_copy(particles.V(), 0.0);
+        Kokkos::deep_copy(particles.Eint(), 0.0);
+        Kokkos::deep_copy(particles.DEintDt(), 1.0);
+        Kokkos::deep_copy(particles.H(), 0.01);
+        auto forces = [](const ParticleData<>& p, const std::size_t first) {
+            const auto x = p.X();
+            const auto a = p.A();
+            Kokkos::parallel_for(
+                "Forces", Kokkos::RangePolicy<>(first, x.extent(0)),
+                KOKKOS_LAMBDA(const int i) {
+                    for (int d = 0; d < 3; ++d) a(i, d) = -x(i, d);
+                });
+        };
+        forces(particles, 0);
+
+        TimeBins bins(0.5, 8);
+        EXPECT_DOUBLE_EQ(bins.Assign(particles), 0.5 * 0.01);
+        EXPECT_EQ(bins.DeepestBin(), 3);
+        EXPECT_EQ(bins.NumSubsteps(), 8);
+        EXPECT_EQ(bins.Range(0).second - bins.Range(0).first, 12);
+        EXPECT_EQ(bins.Range(3).second - bins.Range(3).first, 4);
+        // Only the deepest bin is active between the base step boundaries
+        EXPECT_EQ(bins.FirstActive(0), 0u);
+        EXPECT_EQ(bins.FirstActive(3), 12u);
+        EXPECT_EQ(bins.FirstActive(4), 12u);
+        EXPECT_EQ(bins.FirstActive(8), 0u);
+
+        int n_steps = 0;
+        while (bins.Time() < 2.0 * Kokkos::numbers::pi - 1e-9) {
+            bins.Step(particles, forces);
+            ++n_steps;
+        }
+        EXPECT_EQ(bins.NumEvaluations(),
+                  static_cast<std::size_t>(n_steps) * (12 + 4 * 8));
+
+        // Close to the initial state after one period in both bins
+        auto host_x    = Kokkos::create_mirror_view(particles.X());
+        auto host_eint = Kokkos::create_mirror_view(particles.Eint());
+        auto host_id   = Kokkos::create_mirror_view(particles.PartId());
+        Kokkos::deep_copy(host_x, particles.X());
+        Kokkos::deep_copy(host_eint, particles.Eint());
+        Kokkos::deep_copy(host_id, particles.PartId());
+        const double t = bins.Time();
+        for (int i = 0; i < N; ++i) {
+            const double x0 = 1.0 + host_id(i);
+            EXPECT_NEAR(host_x(i, 0), x0 * std::cos(t), 1e-4 * x0);
+            EXPECT_NEAR(host_eint(i), t, 1e-9);
+        }
+    }
+    Kokkos::finalize();
+    MPI_Finalize();
+}